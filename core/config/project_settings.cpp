@@ -35,6 +35,7 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_pack.h"
 #include "core/io/marshalls.h"
 #include "core/io/resource_uid.h"
@@ -888,6 +889,10 @@ Error ProjectSettings::setup(const String &p_path, const String &p_main_pack, bo
 
 	Compression::gzip_level = GLOBAL_GET("compression/formats/gzip/compression_level");
 
+	FileAccessCompressed::default_block_size = GLOBAL_GET("compression/file_access/block_size");
+	FileAccessCompressed::read_cache_size = (uint64_t)GLOBAL_GET("compression/file_access/read_cache_size_kb") * 1024;
+	FileAccessCompressed::prefetch_blocks = GLOBAL_GET("compression/file_access/prefetch_blocks");
+
 	load_scene_groups_cache();
 
 	project_loaded = err == OK;
@@ -1775,6 +1780,9 @@ ProjectSettings::ProjectSettings() {
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "debug/settings/profiler/max_functions", PROPERTY_HINT_RANGE, "128,65535,1"), 16384);
 	GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/profiler/max_timestamp_query_elements", PROPERTY_HINT_RANGE, "256,65535,1"), 256);
 
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/file_access/block_size", PROPERTY_HINT_RANGE, "256,16777216,1,suffix:B"), FileAccessCompressed::default_block_size);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/file_access/read_cache_size_kb", PROPERTY_HINT_RANGE, "0,1048576,1,or_greater,suffix:KiB"), FileAccessCompressed::read_cache_size / 1024);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/file_access/prefetch_blocks", PROPERTY_HINT_RANGE, "0,64,1"), FileAccessCompressed::prefetch_blocks);
 	GLOBAL_DEF(PropertyInfo(Variant::BOOL, "compression/formats/zstd/long_distance_matching"), Compression::zstd_long_distance_matching);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/formats/zstd/compression_level", PROPERTY_HINT_RANGE, "1,22,1"), Compression::zstd_level);
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "compression/formats/zstd/window_log_size", PROPERTY_HINT_RANGE, "10,30,1"), Compression::zstd_window_log_size);
@@ -42,6 +42,7 @@
 #include "core/os/keyboard.h"
 #include "core/os/main_loop.h"
 #include "core/os/thread_safe.h"
+#include "core/profiling/profiling.h"
 #include "core/variant/typed_array.h"
 
 namespace CoreBind {
@@ -600,6 +601,30 @@ Dictionary OS::get_memory_info() const {
 	return ::OS::get_singleton()->get_memory_info();
 }
 
+Error OS::start_trace() {
+#ifdef GODOT_USE_BUILTIN_TRACER
+	return TraceRecorder::start();
+#else
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Tracing requires the built-in tracer, which isn't available in this build (see the `builtin_tracer` and `profiler_path` SCons options).");
+#endif
+}
+
+Error OS::stop_trace(const String &p_path) {
+#ifdef GODOT_USE_BUILTIN_TRACER
+	return TraceRecorder::stop(p_path);
+#else
+	ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "Tracing requires the built-in tracer, which isn't available in this build (see the `builtin_tracer` and `profiler_path` SCons options).");
+#endif
+}
+
+bool OS::is_tracing() const {
+#ifdef GODOT_USE_BUILTIN_TRACER
+	return TraceRecorder::is_recording();
+#else
+	return false;
+#endif
+}
+
 /** This method uses a signed argument for better error reporting as it's used from the scripting API. */
 void OS::delay_usec(int p_usec) const {
 	ERR_FAIL_COND_MSG(
@@ -821,6 +846,10 @@ void OS::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_static_memory_peak_usage"), &OS::get_static_memory_peak_usage);
 	ClassDB::bind_method(D_METHOD("get_memory_info"), &OS::get_memory_info);
 
+	ClassDB::bind_method(D_METHOD("start_trace"), &OS::start_trace);
+	ClassDB::bind_method(D_METHOD("stop_trace", "path"), &OS::stop_trace);
+	ClassDB::bind_method(D_METHOD("is_tracing"), &OS::is_tracing);
+
 	ClassDB::bind_method(D_METHOD("move_to_trash", "path"), &OS::move_to_trash);
 	ClassDB::bind_method(D_METHOD("get_user_data_dir"), &OS::get_user_data_dir);
 	ClassDB::bind_method(D_METHOD("get_system_dir", "dir", "shared_storage"), &OS::get_system_dir, DEFVAL(true));
@@ -265,6 +265,10 @@ public:
 	uint64_t get_static_memory_peak_usage() const;
 	Dictionary get_memory_info() const;
 
+	Error start_trace();
+	Error stop_trace(const String &p_path);
+	bool is_tracing() const;
+
 	void delay_usec(int p_usec) const;
 	void delay_msec(int p_msec) const;
 	uint64_t get_ticks_msec() const;
@@ -40,6 +40,7 @@
 #include "core/math/expression.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
+#include "core/profiling/alloc_profiler.h"
 #include "servers/display/display_server.h"
 
 class RemoteDebugger::PerformanceProfiler : public EngineProfiler {
@@ -99,6 +100,45 @@ public:
 	}
 };
 
+#ifdef ALLOC_PROFILER_ENABLED
+class RemoteDebugger::AllocationProfiler : public EngineProfiler {
+	bool started = false;
+	uint64_t last_report_time = 0;
+
+public:
+	void toggle(bool p_enable, const Array &p_opts) override {
+		if (p_enable) {
+			// Don't take over a profiler started from the command line.
+			if (!AllocProfiler::is_active()) {
+				const uint64_t interval = p_opts.size() > 0 ? uint64_t(p_opts[0]) : AllocProfiler::DEFAULT_SAMPLE_INTERVAL;
+				AllocProfiler::start(interval);
+				started = true;
+			}
+		} else if (started) {
+			AllocProfiler::stop();
+			started = false;
+		}
+	}
+	void add(const Array &p_data) override {}
+	void tick(double p_frame_time, double p_process_time, double p_physics_time, double p_physics_frame_time) override {
+		uint64_t pt = OS::get_singleton()->get_ticks_msec();
+		if (pt - last_report_time < 1000) {
+			return;
+		}
+		last_report_time = pt;
+
+		Array arr = { AllocProfiler::get_report() };
+		EngineDebugger::get_singleton()->send_message("allocations:profile_frame", arr);
+	}
+
+	~AllocationProfiler() {
+		if (started) {
+			AllocProfiler::stop();
+		}
+	}
+};
+#endif // ALLOC_PROFILER_ENABLED
+
 Error RemoteDebugger::_put_msg(const String &p_message, const Array &p_data) {
 	Array msg = { p_message, Thread::get_caller_id(), p_data };
 	Error err = peer->put_message(msg);
@@ -752,6 +792,12 @@ RemoteDebugger::RemoteDebugger(Ref<RemoteDebuggerPeer> p_peer) {
 		profiler_enable("performance", true);
 	}
 
+#ifdef ALLOC_PROFILER_ENABLED
+	// Allocation Profiler
+	allocation_profiler.instantiate();
+	allocation_profiler->bind("allocations");
+#endif
+
 	// Core and profiler captures.
 	Capture core_cap(this,
 			[](void *p_user, const String &p_cmd, const Array &p_data, bool &r_captured) {
@@ -53,6 +53,12 @@ private:
 
 	Ref<PerformanceProfiler> performance_profiler;
 
+#ifdef ALLOC_PROFILER_ENABLED
+	class AllocationProfiler;
+
+	Ref<AllocationProfiler> allocation_profiler;
+#endif
+
 	Ref<RemoteDebuggerPeer> peer;
 
 	struct OutputString {
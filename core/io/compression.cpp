@@ -41,11 +41,36 @@
 #include <brotli/decode.h>
 #endif
 
-// Caches for zstd.
-static BinaryMutex mutex;
-static ZSTD_DCtx *current_zstd_d_ctx = nullptr;
-static bool current_zstd_long_distance_matching;
-static int current_zstd_window_log_size;
+// Cache for zstd, kept per thread so blocks can be decompressed in parallel.
+struct ZstdDecompressionContext {
+	ZSTD_DCtx *ctx = nullptr;
+	bool long_distance_matching = false;
+	int window_log_size = 0;
+
+	ZSTD_DCtx *get() {
+		if (!ctx || long_distance_matching != Compression::zstd_long_distance_matching || window_log_size != Compression::zstd_window_log_size) {
+			if (ctx) {
+				ZSTD_freeDCtx(ctx);
+			}
+
+			ctx = ZSTD_createDCtx();
+			if (Compression::zstd_long_distance_matching) {
+				ZSTD_DCtx_setParameter(ctx, ZSTD_d_windowLogMax, Compression::zstd_window_log_size);
+			}
+			long_distance_matching = Compression::zstd_long_distance_matching;
+			window_log_size = Compression::zstd_window_log_size;
+		}
+		return ctx;
+	}
+
+	~ZstdDecompressionContext() {
+		if (ctx) {
+			ZSTD_freeDCtx(ctx);
+		}
+	}
+};
+
+static thread_local ZstdDecompressionContext zstd_d_ctx;
 
 int64_t Compression::compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode) {
 	switch (p_mode) {
@@ -198,22 +223,7 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 			return total;
 		} break;
 		case MODE_ZSTD: {
-			MutexLock lock(mutex);
-
-			if (!current_zstd_d_ctx || current_zstd_long_distance_matching != zstd_long_distance_matching || current_zstd_window_log_size != zstd_window_log_size) {
-				if (current_zstd_d_ctx) {
-					ZSTD_freeDCtx(current_zstd_d_ctx);
-				}
-
-				current_zstd_d_ctx = ZSTD_createDCtx();
-				if (zstd_long_distance_matching) {
-					ZSTD_DCtx_setParameter(current_zstd_d_ctx, ZSTD_d_windowLogMax, zstd_window_log_size);
-				}
-				current_zstd_long_distance_matching = zstd_long_distance_matching;
-				current_zstd_window_log_size = zstd_window_log_size;
-			}
-
-			size_t ret = ZSTD_decompressDCtx(current_zstd_d_ctx, p_dst, p_dst_max_size, p_src, p_src_size);
+			size_t ret = ZSTD_decompressDCtx(zstd_d_ctx.get(), p_dst, p_dst_max_size, p_src, p_src_size);
 			return (int64_t)ret;
 		} break;
 	}
@@ -221,6 +231,25 @@ int64_t Compression::decompress(uint8_t *p_dst, int64_t p_dst_max_size, const ui
 	ERR_FAIL_V(-1);
 }
 
+int64_t Compression::compress_zstd_dictionary(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, const uint8_t *p_dict, int64_t p_dict_size) {
+	ZSTD_CCtx *cctx = ZSTD_createCCtx();
+	const int64_t max_dst_size = get_max_compressed_buffer_size(p_src_size, MODE_ZSTD);
+	const size_t ret = ZSTD_compress_usingDict(cctx, p_dst, max_dst_size, p_src, p_src_size, p_dict, p_dict_size, zstd_level);
+	ZSTD_freeCCtx(cctx);
+	if (ZSTD_isError(ret)) {
+		return -1;
+	}
+	return (int64_t)ret;
+}
+
+int64_t Compression::decompress_zstd_dictionary(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, const uint8_t *p_dict, int64_t p_dict_size) {
+	const size_t ret = ZSTD_decompress_usingDict(zstd_d_ctx.get(), p_dst, p_dst_max_size, p_src, p_src_size, p_dict, p_dict_size);
+	if (ZSTD_isError(ret)) {
+		return -1;
+	}
+	return (int64_t)ret;
+}
+
 /**
 	This will handle both Gzip and Deflate streams. It will automatically allocate the output buffer into the provided p_dst_vect Vector.
 	This is required for compressed data whose final uncompressed size is unknown, as is the case for HTTP response bodies.
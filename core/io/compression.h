@@ -55,5 +55,9 @@ public:
 	static int64_t compress(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int64_t get_max_compressed_buffer_size(int64_t p_src_size, Mode p_mode = MODE_ZSTD);
 	static int64_t decompress(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode = MODE_ZSTD);
+	// Zstandard with a raw content dictionary, which must be the same when compressing and decompressing.
+	// Helps small inputs that share most of their content with the dictionary, e.g. text resources of the same kind.
+	static int64_t compress_zstd_dictionary(uint8_t *p_dst, const uint8_t *p_src, int64_t p_src_size, const uint8_t *p_dict, int64_t p_dict_size);
+	static int64_t decompress_zstd_dictionary(uint8_t *p_dst, int64_t p_dst_max_size, const uint8_t *p_src, int64_t p_src_size, const uint8_t *p_dict, int64_t p_dict_size);
 	static int decompress_dynamic(Vector<uint8_t> *p_dst_vect, int64_t p_max_dst_size, const uint8_t *p_src, int64_t p_src_size, Mode p_mode);
 };
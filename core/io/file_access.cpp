@@ -33,6 +33,7 @@
 
 #include "core/config/project_settings.h"
 #include "core/crypto/crypto_core.h"
+#include "core/io/file_access_async.h"
 #include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h"
@@ -584,6 +585,29 @@ Vector<uint8_t> FileAccess::get_buffer(int64_t p_length) const {
 	return data;
 }
 
+uint64_t FileAccess::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	const uint64_t original_pos = get_position();
+	seek(p_offset);
+	const uint64_t read = get_buffer(p_dst, p_length);
+	seek(original_pos);
+	return read;
+}
+
+Ref<FileAccessAsyncRead> FileAccess::read_async(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, AsyncReadCallback p_callback, void *p_userdata) {
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, Ref<FileAccessAsyncRead>());
+
+	Ref<FileAccessAsyncRead> read;
+	read.instantiate();
+	read->setup(Ref<FileAccess>(this), p_offset, p_dst, p_length, p_callback, p_userdata);
+	_read_async(read);
+	return read;
+}
+
+void FileAccess::_read_async(const Ref<FileAccessAsyncRead> &p_read) {
+	const uint64_t read_length = get_buffer_at(p_read->get_offset(), p_read->get_destination(), p_read->get_length());
+	p_read->complete(OK, read_length);
+}
+
 String FileAccess::get_as_utf8_string() const {
 	Vector<uint8_t> sourcef;
 	uint64_t len = get_length();
@@ -920,14 +944,14 @@ bool FileAccess::store_buffer(const uint8_t *p_src, uint64_t p_length) {
 
 bool FileAccess::store_var(const Variant &p_var, bool p_full_objects) {
 	int len;
-	Error err = encode_variant(p_var, nullptr, len, p_full_objects);
+	Error err = encode_variant(p_var, nullptr, len, p_full_objects, 0, compact_var_encoding);
 	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
 
 	Vector<uint8_t> buff;
 	buff.resize(len);
 
 	uint8_t *w = buff.ptrw();
-	err = encode_variant(p_var, &w[0], len, p_full_objects);
+	err = encode_variant(p_var, &w[0], len, p_full_objects, 0, compact_var_encoding);
 	ERR_FAIL_COND_V_MSG(err != OK, false, "Error when trying to encode Variant.");
 
 	return store_32(uint32_t(len)) && store_buffer(buff);
@@ -1084,6 +1108,8 @@ void FileAccess::_bind_methods() {
 	ClassDB::bind_static_method("FileAccess", D_METHOD("get_sha256", "path"), &FileAccess::get_sha256);
 	ClassDB::bind_method(D_METHOD("is_big_endian"), &FileAccess::is_big_endian);
 	ClassDB::bind_method(D_METHOD("set_big_endian", "big_endian"), &FileAccess::set_big_endian);
+	ClassDB::bind_method(D_METHOD("is_compact_var_encoding"), &FileAccess::is_compact_var_encoding);
+	ClassDB::bind_method(D_METHOD("set_compact_var_encoding", "enabled"), &FileAccess::set_compact_var_encoding);
 	ClassDB::bind_method(D_METHOD("get_error"), &FileAccess::get_error);
 	ClassDB::bind_method(D_METHOD("get_var", "allow_objects"), &FileAccess::get_var, DEFVAL(false));
 
@@ -1127,6 +1153,7 @@ void FileAccess::_bind_methods() {
 	ClassDB::bind_static_method("FileAccess", D_METHOD("get_extended_attributes_list", "file"), &FileAccess::get_extended_attributes_list);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "big_endian"), "set_big_endian", "is_big_endian");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compact_var_encoding"), "set_compact_var_encoding", "is_compact_var_encoding");
 
 	BIND_ENUM_CONSTANT(READ);
 	BIND_ENUM_CONSTANT(WRITE);
@@ -37,6 +37,8 @@
 #include "core/string/ustring.h"
 #include "core/typedefs.h"
 
+class FileAccessAsyncRead;
+
 /**
  * Multi-Platform abstraction for accessing to files.
  */
@@ -87,12 +89,14 @@ public:
 	typedef void (*FileCloseFailNotify)(const String &);
 
 	typedef Ref<FileAccess> (*CreateFunc)();
+	typedef void (*AsyncReadCallback)(void *p_userdata, Error p_error, uint64_t p_read_length);
 #ifdef BIG_ENDIAN_ENABLED
 	bool big_endian = true;
 #else
 	bool big_endian = false;
 #endif
 	bool real_is_double = false;
+	bool compact_var_encoding = false;
 
 	virtual BitField<UnixPermissionFlags> _get_unix_permissions(const String &p_file) = 0;
 	virtual Error _set_unix_permissions(const String &p_file, BitField<UnixPermissionFlags> p_permissions) = 0;
@@ -107,6 +111,8 @@ public:
 	virtual Error _remove_extended_attribute(const String &p_file, const String &p_attribute_name) { return ERR_UNAVAILABLE; }
 	virtual PackedStringArray _get_extended_attributes_list(const String &p_file) { return PackedStringArray(); }
 
+	virtual void _read_async(const Ref<FileAccessAsyncRead> &p_read);
+
 protected:
 	static void _bind_methods();
 
@@ -191,6 +197,18 @@ public:
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const = 0; ///< get an array of bytes, needs to be overwritten by children.
 	Vector<uint8_t> get_buffer(int64_t p_length) const;
+	/// Zero-copy read: returns a view of exactly p_length bytes at the current position and advances past them.
+	/// If fewer bytes are left, or the backend can't expose its storage, returns an empty span without moving; fall back to get_buffer() then.
+	/// The view stays valid as long as this file access is kept alive.
+	virtual Span<uint8_t> get_buffer_view(uint64_t p_length) const { return Span<uint8_t>(); }
+	/// Reads at p_offset without using or moving the current position. Backends that override it can be read this way from several threads at once.
+	virtual uint64_t get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length);
+	/// Starts reading p_length bytes at p_offset into p_dst, which must stay valid until the returned read completes.
+	/// Several reads can be in flight at once, and the current position isn't used or moved. The callback, if any, is called from
+	/// whichever thread completes the read. Backends that don't support it (see can_read_async()) read synchronously instead.
+	Ref<FileAccessAsyncRead> read_async(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, AsyncReadCallback p_callback = nullptr, void *p_userdata = nullptr);
+	/// Whether read_async() returns without waiting for the data.
+	virtual bool can_read_async() const { return false; }
 	virtual String get_line() const;
 	virtual String get_token() const;
 	virtual Vector<String> get_csv_line(const String &p_delim = ",") const;
@@ -206,6 +224,10 @@ public:
 	virtual void set_big_endian(bool p_big_endian) { big_endian = p_big_endian; }
 	inline bool is_big_endian() const { return big_endian; }
 
+	// Typed containers written with store_var() drop per-element headers. get_var() reads both forms.
+	void set_compact_var_encoding(bool p_enabled) { compact_var_encoding = p_enabled; }
+	bool is_compact_var_encoding() const { return compact_var_encoding; }
+
 	virtual Error get_error() const = 0; ///< get last error
 
 	virtual Error resize(int64_t p_length) = 0;
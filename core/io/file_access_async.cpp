@@ -0,0 +1,166 @@
+/**************************************************************************/
+/*  file_access_async.cpp                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_async.h"
+
+void FileAccessAsyncRead::setup(const Ref<FileAccess> &p_file, uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, FileAccess::AsyncReadCallback p_callback, void *p_userdata) {
+	file = p_file;
+	offset = p_offset;
+	dst = p_dst;
+	length = p_length;
+	callback = p_callback;
+	userdata = p_userdata;
+}
+
+void FileAccessAsyncRead::redirect(const Ref<FileAccess> &p_file, uint64_t p_offset, uint64_t p_length) {
+	ERR_FAIL_COND(completed.is_set());
+	file = p_file;
+	offset = p_offset;
+	length = p_length;
+}
+
+void FileAccessAsyncRead::complete(Error p_error, uint64_t p_read_length) {
+	ERR_FAIL_COND(completed.is_set());
+	error = p_error;
+	read_length = p_read_length;
+	if (callback) {
+		callback(userdata, error, read_length);
+	}
+	file.unref();
+
+	MutexLock lock(mutex);
+	completed.set();
+	completed_cond.notify_all();
+}
+
+Error FileAccessAsyncRead::wait() {
+	if (!completed.is_set()) {
+		MutexLock lock(mutex);
+		while (!completed.is_set()) {
+			completed_cond.wait(lock);
+		}
+	}
+	return error;
+}
+
+Error FileAccessAsyncRead::get_error() const {
+	ERR_FAIL_COND_V_MSG(!completed.is_set(), ERR_BUSY, "The read hasn't completed yet.");
+	return error;
+}
+
+uint64_t FileAccessAsyncRead::get_read_length() const {
+	ERR_FAIL_COND_V_MSG(!completed.is_set(), 0, "The read hasn't completed yet.");
+	return read_length;
+}
+
+//////////////////////////////////////////////////////////////////
+
+FileAccessAsync *(*FileAccessAsync::_create)() = nullptr;
+
+FileAccessAsync *FileAccessAsync::create() {
+	ERR_FAIL_COND_V_MSG(singleton, nullptr, "FileAccessAsync singleton already exists.");
+	if (_create) {
+		return _create();
+	}
+	return memnew(FileAccessAsync);
+}
+
+void FileAccessAsync::_thread_func(void *p_self) {
+	FileAccessAsync *self = static_cast<FileAccessAsync *>(p_self);
+
+	while (true) {
+		self->semaphore.wait();
+
+		MutexLock lock(self->mutex);
+		if (self->queue.is_empty()) {
+			if (self->exiting.is_set()) {
+				break;
+			}
+			continue;
+		}
+		Ref<FileAccessAsyncRead> read = self->queue.front()->get();
+		self->queue.pop_front();
+		lock.temp_unlock();
+
+		const uint64_t read_length = read->get_file()->get_buffer_at(read->get_offset(), read->get_destination(), read->get_length());
+		read->complete(OK, read_length);
+	}
+}
+
+void FileAccessAsync::submit(const Ref<FileAccessAsyncRead> &p_read, int p_fd) {
+	ERR_FAIL_COND(p_read.is_null());
+
+	if (p_fd >= 0 && _submit_native(p_read, p_fd)) {
+		return;
+	}
+
+#ifdef THREADS_ENABLED
+	MutexLock lock(mutex);
+	if (!exiting.is_set()) {
+		if (threads.is_empty()) {
+			// Started on first use, most projects never read asynchronously.
+			threads.resize(THREAD_COUNT);
+			for (Thread &thread : threads) {
+				thread.start(&FileAccessAsync::_thread_func, this);
+			}
+		}
+		queue.push_back(p_read);
+		semaphore.post();
+		return;
+	}
+	lock.temp_unlock();
+#endif
+
+	const uint64_t read_length = p_read->get_file()->get_buffer_at(p_read->get_offset(), p_read->get_destination(), p_read->get_length());
+	p_read->complete(OK, read_length);
+}
+
+FileAccessAsync::FileAccessAsync() {
+	singleton = this;
+}
+
+FileAccessAsync::~FileAccessAsync() {
+	{
+		MutexLock lock(mutex);
+		exiting.set();
+	}
+	// Queued reads are still carried out before the threads exit.
+	for (uint32_t i = 0; i < threads.size(); i++) {
+		semaphore.post();
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+	threads.clear();
+
+	if (singleton == this) {
+		singleton = nullptr;
+	}
+}
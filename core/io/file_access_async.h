@@ -0,0 +1,109 @@
+/**************************************************************************/
+/*  file_access_async.h                                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/os/condition_variable.h"
+#include "core/os/mutex.h"
+#include "core/os/semaphore.h"
+#include "core/os/thread.h"
+#include "core/templates/list.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+
+// A read started with FileAccess::read_async().
+class FileAccessAsyncRead : public RefCounted {
+	GDSOFTCLASS(FileAccessAsyncRead, RefCounted);
+
+	Ref<FileAccess> file; // Kept open until the read completes.
+	uint64_t offset = 0;
+	uint8_t *dst = nullptr;
+	uint64_t length = 0;
+	FileAccess::AsyncReadCallback callback = nullptr;
+	void *userdata = nullptr;
+
+	Error error = OK;
+	uint64_t read_length = 0;
+	SafeFlag completed;
+	BinaryMutex mutex;
+	ConditionVariable completed_cond;
+
+public:
+	void setup(const Ref<FileAccess> &p_file, uint64_t p_offset, uint8_t *p_dst, uint64_t p_length, FileAccess::AsyncReadCallback p_callback, void *p_userdata);
+	// For backends reading from another file, e.g. the pack a file is in.
+	void redirect(const Ref<FileAccess> &p_file, uint64_t p_offset, uint64_t p_length);
+	// Called by the backend once done, reads past the end of the file complete with a shorter length.
+	void complete(Error p_error, uint64_t p_read_length);
+
+	const Ref<FileAccess> &get_file() const { return file; }
+	uint64_t get_offset() const { return offset; }
+	uint8_t *get_destination() const { return dst; }
+	uint64_t get_length() const { return length; }
+
+	bool is_completed() const { return completed.is_set(); }
+	// Blocks until the read completes.
+	Error wait();
+	Error get_error() const;
+	uint64_t get_read_length() const;
+};
+
+// Carries out asynchronous reads for file access backends. Platforms can hand reads on plain file descriptors
+// to the OS; everything else runs on a few dedicated threads, so waiting on the disk doesn't hold up
+// WorkerThreadPool threads.
+class FileAccessAsync {
+	static inline FileAccessAsync *singleton = nullptr;
+
+	static constexpr int THREAD_COUNT = 2;
+
+	Mutex mutex;
+	Semaphore semaphore;
+	List<Ref<FileAccessAsyncRead>> queue;
+	LocalVector<Thread> threads;
+	SafeFlag exiting;
+
+	static void _thread_func(void *p_self);
+
+protected:
+	static FileAccessAsync *(*_create)();
+
+	// Returns false if the OS can't take this read, it's queued for the threads then.
+	virtual bool _submit_native(const Ref<FileAccessAsyncRead> &p_read, int p_fd) { return false; }
+
+public:
+	static FileAccessAsync *get_singleton() { return singleton; }
+	static FileAccessAsync *create();
+
+	// The file of p_read must support get_buffer_at() from other threads. p_fd, if valid, is its file descriptor.
+	void submit(const Ref<FileAccessAsyncRead> &p_read, int p_fd = -1);
+
+	FileAccessAsync();
+	virtual ~FileAccessAsync();
+};
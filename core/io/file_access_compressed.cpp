@@ -30,6 +30,8 @@
 
 #include "file_access_compressed.h"
 
+#include "core/templates/hashfuncs.h"
+
 void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_mode, uint32_t p_block_size) {
 	magic = p_magic.ascii().get_data();
 	magic = (magic + "    ").substr(0, 4);
@@ -38,41 +40,264 @@ void FileAccessCompressed::configure(const String &p_magic, Compression::Mode p_
 	block_size = p_block_size;
 }
 
+void FileAccessCompressed::set_dictionary(const Vector<uint8_t> &p_dictionary) {
+	ERR_FAIL_COND_MSG(f.is_valid(), "The dictionary must be set before opening the file.");
+	dictionary = p_dictionary;
+}
+
+uint32_t FileAccessCompressed::_get_block_size(uint32_t p_block) const {
+	return p_block == read_block_count - 1 ? read_total % block_size : block_size;
+}
+
+uint32_t FileAccessCompressed::_acquire_cache_slot(uint32_t p_block) const {
+	// Least recently used, but never the block being read from.
+	// Slots whose prefetch task hasn't started yet are only taken if there's nothing else.
+	uint32_t victim = UINT32_MAX;
+	uint32_t pending_victim = UINT32_MAX;
+	for (uint32_t i = 0; i < block_cache.size(); i++) {
+		CachedBlock &slot = block_cache[i];
+		if (slot.block == UINT32_MAX) {
+			victim = i;
+			break;
+		}
+		if (slot.block == read_block) {
+			continue;
+		}
+		if (slot.prefetch && slot.prefetch->claimed.get() == 0) {
+			if (pending_victim == UINT32_MAX || slot.last_used < block_cache[pending_victim].last_used) {
+				pending_victim = i;
+			}
+			continue;
+		}
+		if (victim == UINT32_MAX || slot.last_used < block_cache[victim].last_used) {
+			victim = i;
+		}
+	}
+	if (victim == UINT32_MAX) {
+		victim = pending_victim;
+	}
+	DEV_ASSERT(victim != UINT32_MAX);
+
+	CachedBlock &slot = block_cache[victim];
+	_release_prefetch_task(slot);
+	if (slot.block != UINT32_MAX) {
+		block_cache_map.erase(slot.block);
+	}
+
+	slot.block = p_block;
+	slot.ready = false;
+	slot.failed = false;
+	block_cache_map.insert(p_block, victim);
+	return victim;
+}
+
+bool FileAccessCompressed::_read_compressed_block(CachedBlock &p_slot, uint32_t p_block) const {
+	const ReadBlock &rb = read_blocks[p_block];
+	p_slot.compressed.resize(rb.csize);
+	if (p_slot.data.size() < block_size) {
+		p_slot.data.resize(block_size);
+	}
+	f->seek(rb.offset);
+	return f->get_buffer(p_slot.compressed.ptr(), rb.csize) == rb.csize;
+}
+
+void FileAccessCompressed::_decompress_block(CachedBlock &p_slot) {
+	if (p_slot.failed) {
+		return;
+	}
+
+	const FileAccessCompressed *fac = p_slot.owner;
+	const int64_t dst_max = fac->read_block_count == 1 ? fac->read_total : fac->block_size;
+	int64_t ret;
+	if (fac->use_dictionary) {
+		ret = Compression::decompress_zstd_dictionary(p_slot.data.ptr(), dst_max, p_slot.compressed.ptr(), p_slot.compressed.size(), fac->dictionary.ptr(), fac->dictionary.size());
+	} else {
+		ret = Compression::decompress(p_slot.data.ptr(), dst_max, p_slot.compressed.ptr(), p_slot.compressed.size(), fac->cmode);
+	}
+	p_slot.failed = ret < 0;
+}
+
+void FileAccessCompressed::_prefetch_task(void *p_task) {
+	PrefetchTask *task = static_cast<PrefetchTask *>(p_task);
+	if (task->claimed.postincrement() == 0) {
+		_decompress_block(*task->slot);
+		task->done.post();
+	}
+	// Otherwise, the reader took care of it, and may have reused the slot already.
+	_unref_prefetch_task(task);
+}
+
+void FileAccessCompressed::_unref_prefetch_task(PrefetchTask *p_task) {
+	if (p_task->refcount.unref()) {
+		memdelete(p_task);
+	}
+}
+
+void FileAccessCompressed::_wait_block(CachedBlock &p_slot) const {
+	if (p_slot.ready) {
+		return;
+	}
+
+	if (!p_slot.prefetch || p_slot.prefetch->claimed.postincrement() == 0) {
+		// Not prefetched, or no pool thread started on it yet. Rather than waiting for one to get to it,
+		// it's decompressed right here. A pending task returns right away, and is released later.
+		_decompress_block(p_slot);
+	} else {
+		// A pool thread is already decompressing it.
+		p_slot.prefetch->done.wait();
+	}
+	p_slot.ready = true;
+}
+
+// Makes sure the prefetch task won't touch the slot anymore, then gives the task back to the pool.
+void FileAccessCompressed::_release_prefetch_task(CachedBlock &p_slot) const {
+	PrefetchTask *task = p_slot.prefetch;
+	if (!task) {
+		return;
+	}
+
+	if (task->claimed.postincrement() != 0 && !p_slot.ready) {
+		// Started on by a pool thread, which is decompressing into the slot.
+		task->done.wait();
+	}
+
+	// Once claimed, a task that didn't start yet does nothing, and can be run right here while waiting.
+	// Tasks older than the caller's one can't be waited for from it (ERR_BUSY), which only happens if the file
+	// changed threads. The claimed task is left to the pool then, and frees its shared state whenever it runs.
+	WorkerThreadPool::get_singleton()->wait_for_task_completion(task->task_id);
+	_unref_prefetch_task(task);
+	p_slot.prefetch = nullptr;
+}
+
+const uint8_t *FileAccessCompressed::_load_block(uint32_t p_block) const {
+	CachedBlock *slot;
+	const uint32_t *cached = block_cache_map.getptr(p_block);
+	if (cached) {
+		slot = &block_cache[*cached];
+	} else {
+		slot = &block_cache[_acquire_cache_slot(p_block)];
+		slot->failed = !_read_compressed_block(*slot, p_block);
+	}
+
+	_wait_block(*slot);
+	slot->last_used = ++block_cache_tick;
+
+	if (slot->failed) {
+		// Don't keep it around, so the error is reported again if read again.
+		block_cache_map.erase(p_block);
+		slot->block = UINT32_MAX;
+		return nullptr;
+	}
+	return slot->data.ptr();
+}
+
+void FileAccessCompressed::_prefetch_blocks(uint32_t p_from) const {
+	const uint32_t to = MIN(p_from + read_prefetch_blocks, read_block_count);
+	for (uint32_t i = p_from; i < to; i++) {
+		if (block_cache_map.has(i)) {
+			continue;
+		}
+
+		CachedBlock &slot = block_cache[_acquire_cache_slot(i)];
+		slot.last_used = ++block_cache_tick;
+		if (!_read_compressed_block(slot, i)) {
+			// Reported when the block is actually read.
+			slot.failed = true;
+			continue;
+		}
+		PrefetchTask *task = memnew(PrefetchTask);
+		task->slot = &slot;
+		task->refcount.init(2); // The slot and the task.
+		slot.prefetch = task;
+		task->task_id = WorkerThreadPool::get_singleton()->add_native_task(&FileAccessCompressed::_prefetch_task, task, false, "FileAccessCompressed block prefetch");
+	}
+}
+
+void FileAccessCompressed::_clear_block_cache() {
+	for (CachedBlock &slot : block_cache) {
+		_release_prefetch_task(slot);
+	}
+	block_cache.clear();
+	block_cache_map.clear();
+	block_cache_tick = 0;
+	read_ptr = nullptr;
+}
+
 Error FileAccessCompressed::open_after_magic(Ref<FileAccess> p_base) {
 	f = p_base;
-	cmode = (Compression::Mode)f->get_32();
+	const uint32_t mode_field = f->get_32();
+	cmode = (Compression::Mode)(mode_field & HEADER_MODE_MASK);
 	block_size = f->get_32();
 	if (block_size == 0) {
 		f.unref();
 		ERR_FAIL_V_MSG(ERR_FILE_CORRUPT, vformat("Can't open compressed file '%s' with block size 0, it is corrupted.", p_base->get_path()));
 	}
 	read_total = f->get_32();
+	use_dictionary = mode_field & HEADER_FLAG_DICTIONARY;
+	if (use_dictionary) {
+		const uint32_t dictionary_hash = f->get_32();
+		if (cmode != Compression::MODE_ZSTD || dictionary.is_empty() || dictionary_hash != hash_murmur3_buffer(dictionary.ptr(), dictionary.size())) {
+			f.unref();
+			ERR_FAIL_V_MSG(ERR_INVALID_DATA, vformat("Can't open compressed file '%s', it was compressed with a different dictionary.", p_base->get_path()));
+		}
+	}
 	uint32_t bc = (read_total / block_size) + 1;
 	uint64_t acc_ofs = f->get_position() + bc * 4;
-	uint32_t max_bs = 0;
 	for (uint32_t i = 0; i < bc; i++) {
 		ReadBlock rb;
 		rb.offset = acc_ofs;
 		rb.csize = f->get_32();
 		acc_ofs += rb.csize;
-		max_bs = MAX(max_bs, rb.csize);
 		read_blocks.push_back(rb);
 	}
 
-	comp_buffer.resize(max_bs);
-	buffer.resize(block_size);
-	read_ptr = buffer.ptrw();
-	f->get_buffer(comp_buffer.ptrw(), read_blocks[0].csize);
 	at_end = false;
 	read_eof = false;
 	read_block_count = bc;
-	read_block_size = read_blocks.size() == 1 ? read_total : block_size;
-
-	const int64_t ret = Compression::decompress(buffer.ptrw(), read_block_size, comp_buffer.ptr(), read_blocks[0].csize, cmode);
 	read_block = 0;
 	read_pos = 0;
+	read_block_size = _get_block_size(0);
+
+	// Sequential reads keep the next blocks decompressing in the background, the cache must fit them all.
+	read_prefetch_blocks = block_size >= PREFETCH_MIN_BLOCK_SIZE ? prefetch_blocks : 0;
+	uint64_t cache_slots = MAX(read_cache_size / block_size, 2 + (uint64_t)read_prefetch_blocks);
+	block_cache.resize((uint32_t)MIN(cache_slots, (uint64_t)bc));
+	for (CachedBlock &slot : block_cache) {
+		slot.owner = this;
+	}
+
+	read_ptr = _load_block(0);
+	return read_ptr ? OK : ERR_FILE_CORRUPT;
+}
+
+Error FileAccessCompressed::_start_writing() {
+	use_dictionary = !dictionary.is_empty();
+	if (use_dictionary && cmode != Compression::MODE_ZSTD) {
+		f.unref();
+		ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Compression dictionaries are only supported with Zstandard.");
+	}
+	if (block_size == 0) {
+		block_size = default_block_size;
+	}
+
+	buffer.clear();
+	writing = true;
+	write_pos = 0;
+	write_buffer_size = 256;
+	buffer.resize(256);
+	write_max = 0;
+	write_ptr = buffer.ptrw();
+
+	//don't store anything else unless it's done saving!
+	return OK;
+}
+
+Error FileAccessCompressed::open_for_writing(Ref<FileAccess> p_base) {
+	ERR_FAIL_COND_V(p_base.is_null() || !p_base->is_open(), ERR_FILE_CANT_OPEN);
+	_close();
 
-	return ret == -1 ? ERR_FILE_CORRUPT : OK;
+	f = p_base;
+	return _start_writing();
 }
 
 Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags) {
@@ -88,21 +313,15 @@ Error FileAccessCompressed::open_internal(const String &p_path, int p_mode_flags
 	}
 
 	if (p_mode_flags & WRITE) {
-		buffer.clear();
-		writing = true;
-		write_pos = 0;
-		write_buffer_size = 256;
-		buffer.resize(256);
-		write_max = 0;
-		write_ptr = buffer.ptrw();
-
-		//don't store anything else unless it's done saving!
+		return _start_writing();
 	} else {
 		char rmagic[5];
 		f->get_buffer((uint8_t *)rmagic, 4);
 		rmagic[4] = 0;
 		err = ERR_FILE_UNRECOGNIZED;
 		if (magic != rmagic || (err = open_after_magic(f)) != OK) {
+			_clear_block_cache();
+			read_blocks.clear();
 			f.unref();
 			return err;
 		}
@@ -121,9 +340,13 @@ void FileAccessCompressed::_close() {
 
 		CharString mgc = magic.utf8();
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //write header 4
-		f->store_32(cmode); //write compression mode 4
+		f->store_32(cmode | (use_dictionary ? HEADER_FLAG_DICTIONARY : 0)); //write compression mode 4
 		f->store_32(block_size); //write block size 4
 		f->store_32(uint32_t(write_max)); //max amount of data written 4
+		if (use_dictionary) {
+			f->store_32(hash_murmur3_buffer(dictionary.ptr(), dictionary.size())); //dictionary check 4
+		}
+		uint64_t block_sizes_ofs = f->get_position();
 		uint32_t bc = (write_max / block_size) + 1;
 
 		for (uint32_t i = 0; i < bc; i++) {
@@ -143,21 +366,24 @@ void FileAccessCompressed::_close() {
 			uint32_t bl = i == (bc - 1) ? last_block_size : block_size;
 			uint8_t *bp = &write_ptr[i * block_size];
 
-			const int64_t compressed_size = Compression::compress(temp_cblock_ptr, bp, bl, cmode);
+			const int64_t compressed_size = use_dictionary
+					? Compression::compress_zstd_dictionary(temp_cblock_ptr, bp, bl, dictionary.ptr(), dictionary.size())
+					: Compression::compress(temp_cblock_ptr, bp, bl, cmode);
 			ERR_FAIL_COND_MSG(compressed_size < 0, "FileAccessCompressed: Error compressing data.");
 
 			f->store_buffer(temp_cblock_ptr, (uint64_t)compressed_size);
 			block_sizes.push_back(compressed_size);
 		}
 
-		f->seek(16); //ok write block sizes
+		uint64_t data_end = f->get_position();
+		f->seek(block_sizes_ofs); //ok write block sizes
 		for (uint32_t i = 0; i < bc; i++) {
 			f->store_32(block_sizes[i]);
 		}
-		f->seek_end();
+		f->seek(data_end); // Not seek_end(), the base may hold more data past ours.
 		f->store_buffer((const uint8_t *)mgc.get_data(), mgc.length()); //magic at the end too
 	} else {
-		comp_buffer.clear();
+		_clear_block_cache();
 		read_blocks.clear();
 	}
 	buffer.clear();
@@ -201,12 +427,11 @@ void FileAccessCompressed::seek(uint64_t p_position) {
 			read_eof = false;
 			uint32_t block_idx = p_position / block_size;
 			if (block_idx != read_block) {
+				const uint8_t *block_ptr = _load_block(block_idx);
+				ERR_FAIL_NULL_MSG(block_ptr, "Compressed file is corrupt.");
 				read_block = block_idx;
-				f->seek(read_blocks[read_block].offset);
-				f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-				const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-				ERR_FAIL_COND_MSG(ret == -1, "Compressed file is corrupt.");
-				read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+				read_ptr = block_ptr;
+				read_block_size = _get_block_size(read_block);
 			}
 
 			read_pos = p_position % block_size;
@@ -278,11 +503,8 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 		}
 
 		// We're not done yet; try reading the next block.
-		read_block++;
-
-		if (read_block >= read_block_count) {
+		if (read_block + 1 >= read_block_count) {
 			// We're done! We read back the whole file.
-			read_block--;
 			at_end = true;
 			if (dst_idx + 1 < p_length) {
 				read_eof = true;
@@ -290,12 +512,16 @@ uint64_t FileAccessCompressed::get_buffer(uint8_t *p_dst, uint64_t p_length) con
 			return dst_idx;
 		}
 
-		// Read the next block of compressed data.
-		f->get_buffer(comp_buffer.ptrw(), read_blocks[read_block].csize);
-		const int64_t ret = Compression::decompress(buffer.ptrw(), read_blocks.size() == 1 ? read_total : block_size, comp_buffer.ptr(), read_blocks[read_block].csize, cmode);
-		ERR_FAIL_COND_V_MSG(ret == -1, -1, "Compressed file is corrupt.");
-		read_block_size = read_block == read_block_count - 1 ? read_total % block_size : block_size;
+		// Get the next block, possibly decompressed in the background already.
+		const uint8_t *block_ptr = _load_block(read_block + 1);
+		ERR_FAIL_NULL_V_MSG(block_ptr, -1, "Compressed file is corrupt.");
+		read_block++;
+		read_ptr = block_ptr;
+		read_block_size = _get_block_size(read_block);
 		read_pos = 0;
+
+		// Reading sequentially, keep the blocks after this one coming.
+		_prefetch_blocks(read_block + 1);
 	}
 
 	return p_length;
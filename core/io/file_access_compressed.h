@@ -32,10 +32,34 @@
 
 #include "core/io/compression.h"
 #include "core/io/file_access.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/semaphore.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 
 class FileAccessCompressed : public FileAccess {
 	GDSOFTCLASS(FileAccessCompressed, FileAccess);
+
+public:
+	// Set from the `compression/file_access/*` project settings.
+	static inline uint32_t default_block_size = 4096;
+	static inline uint64_t read_cache_size = 1024 * 1024;
+	static inline uint32_t prefetch_blocks = 4;
+
+	// Smaller blocks are decompressed on the reading thread, scheduling a task would cost more than it saves.
+	static constexpr uint32_t PREFETCH_MIN_BLOCK_SIZE = 64 * 1024;
+
+private:
+	// The compression mode is stored in the low bits of its header field, flags go in the high bits.
+	enum {
+		HEADER_MODE_MASK = 0xFFFF,
+		HEADER_FLAG_DICTIONARY = 1 << 16,
+	};
+
 	Compression::Mode cmode = Compression::MODE_ZSTD;
+	Vector<uint8_t> dictionary;
+	bool use_dictionary = false;
 	bool writing = false;
 	uint64_t write_pos = 0;
 	uint8_t *write_ptr = nullptr;
@@ -50,8 +74,38 @@ class FileAccessCompressed : public FileAccess {
 		uint64_t offset;
 	};
 
-	mutable Vector<uint8_t> comp_buffer;
-	uint8_t *read_ptr = nullptr;
+	struct CachedBlock;
+
+	// A block being decompressed ahead of a sequential read on the WorkerThreadPool. Whoever claims
+	// the block first (the task or the reader) decompresses it. Shared by the slot and the task, so
+	// a slot claimed before the task started can be reused without waiting for it.
+	struct PrefetchTask {
+		CachedBlock *slot = nullptr;
+		WorkerThreadPool::TaskID task_id = WorkerThreadPool::INVALID_TASK_ID;
+		SafeNumeric<uint32_t> claimed;
+		Semaphore done; // Posted once the block is decompressed, if the task claimed it.
+		SafeRefCount refcount;
+	};
+
+	// A decompressed block.
+	struct CachedBlock {
+		const FileAccessCompressed *owner = nullptr;
+		uint32_t block = UINT32_MAX;
+		uint64_t last_used = 0;
+		LocalVector<uint8_t> data;
+		LocalVector<uint8_t> compressed;
+		PrefetchTask *prefetch = nullptr; // Until released.
+		bool ready = false; // Only used by the reader.
+		bool failed = false;
+	};
+
+	// Allocated once when opening and never resized, pending tasks point into it.
+	mutable LocalVector<CachedBlock> block_cache;
+	mutable HashMap<uint32_t, uint32_t> block_cache_map; // Block index to slot in block_cache.
+	mutable uint64_t block_cache_tick = 0;
+	uint32_t read_prefetch_blocks = 0;
+
+	mutable const uint8_t *read_ptr = nullptr;
 	mutable uint32_t read_block = 0;
 	uint32_t read_block_count = 0;
 	mutable uint32_t read_block_size = 0;
@@ -63,12 +117,30 @@ class FileAccessCompressed : public FileAccess {
 	mutable Vector<uint8_t> buffer;
 	Ref<FileAccess> f;
 
+	uint32_t _get_block_size(uint32_t p_block) const;
+	uint32_t _acquire_cache_slot(uint32_t p_block) const;
+	bool _read_compressed_block(CachedBlock &p_slot, uint32_t p_block) const;
+	static void _decompress_block(CachedBlock &p_slot);
+	static void _prefetch_task(void *p_task);
+	static void _unref_prefetch_task(PrefetchTask *p_task);
+	void _wait_block(CachedBlock &p_slot) const;
+	void _release_prefetch_task(CachedBlock &p_slot) const;
+	const uint8_t *_load_block(uint32_t p_block) const;
+	void _prefetch_blocks(uint32_t p_from) const;
+	void _clear_block_cache();
+
+	Error _start_writing();
 	void _close();
 
 public:
-	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 4096);
+	// A block size of 0 uses `default_block_size`.
+	void configure(const String &p_magic, Compression::Mode p_mode = Compression::MODE_ZSTD, uint32_t p_block_size = 0);
+	// Zstandard only. Must be set before opening, reading needs the same dictionary the file was written with.
+	void set_dictionary(const Vector<uint8_t> &p_dictionary);
 
 	Error open_after_magic(Ref<FileAccess> p_base);
+	// Compresses into p_base on close, starting at its current position.
+	Error open_for_writing(Ref<FileAccess> p_base);
 
 	virtual Error open_internal(const String &p_path, int p_mode_flags) override; ///< open a file
 	virtual bool is_open() const override; ///< true when file is open
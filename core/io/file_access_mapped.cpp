@@ -0,0 +1,199 @@
+/**************************************************************************/
+/*  file_access_mapped.cpp                                                */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_mapped.h"
+
+#include "core/config/project_settings.h"
+#include "core/os/os.h"
+
+Ref<FileMapping> FileMapping::map(const String &p_path) {
+	const uint8_t *data = nullptr;
+	uint64_t size = 0;
+	void *handle = nullptr;
+	if (OS::get_singleton()->map_file(p_path, data, size, handle) != OK) {
+		return Ref<FileMapping>();
+	}
+
+	Ref<FileMapping> mapping;
+	mapping.instantiate();
+	mapping->data = data;
+	mapping->size = size;
+	mapping->handle = handle;
+	return mapping;
+}
+
+void FileMapping::prefetch(uint64_t p_offset, uint64_t p_length) const {
+	if (p_offset >= size) {
+		return;
+	}
+	OS::get_singleton()->prefetch_mapped_range(data + p_offset, MIN(p_length, size - p_offset));
+}
+
+FileMapping::~FileMapping() {
+	if (data) {
+		OS::get_singleton()->unmap_file(handle, data, size);
+	}
+}
+
+//////////////////////////////////////////////////////////////////
+
+Error FileAccessMapped::open_internal(const String &p_path, int p_mode_flags) {
+	ERR_FAIL_COND_V_MSG(p_mode_flags != READ, ERR_UNAVAILABLE, "Memory-mapped files can only be opened for reading.");
+
+	String os_path = ProjectSettings::get_singleton() ? ProjectSettings::get_singleton()->globalize_path(p_path) : p_path;
+	Ref<FileMapping> new_mapping = FileMapping::map(os_path);
+	if (new_mapping.is_null()) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	Error err = open_mapping(new_mapping, 0, new_mapping->get_size(), p_path);
+	path_absolute = os_path;
+	return err;
+}
+
+Error FileAccessMapped::open_mapping(const Ref<FileMapping> &p_mapping, uint64_t p_offset, uint64_t p_length, const String &p_path) {
+	ERR_FAIL_COND_V(p_mapping.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_offset > p_mapping->get_size() || p_length > p_mapping->get_size() - p_offset, ERR_FILE_CORRUPT, vformat(R"(Range of "%s" is outside of the mapped file.)", p_path));
+
+	mapping = p_mapping;
+	data = p_length ? p_mapping->get_data() + p_offset : nullptr;
+	length = p_length;
+	pos = 0;
+	eof = false;
+	path = p_path;
+	path_absolute = p_path;
+	return OK;
+}
+
+bool FileAccessMapped::is_open() const {
+	return mapping.is_valid();
+}
+
+void FileAccessMapped::seek(uint64_t p_position) {
+	ERR_FAIL_COND_MSG(mapping.is_null(), "File must be opened before use.");
+
+	eof = p_position > length;
+	pos = p_position;
+}
+
+void FileAccessMapped::seek_end(int64_t p_position) {
+	seek(length + p_position);
+}
+
+uint64_t FileAccessMapped::get_position() const {
+	return pos;
+}
+
+uint64_t FileAccessMapped::get_length() const {
+	return length;
+}
+
+bool FileAccessMapped::eof_reached() const {
+	return eof;
+}
+
+uint8_t FileAccessMapped::get_8() const {
+	ERR_FAIL_COND_V_MSG(mapping.is_null(), 0, "File must be opened before use.");
+
+	if (pos >= length) {
+		eof = true;
+		return 0;
+	}
+	return data[pos++];
+}
+
+uint64_t FileAccessMapped::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(mapping.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	uint64_t left = pos < length ? length - pos : 0;
+	uint64_t to_read = p_length;
+	if (to_read > left) {
+		eof = true;
+		to_read = left;
+	}
+
+	if (to_read > 0) {
+		memcpy(p_dst, data + pos, to_read);
+		pos += to_read;
+	}
+	return to_read;
+}
+
+uint64_t FileAccessMapped::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_COND_V_MSG(mapping.is_null(), -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (p_offset >= length) {
+		return 0;
+	}
+	const uint64_t to_read = MIN(p_length, length - p_offset);
+	memcpy(p_dst, data + p_offset, to_read);
+	return to_read;
+}
+
+Span<uint8_t> FileAccessMapped::get_buffer_view(uint64_t p_length) const {
+	ERR_FAIL_COND_V_MSG(mapping.is_null(), Span<uint8_t>(), "File must be opened before use.");
+
+	// All or nothing, short reads are left to get_buffer(), which also sets EOF.
+	if (p_length == 0 || pos >= length || p_length > length - pos) {
+		return Span<uint8_t>();
+	}
+
+	Span<uint8_t> view(data + pos, p_length);
+	pos += p_length;
+	return view;
+}
+
+Error FileAccessMapped::get_error() const {
+	return eof ? ERR_FILE_EOF : OK;
+}
+
+void FileAccessMapped::flush() {
+	ERR_FAIL_MSG("Memory-mapped files are read-only.");
+}
+
+bool FileAccessMapped::store_buffer(const uint8_t *p_src, uint64_t p_length) {
+	ERR_FAIL_V_MSG(false, "Memory-mapped files are read-only.");
+}
+
+bool FileAccessMapped::file_exists(const String &p_name) {
+	String os_path = ProjectSettings::get_singleton() ? ProjectSettings::get_singleton()->globalize_path(p_name) : p_name;
+	Ref<FileAccess> f = FileAccess::create(ACCESS_FILESYSTEM);
+	return f->file_exists(os_path);
+}
+
+void FileAccessMapped::close() {
+	mapping.unref();
+	data = nullptr;
+	length = 0;
+	pos = 0;
+	eof = false;
+}
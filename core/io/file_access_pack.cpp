@@ -30,10 +30,14 @@
 
 #include "file_access_pack.h"
 
+#include "core/io/file_access_async.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_patched.h"
+#include "core/io/marshalls.h"
 #include "core/object/script_language.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
 Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
@@ -46,7 +50,7 @@ Error PackedData::add_pack(const String &p_path, bool p_replace_files, uint64_t
 	return ERR_FILE_UNRECOGNIZED;
 }
 
-void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta) {
+void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted, bool p_bundle, bool p_delta, bool p_compressed, uint64_t p_stored_size) {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
 
@@ -56,9 +60,11 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 	pf.encrypted = p_encrypted;
 	pf.bundle = p_bundle;
 	pf.delta = p_delta;
+	pf.compressed = p_compressed;
 	pf.pack = p_pkg_path;
 	pf.offset = p_ofs;
 	pf.size = p_size;
+	pf.stored_size = p_compressed ? p_stored_size : p_size;
 	for (int i = 0; i < 16; i++) {
 		pf.md5[i] = p_md5[i];
 	}
@@ -66,9 +72,11 @@ void PackedData::add_path(const String &p_pkg_path, const String &p_path, uint64
 
 	if (p_delta) {
 		delta_patches[pmd5].push_back(pf);
+		_uncache_patched_file(pmd5);
 	} else if (!exists || p_replace_files) {
 		files[pmd5] = pf;
 		delta_patches[pmd5].clear();
+		_uncache_patched_file(pmd5);
 	}
 
 	if (!exists) {
@@ -123,6 +131,7 @@ void PackedData::remove_path(const String &p_path) {
 	cd->files.erase(simplified_path.get_file());
 
 	files.erase(pmd5);
+	_uncache_patched_file(pmd5);
 }
 
 void PackedData::add_pack_source(PackSource *p_source) {
@@ -142,6 +151,17 @@ uint8_t *PackedData::get_file_hash(const String &p_path) {
 	return E->value.md5;
 }
 
+void PackedData::prefetch_path(const String &p_path) {
+	String simplified_path = p_path.simplify_path().trim_prefix("res://");
+	PathMD5 pmd5(simplified_path.md5_buffer());
+	HashMap<PathMD5, PackedFile, PathMD5>::Iterator E = files.find(pmd5);
+	if (!E || E->value.offset == 0) {
+		return;
+	}
+
+	E->value.src->prefetch(&E->value);
+}
+
 Vector<PackedData::PackedFile> PackedData::get_delta_patches(const String &p_path) const {
 	String simplified_path = p_path.simplify_path().trim_prefix("res://");
 	PathMD5 pmd5(simplified_path.md5_buffer());
@@ -164,6 +184,54 @@ bool PackedData::has_delta_patches(const String &p_path) const {
 	return !E->value.is_empty();
 }
 
+bool PackedData::get_patched_file(const String &p_path, Vector<uint8_t> &r_data) {
+	String simplified_path = p_path.simplify_path().trim_prefix("res://");
+	PathMD5 pmd5(simplified_path.md5_buffer());
+
+	MutexLock lock(patched_files_mutex);
+	HashMap<PathMD5, Vector<uint8_t>, PathMD5>::ConstIterator E = patched_files.find(pmd5);
+	if (!E) {
+		return false;
+	}
+
+	r_data = E->value; // Shared, not copied.
+	return true;
+}
+
+void PackedData::cache_patched_file(const String &p_path, const Vector<uint8_t> &p_data) {
+	if ((uint64_t)p_data.size() > PATCHED_FILES_MAX_SIZE) {
+		return;
+	}
+
+	String simplified_path = p_path.simplify_path().trim_prefix("res://");
+	PathMD5 pmd5(simplified_path.md5_buffer());
+
+	_uncache_patched_file(pmd5);
+
+	MutexLock lock(patched_files_mutex);
+	if (patched_files.has(pmd5)) {
+		return; // Cached by another thread meanwhile.
+	}
+
+	// Insertion order is kept, the first entries are the oldest.
+	while (patched_files_size + p_data.size() > PATCHED_FILES_MAX_SIZE) {
+		patched_files_size -= patched_files.begin()->value.size();
+		patched_files.remove(patched_files.begin());
+	}
+
+	patched_files.insert(pmd5, p_data);
+	patched_files_size += p_data.size();
+}
+
+void PackedData::_uncache_patched_file(const PathMD5 &p_path) {
+	MutexLock lock(patched_files_mutex);
+	HashMap<PathMD5, Vector<uint8_t>, PathMD5>::Iterator E = patched_files.find(p_path);
+	if (E) {
+		patched_files_size -= E->value.size();
+		patched_files.remove(E);
+	}
+}
+
 HashSet<String> PackedData::get_file_paths() const {
 	HashSet<String> file_paths;
 	_get_file_paths(root, root->name, file_paths);
@@ -183,6 +251,11 @@ void PackedData::_get_file_paths(PackedDir *p_dir, const String &p_parent_dir, H
 void PackedData::clear() {
 	files.clear();
 	delta_patches.clear();
+	{
+		MutexLock lock(patched_files_mutex);
+		patched_files.clear();
+		patched_files_size = 0;
+	}
 	_free_packed_dirs(root);
 	root = memnew(PackedDir);
 }
@@ -284,6 +357,7 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	}
 
 	int64_t pck_start_pos = f->get_position() - 4;
+	String pck_os_path = f->get_path_absolute();
 
 	// Read header.
 	uint32_t version = f->get_32();
@@ -291,21 +365,21 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 	uint32_t ver_minor = f->get_32();
 	uint32_t ver_patch = f->get_32(); // Not used for validation.
 
-	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
+	ERR_FAIL_COND_V_MSG(version != PACK_FORMAT_VERSION_V4 && version != PACK_FORMAT_VERSION_V3 && version != PACK_FORMAT_VERSION_V2, false, vformat("Pack version unsupported: %d.", version));
 	ERR_FAIL_COND_V_MSG(ver_major > GODOT_VERSION_MAJOR || (ver_major == GODOT_VERSION_MAJOR && ver_minor > GODOT_VERSION_MINOR), false, vformat("Pack created with a newer version of the engine: %d.%d.%d.", ver_major, ver_minor, ver_patch));
 
 	uint32_t pack_flags = f->get_32();
 	bool enc_directory = (pack_flags & PACK_DIR_ENCRYPTED);
-	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled for V3.
+	bool rel_filebase = (pack_flags & PACK_REL_FILEBASE); // Note: Always enabled since V3.
 	bool sparse_bundle = (pack_flags & PACK_SPARSE_BUNDLE);
 
 	uint64_t file_base = f->get_64();
-	if ((version == PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
+	if ((version >= PACK_FORMAT_VERSION_V3) || (version == PACK_FORMAT_VERSION_V2 && rel_filebase)) {
 		file_base += pck_start_pos;
 	}
 
-	if (version == PACK_FORMAT_VERSION_V3) {
-		// V3: Read directory offset and skip reserved part of the header.
+	if (version >= PACK_FORMAT_VERSION_V3) {
+		// V3 and V4: Read directory offset and skip reserved part of the header.
 		uint64_t dir_offset = f->get_64() + pck_start_pos;
 		f->seek(dir_offset);
 	} else if (version == PACK_FORMAT_VERSION_V2) {
@@ -315,8 +389,19 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		}
 	}
 
+	Ref<FileMapping> mapping;
+	if (!sparse_bundle) {
+		// Map the whole pack once, reads then come straight from the page cache (shared between processes) without seeking or copying.
+		// Not all platforms or paths (e.g. packs nested in other packs, or on network or removable storage) can be mapped,
+		// get_file() falls back to FileAccessPack then.
+		mapping = FileMapping::map(pck_os_path);
+	}
+	// Every file must lie within the pack, so a corrupted or truncated one is rejected here instead of faulting
+	// when the mapping is read past its end.
+	const uint64_t pack_size = mapping.is_valid() ? mapping->get_size() : f->get_length();
+
 	// Read directory.
-	int file_count = f->get_32();
+	uint32_t file_count = f->get_32();
 	if (enc_directory) {
 		Ref<FileAccessEncrypted> fae;
 		fae.instantiate();
@@ -333,32 +418,147 @@ bool PackedSourcePCK::try_open_pack(const String &p_path, bool p_replace_files,
 		f = fae;
 	}
 
-	for (int i = 0; i < file_count; i++) {
-		uint32_t sl = f->get_32();
-		CharString cs;
-		cs.resize_uninitialized(sl + 1);
-		f->get_buffer((uint8_t *)cs.ptr(), sl);
-		cs[sl] = 0;
+	if (version == PACK_FORMAT_VERSION_V4) {
+		uint32_t strings_size = f->get_32();
+		uint64_t index_pos = f->get_position();
+		uint64_t index_size = (uint64_t)file_count * PACK_INDEX_ENTRY_SIZE + strings_size;
+		if (!enc_directory && mapping.is_valid() && index_pos + index_size <= mapping->get_size()) {
+			// Use the index in place, no reads or copies.
+			if (_add_index(p_path, mapping->get_data() + index_pos, index_size, file_count, file_base, pack_size, p_replace_files, sparse_bundle) != OK) {
+				return false;
+			}
+		} else {
+			Vector<uint8_t> index;
+			ERR_FAIL_COND_V_MSG(index.resize(index_size) != OK, false, vformat("Can't allocate the directory of pack \"%s\".", p_path));
+			ERR_FAIL_COND_V_MSG(f->get_buffer(index.ptrw(), index_size) != index_size, false, vformat("Pack \"%s\" has a truncated directory.", p_path));
+			if (_add_index(p_path, index.ptr(), index_size, file_count, file_base, pack_size, p_replace_files, sparse_bundle) != OK) {
+				return false;
+			}
+		}
+	} else {
+		struct LegacyEntry {
+			String path;
+			uint64_t ofs = 0;
+			uint64_t size = 0;
+			uint8_t md5[16] = {};
+			uint32_t flags = 0;
+		};
+
+		// Everything is checked before anything is added, like in _add_index().
+		LocalVector<LegacyEntry> entries;
+		for (uint32_t i = 0; i < file_count; i++) {
+			LegacyEntry entry;
+			uint32_t sl = f->get_32();
+			ERR_FAIL_COND_V_MSG(f->get_position() + sl > f->get_length(), false, vformat("Pack \"%s\" has a corrupted directory.", p_path));
+			CharString cs;
+			cs.resize_uninitialized(sl + 1);
+			f->get_buffer((uint8_t *)cs.ptr(), sl);
+			cs[sl] = 0;
+
+			entry.path = String::utf8(cs.ptr(), sl);
+			entry.ofs = f->get_64();
+			entry.size = f->get_64();
+			f->get_buffer(entry.md5, 16);
+			entry.flags = f->get_32();
+			ERR_FAIL_COND_V_MSG(f->eof_reached(), false, vformat("Pack \"%s\" has a truncated directory.", p_path));
+			if (!(entry.flags & PACK_FILE_REMOVAL) && !sparse_bundle) {
+				ERR_FAIL_COND_V_MSG(!_is_range_in_pack(file_base, entry.ofs, entry.size, pack_size), false, vformat("Pack \"%s\" has a file out of its bounds.", p_path));
+			}
+			entries.push_back(entry);
+		}
+
+		for (const LegacyEntry &entry : entries) {
+			if (entry.flags & PACK_FILE_REMOVAL) { // The file was removed.
+				PackedData::get_singleton()->remove_path(entry.path);
+			} else {
+				PackedData::get_singleton()->add_path(p_path, entry.path, file_base + entry.ofs, entry.size, entry.md5, this, p_replace_files, (entry.flags & PACK_FILE_ENCRYPTED), sparse_bundle, (entry.flags & PACK_FILE_DELTA));
+			}
+		}
+	}
+
+	if (mapping.is_valid()) {
+		mappings[p_path] = mapping;
+	} else {
+		mappings.erase(p_path);
+	}
+
+	return true;
+}
+
+// Overflow-safe check of p_base + p_ofs + p_size <= p_pack_size.
+bool PackedSourcePCK::_is_range_in_pack(uint64_t p_base, uint64_t p_ofs, uint64_t p_size, uint64_t p_pack_size) {
+	return p_base <= p_pack_size && p_ofs <= p_pack_size - p_base && p_size <= p_pack_size - p_base - p_ofs;
+}
+
+Error PackedSourcePCK::_add_index(const String &p_path, const uint8_t *p_index, uint64_t p_index_size, uint32_t p_file_count, uint64_t p_file_base, uint64_t p_pack_size, bool p_replace_files, bool p_bundle) {
+	const uint64_t entries_size = (uint64_t)p_file_count * PACK_INDEX_ENTRY_SIZE;
+	ERR_FAIL_COND_V_MSG(entries_size > p_index_size, ERR_FILE_CORRUPT, vformat("Pack \"%s\" has a corrupted directory.", p_path));
+	const char *strings = (const char *)p_index + entries_size;
+	const uint64_t strings_size = p_index_size - entries_size;
 
-		String path = String::utf8(cs.ptr(), sl);
-		uint64_t ofs = f->get_64();
-		uint64_t size = f->get_64();
-		uint8_t md5[16];
-		f->get_buffer(md5, 16);
-		uint32_t flags = f->get_32();
+	// Everything is checked before anything is added, so a corrupted pack leaves nothing behind.
+	for (uint32_t i = 0; i < p_file_count; i++) {
+		const uint8_t *entry = p_index + (uint64_t)i * PACK_INDEX_ENTRY_SIZE;
+		uint32_t path_ofs = decode_uint32(entry + 44);
+		uint32_t path_len = decode_uint32(entry + 48);
+		ERR_FAIL_COND_V_MSG((uint64_t)path_ofs + path_len > strings_size, ERR_FILE_CORRUPT, vformat("Pack \"%s\" has a corrupted directory.", p_path));
 
+		uint32_t flags = decode_uint32(entry + 40);
+		if (!(flags & PACK_FILE_REMOVAL) && !p_bundle) {
+			// Sparse bundles keep each file on its own, those are checked when opened.
+			uint64_t stored_size = (flags & PACK_FILE_COMPRESSED) ? decode_uint64(entry + 16) : decode_uint64(entry + 8);
+			ERR_FAIL_COND_V_MSG(!_is_range_in_pack(p_file_base, decode_uint64(entry), stored_size, p_pack_size), ERR_FILE_CORRUPT, vformat("Pack \"%s\" has a file out of its bounds.", p_path));
+		}
+	}
+
+	for (uint32_t i = 0; i < p_file_count; i++) {
+		const uint8_t *entry = p_index + (uint64_t)i * PACK_INDEX_ENTRY_SIZE;
+		uint64_t ofs = decode_uint64(entry);
+		uint64_t size = decode_uint64(entry + 8);
+		uint64_t stored_size = decode_uint64(entry + 16);
+		const uint8_t *md5 = entry + 24;
+		uint32_t flags = decode_uint32(entry + 40);
+		uint32_t path_ofs = decode_uint32(entry + 44);
+		uint32_t path_len = decode_uint32(entry + 48);
+
+		String path = String::utf8(strings + path_ofs, path_len);
 		if (flags & PACK_FILE_REMOVAL) { // The file was removed.
 			PackedData::get_singleton()->remove_path(path);
 		} else {
-			PackedData::get_singleton()->add_path(p_path, path, file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), sparse_bundle, (flags & PACK_FILE_DELTA));
+			PackedData::get_singleton()->add_path(p_path, path, p_file_base + ofs, size, md5, this, p_replace_files, (flags & PACK_FILE_ENCRYPTED), p_bundle, (flags & PACK_FILE_DELTA), (flags & PACK_FILE_COMPRESSED), stored_size);
 		}
 	}
-
-	return true;
+	return OK;
 }
 
 Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::PackedFile *p_file) {
-	Ref<FileAccess> file(memnew(FileAccessPack(p_path, *p_file)));
+	Ref<FileAccess> file;
+	if (!p_file->encrypted && !p_file->bundle) {
+		HashMap<String, Ref<FileMapping>>::ConstIterator E = mappings.find(p_file->pack);
+		if (E) {
+			Ref<FileAccessMapped> file_mapped;
+			file_mapped.instantiate();
+			if (file_mapped->open_mapping(E->value, p_file->offset, p_file->stored_size, p_path) == OK) {
+				file = file_mapped;
+			}
+		}
+	}
+	if (file.is_null()) {
+		file = Ref<FileAccess>(memnew(FileAccessPack(p_path, *p_file)));
+	}
+
+	if (p_file->compressed) {
+		// Decompressed on read, FileAccessCompressed caches and prefetches the blocks.
+		char magic[4] = {};
+		file->get_buffer((uint8_t *)magic, 4);
+		ERR_FAIL_COND_V_MSG(memcmp(magic, PACK_COMPRESSED_MAGIC, 4) != 0, Ref<FileAccess>(), vformat(R"(Compressed pack-referenced file "%s" from pack "%s" is corrupted.)", p_path, p_file->pack));
+
+		Ref<FileAccessCompressed> file_compressed;
+		file_compressed.instantiate();
+		Error err = file_compressed->open_after_magic(file);
+		ERR_FAIL_COND_V_MSG(err != OK, Ref<FileAccess>(), vformat(R"(Can't open compressed pack-referenced file "%s" from pack "%s".)", p_path, p_file->pack));
+		file = file_compressed;
+	}
 
 	if (PackedData::get_singleton()->has_delta_patches(p_path)) {
 		Ref<FileAccessPatched> file_patched;
@@ -371,6 +571,16 @@ Ref<FileAccess> PackedSourcePCK::get_file(const String &p_path, PackedData::Pack
 	return file;
 }
 
+void PackedSourcePCK::prefetch(PackedData::PackedFile *p_file) {
+	if (p_file->bundle) {
+		return;
+	}
+	HashMap<String, Ref<FileMapping>>::ConstIterator E = mappings.find(p_file->pack);
+	if (E) {
+		E->value->prefetch(p_file->offset, p_file->stored_size);
+	}
+}
+
 //////////////////////////////////////////////////////////////////
 
 bool PackedSourceDirectory::try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) {
@@ -427,7 +637,7 @@ bool FileAccessPack::is_open() const {
 void FileAccessPack::seek(uint64_t p_position) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
-	if (p_position > pf.size) {
+	if (p_position > pf.stored_size) {
 		eof = true;
 	} else {
 		eof = false;
@@ -438,7 +648,7 @@ void FileAccessPack::seek(uint64_t p_position) {
 }
 
 void FileAccessPack::seek_end(int64_t p_position) {
-	seek(pf.size + p_position);
+	seek(pf.stored_size + p_position);
 }
 
 uint64_t FileAccessPack::get_position() const {
@@ -446,7 +656,7 @@ uint64_t FileAccessPack::get_position() const {
 }
 
 uint64_t FileAccessPack::get_length() const {
-	return pf.size;
+	return pf.stored_size;
 }
 
 bool FileAccessPack::eof_reached() const {
@@ -462,9 +672,9 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	}
 
 	int64_t to_read = p_length;
-	if (to_read + pos > pf.size) {
+	if (to_read + pos > pf.stored_size) {
 		eof = true;
-		to_read = (int64_t)pf.size - (int64_t)pos;
+		to_read = (int64_t)pf.stored_size - (int64_t)pos;
 	}
 
 	pos += to_read;
@@ -477,6 +687,35 @@ uint64_t FileAccessPack::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return to_read;
 }
 
+uint64_t FileAccessPack::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_COND_V_MSG(f.is_null(), -1, "File must be opened before use.");
+
+	if (pf.encrypted) {
+		return FileAccess::get_buffer_at(p_offset, p_dst, p_length);
+	}
+	if (p_offset >= pf.stored_size) {
+		return 0;
+	}
+	return f->get_buffer_at(off + p_offset, p_dst, MIN(p_length, pf.stored_size - p_offset));
+}
+
+bool FileAccessPack::can_read_async() const {
+	return f.is_valid() && !pf.encrypted && f->can_read_async();
+}
+
+void FileAccessPack::_read_async(const Ref<FileAccessAsyncRead> &p_read) {
+	if (f.is_null() || pf.encrypted) {
+		FileAccess::_read_async(p_read);
+		return;
+	}
+
+	// Read straight from the pack, so the read can be handed to the OS.
+	const uint64_t offset = p_read->get_offset();
+	const uint64_t length = offset < pf.stored_size ? MIN(p_read->get_length(), pf.stored_size - offset) : 0;
+	p_read->redirect(f, off + offset, length);
+	f->_read_async(p_read);
+}
+
 void FileAccessPack::set_big_endian(bool p_big_endian) {
 	ERR_FAIL_COND_MSG(f.is_null(), "File must be opened before use.");
 
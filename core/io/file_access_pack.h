@@ -32,6 +32,8 @@
 
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_mapped.h"
+#include "core/os/mutex.h"
 #include "core/string/print_string.h"
 #include "core/templates/hash_set.h"
 #include "core/templates/list.h"
@@ -41,9 +43,18 @@
 
 #define PACK_FORMAT_VERSION_V2 2
 #define PACK_FORMAT_VERSION_V3 3
+#define PACK_FORMAT_VERSION_V4 4
 
 // The current packed file format version number.
-#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V3
+#define PACK_FORMAT_VERSION PACK_FORMAT_VERSION_V4
+
+// Magic of compressed files stored in packs ("GCPF" in ASCII), see FileAccessCompressed.
+#define PACK_COMPRESSED_MAGIC "GCPF"
+
+// V4 directory: file count, string table size, fixed size entries and the string table holding the paths.
+// Entries can be read in place from a mapping of the pack. Entry layout (little-endian):
+// offset (64), size (64), stored size (64), MD5 (16 bytes), flags (32), path offset (32), path length (32), reserved (32).
+#define PACK_INDEX_ENTRY_SIZE 56
 
 enum PackFlags {
 	PACK_DIR_ENCRYPTED = 1 << 0,
@@ -55,6 +66,7 @@ enum PackFileFlags {
 	PACK_FILE_ENCRYPTED = 1 << 0,
 	PACK_FILE_REMOVAL = 1 << 1,
 	PACK_FILE_DELTA = 1 << 2,
+	PACK_FILE_COMPRESSED = 1 << 3,
 };
 
 class PackSource;
@@ -69,11 +81,13 @@ public:
 		String pack;
 		uint64_t offset; //if offset is ZERO, the file was ERASED
 		uint64_t size;
+		uint64_t stored_size; // Differs from size for compressed files.
 		uint8_t md5[16];
 		PackSource *src = nullptr;
 		bool encrypted;
 		bool bundle;
 		bool delta;
+		bool compressed;
 	};
 
 private:
@@ -107,10 +121,19 @@ private:
 	HashMap<PathMD5, PackedFile, PathMD5> files;
 	HashMap<PathMD5, Vector<PackedFile>, PathMD5> delta_patches;
 
+	// Files rebuilt from their delta patches, so the patches are applied once. The oldest go first when over budget.
+	HashMap<PathMD5, Vector<uint8_t>, PathMD5> patched_files;
+	uint64_t patched_files_size = 0;
+	Mutex patched_files_mutex;
+
+	void _uncache_patched_file(const PathMD5 &p_path);
+
 	Vector<PackSource *> sources;
 
 	PackedDir *root = nullptr;
 
+	static constexpr uint64_t PATCHED_FILES_MAX_SIZE = 64 * 1024 * 1024;
+
 	static inline PackedData *singleton = nullptr;
 	bool disabled = false;
 
@@ -119,11 +142,13 @@ private:
 
 public:
 	void add_pack_source(PackSource *p_source);
-	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false); // for PackSource
+	void add_path(const String &p_pkg_path, const String &p_path, uint64_t p_ofs, uint64_t p_size, const uint8_t *p_md5, PackSource *p_src, bool p_replace_files, bool p_encrypted = false, bool p_bundle = false, bool p_delta = false, bool p_compressed = false, uint64_t p_stored_size = 0); // for PackSource
 	void remove_path(const String &p_path);
 	uint8_t *get_file_hash(const String &p_path);
 	Vector<PackedFile> get_delta_patches(const String &p_path) const;
 	bool has_delta_patches(const String &p_path) const;
+	bool get_patched_file(const String &p_path, Vector<uint8_t> &r_data);
+	void cache_patched_file(const String &p_path, const Vector<uint8_t> &p_data);
 	HashSet<String> get_file_paths() const;
 
 	void set_disabled(bool p_disabled) { disabled = p_disabled; }
@@ -135,6 +160,7 @@ public:
 	void clear();
 
 	_FORCE_INLINE_ Ref<FileAccess> try_open_path(const String &p_path);
+	void prefetch_path(const String &p_path);
 	_FORCE_INLINE_ bool has_path(const String &p_path);
 
 	_FORCE_INLINE_ int64_t get_size(const String &p_path);
@@ -150,13 +176,21 @@ class PackSource {
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) = 0;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) = 0;
+	virtual void prefetch(PackedData::PackedFile *p_file) {}
 	virtual ~PackSource() {}
 };
 
 class PackedSourcePCK : public PackSource {
+	// Whole-pack mappings, keyed by pack path. Files are served straight from them when possible.
+	HashMap<String, Ref<FileMapping>> mappings;
+
+	static bool _is_range_in_pack(uint64_t p_base, uint64_t p_ofs, uint64_t p_size, uint64_t p_pack_size);
+	Error _add_index(const String &p_path, const uint8_t *p_index, uint64_t p_index_size, uint32_t p_file_count, uint64_t p_file_base, uint64_t p_pack_size, bool p_replace_files, bool p_bundle);
+
 public:
 	virtual bool try_open_pack(const String &p_path, bool p_replace_files, uint64_t p_offset) override;
 	virtual Ref<FileAccess> get_file(const String &p_path, PackedData::PackedFile *p_file) override;
+	virtual void prefetch(PackedData::PackedFile *p_file) override;
 };
 
 class PackedSourceDirectory : public PackSource {
@@ -203,6 +237,9 @@ public:
 	virtual bool eof_reached() const override;
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual uint64_t get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) override;
+	virtual bool can_read_async() const override;
+	virtual void _read_async(const Ref<FileAccessAsyncRead> &p_read) override;
 
 	virtual void set_big_endian(bool p_big_endian) override;
 
@@ -39,6 +39,11 @@ Error FileAccessPatched::_apply_patch() const {
 	ERR_FAIL_COND_V(!is_open(), FAILED);
 
 	String path = old_file->get_path();
+	if (PackedData::get_singleton()->get_patched_file(path, patched_file_data)) {
+		patched_file.instantiate();
+		return patched_file->open_custom(patched_file_data.ptr(), patched_file_data.size());
+	}
+
 	Vector<PackedData::PackedFile> delta_patches = PackedData::get_singleton()->get_delta_patches(path);
 	Vector<uint8_t> old_file_data = old_file->get_buffer(old_file->get_length());
 
@@ -77,6 +82,7 @@ Error FileAccessPatched::_apply_patch() const {
 	}
 
 	patched_file_data = old_file_data;
+	PackedData::get_singleton()->cache_patched_file(path, patched_file_data);
 	patched_file.instantiate();
 	return patched_file->open_custom(patched_file_data.ptr(), patched_file_data.size());
 }
@@ -36,6 +36,7 @@
 #include "core/io/resource_loader.h"
 #include "core/math/math_funcs.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/unique_vector.h"
 #include "core/variant/dictionary.h"
 
 const char *Image::format_names[Image::FORMAT_MAX] = {
@@ -1268,10 +1269,14 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 		return;
 	}
 
-	Image dst(p_width, p_height, false, format);
+	// Scale into plain buffers, which are handed over to the image at the end without copying.
+	int dst_mipmaps = 0;
+	const int64_t dst_size = _get_dst_image_size(p_width, p_height, format, dst_mipmaps, 0);
+	UniqueVector<uint8_t> dst;
+	dst.resize_initialized(dst_size);
 
 	// Setup mipmap-aware scaling
-	Image dst2;
+	UniqueVector<uint8_t> dst2;
 	int mip1 = 0;
 	int mip2 = 0;
 	float mip1_weight = 0;
@@ -1288,7 +1293,7 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 	}
 	bool interpolate_mipmaps = mipmap_aware && mip1 != mip2;
 	if (interpolate_mipmaps) {
-		dst2.initialize_data(p_width, p_height, false, format);
+		dst2.resize_initialized(dst_size);
 	}
 
 	bool had_mipmaps = mipmaps;
@@ -1300,7 +1305,7 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 	const uint8_t *r = data.ptr();
 	const unsigned char *r_ptr = r;
 
-	uint8_t *w = dst.data.ptrw();
+	uint8_t *w = dst.ptrw();
 	unsigned char *w_ptr = w;
 
 	switch (p_interpolation) {
@@ -1402,7 +1407,7 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 						_get_mipmap_offset_and_size(mip2, offs, src_width, src_height);
 						src_ptr = r_ptr + offs;
 						// Switch to write to the second destination image
-						w = dst2.data.ptrw();
+						w = dst2.ptrw();
 						w_ptr = w;
 					}
 				}
@@ -1472,7 +1477,7 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 
 			if (interpolate_mipmaps) {
 				// Switch to read again from the first scaled mipmap to overlay it over the second
-				r = dst.data.ptr();
+				r = dst.ptr();
 				_overlay(r, w, mip1_weight, p_width, p_height, get_format_pixel_size(format));
 			}
 
@@ -1605,15 +1610,14 @@ void Image::resize(int p_width, int p_height, Interpolation p_interpolation) {
 		} break;
 	}
 
-	if (interpolate_mipmaps) {
-		dst._copy_internals_from(dst2);
-	}
+	width = p_width;
+	height = p_height;
+	mipmaps = false;
+	data = interpolate_mipmaps ? dst2.release() : dst.release();
 
 	if (had_mipmaps) {
-		dst.generate_mipmaps();
+		generate_mipmaps();
 	}
-
-	_copy_internals_from(dst);
 }
 
 void Image::crop_from_point(int p_x, int p_y, int p_width, int p_height) {
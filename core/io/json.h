@@ -38,6 +38,8 @@
 class JSON : public Resource {
 	GDCLASS(JSON, Resource);
 
+	friend class JSONStreamWriter;
+
 	enum TokenType {
 		TK_CURLY_BRACKET_OPEN,
 		TK_CURLY_BRACKET_CLOSE,
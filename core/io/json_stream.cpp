@@ -0,0 +1,886 @@
+/**************************************************************************/
+/*  json_stream.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "json_stream.h"
+
+#include "core/io/json.h"
+
+const char *JSONStreamReader::tk_name[TK_MAX] = {
+	"'{'",
+	"'}'",
+	"'['",
+	"']'",
+	"string",
+	"number",
+	"literal",
+	"':'",
+	"','",
+	"EOF",
+};
+
+static bool _parse_hex4(const uint8_t *p_str, char32_t &r_value) {
+	r_value = 0;
+	for (int i = 0; i < 4; i++) {
+		const uint8_t c = p_str[i];
+		char32_t v;
+		if (is_digit(c)) {
+			v = c - '0';
+		} else if (c >= 'a' && c <= 'f') {
+			v = c - 'a' + 10;
+		} else if (c >= 'A' && c <= 'F') {
+			v = c - 'A' + 10;
+		} else {
+			return false;
+		}
+		r_value = (r_value << 4) | v;
+	}
+	return true;
+}
+
+static void _append_utf8(LocalVector<char> &r_str, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_str.push_back(p_char);
+	} else if (p_char < 0x800) {
+		r_str.push_back(0xC0 | (p_char >> 6));
+		r_str.push_back(0x80 | (p_char & 0x3F));
+	} else if (p_char < 0x10000) {
+		r_str.push_back(0xE0 | (p_char >> 12));
+		r_str.push_back(0x80 | ((p_char >> 6) & 0x3F));
+		r_str.push_back(0x80 | (p_char & 0x3F));
+	} else {
+		r_str.push_back(0xF0 | (p_char >> 18));
+		r_str.push_back(0x80 | ((p_char >> 12) & 0x3F));
+		r_str.push_back(0x80 | ((p_char >> 6) & 0x3F));
+		r_str.push_back(0x80 | (p_char & 0x3F));
+	}
+}
+
+void JSONStreamReader::reset() {
+	file.unref();
+	stream.unref();
+	source_ended = false;
+	at_start = true;
+	buffer.clear();
+	buffer_pos = 0;
+	state = STATE_VALUE;
+	containers.clear();
+	event = EVENT_NONE;
+	value = Variant();
+	value_stack.clear();
+	key_stack.clear();
+	line = 1;
+	error = OK;
+	error_message = String();
+}
+
+void JSONStreamReader::set_file(const Ref<FileAccess> &p_file) {
+	reset();
+	file = p_file;
+}
+
+void JSONStreamReader::set_stream(const Ref<StreamPeer> &p_stream) {
+	reset();
+	stream = p_stream;
+}
+
+void JSONStreamReader::append_data(const PackedByteArray &p_data) {
+	append_data(p_data.ptr(), p_data.size());
+}
+
+void JSONStreamReader::append_data(const uint8_t *p_data, uint32_t p_size) {
+	ERR_FAIL_COND_MSG(file.is_valid() || stream.is_valid(), "Can't append data when reading from a file or stream.");
+	ERR_FAIL_COND_MSG(source_ended, "Can't append data after finish_data().");
+
+	_compact();
+	const uint32_t size = buffer.size();
+	buffer.resize(size + p_size);
+	memcpy(buffer.ptr() + size, p_data, p_size);
+}
+
+void JSONStreamReader::finish_data() {
+	source_ended = true;
+}
+
+void JSONStreamReader::_compact() {
+	if (buffer_pos > 0) {
+		memmove(buffer.ptr(), buffer.ptr() + buffer_pos, buffer.size() - buffer_pos);
+		buffer.resize(buffer.size() - buffer_pos);
+		buffer_pos = 0;
+	}
+}
+
+Error JSONStreamReader::_fill() {
+	if (source_ended || (file.is_null() && stream.is_null())) {
+		return ERR_BUSY; // Appended data, waiting for more or finish_data().
+	}
+
+	_compact();
+
+	// Whatever is left is an incomplete token. Reading at least as much again keeps long tokens from being rescanned once per chunk.
+	const uint32_t pending = buffer.size();
+	const uint32_t to_read = MAX(CHUNK_SIZE, pending);
+	buffer.resize(pending + to_read);
+
+	if (file.is_valid()) {
+		uint64_t received = file->get_buffer(buffer.ptr() + pending, to_read);
+		if (received > to_read) {
+			received = 0; // Error.
+		}
+		buffer.resize(pending + received);
+		if (received < to_read) {
+			source_ended = true;
+		}
+		return OK;
+	}
+
+	int received = 0;
+	Error err = stream->get_partial_data(buffer.ptr() + pending, to_read, received);
+	buffer.resize(pending + (err == OK ? received : 0));
+	if (err != OK) {
+		source_ended = true; // Disconnected.
+		return OK;
+	}
+	return received > 0 ? OK : ERR_BUSY;
+}
+
+Error JSONStreamReader::_parse_string(const uint8_t *p_str, uint32_t p_len, Token &r_token, String &r_err_str) const {
+	r_token.type = TK_STRING;
+
+	bool escaped = false;
+	for (uint32_t i = 0; i < p_len; i++) {
+		if (p_str[i] == '\\') {
+			escaped = true;
+		} else if (p_str[i] == '\n') {
+			r_token.lines++;
+		}
+	}
+	if (!escaped) {
+		r_token.value = String::utf8((const char *)p_str, p_len);
+		return OK;
+	}
+
+	LocalVector<char> str;
+	str.reserve(p_len);
+	for (uint32_t i = 0; i < p_len; i++) {
+		if (p_str[i] != '\\') {
+			str.push_back(p_str[i]);
+			continue;
+		}
+
+		// The end quote was found past any escape, so the escaped character is always there.
+		const uint8_t next = p_str[++i];
+		switch (next) {
+			case 'b':
+				str.push_back(8);
+				break;
+			case 't':
+				str.push_back(9);
+				break;
+			case 'n':
+				str.push_back(10);
+				break;
+			case 'f':
+				str.push_back(12);
+				break;
+			case 'r':
+				str.push_back(13);
+				break;
+			case '"':
+			case '\\':
+			case '/':
+				str.push_back(next);
+				break;
+			case 'u': {
+				char32_t res;
+				if (i + 4 >= p_len) {
+					r_err_str = "Unterminated string";
+					return ERR_PARSE_ERROR;
+				}
+				if (!_parse_hex4(p_str + i + 1, res)) {
+					r_err_str = "Malformed hex constant in string";
+					return ERR_PARSE_ERROR;
+				}
+				i += 4;
+
+				if ((res & 0xfffffc00) == 0xd800) {
+					if (i + 2 >= p_len || p_str[i + 1] != '\\' || p_str[i + 2] != 'u') {
+						r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					i += 2;
+					char32_t trail;
+					if (i + 4 >= p_len) {
+						r_err_str = "Unterminated string";
+						return ERR_PARSE_ERROR;
+					}
+					if (!_parse_hex4(p_str + i + 1, trail)) {
+						r_err_str = "Malformed hex constant in string";
+						return ERR_PARSE_ERROR;
+					}
+					if ((trail & 0xfffffc00) != 0xdc00) {
+						r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
+						return ERR_PARSE_ERROR;
+					}
+					res = (res << 10UL) + trail - ((0xd800 << 10UL) + 0xdc00 - 0x10000);
+					i += 4;
+				} else if ((res & 0xfffffc00) == 0xdc00) {
+					r_err_str = "Invalid UTF-16 sequence in string, unpaired trail surrogate";
+					return ERR_PARSE_ERROR;
+				}
+				_append_utf8(str, res);
+			} break;
+			default: {
+				r_err_str = "Invalid escape sequence";
+				return ERR_PARSE_ERROR;
+			}
+		}
+	}
+
+	r_token.value = String::utf8(str.ptr(), str.size());
+	return OK;
+}
+
+Error JSONStreamReader::_scan_token(Token &r_token, String &r_err_str) const {
+	const uint8_t *str = buffer.ptr() + buffer_pos;
+	const uint32_t len = buffer.size() - buffer_pos;
+
+	uint32_t index = 0;
+	r_token.lines = 0;
+	while (index < len && str[index] <= 32) {
+		if (str[index] == '\n') {
+			r_token.lines++;
+		}
+		index++;
+	}
+
+	if (index == len) {
+		if (!source_ended) {
+			return ERR_BUSY;
+		}
+		r_token.type = TK_EOF;
+		r_token.length = index;
+		return OK;
+	}
+
+	r_token.length = index + 1;
+	switch (str[index]) {
+		case '{': {
+			r_token.type = TK_CURLY_BRACKET_OPEN;
+			return OK;
+		}
+		case '}': {
+			r_token.type = TK_CURLY_BRACKET_CLOSE;
+			return OK;
+		}
+		case '[': {
+			r_token.type = TK_BRACKET_OPEN;
+			return OK;
+		}
+		case ']': {
+			r_token.type = TK_BRACKET_CLOSE;
+			return OK;
+		}
+		case ':': {
+			r_token.type = TK_COLON;
+			return OK;
+		}
+		case ',': {
+			r_token.type = TK_COMMA;
+			return OK;
+		}
+		case '"': {
+			// Find the end first, incomplete strings are left in the buffer without decoding them.
+			uint32_t end = index + 1;
+			while (end < len && str[end] != '"') {
+				end += str[end] == '\\' ? 2 : 1;
+			}
+			if (end >= len) {
+				if (!source_ended) {
+					return ERR_BUSY;
+				}
+				r_err_str = "Unterminated string";
+				return ERR_PARSE_ERROR;
+			}
+			r_token.length = end + 1;
+			return _parse_string(str + index + 1, end - index - 1, r_token, r_err_str);
+		}
+		default: {
+			uint32_t end = index;
+			if (str[index] == '-' || is_digit(str[index])) {
+				while (end < len && (is_digit(str[end]) || str[end] == '-' || str[end] == '+' || str[end] == '.' || str[end] == 'e' || str[end] == 'E')) {
+					end++;
+				}
+				if (end == len && !source_ended) {
+					return ERR_BUSY; // The number may go on.
+				}
+
+				// Parsed as JSON::parse() does, numbers are ASCII so widening them is enough.
+				char32_t local[64];
+				LocalVector<char32_t> large;
+				char32_t *number = local;
+				if (end - index >= 64) {
+					large.resize(end - index + 1);
+					number = large.ptr();
+				}
+				for (uint32_t i = index; i < end; i++) {
+					number[i - index] = str[i];
+				}
+				number[end - index] = 0;
+
+				const char32_t *number_end;
+				double number_value = String::to_float(number, &number_end);
+				if (number_end == number) {
+					r_err_str = "Malformed number";
+					return ERR_PARSE_ERROR;
+				}
+				r_token.type = TK_NUMBER;
+				r_token.value = number_value;
+				r_token.length = index + (number_end - number);
+				return OK;
+			}
+
+			if (is_ascii_alphabet_char(str[index])) {
+				while (end < len && is_ascii_alphabet_char(str[end])) {
+					end++;
+				}
+				if (end == len && !source_ended) {
+					return ERR_BUSY;
+				}
+
+				const char *id = (const char *)str + index;
+				const uint32_t id_len = end - index;
+				r_token.type = TK_LITERAL;
+				r_token.length = end;
+				if (id_len == 4 && memcmp(id, "true", 4) == 0) {
+					r_token.value = true;
+				} else if (id_len == 5 && memcmp(id, "false", 5) == 0) {
+					r_token.value = false;
+				} else if (id_len == 4 && memcmp(id, "null", 4) == 0) {
+					r_token.value = Variant();
+				} else {
+					r_err_str = vformat("Expected 'true', 'false', or 'null', got '%s'", String::utf8(id, id_len));
+					return ERR_PARSE_ERROR;
+				}
+				return OK;
+			}
+
+			r_err_str = "Unexpected character";
+			return ERR_PARSE_ERROR;
+		}
+	}
+}
+
+Error JSONStreamReader::_next_token(Token &r_token) {
+	while (true) {
+		if (at_start) {
+			// Skip the UTF-8 byte order mark.
+			if (buffer.size() - buffer_pos < 3 && !source_ended) {
+				Error err = _fill();
+				if (err != OK) {
+					return err;
+				}
+				continue;
+			}
+			if (buffer.size() - buffer_pos >= 3 && memcmp(buffer.ptr() + buffer_pos, "\xEF\xBB\xBF", 3) == 0) {
+				buffer_pos += 3;
+			}
+			at_start = false;
+		}
+
+		String err_str;
+		Error err = _scan_token(r_token, err_str);
+		if (err == OK) {
+			buffer_pos += r_token.length;
+			line += r_token.lines;
+			return OK;
+		}
+		if (err != ERR_BUSY) {
+			line += r_token.lines;
+			return _set_error(err_str);
+		}
+
+		err = _fill();
+		if (err != OK) {
+			return err;
+		}
+	}
+}
+
+Error JSONStreamReader::_set_error(const String &p_message) {
+	error_message = p_message;
+	error = ERR_PARSE_ERROR;
+	event = EVENT_NONE;
+	value = Variant();
+	return error;
+}
+
+Error JSONStreamReader::_begin_value(Token &p_token) {
+	switch (p_token.type) {
+		case TK_CURLY_BRACKET_OPEN:
+		case TK_BRACKET_OPEN: {
+			if (containers.size() >= Variant::MAX_RECURSION_DEPTH) {
+				_set_error("JSON structure is too deep");
+				return error = ERR_OUT_OF_MEMORY;
+			}
+			const bool object = p_token.type == TK_CURLY_BRACKET_OPEN;
+			containers.push_back(object);
+			event = object ? EVENT_OBJECT_BEGIN : EVENT_ARRAY_BEGIN;
+			value = Variant();
+			state = object ? STATE_OBJECT_FIRST : STATE_ARRAY_FIRST;
+			return OK;
+		}
+		case TK_STRING:
+		case TK_NUMBER:
+		case TK_LITERAL: {
+			event = EVENT_VALUE;
+			value = p_token.value;
+			state = STATE_AFTER_VALUE;
+			return OK;
+		}
+		default: {
+			return _set_error(vformat("Expected value, got '%s'", String(tk_name[p_token.type])));
+		}
+	}
+}
+
+Error JSONStreamReader::_end_container(bool p_object) {
+	containers.resize(containers.size() - 1);
+	event = p_object ? EVENT_OBJECT_END : EVENT_ARRAY_END;
+	value = Variant();
+	state = STATE_AFTER_VALUE;
+	return OK;
+}
+
+Error JSONStreamReader::read() {
+	if (error != OK && error != ERR_BUSY) {
+		return error;
+	}
+
+	while (true) {
+		if (state == STATE_DONE) {
+			event = EVENT_NONE;
+			value = Variant();
+			return error = ERR_FILE_EOF;
+		}
+
+		Token token;
+		Error err = _next_token(token);
+		if (err != OK) {
+			return error = err;
+		}
+		error = OK;
+
+		switch (state) {
+			case STATE_VALUE: {
+				return _begin_value(token);
+			}
+			case STATE_ARRAY_FIRST: {
+				if (token.type == TK_BRACKET_CLOSE) {
+					return _end_container(false);
+				}
+				return _begin_value(token);
+			}
+			case STATE_OBJECT_FIRST: {
+				if (token.type == TK_CURLY_BRACKET_CLOSE) {
+					return _end_container(true);
+				}
+				if (token.type != TK_STRING) {
+					return _set_error("Expected key");
+				}
+				event = EVENT_KEY;
+				value = token.value;
+				state = STATE_COLON;
+				return OK;
+			}
+			case STATE_COLON: {
+				if (token.type != TK_COLON) {
+					return _set_error("Expected ':'");
+				}
+				state = STATE_VALUE;
+			} break;
+			case STATE_AFTER_VALUE: {
+				if (containers.is_empty()) {
+					if (token.type != TK_EOF) {
+						return _set_error("Expected 'EOF'");
+					}
+					state = STATE_DONE;
+				} else if (containers[containers.size() - 1]) {
+					if (token.type == TK_CURLY_BRACKET_CLOSE) {
+						return _end_container(true);
+					}
+					if (token.type != TK_COMMA) {
+						return _set_error("Expected '}' or ','");
+					}
+					state = STATE_OBJECT_FIRST;
+				} else {
+					if (token.type == TK_BRACKET_CLOSE) {
+						return _end_container(false);
+					}
+					if (token.type != TK_COMMA) {
+						return _set_error("Expected ','");
+					}
+					state = STATE_ARRAY_FIRST;
+				}
+			} break;
+			case STATE_DONE: {
+			} break;
+		}
+	}
+}
+
+void JSONStreamReader::_add_to_parent(const Variant &p_value) {
+	Variant &parent = value_stack[value_stack.size() - 1];
+	if (parent.get_type() == Variant::DICTIONARY) {
+		Dictionary d = parent;
+		d[key_stack[key_stack.size() - 1]] = p_value;
+	} else {
+		Array a = parent;
+		a.push_back(p_value);
+	}
+}
+
+Error JSONStreamReader::read_value(Variant &r_value) {
+	if (value_stack.is_empty()) {
+		switch (event) {
+			case EVENT_VALUE: {
+				r_value = value;
+				return OK;
+			}
+			case EVENT_OBJECT_BEGIN: {
+				value_stack.push_back(Dictionary());
+			} break;
+			case EVENT_ARRAY_BEGIN: {
+				value_stack.push_back(Array());
+			} break;
+			default: {
+				ERR_FAIL_V_MSG(ERR_INVALID_PARAMETER, "Values can only be read on a value, or at the beginning of an object or array.");
+			}
+		}
+		key_stack.push_back(String());
+	}
+
+	while (true) {
+		Error err = read();
+		if (err != OK) {
+			if (err != ERR_BUSY) {
+				value_stack.clear();
+				key_stack.clear();
+			}
+			return err;
+		}
+
+		switch (event) {
+			case EVENT_OBJECT_BEGIN: {
+				value_stack.push_back(Dictionary());
+				key_stack.push_back(String());
+			} break;
+			case EVENT_ARRAY_BEGIN: {
+				value_stack.push_back(Array());
+				key_stack.push_back(String());
+			} break;
+			case EVENT_KEY: {
+				key_stack[key_stack.size() - 1] = value;
+			} break;
+			case EVENT_VALUE: {
+				_add_to_parent(value);
+			} break;
+			case EVENT_OBJECT_END:
+			case EVENT_ARRAY_END: {
+				Variant container = value_stack[value_stack.size() - 1];
+				value_stack.resize(value_stack.size() - 1);
+				key_stack.resize(key_stack.size() - 1);
+				if (value_stack.is_empty()) {
+					r_value = container;
+					return OK;
+				}
+				_add_to_parent(container);
+			} break;
+			case EVENT_NONE: {
+			} break;
+		}
+	}
+}
+
+Variant JSONStreamReader::_read_value_bind() {
+	Variant ret;
+	if (read_value(ret) != OK) {
+		return Variant();
+	}
+	return ret;
+}
+
+void JSONStreamReader::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("reset"), &JSONStreamReader::reset);
+	ClassDB::bind_method(D_METHOD("set_file", "file"), &JSONStreamReader::set_file);
+	ClassDB::bind_method(D_METHOD("set_stream", "stream"), &JSONStreamReader::set_stream);
+	ClassDB::bind_method(D_METHOD("append_data", "data"), static_cast<void (JSONStreamReader::*)(const PackedByteArray &)>(&JSONStreamReader::append_data));
+	ClassDB::bind_method(D_METHOD("finish_data"), &JSONStreamReader::finish_data);
+
+	ClassDB::bind_method(D_METHOD("read"), &JSONStreamReader::read);
+	ClassDB::bind_method(D_METHOD("read_value"), &JSONStreamReader::_read_value_bind);
+
+	ClassDB::bind_method(D_METHOD("get_event"), &JSONStreamReader::get_event);
+	ClassDB::bind_method(D_METHOD("get_value"), &JSONStreamReader::get_value);
+	ClassDB::bind_method(D_METHOD("get_depth"), &JSONStreamReader::get_depth);
+
+	ClassDB::bind_method(D_METHOD("get_error"), &JSONStreamReader::get_error);
+	ClassDB::bind_method(D_METHOD("get_error_line"), &JSONStreamReader::get_error_line);
+	ClassDB::bind_method(D_METHOD("get_error_message"), &JSONStreamReader::get_error_message);
+
+	BIND_ENUM_CONSTANT(EVENT_NONE);
+	BIND_ENUM_CONSTANT(EVENT_OBJECT_BEGIN);
+	BIND_ENUM_CONSTANT(EVENT_OBJECT_END);
+	BIND_ENUM_CONSTANT(EVENT_ARRAY_BEGIN);
+	BIND_ENUM_CONSTANT(EVENT_ARRAY_END);
+	BIND_ENUM_CONSTANT(EVENT_KEY);
+	BIND_ENUM_CONSTANT(EVENT_VALUE);
+}
+
+//////////////////////////////////////////////////////////////////
+
+void JSONStreamWriter::set_file(const Ref<FileAccess> &p_file) {
+	flush();
+	stream.unref();
+	file = p_file;
+	containers.clear();
+	root_written = false;
+}
+
+void JSONStreamWriter::set_stream(const Ref<StreamPeer> &p_stream) {
+	flush();
+	file.unref();
+	stream = p_stream;
+	containers.clear();
+	root_written = false;
+}
+
+void JSONStreamWriter::set_indent(const String &p_indent) {
+	ERR_FAIL_COND_MSG(!containers.is_empty(), "The indentation can't change while writing an object or array.");
+	indent = p_indent;
+}
+
+String JSONStreamWriter::get_indent() const {
+	return indent;
+}
+
+void JSONStreamWriter::set_sort_keys(bool p_sort_keys) {
+	sort_keys = p_sort_keys;
+}
+
+bool JSONStreamWriter::is_sort_keys() const {
+	return sort_keys;
+}
+
+void JSONStreamWriter::set_full_precision(bool p_full_precision) {
+	full_precision = p_full_precision;
+}
+
+bool JSONStreamWriter::is_full_precision() const {
+	return full_precision;
+}
+
+void JSONStreamWriter::_write(const char *p_data, uint32_t p_len) {
+	const uint32_t size = buffer.size();
+	buffer.resize(size + p_len);
+	memcpy(buffer.ptr() + size, p_data, p_len);
+	if (buffer.size() >= FLUSH_SIZE) {
+		flush();
+	}
+}
+
+void JSONStreamWriter::_write(const String &p_string) {
+	CharString utf8 = p_string.utf8();
+	_write(utf8.get_data(), utf8.length());
+}
+
+void JSONStreamWriter::_write_indent(int p_level) {
+	if (indent.is_empty()) {
+		return;
+	}
+	_write("\n", 1);
+	for (int i = 0; i < p_level; i++) {
+		_write(indent);
+	}
+}
+
+Error JSONStreamWriter::_begin_element() {
+	ERR_FAIL_COND_V_MSG(file.is_null() && stream.is_null(), ERR_UNCONFIGURED, "Set a file or stream before writing.");
+
+	if (containers.is_empty()) {
+		ERR_FAIL_COND_V_MSG(root_written, ERR_ALREADY_EXISTS, "The JSON document already has a root value.");
+		root_written = true;
+		return OK;
+	}
+
+	Container &container = containers[containers.size() - 1];
+	if (container.object) {
+		// write_key() already wrote the separator.
+		ERR_FAIL_COND_V_MSG(!container.has_key, ERR_INVALID_PARAMETER, "A key must be written before each value of an object.");
+		container.has_key = false;
+		return OK;
+	}
+
+	if (!container.empty) {
+		_write(",", 1);
+	}
+	_write_indent(containers.size());
+	container.empty = false;
+	return OK;
+}
+
+Error JSONStreamWriter::begin_object() {
+	Error err = _begin_element();
+	if (err != OK) {
+		return err;
+	}
+	ERR_FAIL_COND_V_MSG(containers.size() >= Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "JSON structure is too deep.");
+
+	_write("{", 1);
+	Container container;
+	container.object = true;
+	containers.push_back(container);
+	return OK;
+}
+
+Error JSONStreamWriter::end_object() {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || !containers[containers.size() - 1].object, ERR_INVALID_PARAMETER, "Not writing an object.");
+	ERR_FAIL_COND_V_MSG(containers[containers.size() - 1].has_key, ERR_INVALID_PARAMETER, "The last key of the object has no value.");
+
+	// Like JSON::stringify(), empty objects still get their line breaks.
+	if (containers[containers.size() - 1].empty && !indent.is_empty()) {
+		_write("\n", 1);
+	}
+	containers.resize(containers.size() - 1);
+	_write_indent(containers.size());
+	_write("}", 1);
+	return OK;
+}
+
+Error JSONStreamWriter::begin_array() {
+	Error err = _begin_element();
+	if (err != OK) {
+		return err;
+	}
+	ERR_FAIL_COND_V_MSG(containers.size() >= Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "JSON structure is too deep.");
+
+	_write("[", 1);
+	containers.push_back(Container());
+	return OK;
+}
+
+Error JSONStreamWriter::end_array() {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || containers[containers.size() - 1].object, ERR_INVALID_PARAMETER, "Not writing an array.");
+
+	const bool empty = containers[containers.size() - 1].empty;
+	containers.resize(containers.size() - 1);
+	if (!empty) {
+		_write_indent(containers.size());
+	}
+	_write("]", 1);
+	return OK;
+}
+
+Error JSONStreamWriter::write_key(const String &p_key) {
+	ERR_FAIL_COND_V_MSG(containers.is_empty() || !containers[containers.size() - 1].object, ERR_INVALID_PARAMETER, "Keys can only be written in objects.");
+
+	Container &container = containers[containers.size() - 1];
+	ERR_FAIL_COND_V_MSG(container.has_key, ERR_INVALID_PARAMETER, "The previous key has no value.");
+
+	if (!container.empty) {
+		_write(",", 1);
+	}
+	_write_indent(containers.size());
+	_write("\"", 1);
+	_write(p_key.json_escape());
+	if (indent.is_empty()) {
+		_write("\":", 2);
+	} else {
+		_write("\": ", 3);
+	}
+	container.empty = false;
+	container.has_key = true;
+	return OK;
+}
+
+Error JSONStreamWriter::write_value(const Variant &p_value) {
+	Error err = _begin_element();
+	if (err != OK) {
+		return err;
+	}
+
+	String result;
+	HashSet<const void *> markers;
+	JSON::_stringify(result, p_value, indent, containers.size(), sort_keys, markers, full_precision);
+	_write(result);
+	return OK;
+}
+
+Error JSONStreamWriter::flush() {
+	if (buffer.is_empty()) {
+		return OK;
+	}
+
+	Error err = OK;
+	if (file.is_valid()) {
+		err = file->store_buffer(buffer.ptr(), buffer.size()) ? OK : ERR_FILE_CANT_WRITE;
+	} else if (stream.is_valid()) {
+		err = stream->put_data(buffer.ptr(), buffer.size());
+	}
+	buffer.clear();
+	return err;
+}
+
+void JSONStreamWriter::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_file", "file"), &JSONStreamWriter::set_file);
+	ClassDB::bind_method(D_METHOD("set_stream", "stream"), &JSONStreamWriter::set_stream);
+
+	ClassDB::bind_method(D_METHOD("set_indent", "indent"), &JSONStreamWriter::set_indent);
+	ClassDB::bind_method(D_METHOD("get_indent"), &JSONStreamWriter::get_indent);
+	ClassDB::bind_method(D_METHOD("set_sort_keys", "sort_keys"), &JSONStreamWriter::set_sort_keys);
+	ClassDB::bind_method(D_METHOD("is_sort_keys"), &JSONStreamWriter::is_sort_keys);
+	ClassDB::bind_method(D_METHOD("set_full_precision", "full_precision"), &JSONStreamWriter::set_full_precision);
+	ClassDB::bind_method(D_METHOD("is_full_precision"), &JSONStreamWriter::is_full_precision);
+
+	ClassDB::bind_method(D_METHOD("begin_object"), &JSONStreamWriter::begin_object);
+	ClassDB::bind_method(D_METHOD("end_object"), &JSONStreamWriter::end_object);
+	ClassDB::bind_method(D_METHOD("begin_array"), &JSONStreamWriter::begin_array);
+	ClassDB::bind_method(D_METHOD("end_array"), &JSONStreamWriter::end_array);
+	ClassDB::bind_method(D_METHOD("write_key", "key"), &JSONStreamWriter::write_key);
+	ClassDB::bind_method(D_METHOD("write_value", "value"), &JSONStreamWriter::write_value);
+	ClassDB::bind_method(D_METHOD("flush"), &JSONStreamWriter::flush);
+
+	ADD_PROPERTY(PropertyInfo(Variant::STRING, "indent"), "set_indent", "get_indent");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "sort_keys"), "set_sort_keys", "is_sort_keys");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "full_precision"), "set_full_precision", "is_full_precision");
+}
+
+JSONStreamWriter::~JSONStreamWriter() {
+	flush();
+}
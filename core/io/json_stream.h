@@ -0,0 +1,202 @@
+/**************************************************************************/
+/*  json_stream.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/io/stream_peer.h"
+#include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+
+// Pull parser reading JSON incrementally from a FileAccess, a StreamPeer or appended chunks.
+// Works on UTF-8 bytes, only keys and string values are converted to String.
+class JSONStreamReader : public RefCounted {
+	GDCLASS(JSONStreamReader, RefCounted);
+
+public:
+	enum Event {
+		EVENT_NONE,
+		EVENT_OBJECT_BEGIN,
+		EVENT_OBJECT_END,
+		EVENT_ARRAY_BEGIN,
+		EVENT_ARRAY_END,
+		EVENT_KEY,
+		EVENT_VALUE,
+	};
+
+	static constexpr uint32_t CHUNK_SIZE = 64 * 1024;
+
+private:
+	enum TokenType {
+		TK_CURLY_BRACKET_OPEN,
+		TK_CURLY_BRACKET_CLOSE,
+		TK_BRACKET_OPEN,
+		TK_BRACKET_CLOSE,
+		TK_STRING,
+		TK_NUMBER,
+		TK_LITERAL,
+		TK_COLON,
+		TK_COMMA,
+		TK_EOF,
+		TK_MAX
+	};
+
+	enum State {
+		STATE_VALUE,
+		STATE_ARRAY_FIRST, // A value or ']', also after ',' like JSON::parse().
+		STATE_OBJECT_FIRST, // A key or '}', also after ','.
+		STATE_COLON,
+		STATE_AFTER_VALUE,
+		STATE_DONE,
+	};
+
+	struct Token {
+		TokenType type = TK_EOF;
+		Variant value;
+		uint32_t length = 0; // Bytes used in the buffer, including leading whitespace.
+		int lines = 0; // Line breaks in those bytes.
+	};
+
+	static const char *tk_name[];
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+	bool source_ended = false;
+	bool at_start = true;
+
+	LocalVector<uint8_t> buffer;
+	uint32_t buffer_pos = 0;
+
+	State state = STATE_VALUE;
+	LocalVector<bool> containers; // true for objects.
+	Event event = EVENT_NONE;
+	Variant value;
+
+	// read_value() state, kept so it can resume when a stream runs dry.
+	LocalVector<Variant> value_stack;
+	LocalVector<String> key_stack;
+
+	int line = 1;
+	Error error = OK;
+	String error_message;
+
+	void _compact();
+	Error _fill();
+	Error _parse_string(const uint8_t *p_str, uint32_t p_len, Token &r_token, String &r_err_str) const;
+	Error _scan_token(Token &r_token, String &r_err_str) const;
+	Error _next_token(Token &r_token);
+	Error _set_error(const String &p_message);
+	Error _begin_value(Token &p_token);
+	Error _end_container(bool p_object);
+	void _add_to_parent(const Variant &p_value);
+
+protected:
+	static void _bind_methods();
+
+public:
+	void reset();
+	void set_file(const Ref<FileAccess> &p_file);
+	void set_stream(const Ref<StreamPeer> &p_stream);
+	void append_data(const PackedByteArray &p_data);
+	void append_data(const uint8_t *p_data, uint32_t p_size);
+	void finish_data();
+
+	// OK with a new event, ERR_BUSY when a stream or appended data have no more bytes yet,
+	// ERR_FILE_EOF past the end of the document, or a parse error.
+	Error read();
+	// Reads the whole value of the current event, resuming where it stopped after ERR_BUSY.
+	Error read_value(Variant &r_value);
+	Variant _read_value_bind();
+
+	Event get_event() const { return event; }
+	Variant get_value() const { return value; }
+	int get_depth() const { return containers.size(); }
+
+	Error get_error() const { return error; }
+	int get_error_line() const { return error != OK ? line : 0; }
+	String get_error_message() const { return error_message; }
+};
+
+// Writes JSON to a FileAccess or StreamPeer as it is produced, formatted like JSON::stringify().
+class JSONStreamWriter : public RefCounted {
+	GDCLASS(JSONStreamWriter, RefCounted);
+
+public:
+	static constexpr uint32_t FLUSH_SIZE = 64 * 1024;
+
+private:
+	struct Container {
+		bool object = false;
+		bool empty = true;
+		bool has_key = false;
+	};
+
+	Ref<FileAccess> file;
+	Ref<StreamPeer> stream;
+
+	String indent;
+	bool sort_keys = true;
+	bool full_precision = false;
+
+	LocalVector<uint8_t> buffer;
+	LocalVector<Container> containers;
+	bool root_written = false;
+
+	void _write(const char *p_data, uint32_t p_len);
+	void _write(const String &p_string);
+	void _write_indent(int p_level); // Line break first, nothing without indentation.
+	Error _begin_element();
+
+protected:
+	static void _bind_methods();
+
+public:
+	void set_file(const Ref<FileAccess> &p_file);
+	void set_stream(const Ref<StreamPeer> &p_stream);
+
+	void set_indent(const String &p_indent);
+	String get_indent() const;
+	void set_sort_keys(bool p_sort_keys);
+	bool is_sort_keys() const;
+	void set_full_precision(bool p_full_precision);
+	bool is_full_precision() const;
+
+	Error begin_object();
+	Error end_object();
+	Error begin_array();
+	Error end_array();
+	Error write_key(const String &p_key);
+	Error write_value(const Variant &p_value);
+	Error flush();
+
+	~JSONStreamWriter();
+};
+
+VARIANT_ENUM_CAST(JSONStreamReader::Event);
@@ -78,6 +78,10 @@ ObjectID EncodedObjectAsID::get_object_id() const {
 #define HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_MASK (0b11 << 18)
 #define HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT 18
 
+// For `Variant::ARRAY` and `Variant::DICTIONARY`.
+// Elements of scalar and string typed containers are stored without their own header.
+#define HEADER_DATA_FLAG_COMPACT (1 << 20)
+
 enum ContainerTypeKind {
 	CONTAINER_TYPE_KIND_NONE = 0b00,
 	CONTAINER_TYPE_KIND_BUILTIN = 0b01,
@@ -88,6 +92,136 @@ enum ContainerTypeKind {
 #define GET_CONTAINER_TYPE_KIND(m_header, m_field) \
 	((ContainerTypeKind)(((m_header) & HEADER_DATA_FIELD_##m_field##_MASK) >> HEADER_DATA_FIELD_##m_field##_SHIFT))
 
+// Containers typed with one of these builtin types can store their elements in compact form.
+static bool _is_compact_type(const ContainerType &p_type) {
+	if (p_type.script.is_valid() || p_type.class_name != StringName()) {
+		return false;
+	}
+	switch (p_type.builtin_type) {
+		case Variant::BOOL:
+		case Variant::INT:
+		case Variant::FLOAT:
+		case Variant::STRING:
+		case Variant::STRING_NAME:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static Error _decode_varint(const uint8_t *&buf, int &len, int *r_len, uint64_t &r_value) {
+	r_value = 0;
+	for (int shift = 0; shift < 64; shift += 7) {
+		ERR_FAIL_COND_V(len < 1, ERR_INVALID_DATA);
+		const uint8_t byte = *buf;
+		buf++;
+		len--;
+		if (r_len) {
+			(*r_len)++;
+		}
+		r_value |= uint64_t(byte & 0x7F) << shift;
+		if (!(byte & 0x80)) {
+			return OK;
+		}
+	}
+	ERR_FAIL_V_MSG(ERR_INVALID_DATA, "Variable-length integer is too long.");
+}
+
+static Error _decode_compact_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
+	uint64_t strlen;
+	Error err = _decode_varint(buf, len, r_len, strlen);
+	if (err) {
+		return err;
+	}
+	ERR_FAIL_COND_V(strlen > uint64_t(len), ERR_FILE_EOF);
+
+	String str;
+	ERR_FAIL_COND_V(str.append_utf8((const char *)buf, strlen) != OK, ERR_INVALID_DATA);
+	r_string = str;
+
+	buf += strlen;
+	len -= strlen;
+	if (r_len) {
+		(*r_len) += strlen;
+	}
+	return OK;
+}
+
+// String names are interned per container: index 0 introduces a new name, index N refers to the Nth one seen.
+static Error _decode_compact(Variant::Type p_type, const uint8_t *&buf, int &len, int *r_len, LocalVector<StringName> &r_names, Variant &r_variant) {
+	switch (p_type) {
+		case Variant::BOOL: {
+			ERR_FAIL_COND_V(len < 1, ERR_INVALID_DATA);
+			r_variant = *buf != 0;
+			buf++;
+			len--;
+			if (r_len) {
+				(*r_len)++;
+			}
+		} break;
+		case Variant::INT: {
+			uint64_t zigzag;
+			Error err = _decode_varint(buf, len, r_len, zigzag);
+			if (err) {
+				return err;
+			}
+			r_variant = int64_t(zigzag >> 1) ^ -int64_t(zigzag & 1);
+		} break;
+		case Variant::FLOAT: {
+			ERR_FAIL_COND_V(len < 8, ERR_INVALID_DATA);
+			r_variant = decode_double(buf);
+			buf += 8;
+			len -= 8;
+			if (r_len) {
+				(*r_len) += 8;
+			}
+		} break;
+		case Variant::STRING: {
+			String str;
+			Error err = _decode_compact_string(buf, len, r_len, str);
+			if (err) {
+				return err;
+			}
+			r_variant = str;
+		} break;
+		case Variant::STRING_NAME: {
+			uint64_t index;
+			Error err = _decode_varint(buf, len, r_len, index);
+			if (err) {
+				return err;
+			}
+			if (index == 0) {
+				String str;
+				err = _decode_compact_string(buf, len, r_len, str);
+				if (err) {
+					return err;
+				}
+				r_names.push_back(StringName(str));
+				r_variant = r_names[r_names.size() - 1];
+			} else {
+				ERR_FAIL_COND_V(index > r_names.size(), ERR_INVALID_DATA);
+				r_variant = r_names[index - 1];
+			}
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+	return OK;
+}
+
+// Compact containers are padded so the whole encoded variant stays a multiple of 4 bytes.
+static Error _decode_compact_padding(const uint8_t *p_start, const uint8_t *&buf, int &len, int *r_len) {
+	const int pad = (4 - (buf - p_start) % 4) % 4;
+	ERR_FAIL_COND_V(len < pad, ERR_INVALID_DATA);
+	buf += pad;
+	len -= pad;
+	if (r_len) {
+		(*r_len) += pad;
+	}
+	return OK;
+}
+
 static Error _decode_string(const uint8_t *&buf, int &len, int *r_len, String &r_string) {
 	ERR_FAIL_COND_V(len < 4, ERR_INVALID_DATA);
 
@@ -842,31 +976,54 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				dict.set_typed(key_type, value_type);
 			}
 
+			const bool compact = header & HEADER_DATA_FLAG_COMPACT;
+			const bool compact_keys = compact && _is_compact_type(key_type);
+			const bool compact_values = compact && _is_compact_type(value_type);
+			LocalVector<StringName> names;
+
 			for (int i = 0; i < count; i++) {
 				Variant key, value;
 
-				int used;
-				Error err = decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
-				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+				if (compact_keys) {
+					Error err = _decode_compact(key_type.builtin_type, buf, len, r_len, names, key);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+				} else {
+					int used;
+					Error err = decode_variant(key, buf, len, &used, p_allow_objects, p_depth + 1);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
-				buf += used;
-				len -= used;
-				if (r_len) {
-					(*r_len) += used;
+					buf += used;
+					len -= used;
+					if (r_len) {
+						(*r_len) += used;
+					}
 				}
 
-				err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
-				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+				if (compact_values) {
+					Error err = _decode_compact(value_type.builtin_type, buf, len, r_len, names, value);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+				} else {
+					int used;
+					Error err = decode_variant(value, buf, len, &used, p_allow_objects, p_depth + 1);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
 
-				buf += used;
-				len -= used;
-				if (r_len) {
-					(*r_len) += used;
+					buf += used;
+					len -= used;
+					if (r_len) {
+						(*r_len) += used;
+					}
 				}
 
 				dict[key] = value;
 			}
 
+			if (compact) {
+				Error err = _decode_compact_padding(p_buffer, buf, len, r_len);
+				if (err) {
+					return err;
+				}
+			}
+
 			r_variant = dict;
 
 		} break;
@@ -899,16 +1056,34 @@ Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int
 				array.set_typed(type);
 			}
 
-			for (int i = 0; i < count; i++) {
-				int used = 0;
-				Variant elem;
-				Error err = decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1);
-				ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
-				buf += used;
-				len -= used;
-				array.push_back(elem);
-				if (r_len) {
-					(*r_len) += used;
+			if ((header & HEADER_DATA_FLAG_COMPACT) && _is_compact_type(type)) {
+				// At least one byte per element.
+				ERR_FAIL_COND_V(count > len, ERR_INVALID_DATA);
+				array.resize(count);
+				LocalVector<StringName> names;
+				for (int i = 0; i < count; i++) {
+					Variant elem;
+					Error err = _decode_compact(type.builtin_type, buf, len, r_len, names, elem);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+					array.set(i, elem);
+				}
+
+				Error err = _decode_compact_padding(p_buffer, buf, len, r_len);
+				if (err) {
+					return err;
+				}
+			} else {
+				for (int i = 0; i < count; i++) {
+					int used = 0;
+					Variant elem;
+					Error err = decode_variant(elem, buf, len, &used, p_allow_objects, p_depth + 1);
+					ERR_FAIL_COND_V_MSG(err != OK, err, "Error when trying to decode Variant.");
+					buf += used;
+					len -= used;
+					array.push_back(elem);
+					if (r_len) {
+						(*r_len) += used;
+					}
 				}
 			}
 
@@ -1358,7 +1533,81 @@ static Error _encode_container_type(const ContainerType &p_type, uint8_t *&buf,
 	return OK;
 }
 
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth) {
+static void _encode_varint(uint64_t p_value, uint8_t *&buf, int &r_len) {
+	do {
+		uint8_t byte = p_value & 0x7F;
+		p_value >>= 7;
+		if (p_value) {
+			byte |= 0x80;
+		}
+		if (buf) {
+			*(buf++) = byte;
+		}
+		r_len++;
+	} while (p_value);
+}
+
+static void _encode_compact_string(const String &p_string, uint8_t *&buf, int &r_len) {
+	CharString utf8 = p_string.utf8();
+	_encode_varint(utf8.length(), buf, r_len);
+	if (buf) {
+		memcpy(buf, utf8.get_data(), utf8.length());
+		buf += utf8.length();
+	}
+	r_len += utf8.length();
+}
+
+static Error _encode_compact(const Variant &p_variant, Variant::Type p_type, uint8_t *&buf, int &r_len, HashMap<StringName, uint32_t> &r_names) {
+	ERR_FAIL_COND_V(p_variant.get_type() != p_type, ERR_BUG);
+	switch (p_type) {
+		case Variant::BOOL: {
+			if (buf) {
+				*(buf++) = p_variant.operator bool() ? 1 : 0;
+			}
+			r_len++;
+		} break;
+		case Variant::INT: {
+			const int64_t val = p_variant;
+			_encode_varint((uint64_t(val) << 1) ^ uint64_t(val >> 63), buf, r_len);
+		} break;
+		case Variant::FLOAT: {
+			if (buf) {
+				encode_double(p_variant.operator double(), buf);
+				buf += 8;
+			}
+			r_len += 8;
+		} break;
+		case Variant::STRING: {
+			_encode_compact_string(p_variant, buf, r_len);
+		} break;
+		case Variant::STRING_NAME: {
+			const StringName name = p_variant;
+			HashMap<StringName, uint32_t>::ConstIterator E = r_names.find(name);
+			if (E) {
+				_encode_varint(E->value, buf, r_len);
+			} else {
+				_encode_varint(0, buf, r_len);
+				_encode_compact_string(name, buf, r_len);
+				r_names.insert(name, r_names.size() + 1);
+			}
+		} break;
+		default: {
+			ERR_FAIL_V(ERR_BUG);
+		}
+	}
+	return OK;
+}
+
+static void _encode_compact_padding(uint8_t *&buf, int &r_len) {
+	while (r_len % 4) {
+		r_len++;
+		if (buf) {
+			*(buf++) = 0;
+		}
+	}
+}
+
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects, int p_depth, bool p_compact) {
 	ERR_FAIL_COND_V_MSG(p_depth > Variant::MAX_RECURSION_DEPTH, ERR_OUT_OF_MEMORY, "Potential infinite recursion detected. Bailing.");
 	uint8_t *buf = r_buffer;
 
@@ -1400,10 +1649,16 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			const Dictionary dict = p_variant;
 			_encode_container_type_header(dict.get_key_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_KEY_SHIFT, p_full_objects);
 			_encode_container_type_header(dict.get_value_type(), header, HEADER_DATA_FIELD_TYPED_DICTIONARY_VALUE_SHIFT, p_full_objects);
+			if (p_compact && (_is_compact_type(dict.get_key_type()) || _is_compact_type(dict.get_value_type()))) {
+				header |= HEADER_DATA_FLAG_COMPACT;
+			}
 		} break;
 		case Variant::ARRAY: {
 			const Array array = p_variant;
 			_encode_container_type_header(array.get_element_type(), header, HEADER_DATA_FIELD_TYPED_ARRAY_SHIFT, p_full_objects);
+			if (p_compact && _is_compact_type(array.get_element_type())) {
+				header |= HEADER_DATA_FLAG_COMPACT;
+			}
 		} break;
 #ifdef REAL_T_IS_DOUBLE
 		case Variant::VECTOR2:
@@ -1849,24 +2104,44 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
+			const bool compact = header & HEADER_DATA_FLAG_COMPACT;
+			const bool compact_keys = compact && _is_compact_type(dict.get_key_type());
+			const bool compact_values = compact && _is_compact_type(dict.get_value_type());
+			HashMap<StringName, uint32_t> names;
+
 			for (const KeyValue<Variant, Variant> &kv : dict) {
-				int len;
-				Error err = encode_variant(kv.key, buf, len, p_full_objects, p_depth + 1);
-				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
+				if (compact_keys) {
+					Error err = _encode_compact(kv.key, dict.get_key_type().builtin_type, buf, r_len, names);
+					ERR_FAIL_COND_V(err, err);
+				} else {
+					int len;
+					Error err = encode_variant(kv.key, buf, len, p_full_objects, p_depth + 1, p_compact);
+					ERR_FAIL_COND_V(err, err);
+					ERR_FAIL_COND_V(len % 4, ERR_BUG);
+					r_len += len;
+					if (buf) {
+						buf += len;
+					}
 				}
-				err = encode_variant(kv.value, buf, len, p_full_objects, p_depth + 1);
-				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				r_len += len;
-				if (buf) {
-					buf += len;
+				if (compact_values) {
+					Error err = _encode_compact(kv.value, dict.get_value_type().builtin_type, buf, r_len, names);
+					ERR_FAIL_COND_V(err, err);
+				} else {
+					int len;
+					Error err = encode_variant(kv.value, buf, len, p_full_objects, p_depth + 1, p_compact);
+					ERR_FAIL_COND_V(err, err);
+					ERR_FAIL_COND_V(len % 4, ERR_BUG);
+					r_len += len;
+					if (buf) {
+						buf += len;
+					}
 				}
 			}
 
+			if (compact) {
+				_encode_compact_padding(buf, r_len);
+			}
+
 		} break;
 		case Variant::ARRAY: {
 			const Array array = p_variant;
@@ -1884,15 +2159,25 @@ Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bo
 			}
 			r_len += 4;
 
-			for (const Variant &elem : array) {
-				int len;
-				Error err = encode_variant(elem, buf, len, p_full_objects, p_depth + 1);
-				ERR_FAIL_COND_V(err, err);
-				ERR_FAIL_COND_V(len % 4, ERR_BUG);
-				if (buf) {
-					buf += len;
+			if (header & HEADER_DATA_FLAG_COMPACT) {
+				const Variant::Type type = Variant::Type(array.get_typed_builtin());
+				HashMap<StringName, uint32_t> names;
+				for (const Variant &elem : array) {
+					Error err = _encode_compact(elem, type, buf, r_len, names);
+					ERR_FAIL_COND_V(err, err);
+				}
+				_encode_compact_padding(buf, r_len);
+			} else {
+				for (const Variant &elem : array) {
+					int len;
+					Error err = encode_variant(elem, buf, len, p_full_objects, p_depth + 1, p_compact);
+					ERR_FAIL_COND_V(err, err);
+					ERR_FAIL_COND_V(len % 4, ERR_BUG);
+					if (buf) {
+						buf += len;
+					}
+					r_len += len;
 				}
-				r_len += len;
 			}
 
 		} break;
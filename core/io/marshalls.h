@@ -220,6 +220,9 @@ public:
 };
 
 Error decode_variant(Variant &r_variant, const uint8_t *p_buffer, int p_len, int *r_len = nullptr, bool p_allow_objects = false, int p_depth = 0);
-Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0);
+// With `p_compact`, containers typed with a scalar or string type store their elements without
+// per-element headers, integers as variable-length integers, and repeated string names only once.
+// `decode_variant()` reads both forms.
+Error encode_variant(const Variant &p_variant, uint8_t *r_buffer, int &r_len, bool p_full_objects = false, int p_depth = 0, bool p_compact = false);
 
 Vector<float> vector3_to_float32_array(const Vector3 *vecs, size_t count);
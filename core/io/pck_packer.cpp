@@ -31,9 +31,12 @@
 #include "pck_packer.h"
 
 #include "core/crypto/crypto_core.h"
+#include "core/io/delta_encoding.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_compressed.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
+#include "core/templates/local_vector.h"
 #include "core/version.h"
 
 static int _get_pad(int p_alignment, int p_n) {
@@ -49,8 +52,17 @@ static int _get_pad(int p_alignment, int p_n) {
 void PCKPacker::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("pck_start", "pck_path", "alignment", "key", "encrypt_directory"), &PCKPacker::pck_start, DEFVAL(32), DEFVAL("0000000000000000000000000000000000000000000000000000000000000000"), DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("add_file", "target_path", "source_path", "encrypt"), &PCKPacker::add_file, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("add_file_delta", "target_path", "source_path", "base_path"), &PCKPacker::add_file_delta);
 	ClassDB::bind_method(D_METHOD("add_file_removal", "target_path"), &PCKPacker::add_file_removal);
 	ClassDB::bind_method(D_METHOD("flush", "verbose"), &PCKPacker::flush, DEFVAL(false));
+
+	ClassDB::bind_method(D_METHOD("set_compression_enabled", "enabled"), &PCKPacker::set_compression_enabled);
+	ClassDB::bind_method(D_METHOD("is_compression_enabled"), &PCKPacker::is_compression_enabled);
+	ClassDB::bind_method(D_METHOD("set_deduplication_enabled", "enabled"), &PCKPacker::set_deduplication_enabled);
+	ClassDB::bind_method(D_METHOD("is_deduplication_enabled"), &PCKPacker::is_deduplication_enabled);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compression_enabled"), "set_compression_enabled", "is_compression_enabled");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "deduplication_enabled"), "set_deduplication_enabled", "is_deduplication_enabled");
 }
 
 Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const String &p_key, bool p_encrypt_directory) {
@@ -123,6 +135,7 @@ Error PCKPacker::pck_start(const String &p_pck_path, int p_alignment, const Stri
 	file->seek(file_base);
 
 	files.clear();
+	stored_contents.clear();
 
 	return OK;
 }
@@ -160,6 +173,7 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	pf.src_path = p_source_path;
 	pf.ofs = file->get_position();
 	pf.size = f->get_length();
+	pf.stored_size = pf.size;
 
 	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_source_path);
 	{
@@ -172,6 +186,28 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 	}
 	pf.encrypted = p_encrypt;
 
+	// Files with the same contents share their storage.
+	String content_key;
+	if (deduplication_enabled) {
+		content_key = get_content_key(data, p_encrypt, compression_enabled);
+
+		HashMap<String, int>::ConstIterator E = stored_contents.find(content_key);
+		if (E) {
+			const File &stored = files[E->value];
+			pf.ofs = stored.ofs;
+			pf.stored_size = stored.stored_size;
+			pf.compressed = stored.compressed;
+			files.push_back(pf);
+			return OK;
+		}
+	}
+
+	// Compression is skipped for encrypted files, and kept only when it saves space.
+	if (compression_enabled && !p_encrypt && !data.is_empty()) {
+		// If not kept, the tail is overwritten by what follows or truncated when flushing.
+		pf.compressed = store_compressed(file, data, pf.stored_size);
+	}
+
 	Ref<FileAccess> ftmp = file;
 
 	Ref<FileAccessEncrypted> fae;
@@ -184,7 +220,9 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 		ftmp = fae;
 	}
 
-	ftmp->store_buffer(data);
+	if (!pf.compressed) {
+		ftmp->store_buffer(data);
+	}
 
 	if (fae.is_valid()) {
 		ftmp.unref();
@@ -196,6 +234,57 @@ Error PCKPacker::add_file(const String &p_target_path, const String &p_source_pa
 		file->store_8(0);
 	}
 
+	if (!content_key.is_empty()) {
+		stored_contents[content_key] = files.size();
+	}
+	files.push_back(pf);
+
+	return OK;
+}
+
+Error PCKPacker::add_file_delta(const String &p_target_path, const String &p_source_path, const String &p_base_path) {
+	ERR_FAIL_COND_V_MSG(file.is_null(), ERR_INVALID_PARAMETER, "File must be opened before use.");
+
+	Error err;
+	Vector<uint8_t> data = FileAccess::get_file_as_bytes(p_source_path, &err);
+	if (err != OK) {
+		return ERR_FILE_CANT_OPEN;
+	}
+	Vector<uint8_t> base_data = FileAccess::get_file_as_bytes(p_base_path, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, ERR_FILE_CANT_OPEN, vformat("Can't open delta base file '%s'.", p_base_path));
+
+	Vector<uint8_t> delta;
+	err = DeltaEncoding::encode_delta(base_data, data, delta);
+	ERR_FAIL_COND_V(err != OK, err);
+	if (delta.size() >= data.size()) {
+		return add_file(p_target_path, p_source_path); // Nothing gained, ship the whole file.
+	}
+
+	File pf;
+	// Simplify path here and on every 'files' access so that paths that have extra '/'
+	// symbols or 'res://' in them still match the MD5 hash for the saved path.
+	pf.path = p_target_path.simplify_path().trim_prefix("res://");
+	pf.src_path = p_source_path;
+	pf.ofs = file->get_position();
+	pf.size = delta.size();
+	pf.stored_size = pf.size;
+	pf.delta = true;
+	{
+		unsigned char hash[16];
+		CryptoCore::md5(delta.ptr(), delta.size(), hash);
+		pf.md5.resize(16);
+		for (int i = 0; i < 16; i++) {
+			pf.md5.write[i] = hash[i];
+		}
+	}
+
+	file->store_buffer(delta);
+
+	int pad = _get_pad(alignment, file->get_position());
+	for (int j = 0; j < pad; j++) {
+		file->store_8(0);
+	}
+
 	files.push_back(pf);
 
 	return OK;
@@ -230,20 +319,26 @@ Error PCKPacker::flush(bool p_verbose) {
 		fhead = fae;
 	}
 
+	// Paths go to a string table after the fixed size entries, so the index can be used in place once mapped.
 	const int file_num = files.size();
+	Vector<uint8_t> strings;
+	LocalVector<uint32_t> path_offsets;
+	LocalVector<uint32_t> path_lengths;
+	path_offsets.resize(file_num);
+	path_lengths.resize(file_num);
 	for (int i = 0; i < file_num; i++) {
 		CharString utf8_string = files[i].path.utf8();
-		int string_len = utf8_string.length();
-		int pad = _get_pad(4, string_len);
-
-		fhead->store_32(uint32_t(string_len + pad));
-		fhead->store_buffer((const uint8_t *)utf8_string.get_data(), string_len);
-		for (int j = 0; j < pad; j++) {
-			fhead->store_8(0);
-		}
+		path_offsets[i] = strings.size();
+		path_lengths[i] = utf8_string.length();
+		strings.resize(strings.size() + utf8_string.length());
+		memcpy(strings.ptrw() + path_offsets[i], utf8_string.get_data(), utf8_string.length());
+	}
+	fhead->store_32(uint32_t(strings.size()));
 
+	for (int i = 0; i < file_num; i++) {
 		fhead->store_64(files[i].ofs - file_base);
 		fhead->store_64(files[i].size);
+		fhead->store_64(files[i].stored_size);
 		fhead->store_buffer(files[i].md5.ptr(), 16);
 
 		uint32_t flags = 0;
@@ -253,22 +348,81 @@ Error PCKPacker::flush(bool p_verbose) {
 		if (files[i].removal) {
 			flags |= PACK_FILE_REMOVAL;
 		}
+		if (files[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
+		if (files[i].delta) {
+			flags |= PACK_FILE_DELTA;
+		}
 		fhead->store_32(flags);
+		fhead->store_32(path_offsets[i]);
+		fhead->store_32(path_lengths[i]);
+		fhead->store_32(0); // Reserved.
 
 		if (p_verbose) {
 			print_line(vformat("[%d/%d - %d%%] PCKPacker flush: %s -> %s", i, file_num, float(i) / file_num * 100, files[i].src_path, files[i].path));
 		}
 	}
+	fhead->store_buffer(strings);
 
 	if (fae.is_valid()) {
 		fhead.unref();
 		fae.unref();
 	}
 
+	// Drop what is left of a compressed file that was replaced by its smaller raw contents.
+	if (file->get_length() > file->get_position()) {
+		file->resize(file->get_position());
+	}
+
 	file.unref();
 	return OK;
 }
 
+void PCKPacker::set_compression_enabled(bool p_enabled) {
+	compression_enabled = p_enabled;
+}
+
+bool PCKPacker::is_compression_enabled() const {
+	return compression_enabled;
+}
+
+void PCKPacker::set_deduplication_enabled(bool p_enabled) {
+	deduplication_enabled = p_enabled;
+}
+
+bool PCKPacker::is_deduplication_enabled() const {
+	return deduplication_enabled;
+}
+
+String PCKPacker::get_content_key(const Vector<uint8_t> &p_data, bool p_encrypted, bool p_compressed) {
+	// A SHA-256 of the contents, and how they are stored.
+	unsigned char hash[32];
+	CryptoCore::sha256(p_data.ptr(), p_data.size(), hash);
+	return String::hex_encode_buffer(hash, 32) + (p_encrypted ? "e" : "") + (p_compressed ? "c" : "");
+}
+
+bool PCKPacker::store_compressed(const Ref<FileAccess> &p_file, const Vector<uint8_t> &p_data, uint64_t &r_stored_size) {
+	const uint64_t ofs = p_file->get_position();
+
+	Ref<FileAccessCompressed> fac;
+	fac.instantiate();
+	fac->configure(PACK_COMPRESSED_MAGIC, Compression::MODE_ZSTD);
+	Error err = fac->open_for_writing(p_file);
+	ERR_FAIL_COND_V(err != OK, false);
+	fac->store_buffer(p_data.ptr(), p_data.size());
+	fac->close();
+
+	r_stored_size = p_file->get_position() - ofs;
+	if (r_stored_size < (uint64_t)p_data.size()) {
+		return true;
+	}
+
+	p_file->seek(ofs);
+	r_stored_size = p_data.size();
+	return false;
+}
+
 PCKPacker::~PCKPacker() {
 	if (file.is_valid()) {
 		flush();
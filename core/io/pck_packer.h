@@ -31,6 +31,7 @@
 #pragma once
 
 #include "core/object/ref_counted.h"
+#include "core/templates/hash_map.h"
 
 class FileAccess;
 
@@ -47,6 +48,9 @@ class PCKPacker : public RefCounted {
 	uint64_t file_base_ofs = 0;
 	uint64_t dir_base_ofs = 0;
 
+	bool compression_enabled = false;
+	bool deduplication_enabled = true;
+
 	static void _bind_methods();
 
 	struct File {
@@ -54,17 +58,34 @@ class PCKPacker : public RefCounted {
 		String src_path;
 		uint64_t ofs = 0;
 		uint64_t size = 0;
+		uint64_t stored_size = 0;
 		bool encrypted = false;
+		bool compressed = false;
+		bool delta = false;
 		bool removal = false;
 		Vector<uint8_t> md5;
 	};
 	Vector<File> files;
+	HashMap<String, int> stored_contents; // Content hash to the first file storing it.
 
 public:
 	Error pck_start(const String &p_pck_path, int p_alignment = 32, const String &p_key = "0000000000000000000000000000000000000000000000000000000000000000", bool p_encrypt_directory = false);
 	Error add_file(const String &p_target_path, const String &p_source_path, bool p_encrypt = false);
+	Error add_file_delta(const String &p_target_path, const String &p_source_path, const String &p_base_path);
 	Error add_file_removal(const String &p_target_path);
 	Error flush(bool p_verbose = false);
 
+	void set_compression_enabled(bool p_enabled);
+	bool is_compression_enabled() const;
+	void set_deduplication_enabled(bool p_enabled);
+	bool is_deduplication_enabled() const;
+
+	// Also used by the editor exporter, so both store files the same way.
+	// Files with the same key can share their storage.
+	static String get_content_key(const Vector<uint8_t> &p_data, bool p_encrypted, bool p_compressed);
+	// Stores p_data compressed at the current position if it ends up smaller, and returns whether it did.
+	// Otherwise, the position is left where it was. What was written past it must be overwritten or truncated.
+	static bool store_compressed(const Ref<FileAccess> &p_file, const Vector<uint8_t> &p_data, uint64_t &r_stored_size);
+
 	~PCKPacker();
 };
@@ -32,7 +32,10 @@
 
 #include "core/config/project_settings.h"
 #include "core/io/dir_access.h"
+#include "core/io/file_access_async.h"
 #include "core/io/file_access_compressed.h"
+#include "core/io/file_access_memory.h"
+#include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/object/script_language.h"
 #include "core/version.h"
@@ -109,6 +112,13 @@ void ResourceLoaderBinary::_advance_padding(uint32_t p_len) {
 	}
 }
 
+// Packed array lengths come from the file, don't let a corrupt one trigger a huge allocation.
+static bool is_packed_array_length_valid(const Ref<FileAccess> &f, uint64_t p_len, uint64_t p_element_size) {
+	uint64_t position = f->get_position();
+	uint64_t length = f->get_length();
+	return position <= length && p_len <= (length - position) / p_element_size;
+}
+
 static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 	if (f->real_is_double) {
 		if constexpr (sizeof(real_t) == 8) {
@@ -124,8 +134,16 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 #endif
 		} else if constexpr (sizeof(real_t) == 4) {
 			// May be slower, but this is for compatibility. Eventually the data should be converted.
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_double();
+			// Convert straight from mapped storage when possible, instead of a virtual call per element.
+			Span<uint8_t> view = f->is_big_endian() ? Span<uint8_t>() : f->get_buffer_view(count * sizeof(double));
+			if (view.size() == count * sizeof(double)) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = decode_double(view.ptr() + i * sizeof(double));
+				}
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_double();
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -143,8 +161,15 @@ static Error read_reals(real_t *dst, Ref<FileAccess> &f, size_t count) {
 			}
 #endif
 		} else if constexpr (sizeof(real_t) == 8) {
-			for (size_t i = 0; i < count; ++i) {
-				dst[i] = f->get_float();
+			Span<uint8_t> view = f->is_big_endian() ? Span<uint8_t>() : f->get_buffer_view(count * sizeof(float));
+			if (view.size() == count * sizeof(float)) {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = decode_float(view.ptr() + i * sizeof(float));
+				}
+			} else {
+				for (size_t i = 0; i < count; ++i) {
+					dst[i] = f->get_float();
+				}
 			}
 		} else {
 			ERR_FAIL_V_MSG(ERR_UNAVAILABLE, "real_t size is neither 4 nor 8!");
@@ -508,9 +533,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_BYTE_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, 1), ERR_FILE_CORRUPT);
 
 			Vector<uint8_t> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			uint8_t *w = array.ptrw();
 			f->get_buffer(w, len);
 			_advance_padding(len);
@@ -520,9 +546,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_INT32_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, sizeof(int32_t)), ERR_FILE_CORRUPT);
 
 			Vector<int32_t> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			int32_t *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(int32_t));
 #ifdef BIG_ENDIAN_ENABLED
@@ -539,9 +566,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_INT64_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, sizeof(int64_t)), ERR_FILE_CORRUPT);
 
 			Vector<int64_t> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			int64_t *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(int64_t));
 #ifdef BIG_ENDIAN_ENABLED
@@ -558,9 +586,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_FLOAT32_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, sizeof(float)), ERR_FILE_CORRUPT);
 
 			Vector<float> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			float *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(float));
 #ifdef BIG_ENDIAN_ENABLED
@@ -577,9 +606,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_FLOAT64_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, sizeof(double)), ERR_FILE_CORRUPT);
 
 			Vector<double> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			double *w = array.ptrw();
 			f->get_buffer((uint8_t *)w, len * sizeof(double));
 #ifdef BIG_ENDIAN_ENABLED
@@ -608,9 +638,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR2_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, (f->real_is_double ? sizeof(double) : sizeof(float)) * 2), ERR_FILE_CORRUPT);
 
 			Vector<Vector2> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Vector2 *w = array.ptrw();
 			static_assert(sizeof(Vector2) == 2 * sizeof(real_t));
 			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 2);
@@ -621,9 +652,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR3_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, (f->real_is_double ? sizeof(double) : sizeof(float)) * 3), ERR_FILE_CORRUPT);
 
 			Vector<Vector3> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Vector3 *w = array.ptrw();
 			static_assert(sizeof(Vector3) == 3 * sizeof(real_t));
 			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 3);
@@ -634,9 +666,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_COLOR_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, sizeof(float) * 4), ERR_FILE_CORRUPT);
 
 			Vector<Color> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Color *w = array.ptrw();
 			// Colors always use `float` even with double-precision support enabled
 			static_assert(sizeof(Color) == 4 * sizeof(float));
@@ -655,9 +688,10 @@ Error ResourceLoaderBinary::parse_variant(Variant &r_v) {
 		} break;
 		case VARIANT_PACKED_VECTOR4_ARRAY: {
 			uint32_t len = f->get_32();
+			ERR_FAIL_COND_V(!is_packed_array_length_valid(f, len, (f->real_is_double ? sizeof(double) : sizeof(float)) * 4), ERR_FILE_CORRUPT);
 
 			Vector<Vector4> array;
-			array.resize(len);
+			array.resize_uninitialized(len);
 			Vector4 *w = array.ptrw();
 			static_assert(sizeof(Vector4) == 4 * sizeof(real_t));
 			const Error err = read_reals(reinterpret_cast<real_t *>(w), f, len * 4);
@@ -678,11 +712,37 @@ Ref<Resource> ResourceLoaderBinary::get_resource() {
 	return resource;
 }
 
+void ResourceLoaderBinary::_file_read_done(void *p_self, Error p_error, uint64_t p_read_length) {
+	ResourceLoaderBinary *self = static_cast<ResourceLoaderBinary *>(p_self);
+	if (self->file_read_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		WorkerThreadPool::get_singleton()->notify_yield_over(self->file_read_task_id);
+	}
+}
+
+Error ResourceLoaderBinary::_wait_file_read(const Ref<FileAccessAsyncRead> &p_read) {
+	if (file_read_task_id != WorkerThreadPool::INVALID_TASK_ID) {
+		// Instead of holding up a pool thread on the disk, let it run other tasks meanwhile (e.g. the
+		// external resources just requested). Woken up once by _file_read_done(), which may have run already.
+		ResourceLoader::_load_yield();
+		file_read_task_id = WorkerThreadPool::INVALID_TASK_ID;
+	}
+	// Returns right away on a pool thread, the read is marked completed right after the callback.
+	return p_read->wait();
+}
+
 Error ResourceLoaderBinary::load() {
 	if (error != OK) {
 		return error;
 	}
 
+	// All of the file is needed right after the external resources started loading, read it meanwhile.
+	Ref<FileAccessAsyncRead> file_read;
+	if (!external_resources.is_empty() && f->can_read_async() && f->get_length() <= ASYNC_READ_MAX_SIZE) {
+		file_data.resize(f->get_length());
+		file_read_task_id = WorkerThreadPool::get_singleton()->get_caller_task_id();
+		file_read = f->read_async(0, file_data.ptrw(), file_data.size(), &ResourceLoaderBinary::_file_read_done, this);
+	}
+
 	for (int i = 0; i < external_resources.size(); i++) {
 		String path = external_resources[i].path;
 
@@ -702,11 +762,27 @@ Error ResourceLoaderBinary::load() {
 				ResourceLoader::notify_dependency_error(local_path, path, external_resources[i].type);
 			} else {
 				error = ERR_FILE_MISSING_DEPENDENCIES;
+				if (file_read.is_valid()) {
+					_wait_file_read(file_read); // Still writing to file_data.
+				}
 				ERR_FAIL_V_MSG(error, vformat("Can't load dependency: '%s'.", path));
 			}
 		}
 	}
 
+	if (file_read.is_valid()) {
+		if (_wait_file_read(file_read) == OK && file_read->get_read_length() == (uint64_t)file_data.size()) {
+			Ref<FileAccessMemory> fm;
+			fm.instantiate();
+			fm->open_custom(file_data.ptr(), file_data.size());
+			fm->set_big_endian(f->is_big_endian());
+			fm->real_is_double = f->real_is_double;
+			f = fm;
+		} else {
+			file_data.clear();
+		}
+	}
+
 	for (int i = 0; i < internal_resources.size(); i++) {
 		bool main = i == (internal_resources.size() - 1);
 
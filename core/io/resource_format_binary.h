@@ -44,6 +44,16 @@ class ResourceLoaderBinary {
 	uint32_t ver_format = 0;
 
 	Ref<FileAccess> f;
+	// Backing f once it's been read ahead asynchronously, see load().
+	Vector<uint8_t> file_data;
+	// The load task to wake up once the read ahead completes, if loading on the WorkerThreadPool.
+	WorkerThreadPool::TaskID file_read_task_id = WorkerThreadPool::INVALID_TASK_ID;
+
+	static void _file_read_done(void *p_self, Error p_error, uint64_t p_read_length);
+	Error _wait_file_read(const Ref<FileAccessAsyncRead> &p_read);
+
+	// Larger files are read as needed instead of holding a second copy of them in memory.
+	static constexpr uint64_t ASYNC_READ_MAX_SIZE = 16 * 1024 * 1024;
 
 	uint64_t importmd_ofs = 0;
 
@@ -34,11 +34,13 @@
 #include "core/core_bind.h"
 #include "core/io/dir_access.h"
 #include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
 #include "core/io/resource_importer.h"
 #include "core/object/script_language.h"
 #include "core/os/condition_variable.h"
 #include "core/os/os.h"
 #include "core/os/safe_binary_mutex.h"
+#include "core/profiling/alloc_profiler.h"
 #include "core/string/print_string.h"
 #include "core/string/translation_server.h"
 #include "core/templates/rb_set.h"
@@ -361,6 +363,7 @@ Ref<Resource> ResourceLoader::_load(const String &p_path, const String &p_origin
 // This implementation must allow re-entrancy for a task that started awaiting in a deeper stack frame.
 // The load task token must be manually re-referenced before this is called, which includes threaded runs.
 void ResourceLoader::_run_load_task(void *p_userdata) {
+	ALLOC_PROFILE_SCOPE("ResourceLoader");
 	ThreadLoadTask &load_task = *(ThreadLoadTask *)p_userdata;
 
 	{
@@ -392,8 +395,19 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	bool xl_remapped = false;
 	const String &remapped_path = _path_remap(load_task.local_path, &xl_remapped);
 
+	LocalVector<Ref<LoadToken>> prefetch_tokens;
+	if (load_task.prefetch_dependency_graph) {
+		_prefetch_dependency_graph(load_task.local_path, ResourceFormatLoader::CACHE_MODE_REUSE, prefetch_tokens);
+	}
+
 	Error load_err = OK;
 	Ref<Resource> res = _load(remapped_path, remapped_path != load_task.local_path ? load_task.local_path : String(), load_task.type_hint, load_task.cache_mode, &load_err, load_task.use_sub_threads, &load_task.progress);
+
+	// Await the prefetched loads, so this task gathers their resource changed connections, then let them go.
+	for (Ref<LoadToken> &token : prefetch_tokens) {
+		_load_complete(*token.ptr(), nullptr);
+	}
+	prefetch_tokens.clear();
 	if (MessageQueue::get_singleton() != MessageQueue::get_main_singleton()) {
 		MessageQueue::get_singleton()->flush();
 	}
@@ -502,6 +516,139 @@ void ResourceLoader::_run_load_task(void *p_userdata) {
 	curr_load_task = curr_load_task_backup;
 }
 
+void ResourceLoader::_scan_dependencies_task(void *p_userdata) {
+	DependencyScan &scan = *(DependencyScan *)p_userdata;
+
+	List<String> dependencies;
+	get_dependencies(scan.path, &dependencies, true);
+	for (const String &dependency : dependencies) {
+		// Format is "path_or_uid::type::fallback_path", the last two being optional.
+		Vector<String> parts = dependency.split("::");
+		String path = parts[0];
+		if (path.begins_with("uid://")) {
+			ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(path);
+			if (uid != ResourceUID::INVALID_ID && ResourceUID::get_singleton()->has_id(uid)) {
+				path = ResourceUID::get_singleton()->get_id_path(uid);
+			} else if (parts.size() > 2) {
+				path = parts[2];
+			} else {
+				continue; // Let the actual load report it.
+			}
+		}
+
+		path = _validate_local_path(path);
+		if (!path.is_empty()) {
+			scan.dependencies.push_back(Pair<String, String>(path, parts.size() > 1 ? parts[1] : String()));
+		}
+	}
+}
+
+void ResourceLoader::_prefetch_dependency_graph(const String &p_path, ResourceFormatLoader::CacheMode p_cache_mode, LocalVector<Ref<LoadToken>> &r_tokens) {
+	// Discover the whole graph breadth-first, scanning each level in parallel.
+	// Otherwise, dependencies are only found once their dependents start loading, one level at a time.
+	HashMap<String, uint32_t> node_indices;
+	LocalVector<Pair<String, String>> nodes;
+	LocalVector<LocalVector<uint32_t>> edges;
+	node_indices[p_path] = 0;
+	nodes.push_back(Pair<String, String>(p_path, String()));
+	edges.resize(1);
+
+	LocalVector<uint32_t> frontier;
+	frontier.push_back(0);
+	while (!frontier.is_empty()) {
+		LocalVector<DependencyScan> scans;
+		scans.resize(frontier.size());
+		for (uint32_t i = 0; i < frontier.size(); i++) {
+			scans[i].path = nodes[frontier[i]].first;
+		}
+
+		LocalVector<WorkerThreadPool::TaskID> scan_tasks;
+		for (uint32_t i = 1; i < scans.size(); i++) {
+			scan_tasks.push_back(WorkerThreadPool::get_singleton()->add_native_task(&ResourceLoader::_scan_dependencies_task, &scans[i], false, "Scan resource dependencies"));
+		}
+		_scan_dependencies_task(&scans[0]);
+		if (!scan_tasks.is_empty()) {
+			PREPARE_FOR_WTP_WAIT
+			for (WorkerThreadPool::TaskID task_id : scan_tasks) {
+				WorkerThreadPool::get_singleton()->wait_for_task_completion(task_id);
+			}
+			RESTORE_AFTER_WTP_WAIT
+		}
+
+		LocalVector<uint32_t> next_frontier;
+		for (uint32_t i = 0; i < scans.size(); i++) {
+			for (const Pair<String, String> &dependency : scans[i].dependencies) {
+				if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE && ResourceCache::has(dependency.first)) {
+					continue; // Already loaded, and so are its own dependencies.
+				}
+
+				HashMap<String, uint32_t>::Iterator E = node_indices.find(dependency.first);
+				uint32_t index;
+				if (E) {
+					index = E->value;
+				} else {
+					index = nodes.size();
+					node_indices.insert(dependency.first, index);
+					nodes.push_back(dependency);
+					edges.resize(nodes.size());
+					next_frontier.push_back(index);
+				}
+				edges[frontier[i]].push_back(index);
+			}
+		}
+		frontier = next_frontier;
+	}
+
+	// Order the graph leaves first (post-order). Cycles are broken arbitrarily, the loaders handle them on their own.
+	enum : uint8_t {
+		NODE_UNVISITED,
+		NODE_VISITING,
+		NODE_DONE,
+	};
+	LocalVector<uint8_t> state;
+	state.resize_initialized(nodes.size());
+	LocalVector<uint32_t> post_order;
+	post_order.reserve(nodes.size());
+	LocalVector<Pair<uint32_t, uint32_t>> stack; // Node and next edge to follow.
+	stack.push_back(Pair<uint32_t, uint32_t>(0, 0));
+	state[0] = NODE_VISITING;
+	while (!stack.is_empty()) {
+		Pair<uint32_t, uint32_t> &top = stack[stack.size() - 1];
+		if (top.second < edges[top.first].size()) {
+			uint32_t child = edges[top.first][top.second++];
+			if (state[child] == NODE_UNVISITED) {
+				state[child] = NODE_VISITING;
+				stack.push_back(Pair<uint32_t, uint32_t>(child, 0));
+			}
+			continue;
+		}
+		state[top.first] = NODE_DONE;
+		post_order.push_back(top.first);
+		stack.remove_at(stack.size() - 1);
+	}
+
+	// Read-ahead of the pack data goes leaves first, which is the order the data will be consumed in.
+	PackedData *packed_data = PackedData::get_singleton();
+	if (packed_data && !packed_data->is_disabled()) {
+		for (uint32_t node : post_order) {
+			packed_data->prefetch_path(import_remap(_path_remap(nodes[node].first)));
+		}
+	}
+
+	// Load tasks are created dependents first instead, since the WorkerThreadPool doesn't let a task await an older one.
+	// Every dependency is queued by the time its dependents ask for it, so they just attach to it.
+	for (int64_t i = (int64_t)post_order.size() - 1; i >= 0; i--) {
+		uint32_t node = post_order[i];
+		if (node == 0) {
+			continue; // The root is loaded by the caller.
+		}
+		Ref<LoadToken> token = _load_start(nodes[node].first, nodes[node].second, LOAD_THREAD_DISTRIBUTE, p_cache_mode);
+		if (token.is_valid()) {
+			r_tokens.push_back(token);
+		}
+	}
+}
+
 String ResourceLoader::_validate_local_path(const String &p_path) {
 	ResourceUID::ID uid = ResourceUID::get_singleton()->text_to_id(p_path);
 	if (uid != ResourceUID::INVALID_ID) {
@@ -514,7 +661,11 @@ String ResourceLoader::_validate_local_path(const String &p_path) {
 }
 
 Error ResourceLoader::load_threaded_request(const String &p_path, const String &p_type_hint, bool p_use_sub_threads, ResourceFormatLoader::CacheMode p_cache_mode) {
-	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, p_use_sub_threads ? LOAD_THREAD_DISTRIBUTE : LOAD_THREAD_SPAWN_SINGLE, p_cache_mode, true);
+	LoadThreadMode thread_mode = LOAD_THREAD_SPAWN_SINGLE;
+	if (p_use_sub_threads) {
+		thread_mode = GLOBAL_GET_CACHED(bool, "threading/resource_loader/prefetch_dependency_graph") ? LOAD_THREAD_DISTRIBUTE_DEPENDENCY_GRAPH : LOAD_THREAD_DISTRIBUTE;
+	}
+	Ref<ResourceLoader::LoadToken> token = _load_start(p_path, p_type_hint, thread_mode, p_cache_mode, true);
 	return token.is_valid() ? OK : FAILED;
 }
 
@@ -612,7 +763,9 @@ Ref<ResourceLoader::LoadToken> ResourceLoader::_load_start(const String &p_path,
 			load_task.local_path = local_path;
 			load_task.type_hint = p_type_hint;
 			load_task.cache_mode = p_cache_mode;
-			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE;
+			load_task.use_sub_threads = p_thread_mode == LOAD_THREAD_DISTRIBUTE || p_thread_mode == LOAD_THREAD_DISTRIBUTE_DEPENDENCY_GRAPH;
+			// Deep cache modes load every dependency privately, so there's nothing to share ahead of time.
+			load_task.prefetch_dependency_graph = p_thread_mode == LOAD_THREAD_DISTRIBUTE_DEPENDENCY_GRAPH && p_cache_mode != ResourceFormatLoader::CACHE_MODE_IGNORE_DEEP && p_cache_mode != ResourceFormatLoader::CACHE_MODE_REPLACE_DEEP;
 			if (p_cache_mode == ResourceFormatLoader::CACHE_MODE_REUSE) {
 				Ref<Resource> existing = ResourceCache::get_ref(local_path);
 				if (existing.is_valid()) {
@@ -780,6 +933,12 @@ Ref<Resource> ResourceLoader::_load_complete(LoadToken &p_load_token, Error *r_e
 	return _load_complete_inner(p_load_token, r_error, thread_load_lock);
 }
 
+void ResourceLoader::_load_yield() {
+	PREPARE_FOR_WTP_WAIT
+	WorkerThreadPool::get_singleton()->yield();
+	RESTORE_AFTER_WTP_WAIT
+}
+
 void ResourceLoader::set_is_import_thread(bool p_import_thread) {
 	import_thread = p_import_thread;
 }
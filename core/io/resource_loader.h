@@ -124,6 +124,7 @@ public:
 		LOAD_THREAD_FROM_CURRENT,
 		LOAD_THREAD_SPAWN_SINGLE,
 		LOAD_THREAD_DISTRIBUTE,
+		LOAD_THREAD_DISTRIBUTE_DEPENDENCY_GRAPH, // Like LOAD_THREAD_DISTRIBUTE, but the whole dependency graph is discovered and scheduled up front.
 	};
 
 	struct LoadToken : public RefCounted {
@@ -141,6 +142,8 @@ public:
 
 	static Ref<LoadToken> _load_start(const String &p_path, const String &p_type_hint, LoadThreadMode p_thread_mode, ResourceFormatLoader::CacheMode p_cache_mode, bool p_for_user = false);
 	static Ref<Resource> _load_complete(LoadToken &p_load_token, Error *r_error);
+	// Lets the WorkerThreadPool run other tasks on the thread of the calling load task, until WorkerThreadPool::notify_yield_over() is called for it.
+	static void _load_yield();
 
 private:
 	static LoadToken *_load_threaded_request_reuse_user_token(const String &p_path);
@@ -191,6 +194,7 @@ private:
 		Error error = OK;
 		Ref<Resource> resource;
 		bool use_sub_threads = false;
+		bool prefetch_dependency_graph = false;
 		HashSet<String> sub_tasks;
 
 		struct ResourceChangedConnection {
@@ -203,6 +207,13 @@ private:
 
 	static void _run_load_task(void *p_userdata);
 
+	struct DependencyScan {
+		String path;
+		LocalVector<Pair<String, String>> dependencies; // Local path and type hint.
+	};
+	static void _scan_dependencies_task(void *p_userdata);
+	static void _prefetch_dependency_graph(const String &p_path, ResourceFormatLoader::CacheMode p_cache_mode, LocalVector<Ref<LoadToken>> &r_tokens);
+
 	static thread_local bool import_thread;
 	static thread_local int load_nesting;
 	static thread_local HashMap<int, HashMap<String, Ref<Resource>>> res_ref_overrides; // Outermost key is nesting level.
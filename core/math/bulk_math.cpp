@@ -0,0 +1,490 @@
+/**************************************************************************/
+/*  bulk_math.cpp                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "bulk_math.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BULK_MATH_SSE2
+#include <emmintrin.h>
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+// AVX2 isn't part of the baseline instruction sets, its kernels are compiled separately and picked at runtime.
+#define BULK_MATH_AVX2
+#if defined(__GNUC__) || defined(__clang__)
+#define BULK_MATH_AVX2_FUNC __attribute__((target("avx2")))
+#else
+#define BULK_MATH_AVX2_FUNC
+#endif
+#elif (defined(__ARM_NEON) && defined(__aarch64__)) || defined(_M_ARM64)
+#define BULK_MATH_NEON
+#include <arm_neon.h>
+#endif
+
+#if defined(BULK_MATH_SSE2) || defined(BULK_MATH_NEON)
+#define BULK_MATH_SIMD
+#endif
+
+static_assert(sizeof(Vector3) == sizeof(real_t) * 3, "Vector3 arrays must be tightly packed.");
+
+#ifdef BULK_MATH_AVX2
+static bool _detect_avx2() {
+#ifdef _MSC_VER
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7) {
+		return false;
+	}
+	// AVX and OSXSAVE, then check that the OS preserves YMM registers.
+	__cpuid(info, 1);
+	const int avx_osxsave = (1 << 27) | (1 << 28);
+	if ((info[2] & avx_osxsave) != avx_osxsave || (_xgetbv(0) & 0x6) != 0x6) {
+		return false;
+	}
+	__cpuidex(info, 7, 0);
+	return info[1] & (1 << 5);
+#else
+	__builtin_cpu_init();
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+#endif
+
+bool BulkMath::has_avx2() {
+#ifdef BULK_MATH_AVX2
+	static const bool avx2 = _detect_avx2();
+	return avx2;
+#else
+	return false;
+#endif
+}
+
+// Four-wide operations shared by the SSE2 and NEON kernels.
+
+#if defined(BULK_MATH_SSE2)
+typedef __m128 Float4;
+
+static _FORCE_INLINE_ Float4 f4_load(const float *p_src) { return _mm_loadu_ps(p_src); }
+static _FORCE_INLINE_ void f4_store(float *p_dst, Float4 p_v) { _mm_storeu_ps(p_dst, p_v); }
+static _FORCE_INLINE_ Float4 f4_set(float p_v) { return _mm_set1_ps(p_v); }
+static _FORCE_INLINE_ Float4 f4_add(Float4 p_a, Float4 p_b) { return _mm_add_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_sub(Float4 p_a, Float4 p_b) { return _mm_sub_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_mul(Float4 p_a, Float4 p_b) { return _mm_mul_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_min(Float4 p_a, Float4 p_b) { return _mm_min_ps(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_max(Float4 p_a, Float4 p_b) { return _mm_max_ps(p_a, p_b); }
+
+#define F4_SHUFFLE(m_a, m_b, m_i0, m_i1, m_i2, m_i3) _mm_shuffle_ps(m_a, m_b, _MM_SHUFFLE(m_i3, m_i2, m_i1, m_i0))
+
+// Loads four Vector3 as separate x, y and z lanes.
+static _FORCE_INLINE_ void f4_load3(const float *p_src, Float4 &r_x, Float4 &r_y, Float4 &r_z) {
+	const Float4 a0 = _mm_loadu_ps(p_src); // x0 y0 z0 x1
+	const Float4 a1 = _mm_loadu_ps(p_src + 4); // y1 z1 x2 y2
+	const Float4 a2 = _mm_loadu_ps(p_src + 8); // z2 x3 y3 z3
+	r_x = F4_SHUFFLE(a0, F4_SHUFFLE(a1, a2, 2, 2, 1, 1), 0, 3, 0, 2);
+	r_y = F4_SHUFFLE(F4_SHUFFLE(a0, a1, 1, 1, 0, 0), F4_SHUFFLE(a1, a2, 3, 3, 2, 2), 0, 2, 0, 2);
+	r_z = F4_SHUFFLE(F4_SHUFFLE(a0, a1, 2, 2, 1, 1), F4_SHUFFLE(a2, a2, 0, 0, 3, 3), 0, 2, 0, 2);
+}
+
+static _FORCE_INLINE_ void f4_store3(float *p_dst, Float4 p_x, Float4 p_y, Float4 p_z) {
+	_mm_storeu_ps(p_dst, F4_SHUFFLE(F4_SHUFFLE(p_x, p_y, 0, 0, 0, 0), F4_SHUFFLE(p_z, p_x, 0, 0, 1, 1), 0, 2, 0, 2));
+	_mm_storeu_ps(p_dst + 4, F4_SHUFFLE(F4_SHUFFLE(p_y, p_z, 1, 1, 1, 1), F4_SHUFFLE(p_x, p_y, 2, 2, 2, 2), 0, 2, 0, 2));
+	_mm_storeu_ps(p_dst + 8, F4_SHUFFLE(F4_SHUFFLE(p_z, p_x, 2, 2, 3, 3), F4_SHUFFLE(p_y, p_z, 3, 3, 3, 3), 0, 2, 0, 2));
+}
+
+#undef F4_SHUFFLE
+
+// Adds four floats to a sum kept as doubles.
+static _FORCE_INLINE_ void f4_sum_to_double(const float *p_src, int64_t p_count, int64_t &r_index, double &r_sum) {
+	__m128d acc0 = _mm_setzero_pd();
+	__m128d acc1 = _mm_setzero_pd();
+	for (; r_index + 4 <= p_count; r_index += 4) {
+		const __m128 v = _mm_loadu_ps(p_src + r_index);
+		acc0 = _mm_add_pd(acc0, _mm_cvtps_pd(v));
+		acc1 = _mm_add_pd(acc1, _mm_cvtps_pd(_mm_movehl_ps(v, v)));
+	}
+	double lanes[2];
+	_mm_storeu_pd(lanes, _mm_add_pd(acc0, acc1));
+	r_sum += lanes[0] + lanes[1];
+}
+
+#elif defined(BULK_MATH_NEON)
+typedef float32x4_t Float4;
+
+static _FORCE_INLINE_ Float4 f4_load(const float *p_src) { return vld1q_f32(p_src); }
+static _FORCE_INLINE_ void f4_store(float *p_dst, Float4 p_v) { vst1q_f32(p_dst, p_v); }
+static _FORCE_INLINE_ Float4 f4_set(float p_v) { return vdupq_n_f32(p_v); }
+static _FORCE_INLINE_ Float4 f4_add(Float4 p_a, Float4 p_b) { return vaddq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_sub(Float4 p_a, Float4 p_b) { return vsubq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_mul(Float4 p_a, Float4 p_b) { return vmulq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_min(Float4 p_a, Float4 p_b) { return vminq_f32(p_a, p_b); }
+static _FORCE_INLINE_ Float4 f4_max(Float4 p_a, Float4 p_b) { return vmaxq_f32(p_a, p_b); }
+
+static _FORCE_INLINE_ void f4_load3(const float *p_src, Float4 &r_x, Float4 &r_y, Float4 &r_z) {
+	const float32x4x3_t v = vld3q_f32(p_src);
+	r_x = v.val[0];
+	r_y = v.val[1];
+	r_z = v.val[2];
+}
+
+static _FORCE_INLINE_ void f4_store3(float *p_dst, Float4 p_x, Float4 p_y, Float4 p_z) {
+	float32x4x3_t v;
+	v.val[0] = p_x;
+	v.val[1] = p_y;
+	v.val[2] = p_z;
+	vst3q_f32(p_dst, v);
+}
+
+static _FORCE_INLINE_ void f4_sum_to_double(const float *p_src, int64_t p_count, int64_t &r_index, double &r_sum) {
+	float64x2_t acc0 = vdupq_n_f64(0.0);
+	float64x2_t acc1 = vdupq_n_f64(0.0);
+	for (; r_index + 4 <= p_count; r_index += 4) {
+		const float32x4_t v = vld1q_f32(p_src + r_index);
+		acc0 = vaddq_f64(acc0, vcvt_f64_f32(vget_low_f32(v)));
+		acc1 = vaddq_f64(acc1, vcvt_high_f64_f32(v));
+	}
+	r_sum += vaddvq_f64(vaddq_f64(acc0, acc1));
+}
+#endif
+
+#ifdef BULK_MATH_SIMD
+static _FORCE_INLINE_ float f4_reduce_min(Float4 p_v) {
+	float lanes[4];
+	f4_store(lanes, p_v);
+	return MIN(MIN(lanes[0], lanes[1]), MIN(lanes[2], lanes[3]));
+}
+
+static _FORCE_INLINE_ float f4_reduce_max(Float4 p_v) {
+	float lanes[4];
+	f4_store(lanes, p_v);
+	return MAX(MAX(lanes[0], lanes[1]), MAX(lanes[2], lanes[3]));
+}
+#endif
+
+// AVX2 kernels. Each processes as many elements as it can in blocks of eight and returns where it stopped.
+
+#ifdef BULK_MATH_AVX2
+static BULK_MATH_AVX2_FUNC int64_t _sum_avx2(const float *p_src, int64_t p_count, double &r_sum) {
+	__m256d acc0 = _mm256_setzero_pd();
+	__m256d acc1 = _mm256_setzero_pd();
+	int64_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		const __m256 v = _mm256_loadu_ps(p_src + i);
+		acc0 = _mm256_add_pd(acc0, _mm256_cvtps_pd(_mm256_castps256_ps128(v)));
+		acc1 = _mm256_add_pd(acc1, _mm256_cvtps_pd(_mm256_extractf128_ps(v, 1)));
+	}
+	double lanes[4];
+	_mm256_storeu_pd(lanes, _mm256_add_pd(acc0, acc1));
+	r_sum += (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+	return i;
+}
+
+static BULK_MATH_AVX2_FUNC int64_t _min_max_avx2(const float *p_src, int64_t p_count, bool p_max, float &r_result) {
+	if (p_count < 8) {
+		return 0;
+	}
+	__m256 acc = _mm256_loadu_ps(p_src);
+	int64_t i = 8;
+	for (; i + 8 <= p_count; i += 8) {
+		const __m256 v = _mm256_loadu_ps(p_src + i);
+		acc = p_max ? _mm256_max_ps(acc, v) : _mm256_min_ps(acc, v);
+	}
+	float lanes[8];
+	_mm256_storeu_ps(lanes, acc);
+	for (int j = 0; j < 8; j++) {
+		r_result = p_max ? MAX(r_result, lanes[j]) : MIN(r_result, lanes[j]);
+	}
+	return i;
+}
+
+static BULK_MATH_AVX2_FUNC int64_t _add_avx2(float *p_dst, const float *p_src, int64_t p_count) {
+	int64_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		_mm256_storeu_ps(p_dst + i, _mm256_add_ps(_mm256_loadu_ps(p_dst + i), _mm256_loadu_ps(p_src + i)));
+	}
+	return i;
+}
+
+static BULK_MATH_AVX2_FUNC int64_t _fma_avx2(float *p_dst, float p_mul, float p_add, int64_t p_count) {
+	const __m256 mul = _mm256_set1_ps(p_mul);
+	const __m256 add = _mm256_set1_ps(p_add);
+	int64_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		_mm256_storeu_ps(p_dst + i, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(p_dst + i), mul), add));
+	}
+	return i;
+}
+
+static BULK_MATH_AVX2_FUNC int64_t _mul_scalar_avx2(float *p_dst, float p_scalar, int64_t p_count) {
+	const __m256 scalar = _mm256_set1_ps(p_scalar);
+	int64_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		_mm256_storeu_ps(p_dst + i, _mm256_mul_ps(_mm256_loadu_ps(p_dst + i), scalar));
+	}
+	return i;
+}
+
+static BULK_MATH_AVX2_FUNC int64_t _lerp_avx2(float *p_dst, const float *p_to, float p_weight, int64_t p_count) {
+	const __m256 weight = _mm256_set1_ps(p_weight);
+	int64_t i = 0;
+	for (; i + 8 <= p_count; i += 8) {
+		const __m256 from = _mm256_loadu_ps(p_dst + i);
+		const __m256 to = _mm256_loadu_ps(p_to + i);
+		_mm256_storeu_ps(p_dst + i, _mm256_add_ps(from, _mm256_mul_ps(_mm256_sub_ps(to, from), weight)));
+	}
+	return i;
+}
+#endif
+
+double BulkMath::sum(const float *p_src, int64_t p_count) {
+	double result = 0.0;
+	int64_t i = 0;
+#ifdef BULK_MATH_AVX2
+	if (has_avx2()) {
+		i = _sum_avx2(p_src, p_count, result);
+	}
+#endif
+#ifdef BULK_MATH_SIMD
+	f4_sum_to_double(p_src, p_count, i, result);
+#endif
+	for (; i < p_count; i++) {
+		result += p_src[i];
+	}
+	return result;
+}
+
+float BulkMath::min(const float *p_src, int64_t p_count) {
+	if (p_count <= 0) {
+		return 0.0f;
+	}
+	float result = p_src[0];
+	int64_t i = 0;
+#ifdef BULK_MATH_AVX2
+	if (has_avx2()) {
+		i = _min_max_avx2(p_src, p_count, false, result);
+	}
+#endif
+#ifdef BULK_MATH_SIMD
+	if (i + 4 <= p_count) {
+		Float4 acc = f4_load(p_src + i);
+		for (i += 4; i + 4 <= p_count; i += 4) {
+			acc = f4_min(acc, f4_load(p_src + i));
+		}
+		result = MIN(result, f4_reduce_min(acc));
+	}
+#endif
+	for (; i < p_count; i++) {
+		result = MIN(result, p_src[i]);
+	}
+	return result;
+}
+
+float BulkMath::max(const float *p_src, int64_t p_count) {
+	if (p_count <= 0) {
+		return 0.0f;
+	}
+	float result = p_src[0];
+	int64_t i = 0;
+#ifdef BULK_MATH_AVX2
+	if (has_avx2()) {
+		i = _min_max_avx2(p_src, p_count, true, result);
+	}
+#endif
+#ifdef BULK_MATH_SIMD
+	if (i + 4 <= p_count) {
+		Float4 acc = f4_load(p_src + i);
+		for (i += 4; i + 4 <= p_count; i += 4) {
+			acc = f4_max(acc, f4_load(p_src + i));
+		}
+		result = MAX(result, f4_reduce_max(acc));
+	}
+#endif
+	for (; i < p_count; i++) {
+		result = MAX(result, p_src[i]);
+	}
+	return result;
+}
+
+void BulkMath::add(float *p_dst, const float *p_src, int64_t p_count) {
+	int64_t i = 0;
+#ifdef BULK_MATH_AVX2
+	if (has_avx2()) {
+		i = _add_avx2(p_dst, p_src, p_count);
+	}
+#endif
+#ifdef BULK_MATH_SIMD
+	for (; i + 4 <= p_count; i += 4) {
+		f4_store(p_dst + i, f4_add(f4_load(p_dst + i), f4_load(p_src + i)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] += p_src[i];
+	}
+}
+
+void BulkMath::mul_scalar(float *p_dst, float p_scalar, int64_t p_count) {
+	int64_t i = 0;
+#ifdef BULK_MATH_AVX2
+	if (has_avx2()) {
+		i = _mul_scalar_avx2(p_dst, p_scalar, p_count);
+	}
+#endif
+#ifdef BULK_MATH_SIMD
+	const Float4 scalar = f4_set(p_scalar);
+	for (; i + 4 <= p_count; i += 4) {
+		f4_store(p_dst + i, f4_mul(f4_load(p_dst + i), scalar));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] *= p_scalar;
+	}
+}
+
+void BulkMath::fma(float *p_dst, float p_mul, float p_add, int64_t p_count) {
+	int64_t i = 0;
+#ifdef BULK_MATH_AVX2
+	if (has_avx2()) {
+		i = _fma_avx2(p_dst, p_mul, p_add, p_count);
+	}
+#endif
+#ifdef BULK_MATH_SIMD
+	const Float4 mul = f4_set(p_mul);
+	const Float4 add = f4_set(p_add);
+	for (; i + 4 <= p_count; i += 4) {
+		f4_store(p_dst + i, f4_add(f4_mul(f4_load(p_dst + i), mul), add));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_dst[i] * p_mul + p_add;
+	}
+}
+
+void BulkMath::lerp(float *p_dst, const float *p_to, float p_weight, int64_t p_count) {
+	int64_t i = 0;
+#ifdef BULK_MATH_AVX2
+	if (has_avx2()) {
+		i = _lerp_avx2(p_dst, p_to, p_weight, p_count);
+	}
+#endif
+#ifdef BULK_MATH_SIMD
+	const Float4 weight = f4_set(p_weight);
+	for (; i + 4 <= p_count; i += 4) {
+		const Float4 from = f4_load(p_dst + i);
+		f4_store(p_dst + i, f4_add(from, f4_mul(f4_sub(f4_load(p_to + i), from), weight)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = Math::lerp(p_dst[i], p_to[i], p_weight);
+	}
+}
+
+// Vector3 arrays are processed as flat float arrays when possible, which isn't the case with double precision.
+
+void BulkMath::vector3_add(Vector3 *p_dst, const Vector3 *p_src, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		p_dst[i] += p_src[i];
+	}
+#else
+	add((float *)p_dst, (const float *)p_src, p_count * 3);
+#endif
+}
+
+void BulkMath::vector3_mul_scalar(Vector3 *p_dst, real_t p_scalar, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		p_dst[i] *= p_scalar;
+	}
+#else
+	mul_scalar((float *)p_dst, p_scalar, p_count * 3);
+#endif
+}
+
+void BulkMath::vector3_lerp(Vector3 *p_dst, const Vector3 *p_to, real_t p_weight, int64_t p_count) {
+#ifdef REAL_T_IS_DOUBLE
+	for (int64_t i = 0; i < p_count; i++) {
+		p_dst[i] = p_dst[i].lerp(p_to[i], p_weight);
+	}
+#else
+	lerp((float *)p_dst, (const float *)p_to, p_weight, p_count * 3);
+#endif
+}
+
+void BulkMath::vector3_transform(Vector3 *p_dst, const Transform3D &p_transform, int64_t p_count) {
+	int64_t i = 0;
+#if defined(BULK_MATH_SIMD) && !defined(REAL_T_IS_DOUBLE)
+	const Basis &basis = p_transform.basis;
+	const Float4 r00 = f4_set(basis[0][0]), r01 = f4_set(basis[0][1]), r02 = f4_set(basis[0][2]);
+	const Float4 r10 = f4_set(basis[1][0]), r11 = f4_set(basis[1][1]), r12 = f4_set(basis[1][2]);
+	const Float4 r20 = f4_set(basis[2][0]), r21 = f4_set(basis[2][1]), r22 = f4_set(basis[2][2]);
+	const Float4 ox = f4_set(p_transform.origin.x), oy = f4_set(p_transform.origin.y), oz = f4_set(p_transform.origin.z);
+	for (; i + 4 <= p_count; i += 4) {
+		float *ptr = (float *)(p_dst + i);
+		Float4 x, y, z;
+		f4_load3(ptr, x, y, z);
+		const Float4 tx = f4_add(f4_add(f4_add(f4_mul(x, r00), f4_mul(y, r01)), f4_mul(z, r02)), ox);
+		const Float4 ty = f4_add(f4_add(f4_add(f4_mul(x, r10), f4_mul(y, r11)), f4_mul(z, r12)), oy);
+		const Float4 tz = f4_add(f4_add(f4_add(f4_mul(x, r20), f4_mul(y, r21)), f4_mul(z, r22)), oz);
+		f4_store3(ptr, tx, ty, tz);
+	}
+#endif
+	for (; i < p_count; i++) {
+		p_dst[i] = p_transform.xform(p_dst[i]);
+	}
+}
+
+void BulkMath::vector3_dot(float *r_dst, const Vector3 *p_a, const Vector3 *p_b, int64_t p_count) {
+	int64_t i = 0;
+#if defined(BULK_MATH_SIMD) && !defined(REAL_T_IS_DOUBLE)
+	for (; i + 4 <= p_count; i += 4) {
+		Float4 ax, ay, az, bx, by, bz;
+		f4_load3((const float *)(p_a + i), ax, ay, az);
+		f4_load3((const float *)(p_b + i), bx, by, bz);
+		f4_store(r_dst + i, f4_add(f4_add(f4_mul(ax, bx), f4_mul(ay, by)), f4_mul(az, bz)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_a[i].dot(p_b[i]);
+	}
+}
+
+void BulkMath::vector3_length_squared(float *r_dst, const Vector3 *p_src, int64_t p_count) {
+	int64_t i = 0;
+#if defined(BULK_MATH_SIMD) && !defined(REAL_T_IS_DOUBLE)
+	for (; i + 4 <= p_count; i += 4) {
+		Float4 x, y, z;
+		f4_load3((const float *)(p_src + i), x, y, z);
+		f4_store(r_dst + i, f4_add(f4_add(f4_mul(x, x), f4_mul(y, y)), f4_mul(z, z)));
+	}
+#endif
+	for (; i < p_count; i++) {
+		r_dst[i] = p_src[i].length_squared();
+	}
+}
@@ -0,0 +1,60 @@
+/**************************************************************************/
+/*  bulk_math.h                                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/transform_3d.h"
+#include "core/math/vector3.h"
+
+// Math on whole arrays at once, used by the bulk methods of packed arrays.
+// Kernels use SSE2 or NEON when available, and AVX2 when the CPU supports it.
+// Results may differ from doing the same operations one element at a time in the
+// last bits, as sums are accumulated in several lanes.
+class BulkMath {
+public:
+	static bool has_avx2();
+
+	static double sum(const float *p_src, int64_t p_count);
+	static float min(const float *p_src, int64_t p_count);
+	static float max(const float *p_src, int64_t p_count);
+
+	// Element-wise, `p_dst` is updated in place.
+	static void add(float *p_dst, const float *p_src, int64_t p_count);
+	static void mul_scalar(float *p_dst, float p_scalar, int64_t p_count);
+	static void fma(float *p_dst, float p_mul, float p_add, int64_t p_count);
+	static void lerp(float *p_dst, const float *p_to, float p_weight, int64_t p_count);
+
+	static void vector3_add(Vector3 *p_dst, const Vector3 *p_src, int64_t p_count);
+	static void vector3_mul_scalar(Vector3 *p_dst, real_t p_scalar, int64_t p_count);
+	static void vector3_lerp(Vector3 *p_dst, const Vector3 *p_to, real_t p_weight, int64_t p_count);
+	static void vector3_transform(Vector3 *p_dst, const Transform3D &p_transform, int64_t p_count);
+	static void vector3_dot(float *r_dst, const Vector3 *p_a, const Vector3 *p_b, int64_t p_count);
+	static void vector3_length_squared(float *r_dst, const Vector3 *p_src, int64_t p_count);
+};
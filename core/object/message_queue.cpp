@@ -33,6 +33,8 @@
 #include "core/config/project_settings.h"
 #include "core/object/class_db.h"
 #include "core/object/script_language.h"
+#include "core/os/os.h"
+#include "core/variant/variant_internal.h"
 
 #include <cstdio>
 
@@ -58,6 +60,33 @@
 		mutex.unlock();                           \
 	}
 
+// Guards the thread queues of the main MessageQueue. Not a member, as threads may exit after it's gone.
+static BinaryMutex thread_queues_mutex;
+
+struct ThreadCallQueueOwner {
+	uint32_t generation = 0;
+	uint32_t index = 0;
+	CallQueue *queue = nullptr;
+
+	// Lets another thread reuse the queue, its pending messages are still flushed.
+	~ThreadCallQueueOwner() {
+		if (queue) {
+			MutexLock lock(thread_queues_mutex);
+			MessageQueue *message_queue = static_cast<MessageQueue *>(MessageQueue::main_singleton);
+			if (message_queue && generation == MessageQueue::generation) {
+				message_queue->thread_queues[index].in_use = false;
+			}
+		}
+	}
+};
+
+static thread_local ThreadCallQueueOwner thread_call_queue;
+
+#define REDIRECT_TO_THREAD_QUEUE(m_push)                                                               \
+	if (this == MessageQueue::main_singleton && !Thread::is_main_thread()) {                           \
+		return static_cast<MessageQueue *>(MessageQueue::main_singleton)->_get_thread_queue()->m_push; \
+	}
+
 void CallQueue::_add_page() {
 	if (pages_used == page_bytes.size()) {
 		pages.push_back(allocator->alloc());
@@ -67,6 +96,36 @@ void CallQueue::_add_page() {
 	pages_used++;
 }
 
+// Messages of the main queue are numbered in the order they are pushed. Messages of other queues take the
+// number of the last message of the main queue, so merged flushes run them after it and before the next one.
+// Only the main queue's own counter is shared, and only the main thread writes it.
+uint64_t CallQueue::_next_sequence() {
+	if (this == MessageQueue::main_singleton) {
+		// Pushes to the main queue hold its mutex, a plain store is enough.
+		const uint64_t next = sequence.get() + 1;
+		sequence.set(next);
+		return next;
+	}
+
+	const uint64_t main_sequence = MessageQueue::main_singleton ? MessageQueue::main_singleton->sequence.get() : 0;
+	sequence.set(main_sequence);
+	return main_sequence;
+}
+
+// Whether the value of the last set can be replaced without another message seeing the previous one.
+// Must be called with the mutex locked.
+bool CallQueue::_can_replace_last_set() const {
+	if (flushing || !last_set) {
+		return false;
+	}
+	if (this == MessageQueue::main_singleton) {
+		// Messages of other threads pushed since then run between the set and the next message of this queue.
+		return !static_cast<const MessageQueue *>(this)->_thread_queues_pushed_since(last_set->sequence);
+	}
+	// Messages of the main queue pushed since then run after the set.
+	return !MessageQueue::main_singleton || MessageQueue::main_singleton->sequence.get() == last_set->sequence;
+}
+
 Error CallQueue::push_callp(ObjectID p_id, const StringName &p_method, const Variant **p_args, int p_argcount, bool p_show_error) {
 	return push_callablep(Callable(p_id, p_method), p_args, p_argcount, p_show_error);
 }
@@ -83,7 +142,42 @@ Error CallQueue::push_set(Object *p_object, const StringName &p_prop, const Vari
 	return push_set(p_object->get_instance_id(), p_prop, p_value);
 }
 
+uint32_t CallQueue::_get_message_size(const Message *p_message) {
+	if ((p_message->type & FLAG_MASK) == TYPE_NOTIFICATION) {
+		return sizeof(Message);
+	}
+	return sizeof(Message) + sizeof(Variant) * p_message->args;
+}
+
+// Resolved when the message runs, on the flushing thread, so the pushing thread doesn't touch the object.
+MethodBind *CallQueue::_get_direct_call_method(Object *p_object, const Callable &p_callable, const Variant *p_args, int p_argcount) {
+	// Scripts take precedence over native methods.
+	if (!p_object || p_callable.is_custom() || p_object->get_script_instance()) {
+		return nullptr;
+	}
+
+	MethodBind *method = ClassDB::get_method(p_object->get_class_name(), p_callable.get_method());
+	if (!method || method->is_vararg() || method->get_argument_count() != p_argcount) {
+		return nullptr;
+	}
+
+	// Arguments must be usable without conversion. Objects, arrays and dictionaries may need a class or element type check.
+	for (int i = 0; i < p_argcount; i++) {
+		const Variant::Type type = method->get_argument_type(i);
+		if (type == Variant::NIL) {
+			continue; // Takes any Variant.
+		}
+		if (type != p_args[i].get_type() || type == Variant::OBJECT || type == Variant::ARRAY || type == Variant::DICTIONARY) {
+			return nullptr;
+		}
+	}
+
+	return method;
+}
+
 Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_args, int p_argcount, bool p_show_error) {
+	REDIRECT_TO_THREAD_QUEUE(push_callablep(p_callable, p_args, p_argcount, p_show_error));
+
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant) * p_argcount;
 
 	ERR_FAIL_COND_V_MSG(room_needed > uint32_t(PAGE_SIZE_BYTES), ERR_INVALID_PARAMETER, "Message is too large to fit on a page (" + itos(PAGE_SIZE_BYTES) + " bytes), consider passing less arguments.");
@@ -107,6 +201,7 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
 
 	Message *msg = memnew_placement(buffer_end, Message);
+	msg->sequence = _next_sequence();
 	msg->args = p_argcount;
 	msg->callable = p_callable;
 	msg->type = TYPE_CALL;
@@ -128,13 +223,27 @@ Error CallQueue::push_callablep(const Callable &p_callable, const Variant **p_ar
 
 	page_bytes[pages_used - 1] += room_needed;
 
+	last_set = nullptr;
+
 	UNLOCK_MUTEX;
 
 	return OK;
 }
 
 Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant &p_value) {
+	REDIRECT_TO_THREAD_QUEUE(push_set(p_id, p_prop, p_value));
+
 	LOCK_MUTEX;
+
+	// Coalesce with the previous message if it sets the same property and nothing was pushed since, in any queue,
+	// so no other message can observe the previous value.
+	// Messages pushed while flushing aren't tracked, as the one being replaced may be running.
+	if (_can_replace_last_set() && last_set->callable.get_object_id() == p_id && last_set->callable.get_method() == p_prop) {
+		*(Variant *)(last_set + 1) = p_value;
+		UNLOCK_MUTEX;
+		return OK;
+	}
+
 	uint32_t room_needed = sizeof(Message) + sizeof(Variant);
 
 	_ensure_first_page();
@@ -158,6 +267,7 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
 
 	Message *msg = memnew_placement(buffer_end, Message);
+	msg->sequence = _next_sequence();
 	msg->args = 1;
 	msg->callable = Callable(p_id, p_prop);
 	msg->type = TYPE_SET;
@@ -168,6 +278,9 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 	*v = p_value;
 
 	page_bytes[pages_used - 1] += room_needed;
+
+	last_set = flushing ? nullptr : msg;
+
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -175,6 +288,8 @@ Error CallQueue::push_set(ObjectID p_id, const StringName &p_prop, const Variant
 
 Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	ERR_FAIL_COND_V(p_notification < 0, ERR_INVALID_PARAMETER);
+	REDIRECT_TO_THREAD_QUEUE(push_notification(p_id, p_notification));
+
 	LOCK_MUTEX;
 	uint32_t room_needed = sizeof(Message);
 
@@ -194,6 +309,7 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	uint8_t *buffer_end = &page->data[page_bytes[pages_used - 1]];
 
 	Message *msg = memnew_placement(buffer_end, Message);
+	msg->sequence = _next_sequence();
 
 	msg->type = TYPE_NOTIFICATION;
 	msg->callable = Callable(p_id, CoreStringName(notification)); //name is meaningless but callable needs it
@@ -201,6 +317,9 @@ Error CallQueue::push_notification(ObjectID p_id, int p_notification) {
 	msg->notification = p_notification;
 
 	page_bytes[pages_used - 1] += room_needed;
+
+	last_set = nullptr;
+
 	UNLOCK_MUTEX;
 
 	return OK;
@@ -223,7 +342,95 @@ void CallQueue::_call_function(const Callable &p_callable, const Variant *p_args
 	}
 }
 
+void CallQueue::_call_method_bind(Object *p_object, MethodBind *p_method, const Variant *p_args, int p_argcount) {
+	const Variant **argptrs = nullptr;
+	if (p_argcount) {
+		argptrs = (const Variant **)alloca(sizeof(Variant *) * p_argcount);
+		for (int i = 0; i < p_argcount; i++) {
+			argptrs[i] = &p_args[i];
+		}
+	}
+
+	Variant ret;
+	if (p_method->has_return()) {
+		VariantInternal::initialize(&ret, p_method->get_argument_type(-1));
+	}
+	p_method->validated_call(p_object, argptrs, &ret);
+}
+
 Error CallQueue::flush() {
+	if (this != MessageQueue::main_singleton) {
+		uint64_t flushed = 0;
+		return _flush(flushed);
+	}
+
+	MessageQueue *message_queue = static_cast<MessageQueue *>(this);
+	if (message_queue->merging) {
+		return ERR_BUSY;
+	}
+
+	const uint64_t begin_usec = OS::get_singleton()->get_ticks_usec();
+	uint64_t flushed = 0;
+
+	Error err = message_queue->_flush_merged(flushed);
+
+	MessageQueue::flushed_calls.add(flushed);
+	MessageQueue::flush_usec.add(OS::get_singleton()->get_ticks_usec() - begin_usec);
+	return err;
+}
+
+void CallQueue::_run_message(Message *p_message) {
+	Object *target = p_message->callable.get_object();
+
+	switch (p_message->type & FLAG_MASK) {
+		case TYPE_CALL: {
+			if (target || (p_message->type & FLAG_NULL_IS_OK)) {
+				Variant *args = (Variant *)(p_message + 1);
+				MethodBind *method = _get_direct_call_method(target, p_message->callable, args, p_message->args);
+				if (method) {
+					_call_method_bind(target, method, args, p_message->args);
+				} else {
+					_call_function(p_message->callable, args, p_message->args, p_message->type & FLAG_SHOW_ERROR);
+				}
+			}
+		} break;
+		case TYPE_NOTIFICATION: {
+			if (target) {
+				target->notification(p_message->notification);
+			}
+		} break;
+		case TYPE_SET: {
+			if (target) {
+				Variant *arg = (Variant *)(p_message + 1);
+				target->set(p_message->callable.get_method(), *arg);
+			}
+		} break;
+	}
+
+	if ((p_message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
+		Variant *args = (Variant *)(p_message + 1);
+		for (int k = 0; k < p_message->args; k++) {
+			args[k].~Variant();
+		}
+	}
+
+	p_message->~Message();
+}
+
+// Next message to run from the given position, moving to the next page when the current one is done.
+// Must be called with the mutex locked.
+CallQueue::Message *CallQueue::_get_flush_message(uint32_t &r_page, uint32_t &r_offset) {
+	while (r_page + 1 < pages_used && r_offset == page_bytes[r_page]) {
+		r_page++;
+		r_offset = 0;
+	}
+	if (r_page < pages_used && r_offset < page_bytes[r_page]) {
+		return (Message *)&pages[r_page]->data[r_offset];
+	}
+	return nullptr;
+}
+
+Error CallQueue::_flush(uint64_t &r_flushed) {
 	LOCK_MUTEX;
 
 	if (pages.is_empty()) {
@@ -238,6 +445,7 @@ Error CallQueue::flush() {
 	}
 
 	flushing = true;
+	last_set = nullptr;
 
 	uint32_t i = 0;
 	uint32_t offset = 0;
@@ -249,46 +457,13 @@ Error CallQueue::flush() {
 
 		Message *message = (Message *)&page->data[offset];
 
-		uint32_t advance = sizeof(Message);
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			advance += sizeof(Variant) * message->args;
-		}
-
 		//pre-advance so this function is reentrant
-		offset += advance;
-
-		Object *target = message->callable.get_object();
+		offset += _get_message_size(message);
+		r_flushed++;
 
 		UNLOCK_MUTEX;
 
-		switch (message->type & FLAG_MASK) {
-			case TYPE_CALL: {
-				if (target || (message->type & FLAG_NULL_IS_OK)) {
-					Variant *args = (Variant *)(message + 1);
-					_call_function(message->callable, args, message->args, message->type & FLAG_SHOW_ERROR);
-				}
-			} break;
-			case TYPE_NOTIFICATION: {
-				if (target) {
-					target->notification(message->notification);
-				}
-			} break;
-			case TYPE_SET: {
-				if (target) {
-					Variant *arg = (Variant *)(message + 1);
-					target->set(message->callable.get_method(), *arg);
-				}
-			} break;
-		}
-
-		if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-			Variant *args = (Variant *)(message + 1);
-			for (int k = 0; k < message->args; k++) {
-				args[k].~Variant();
-			}
-		}
-
-		message->~Message();
+		_run_message(message);
 
 		LOCK_MUTEX;
 		if (offset == page_bytes[i]) {
@@ -322,10 +497,7 @@ void CallQueue::clear() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+			uint32_t advance = _get_message_size(message);
 
 			offset += advance;
 
@@ -342,6 +514,7 @@ void CallQueue::clear() {
 
 	pages_used = 1;
 	page_bytes[0] = 0;
+	last_set = nullptr;
 
 	UNLOCK_MUTEX;
 }
@@ -362,10 +535,7 @@ void CallQueue::statistics() {
 
 			Message *message = (Message *)&page->data[offset];
 
-			uint32_t advance = sizeof(Message);
-			if ((message->type & FLAG_MASK) != TYPE_NOTIFICATION) {
-				advance += sizeof(Variant) * message->args;
-			}
+			uint32_t advance = _get_message_size(message);
 
 			Object *target = message->callable.get_object();
 
@@ -442,10 +612,22 @@ void CallQueue::statistics() {
 }
 
 bool CallQueue::is_flushing() const {
+	if (this == MessageQueue::main_singleton) {
+		return static_cast<const MessageQueue *>(this)->merging;
+	}
 	return flushing;
 }
 
 bool CallQueue::has_messages() const {
+	if (this == MessageQueue::main_singleton) {
+		MutexLock lock(thread_queues_mutex);
+		for (const MessageQueue::ThreadQueue &thread_queue : static_cast<const MessageQueue *>(this)->thread_queues) {
+			if (thread_queue.queue->has_messages()) {
+				return true;
+			}
+		}
+	}
+
 	if (pages_used == 0) {
 		return false;
 	}
@@ -457,7 +639,14 @@ bool CallQueue::has_messages() const {
 }
 
 int CallQueue::get_max_buffer_usage() const {
-	return pages.size() * PAGE_SIZE_BYTES;
+	int usage = pages.size() * PAGE_SIZE_BYTES;
+	if (this == MessageQueue::main_singleton) {
+		MutexLock lock(thread_queues_mutex);
+		for (const MessageQueue::ThreadQueue &thread_queue : static_cast<const MessageQueue *>(this)->thread_queues) {
+			usage += thread_queue.queue->get_max_buffer_usage();
+		}
+	}
+	return usage;
 }
 
 CallQueue::CallQueue(Allocator *p_custom_allocator, uint32_t p_max_pages, const String &p_error_text) {
@@ -489,6 +678,145 @@ CallQueue::~CallQueue() {
 CallQueue *MessageQueue::main_singleton = nullptr;
 thread_local CallQueue *MessageQueue::thread_singleton = nullptr;
 
+static uint64_t total_flushed_calls = 0;
+static uint64_t total_flush_usec = 0;
+static MessageQueue::FlushStats frame_flush_stats;
+
+CallQueue *MessageQueue::_get_thread_queue() {
+	if (likely(thread_call_queue.queue && thread_call_queue.generation == generation)) {
+		return thread_call_queue.queue;
+	}
+
+	MutexLock lock(thread_queues_mutex);
+
+	uint32_t index = 0;
+	while (index < thread_queues.size() && thread_queues[index].in_use) {
+		index++;
+	}
+	if (index == thread_queues.size()) {
+		ThreadQueue thread_queue;
+		thread_queue.queue = memnew(CallQueue(allocator, max_pages, error_text));
+		thread_queues.push_back(thread_queue);
+		thread_queue_count.set(thread_queues.size());
+	}
+	thread_queues[index].in_use = true;
+
+	thread_call_queue.generation = generation;
+	thread_call_queue.index = index;
+	thread_call_queue.queue = thread_queues[index].queue;
+	return thread_call_queue.queue;
+}
+
+bool MessageQueue::_thread_queues_pushed_since(uint64_t p_sequence) const {
+	MutexLock lock(thread_queues_mutex);
+	for (const ThreadQueue &thread_queue : thread_queues) {
+		if (thread_queue.queue->sequence.get() >= p_sequence) {
+			return true;
+		}
+	}
+	return false;
+}
+
+Error MessageQueue::_flush_merged(uint64_t &r_flushed) {
+	// Position of the flush in each queue, starting with this one.
+	// Queues are only freed with the MessageQueue, they can be read without holding `thread_queues_mutex`.
+	struct Cursor {
+		CallQueue *queue = nullptr;
+		uint32_t page = 0;
+		uint32_t offset = 0;
+		Message *message = nullptr; // Next message, once known. It can't change until it runs.
+	};
+	LocalVector<Cursor> cursors;
+	cursors.push_back({ this });
+	uint32_t known_thread_queues = 0;
+
+	merging = true;
+
+	while (true) {
+		if (thread_queue_count.get() != known_thread_queues) {
+			MutexLock lock(thread_queues_mutex);
+			for (uint32_t i = known_thread_queues; i < thread_queues.size(); i++) {
+				cursors.push_back({ thread_queues[i].queue });
+			}
+			known_thread_queues = thread_queues.size();
+		}
+
+		// Messages of thread queues run after the main queue message they were pushed after, and before
+		// the next one, so that messages pushed from another thread after one from the main thread run
+		// after it. Each queue keeps its own order. New messages, including those pushed while running,
+		// go in the same flush.
+		Cursor *next = nullptr;
+		uint64_t next_order = 0;
+		for (Cursor &cursor : cursors) {
+			if (!cursor.message) {
+				MutexLock lock(cursor.queue->mutex);
+				cursor.message = cursor.queue->_get_flush_message(cursor.page, cursor.offset);
+				if (cursor.message && !cursor.queue->flushing) {
+					cursor.queue->flushing = true;
+					cursor.queue->last_set = nullptr;
+				}
+			}
+			if (!cursor.message) {
+				continue;
+			}
+			// Main queue message `n` sorts as `2n`, thread queue messages pushed after it as `2n + 1`.
+			const uint64_t order = cursor.message->sequence * 2 + (cursor.queue == this ? 0 : 1);
+			if (!next || order < next_order) {
+				next = &cursor;
+				next_order = order;
+			}
+		}
+
+		if (next) {
+			Message *message = next->message;
+			next->message = nullptr;
+			{
+				MutexLock lock(next->queue->mutex);
+				next->offset += _get_message_size(message);
+			}
+			r_flushed++;
+			next->queue->_run_message(message);
+			continue;
+		}
+
+		// Done, unless something was pushed since the queues were checked.
+		bool empty = true;
+		for (Cursor &cursor : cursors) {
+			MutexLock lock(cursor.queue->mutex);
+			if (cursor.queue->_get_flush_message(cursor.page, cursor.offset)) {
+				empty = false;
+				continue;
+			}
+			if (!cursor.queue->pages.is_empty()) {
+				cursor.queue->page_bytes[0] = 0;
+				cursor.queue->pages_used = 1;
+			}
+			cursor.page = 0;
+			cursor.offset = 0;
+			cursor.queue->flushing = false;
+		}
+		if (empty) {
+			break;
+		}
+	}
+
+	merging = false;
+	return OK;
+}
+
+MessageQueue::FlushStats MessageQueue::get_frame_flush_stats() {
+	return frame_flush_stats;
+}
+
+void MessageQueue::update_frame_stats() {
+	const uint64_t calls = flushed_calls.get();
+	const uint64_t usec = flush_usec.get();
+	frame_flush_stats.calls = calls - total_flushed_calls;
+	frame_flush_stats.usec = usec - total_flush_usec;
+	total_flushed_calls = calls;
+	total_flush_usec = usec;
+}
+
 void MessageQueue::set_thread_singleton_override(CallQueue *p_thread_singleton) {
 #ifdef DEV_ENABLED
 	if (thread_singleton) {
@@ -512,5 +840,12 @@ MessageQueue::MessageQueue() :
 }
 
 MessageQueue::~MessageQueue() {
+	MutexLock lock(thread_queues_mutex);
+	for (const ThreadQueue &thread_queue : thread_queues) {
+		memdelete(thread_queue.queue);
+	}
+	thread_queues.clear();
+	// Invalidates the queues still referenced by threads.
+	generation++;
 	main_singleton = nullptr;
 }
@@ -32,10 +32,12 @@
 
 #include "core/object/object_id.h"
 #include "core/os/thread_safe.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/local_vector.h"
 #include "core/templates/paged_allocator.h"
 #include "core/variant/variant.h"
 
+class MethodBind;
 class Object;
 
 class CallQueue {
@@ -82,6 +84,7 @@ private:
 
 	struct Message {
 		Callable callable;
+		uint64_t sequence; // See `_next_sequence()`.
 		int16_t type;
 		union {
 			int16_t notification;
@@ -89,6 +92,16 @@ private:
 		};
 	};
 
+	// Last message pushed, when it's a set. Setting the same property again right after replaces its value.
+	Message *last_set = nullptr;
+
+	// For the main queue, the number of the last message pushed. For others, the number of the last message
+	// of the main queue when they last got one. Only written by the thread pushing to this queue.
+	SafeNumeric<uint64_t> sequence;
+
+	uint64_t _next_sequence();
+	bool _can_replace_last_set() const;
+
 	_FORCE_INLINE_ void _ensure_first_page() {
 		if (unlikely(pages.is_empty())) {
 			pages.push_back(allocator->alloc());
@@ -99,7 +112,14 @@ private:
 
 	void _add_page();
 
+	static uint32_t _get_message_size(const Message *p_message);
+	static MethodBind *_get_direct_call_method(Object *p_object, const Callable &p_callable, const Variant *p_args, int p_argcount);
+
 	void _call_function(const Callable &p_callable, const Variant *p_args, int p_argcount, bool p_show_error);
+	void _call_method_bind(Object *p_object, MethodBind *p_method, const Variant *p_args, int p_argcount);
+	void _run_message(Message *p_message);
+	Message *_get_flush_message(uint32_t &r_page, uint32_t &r_offset);
+	Error _flush(uint64_t &r_flushed);
 
 	String error_text;
 
@@ -160,13 +180,42 @@ class MessageQueue : public CallQueue {
 	static CallQueue *main_singleton;
 	static thread_local CallQueue *thread_singleton;
 	friend class CallQueue;
+	friend struct ThreadCallQueueOwner;
+
+	// Messages pushed to the main queue from other threads go to a queue owned by that thread,
+	// so threads don't contend with each other. They are flushed along with the main queue,
+	// each one after the main queue message that was last pushed before it.
+	struct ThreadQueue {
+		CallQueue *queue = nullptr;
+		bool in_use = false;
+	};
+	LocalVector<ThreadQueue> thread_queues;
+	SafeNumeric<uint32_t> thread_queue_count;
+	bool merging = false;
+	static inline uint32_t generation = 0;
+
+	static inline SafeNumeric<uint64_t> flushed_calls{ 0 };
+	static inline SafeNumeric<uint64_t> flush_usec{ 0 };
+
+	CallQueue *_get_thread_queue();
+	bool _thread_queues_pushed_since(uint64_t p_sequence) const;
+	Error _flush_merged(uint64_t &r_flushed);
 
 public:
+	struct FlushStats {
+		uint64_t calls = 0;
+		uint64_t usec = 0;
+	};
+
 	_FORCE_INLINE_ static CallQueue *get_singleton() { return thread_singleton ? thread_singleton : main_singleton; }
 	_FORCE_INLINE_ static CallQueue *get_main_singleton() { return main_singleton; }
 
 	static void set_thread_singleton_override(CallQueue *p_thread_singleton);
 
+	// Messages flushed from the main queue and time spent flushing it during the last frame.
+	static FlushStats get_frame_flush_stats();
+	static void update_frame_stats();
+
 	MessageQueue();
 	~MessageQueue();
 };
@@ -1138,3 +1138,22 @@ public:
 	static void debug_objects(DebugFunc p_func, void *p_user_data);
 	static int get_object_count();
 };
+
+#ifdef DEBUG_ENABLED
+// Keeps the object from being freed while one of its methods runs. Taken by `Object::callp()`,
+// and by anything else calling methods directly, like GDScript inline caches.
+struct _ObjectDebugLock {
+	ObjectID obj_id;
+
+	_ObjectDebugLock(Object *p_obj) {
+		obj_id = p_obj->get_instance_id();
+		p_obj->_lock_index.ref();
+	}
+	~_ObjectDebugLock() {
+		Object *obj_ptr = ObjectDB::get_instance(obj_id);
+		if (likely(obj_ptr)) {
+			obj_ptr->_lock_index.unref();
+		}
+	}
+};
+#endif // DEBUG_ENABLED
@@ -154,8 +154,7 @@ void WorkerThreadPool::_process_task(Task *p_task) {
 		// Let awaiters know.
 		for (uint32_t i = 0; i < threads.size(); i++) {
 			if (threads[i].awaited_task == p_task) {
-				threads[i].cond_var.notify_one();
-				threads[i].signaled = true;
+				_wake_thread(threads[i]);
 			}
 		}
 	}
@@ -186,8 +185,10 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 	Thread::set_name(vformat("WorkerThread %d", thread_data->index));
 
 	while (true) {
-		Task *task_to_process = nullptr;
-		{
+		// Fast path: queued tasks can be taken without locking.
+		Task *task_to_process = thread_data->pool->_try_take_task(thread_data);
+
+		if (!task_to_process) {
 			// Create the lock outside the inner loop so it isn't needlessly unlocked and relocked
 			//  when no task was found to process, and the loop is re-entered.
 			MutexLock lock(thread_data->pool->task_mutex);
@@ -198,19 +199,19 @@ void WorkerThreadPool::_thread_function(void *p_user) {
 					return;
 				}
 
-				thread_data->signaled = false;
-
-				if (!thread_data->pool->task_queue.first()) {
-					// There wasn't a task available yet.
-					// Let's wait for the next notification, then recheck.
-					thread_data->cond_var.wait(lock);
-					continue;
+				if (thread_data->pool->pump_task_queue.first()) {
+					// Got a task to process! Remove it from the queue, then break into the task handling section.
+					task_to_process = thread_data->pool->pump_task_queue.first()->self();
+					thread_data->pool->pump_task_queue.remove(thread_data->pool->pump_task_queue.first());
+					break;
 				}
 
-				// Got a task to process! Remove it from the queue, then break into the task handling section.
-				task_to_process = thread_data->pool->task_queue.first()->self();
-				thread_data->pool->task_queue.remove(thread_data->pool->task_queue.first());
-				break;
+				// There wasn't a task available yet.
+				// Let's wait for the next notification, then recheck. Tasks queued meanwhile are taken right away.
+				task_to_process = thread_data->pool->_sleep(thread_data, lock, ThreadData::SLEEPING);
+				if (task_to_process) {
+					break;
+				}
 			}
 		}
 
@@ -241,13 +242,19 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 
 	uint32_t to_process = 0;
 	uint32_t to_promote = 0;
+	uint32_t to_queue = 0;
 
 	ThreadData *caller_pool_thread = thread_ids.has(Thread::get_caller_id()) ? &threads[thread_ids[Thread::get_caller_id()]] : nullptr;
 
 	for (uint32_t i = 0; i < p_count; i++) {
 		p_tasks[i]->low_priority = !p_high_priority;
 		if (p_high_priority || low_priority_threads_used < max_low_priority_threads) {
-			task_queue.add_last(&p_tasks[i]->task_elem);
+			if (p_pump_task) {
+				pump_task_queue.add_last(&p_tasks[i]->task_elem);
+			} else {
+				// Since the low-priority budget is used up in order, these are always the first ones.
+				to_queue++;
+			}
 			if (!p_high_priority) {
 				low_priority_threads_used++;
 			}
@@ -259,7 +266,31 @@ void WorkerThreadPool::_post_tasks(Task **p_tasks, uint32_t p_count, bool p_high
 		}
 	}
 
-	_notify_threads(caller_pool_thread, to_process, to_promote);
+	// Promoting looks at what threads are running, so that needs task_mutex.
+	if (to_promote) {
+		_notify_threads(caller_pool_thread, 0, to_promote);
+	}
+
+	// Everything else is queued and notified without it, so posters don't contend with
+	// each other nor with threads looking for work.
+	p_lock.temp_unlock();
+
+	// High-priority work posted from within the pool (nested tasks, group tasks spawned
+	// by tasks) stays local to the posting thread. It will most likely be waited for
+	// by it, and idle threads can steal from it anyway.
+	bool use_local_queue = caller_pool_thread && p_high_priority && !p_pump_task;
+
+	for (uint32_t i = 0; i < to_queue; i++) {
+		if (!use_local_queue || !caller_pool_thread->local_queue.push(p_tasks[i])) {
+			_push_injected_task(p_tasks[i]);
+		}
+	}
+
+	if (to_process) {
+		_notify_threads(caller_pool_thread, to_process, 0);
+	}
+
+	p_lock.temp_relock();
 }
 
 void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count) {
@@ -267,70 +298,89 @@ void WorkerThreadPool::_notify_threads(const ThreadData *p_current_thread_data,
 	uint32_t to_promote = p_promote_count;
 
 	// This is where which threads are awaken is decided according to the workload.
-	// Threads that will anyway have a chance to check the situation and process/promote tasks
-	// are excluded from being notified. Others will be tried anyway to try to distribute load.
-	// The current thread, if is a pool thread, is also excluded depending on the promoting/processing
-	// needs because it will anyway loop again. However, it will contribute to decreasing the count,
-	// which helps reducing sync traffic.
+	// Only sleeping threads are woken up, and the current thread, if is a pool thread, is excluded
+	// because it will anyway loop again. Others will be tried anyway to try to distribute load.
+	// Waking up threads for processing doesn't need task_mutex, since they look at the queues once more
+	// after announcing they go to sleep. Promoting does, since it looks at what they are running.
+
+	// Pairs with the fence in _sleep(): either the tasks just queued are seen there, or the sleeping thread here.
+	std::atomic_thread_fence(std::memory_order_seq_cst);
 
 	uint32_t thread_count = threads.size();
+	uint32_t start = notify_index.postincrement();
 
 	// First round:
-	// 1. For processing: notify threads that are not running tasks, to keep the stacks as shallow as possible.
-	// 2. For promoting: since it's exclusive with processing, we fin threads able to promote low-prio tasks now.
-	for (uint32_t i = 0;
-			i < thread_count && (to_process || to_promote);
-			i++, notify_index = (notify_index + 1) % thread_count) {
-		ThreadData &th = threads[notify_index];
-
-		if (th.signaled) {
+	// 1. For processing: wake up threads that are not running tasks, to keep the stacks as shallow as possible.
+	// 2. For promoting: since it's exclusive with processing, we find threads able to promote low-prio tasks now.
+	for (uint32_t i = 0; i < thread_count && (to_process || to_promote); i++) {
+		ThreadData &th = threads[(start + i) % thread_count];
+		if (&th == p_current_thread_data) {
 			continue;
 		}
-		if (th.current_task) {
-			// Good thread for promoting low-prio?
-			if (to_promote && th.awaited_task && th.current_task->low_priority) {
-				if (likely(&th != p_current_thread_data)) {
-					th.cond_var.notify_one();
-				}
-				th.signaled = true;
+
+		if (to_promote && th.current_task && th.awaited_task && th.current_task->low_priority) {
+			// Good thread for promoting low-prio.
+			if (_wake_thread(th)) {
 				to_promote--;
 			}
-		} else {
-			if (to_process) {
-				if (likely(&th != p_current_thread_data)) {
-					th.cond_var.notify_one();
-				}
-				th.signaled = true;
-				to_process--;
-			}
+		} else if (to_process && _wake_thread(th, true)) {
+			to_process--;
 		}
 	}
 
 	// Second round:
 	// For processing: if the first round wasn't enough, let's try now with threads processing tasks but currently awaiting.
-	for (uint32_t i = 0;
-			i < thread_count && to_process;
-			i++, notify_index = (notify_index + 1) % thread_count) {
-		ThreadData &th = threads[notify_index];
-
-		if (th.signaled) {
-			continue;
-		}
-		if (th.awaited_task) {
-			if (likely(&th != p_current_thread_data)) {
-				th.cond_var.notify_one();
-			}
-			th.signaled = true;
+	for (uint32_t i = 0; i < thread_count && to_process; i++) {
+		ThreadData &th = threads[(start + i) % thread_count];
+		if (&th != p_current_thread_data && _wake_thread(th)) {
 			to_process--;
 		}
 	}
 }
 
+// Returns whether the thread was asleep, in which case it's now up to the caller to have something for it.
+bool WorkerThreadPool::_wake_thread(ThreadData &p_thread_data, bool p_only_idle) {
+	uint32_t state = p_thread_data.sleep_state.load();
+	while (state != ThreadData::AWAKE && (!p_only_idle || state == ThreadData::SLEEPING)) {
+		if (p_thread_data.sleep_state.compare_exchange_weak(state, ThreadData::AWAKE)) {
+			p_thread_data.wake_semaphore.post();
+			return true;
+		}
+	}
+	return false;
+}
+
+// Must be called with task_mutex held, once nothing it protects has work for the thread.
+// Whatever changes that afterwards wakes the thread up. Tasks queued without the lock are
+// looked for once more after announcing the sleep, so those can't be missed either; if one
+// is found, the thread doesn't sleep and the task is returned.
+WorkerThreadPool::Task *WorkerThreadPool::_sleep(ThreadData *p_thread_data, MutexLock<BinaryMutex> &p_lock, uint32_t p_sleep_state) {
+	p_thread_data->sleep_state.store(p_sleep_state);
+	// Pairs with the fence in _notify_threads().
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	p_lock.temp_unlock();
+
+	Task *task = _try_take_task(p_thread_data);
+	uint32_t state = p_sleep_state;
+	if (!task || !p_thread_data->sleep_state.compare_exchange_strong(state, ThreadData::AWAKE)) {
+		// Either there's nothing to do or someone is already waking this thread up, whose post must be consumed.
+		p_thread_data->wake_semaphore.wait();
+	}
+
+	p_lock.temp_relock();
+	return task;
+}
+
 bool WorkerThreadPool::_try_promote_low_priority_task() {
 	if (low_priority_task_queue.first()) {
 		Task *low_prio_task = low_priority_task_queue.first()->self();
 		low_priority_task_queue.remove(low_priority_task_queue.first());
-		task_queue.add_last(&low_prio_task->task_elem);
+		if (low_prio_task->is_pump_task) {
+			pump_task_queue.add_last(&low_prio_task->task_elem);
+		} else {
+			_push_injected_task(low_prio_task);
+		}
 		low_priority_threads_used++;
 		return true;
 	} else {
@@ -338,6 +388,84 @@ bool WorkerThreadPool::_try_promote_low_priority_task() {
 	}
 }
 
+void WorkerThreadPool::_push_injected_task(Task *p_task) {
+	InjectionQueue &queue = injection_queues[injection_index.postincrement() % INJECTION_QUEUE_COUNT];
+	MutexLock lock(queue.mutex);
+	queue.tasks.add_last(&p_task->task_elem);
+	queue.size.fetch_add(1);
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_try_take_injected_task(const ThreadData *p_thread_data) {
+	for (uint32_t i = 0; i < INJECTION_QUEUE_COUNT; i++) {
+		InjectionQueue &queue = injection_queues[(p_thread_data->index + i) % INJECTION_QUEUE_COUNT];
+		if (queue.size.load() == 0) {
+			continue;
+		}
+		MutexLock lock(queue.mutex);
+		SelfList<Task> *first = queue.tasks.first();
+		if (first) {
+			queue.tasks.remove(first);
+			queue.size.fetch_sub(1);
+			return first->self();
+		}
+	}
+	return nullptr;
+}
+
+WorkerThreadPool::Task *WorkerThreadPool::_try_steal_task(const ThreadData *p_thief) {
+	uint32_t thread_count = threads.size();
+	uint32_t start = p_thief ? p_thief->index + 1 : 0;
+	for (uint32_t i = 0; i < thread_count; i++) {
+		ThreadData &victim = threads[(start + i) % thread_count];
+		if (&victim == p_thief) {
+			continue;
+		}
+		Task *task = nullptr;
+		// A steal can fail spuriously when racing other thieves or the owner, so retry while there seems to be work.
+		while (!victim.local_queue.is_empty()) {
+			if (victim.local_queue.steal(task)) {
+				return task;
+			}
+		}
+	}
+	return nullptr;
+}
+
+// Doesn't need task_mutex. Pump tasks and low-priority ones not promoted yet are not considered.
+WorkerThreadPool::Task *WorkerThreadPool::_try_take_task(ThreadData *p_thread_data) {
+	if (unlikely(p_thread_data->exited_languages)) {
+		// Tasks can't run anymore without scripting languages.
+		return nullptr;
+	}
+
+	// Own local tasks first, since they are the most likely to be awaited by this thread.
+	Task *task = nullptr;
+	if (p_thread_data->local_queue.pop(task)) {
+		return task;
+	}
+
+	task = _try_take_injected_task(p_thread_data);
+	if (!task) {
+		// Nothing injected; try to take work queued locally by other pool threads.
+		task = _try_steal_task(p_thread_data);
+	}
+	return task;
+}
+
+bool WorkerThreadPool::_has_queued_tasks() const {
+	for (const InjectionQueue &queue : injection_queues) {
+		if (queue.size.load()) {
+			return true;
+		}
+	}
+	for (const ThreadData &th : threads) {
+		if (!th.local_queue.is_empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
 WorkerThreadPool::TaskID WorkerThreadPool::add_native_task(void (*p_func)(void *), void *p_userdata, bool p_high_priority, const String &p_description) {
 	return _add_task(Callable(), p_func, p_userdata, nullptr, p_high_priority, p_description);
 }
@@ -486,15 +614,13 @@ void WorkerThreadPool::_unlock_unlockable_mutexes() {
 void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, Task *p_task) {
 	// Keep processing tasks until the condition to stop waiting is met.
 
+	bool was_woken = false;
 	while (true) {
 		Task *task_to_process = nullptr;
 		bool relock_unlockables = false;
 		{
 			MutexLock lock(task_mutex);
 
-			bool was_signaled = p_caller_pool_thread->signaled;
-			p_caller_pool_thread->signaled = false;
-
 			bool exit = _handle_runlevel(p_caller_pool_thread, lock);
 			if (unlikely(exit)) {
 				break;
@@ -513,14 +639,12 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 			}
 
 			if (wait_is_over) {
-				if (was_signaled) {
-					// This thread was awaken for some additional reason, but it's about to exit.
+				if (was_woken) {
+					// This thread may have been awaken for some additional reason, but it's about to exit.
 					// Let's find out what may be pending and forward the requests.
-					uint32_t to_process = task_queue.first() ? 1 : 0;
+					uint32_t to_process = (pump_task_queue.first() || _has_queued_tasks()) ? 1 : 0;
 					uint32_t to_promote = p_caller_pool_thread->current_task->low_priority && low_priority_task_queue.first() ? 1 : 0;
 					if (to_process || to_promote) {
-						// This thread must be left alone since it won't loop again.
-						p_caller_pool_thread->signaled = true;
 						_notify_threads(p_caller_pool_thread, to_process, to_promote);
 					}
 				}
@@ -534,13 +658,16 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 			}
 
-			if (p_caller_pool_thread->pool->task_queue.first()) {
-				task_to_process = task_queue.first()->self();
-				if ((p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) && task_to_process->is_pump_task) {
-					task_to_process = nullptr;
+			// Own local tasks first, since the awaited one is likely among them, then injected and stolen ones.
+			// None of these need the lock, but it's held anyway for the checks above.
+			task_to_process = _try_take_task(p_caller_pool_thread);
+
+			if (!task_to_process && pump_task_queue.first()) {
+				if (p_task == ThreadData::YIELDING || p_caller_pool_thread->has_pump_task == true) {
 					_notify_threads(p_caller_pool_thread, 1, 0);
 				} else {
-					task_queue.remove(task_queue.first());
+					task_to_process = pump_task_queue.first()->self();
+					pump_task_queue.remove(pump_task_queue.first());
 				}
 			}
 
@@ -552,7 +679,8 @@ void WorkerThreadPool::_wait_collaboratively(ThreadData *p_caller_pool_thread, T
 				}
 				relock_unlockables = true;
 
-				p_caller_pool_thread->cond_var.wait(lock);
+				task_to_process = _sleep(p_caller_pool_thread, lock, ThreadData::AWAITING);
+				was_woken = !task_to_process;
 
 				p_caller_pool_thread->awaited_task = nullptr;
 			}
@@ -573,8 +701,7 @@ void WorkerThreadPool::_switch_runlevel(Runlevel p_runlevel) {
 	runlevel = p_runlevel;
 	memset(&runlevel_data, 0, sizeof(runlevel_data));
 	for (uint32_t i = 0; i < threads.size(); i++) {
-		threads[i].cond_var.notify_one();
-		threads[i].signaled = true;
+		_wake_thread(threads[i]);
 	}
 	control_cond_var.notify_all();
 }
@@ -587,7 +714,7 @@ bool WorkerThreadPool::_handle_runlevel(ThreadData *p_thread_data, MutexLock<Bin
 		} break;
 		case RUNLEVEL_PRE_EXIT_LANGUAGES: {
 			if (!p_thread_data->pre_exited_languages) {
-				if (!task_queue.first() && !low_priority_task_queue.first()) {
+				if (!pump_task_queue.first() && !low_priority_task_queue.first() && !_has_queued_tasks()) {
 					p_thread_data->pre_exited_languages = true;
 					runlevel_data.pre_exit_languages.num_idle_threads++;
 					control_cond_var.notify_all();
@@ -646,8 +773,7 @@ void WorkerThreadPool::notify_yield_over(TaskID p_task_id) {
 
 	ThreadData &td = threads[task->pool_thread_index];
 	td.yield_is_over = true;
-	td.signaled = true;
-	td.cond_var.notify_one();
+	_wake_thread(td);
 }
 
 WorkerThreadPool::GroupID WorkerThreadPool::_add_group_task(const Callable &p_callable, void (*p_func)(void *, uint32_t), void *p_userdata, BaseTemplateUserdata *p_template_userdata, int p_elements, int p_tasks, bool p_high_priority, const String &p_description) {
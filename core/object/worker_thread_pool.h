@@ -40,6 +40,7 @@
 #include "core/templates/rid.h"
 #include "core/templates/safe_refcount.h"
 #include "core/templates/self_list.h"
+#include "core/templates/work_stealing_queue.h"
 
 class WorkerThreadPool : public Object {
 	GDCLASS(WorkerThreadPool, Object)
@@ -104,31 +105,56 @@ private:
 	PagedAllocator<Task, false, TASKS_PAGE_SIZE> task_allocator;
 	PagedAllocator<Group, false, GROUPS_PAGE_SIZE> group_allocator;
 
+	// Tasks posted from outside the pool, and low-priority ones once they are allowed to run.
+	// Split in shards with their own lock, so posting threads don't contend with each other
+	// nor with task_mutex. Each pool thread starts looking from a different shard.
+	struct InjectionQueue {
+		BinaryMutex mutex;
+		SelfList<Task>::List tasks;
+		std::atomic<uint32_t> size = 0; // Lets threads skip empty shards without locking.
+	};
+
+	static const uint32_t INJECTION_QUEUE_COUNT = 8;
+	InjectionQueue injection_queues[INJECTION_QUEUE_COUNT];
+	SafeNumeric<uint32_t> injection_index; // For rotating across shards.
+
+	// These are protected by task_mutex. Pump tasks stay apart, since threads which can't take
+	// one have to look at them first.
 	SelfList<Task>::List low_priority_task_queue;
-	SelfList<Task>::List task_queue;
+	SelfList<Task>::List pump_task_queue;
 
 	BinaryMutex task_mutex;
 
+	static const uint32_t LOCAL_QUEUE_SIZE = 1024;
+
 	struct ThreadData {
 		static Task *const YIELDING; // Too bad constexpr doesn't work here.
 
+		enum SleepState : uint32_t {
+			AWAKE,
+			SLEEPING, // Not running any task.
+			AWAITING, // Waiting collaboratively from within a task.
+		};
+
 		uint32_t index = 0;
 		Thread thread;
-		bool signaled : 1;
 		bool yield_is_over : 1;
 		bool pre_exited_languages : 1;
-		bool exited_languages : 1;
 		bool has_pump_task : 1; // Threads can only have one pump task.
+		bool exited_languages = false; // Apart from the bitfield, since the thread reads it without locking.
 		Task *current_task = nullptr;
-		Task *awaited_task = nullptr; // Null if not awaiting the condition variable, or special value (YIELDING).
-		ConditionVariable cond_var;
+		Task *awaited_task = nullptr; // Null if not sleeping, or special value (YIELDING).
+		// Set by the thread itself before going to sleep, and back to AWAKE by whoever wakes it up,
+		// which is then the only one to post wake_semaphore.
+		std::atomic<uint32_t> sleep_state = AWAKE;
+		Semaphore wake_semaphore;
 		WorkerThreadPool *pool = nullptr;
+		// Pushed to and popped from by the owner thread only, and stolen from by others, all without locking.
+		WorkStealingQueue<Task *, LOCAL_QUEUE_SIZE> local_queue;
 
 		ThreadData() :
-				signaled(false),
 				yield_is_over(false),
 				pre_exited_languages(false),
-				exited_languages(false),
 				has_pump_task(false) {}
 	};
 
@@ -167,7 +193,7 @@ private:
 
 	uint32_t max_low_priority_threads = 0;
 	uint32_t low_priority_threads_used = 0;
-	uint32_t notify_index = 0; // For rotating across threads, no help distributing load.
+	SafeNumeric<uint32_t> notify_index; // For rotating across threads, no help distributing load.
 
 	uint64_t last_task = 1;
 	int pump_task_count = 0;
@@ -182,6 +208,14 @@ private:
 	void _notify_threads(const ThreadData *p_current_thread_data, uint32_t p_process_count, uint32_t p_promote_count);
 
 	bool _try_promote_low_priority_task();
+	void _push_injected_task(Task *p_task);
+	Task *_try_take_injected_task(const ThreadData *p_thread_data);
+	Task *_try_steal_task(const ThreadData *p_thief);
+	Task *_try_take_task(ThreadData *p_thread_data);
+	bool _has_queued_tasks() const;
+
+	bool _wake_thread(ThreadData &p_thread_data, bool p_only_idle = false);
+	Task *_sleep(ThreadData *p_thread_data, MutexLock<BinaryMutex> &p_lock, uint32_t p_sleep_state);
 
 	static WorkerThreadPool *singleton;
 
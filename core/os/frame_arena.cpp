@@ -0,0 +1,260 @@
+/**************************************************************************/
+/*  frame_arena.cpp                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "frame_arena.h"
+
+#include "core/os/thread.h"
+#include "core/templates/safe_refcount.h"
+
+namespace {
+
+// Placed before every block handed out, so that free and realloc can tell arena
+// memory from heap fallbacks, and know how much to copy when moving a block.
+struct BlockHeader {
+	uint64_t size;
+	uint64_t from_heap;
+};
+
+struct Chunk {
+	Chunk *next;
+	size_t capacity;
+};
+
+constexpr size_t HEADER_SIZE = Memory::get_aligned_address(sizeof(BlockHeader), Memory::MAX_ALIGN);
+constexpr size_t CHUNK_HEADER_SIZE = Memory::get_aligned_address(sizeof(Chunk), Memory::MAX_ALIGN);
+constexpr size_t DEFAULT_CHUNK_SIZE = 64 * 1024;
+
+struct ThreadArena {
+	// Chunks are kept across scopes and reused; they are only freed when the thread exits.
+	Chunk *first = nullptr;
+	Chunk *current = nullptr;
+	size_t offset = 0;
+	uint8_t *last_block = nullptr; // Most recent allocation in the current chunk, if still on top.
+	uint32_t scope_depth = 0;
+
+	// Accumulated locally and published when the outermost scope exits, to avoid atomics per allocation.
+	uint64_t allocation_count = 0;
+	uint64_t allocated_bytes = 0;
+
+	~ThreadArena() {
+		Chunk *c = first;
+		while (c) {
+			Chunk *next = c->next;
+			Memory::free_static(c);
+			c = next;
+		}
+	}
+};
+
+thread_local ThreadArena thread_arena;
+
+SafeNumeric<uint64_t> pending_allocation_count;
+SafeNumeric<uint64_t> pending_allocated_bytes;
+uint64_t frame_allocation_count = 0;
+uint64_t frame_allocated_bytes = 0;
+
+void *main_frame_chunk = nullptr;
+size_t main_frame_offset = 0;
+
+_FORCE_INLINE_ uint8_t *_chunk_data(Chunk *p_chunk) {
+	return (uint8_t *)p_chunk + CHUNK_HEADER_SIZE;
+}
+
+_FORCE_INLINE_ BlockHeader *_get_header(void *p_memory) {
+	return (BlockHeader *)((uint8_t *)p_memory - HEADER_SIZE);
+}
+
+// Makes the arena point to a chunk with at least p_bytes available, reusing one
+// kept from earlier scopes if possible.
+void _advance_chunk(ThreadArena &r_arena, size_t p_bytes) {
+	Chunk *candidate = r_arena.current ? r_arena.current->next : r_arena.first;
+	while (candidate && candidate->capacity < p_bytes) {
+		candidate = candidate->next;
+	}
+
+	if (!candidate) {
+		size_t capacity = MAX(DEFAULT_CHUNK_SIZE, p_bytes);
+		candidate = (Chunk *)Memory::alloc_static(CHUNK_HEADER_SIZE + capacity);
+		CRASH_COND_MSG(!candidate, "Out of memory");
+		candidate->capacity = capacity;
+		if (r_arena.current) {
+			candidate->next = r_arena.current->next;
+			r_arena.current->next = candidate;
+		} else {
+			candidate->next = r_arena.first;
+			r_arena.first = candidate;
+		}
+	}
+
+	r_arena.current = candidate;
+	r_arena.offset = 0;
+	r_arena.last_block = nullptr;
+}
+
+void _enter_scope(void *&r_chunk, size_t &r_offset) {
+	ThreadArena &arena = thread_arena;
+	r_chunk = arena.current;
+	r_offset = arena.offset;
+	arena.scope_depth++;
+}
+
+void _exit_scope(void *p_chunk, size_t p_offset) {
+	ThreadArena &arena = thread_arena;
+	ERR_FAIL_COND(arena.scope_depth == 0);
+	arena.scope_depth--;
+	arena.current = (Chunk *)p_chunk;
+	arena.offset = p_offset;
+	arena.last_block = nullptr;
+
+	if (arena.scope_depth == 0 && arena.allocation_count) {
+		pending_allocation_count.add(arena.allocation_count);
+		pending_allocated_bytes.add(arena.allocated_bytes);
+		arena.allocation_count = 0;
+		arena.allocated_bytes = 0;
+	}
+}
+
+} // namespace
+
+FrameArena::Scope::Scope() {
+	_enter_scope(chunk, offset);
+}
+
+FrameArena::Scope::~Scope() {
+	_exit_scope(chunk, offset);
+}
+
+void *FrameArena::alloc(size_t p_bytes) {
+	ThreadArena &arena = thread_arena;
+
+	if (arena.scope_depth == 0) {
+		// No scope to bound the lifetime of the memory, so it must come from the heap.
+		uint8_t *mem = (uint8_t *)Memory::alloc_static(HEADER_SIZE + p_bytes);
+		ERR_FAIL_NULL_V(mem, nullptr);
+		BlockHeader *header = (BlockHeader *)mem;
+		header->size = p_bytes;
+		header->from_heap = 1;
+		return mem + HEADER_SIZE;
+	}
+
+	size_t needed = HEADER_SIZE + Memory::get_aligned_address(p_bytes, Memory::MAX_ALIGN);
+	if (unlikely(!arena.current || arena.offset + needed > arena.current->capacity)) {
+		_advance_chunk(arena, needed);
+	}
+
+	uint8_t *mem = _chunk_data(arena.current) + arena.offset;
+	arena.offset += needed;
+	arena.last_block = mem;
+	arena.allocation_count++;
+	arena.allocated_bytes += p_bytes;
+
+	BlockHeader *header = (BlockHeader *)mem;
+	header->size = p_bytes;
+	header->from_heap = 0;
+	return mem + HEADER_SIZE;
+}
+
+void *FrameArena::realloc(void *p_memory, size_t p_bytes) {
+	if (p_memory == nullptr) {
+		return alloc(p_bytes);
+	}
+
+	BlockHeader *header = _get_header(p_memory);
+	if (header->from_heap) {
+		uint8_t *mem = (uint8_t *)Memory::realloc_static(header, HEADER_SIZE + p_bytes);
+		ERR_FAIL_NULL_V(mem, nullptr);
+		((BlockHeader *)mem)->size = p_bytes;
+		return mem + HEADER_SIZE;
+	}
+
+	if (p_bytes <= header->size) {
+		return p_memory;
+	}
+
+	ThreadArena &arena = thread_arena;
+	if ((uint8_t *)header == arena.last_block) {
+		// On top of the current chunk; try to grow in place.
+		size_t block_offset = (uint8_t *)header - _chunk_data(arena.current);
+		size_t new_end = block_offset + HEADER_SIZE + Memory::get_aligned_address(p_bytes, Memory::MAX_ALIGN);
+		if (new_end <= arena.current->capacity) {
+			arena.allocated_bytes += p_bytes - header->size;
+			arena.offset = new_end;
+			header->size = p_bytes;
+			return p_memory;
+		}
+	}
+
+	void *new_memory = alloc(p_bytes);
+	ERR_FAIL_NULL_V(new_memory, nullptr);
+	memcpy(new_memory, p_memory, header->size);
+	free(p_memory);
+	return new_memory;
+}
+
+void FrameArena::free(void *p_memory) {
+	ERR_FAIL_NULL(p_memory);
+
+	BlockHeader *header = _get_header(p_memory);
+	if (header->from_heap) {
+		Memory::free_static(header);
+		return;
+	}
+
+	ThreadArena &arena = thread_arena;
+	if ((uint8_t *)header == arena.last_block) {
+		// Pop it, so that short-lived temporaries don't consume the arena.
+		arena.offset = (uint8_t *)header - _chunk_data(arena.current);
+		arena.last_block = nullptr;
+	}
+	// Otherwise, the memory is reclaimed when the enclosing scope exits.
+}
+
+void FrameArena::begin_frame() {
+	ERR_FAIL_COND(!Thread::is_main_thread());
+	_enter_scope(main_frame_chunk, main_frame_offset);
+}
+
+void FrameArena::end_frame() {
+	ERR_FAIL_COND(!Thread::is_main_thread());
+	_exit_scope(main_frame_chunk, main_frame_offset);
+
+	frame_allocation_count = pending_allocation_count.get();
+	pending_allocation_count.sub(frame_allocation_count);
+	frame_allocated_bytes = pending_allocated_bytes.get();
+	pending_allocated_bytes.sub(frame_allocated_bytes);
+}
+
+uint64_t FrameArena::get_frame_allocation_count() {
+	return frame_allocation_count;
+}
+
+uint64_t FrameArena::get_frame_allocated_bytes() {
+	return frame_allocated_bytes;
+}
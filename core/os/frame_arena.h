@@ -0,0 +1,82 @@
+/**************************************************************************/
+/*  frame_arena.h                                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/templates/local_vector.h"
+
+// Thread-local bump allocator for short-lived scratch data, such as the
+// temporary arrays built every frame while culling or stepping physics.
+//
+// Memory is only served from the arena while a FrameArena::Scope is active on
+// the calling thread. Leaving a scope rewinds the arena to where it was when the
+// scope was entered, so nothing allocated inside a scope may outlive it.
+// Outside of any scope, allocations transparently fall back to the heap.
+//
+// The main loop wraps every iteration in a frame scope for the main thread
+// (see begin_frame() and end_frame()); other threads open their own scopes.
+//
+// Freeing arena memory is a no-op, except for the most recent allocation, which
+// is popped. Reallocating the most recent allocation grows it in place when possible.
+class FrameArena {
+public:
+	class Scope {
+		void *chunk = nullptr;
+		size_t offset = 0;
+
+	public:
+		Scope();
+		~Scope();
+	};
+
+	static void *alloc(size_t p_bytes);
+	static void *realloc(void *p_memory, size_t p_bytes);
+	static void free(void *p_memory);
+
+	// Main thread only. Called by the main loop at the frame boundaries.
+	static void begin_frame();
+	static void end_frame();
+
+	// Allocations served by the arenas of all threads during the last frame.
+	static uint64_t get_frame_allocation_count();
+	static uint64_t get_frame_allocated_bytes();
+};
+
+class FrameArenaAllocator {
+public:
+	_FORCE_INLINE_ static void *alloc(size_t p_memory) { return FrameArena::alloc(p_memory); }
+	_FORCE_INLINE_ static void *realloc(void *p_ptr, size_t p_memory) { return FrameArena::realloc(p_ptr, p_memory); }
+	_FORCE_INLINE_ static void free(void *p_ptr) { FrameArena::free(p_ptr); }
+};
+
+// LocalVector for temporaries that live within a FrameArena::Scope.
+template <typename T, typename U = uint32_t>
+using FrameLocalVector = LocalVector<T, U, false, false, FrameArenaAllocator>;
@@ -30,6 +30,7 @@
 
 #include "memory.h"
 
+#include "core/profiling/alloc_profiler.h"
 #include "core/profiling/profiling.h"
 #include "core/templates/safe_refcount.h"
 
@@ -98,7 +99,7 @@ void Memory::free_aligned_static(void *p_memory) {
 
 template <bool p_ensure_zero>
 void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(ALLOC_PROFILER_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -120,6 +121,13 @@ void *Memory::alloc_static(size_t p_bytes, bool p_pad_align) {
 		uint64_t *s = (uint64_t *)(s8 + SIZE_OFFSET);
 		*s = p_bytes;
 
+#ifdef ALLOC_PROFILER_ENABLED
+		if (AllocProfiler::should_sample(p_bytes)) {
+			*s |= AllocProfiler::SAMPLED_FLAG;
+			AllocProfiler::record_alloc(s8 + DATA_OFFSET, p_bytes);
+		}
+#endif
+
 #ifdef DEBUG_ENABLED
 		uint64_t new_mem_usage = _current_mem_usage.add(p_bytes);
 		_max_mem_usage.exchange_if_greater(new_mem_usage);
@@ -140,7 +148,7 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_memory;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(ALLOC_PROFILER_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -150,6 +158,13 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 		mem -= DATA_OFFSET;
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
 
+#ifdef ALLOC_PROFILER_ENABLED
+		if (*s & AllocProfiler::SAMPLED_FLAG) {
+			*s &= ~AllocProfiler::SAMPLED_FLAG;
+			AllocProfiler::record_free(p_memory);
+		}
+#endif
+
 #ifdef DEBUG_ENABLED
 		if (p_bytes > *s) {
 			uint64_t new_mem_usage = _current_mem_usage.add(p_bytes - *s);
@@ -175,6 +190,13 @@ void *Memory::realloc_static(void *p_memory, size_t p_bytes, bool p_pad_align) {
 
 			*s = p_bytes;
 
+#ifdef ALLOC_PROFILER_ENABLED
+			if (AllocProfiler::should_sample(p_bytes)) {
+				*s |= AllocProfiler::SAMPLED_FLAG;
+				AllocProfiler::record_alloc(mem + DATA_OFFSET, p_bytes);
+			}
+#endif
+
 			return mem + DATA_OFFSET;
 		}
 	} else {
@@ -193,7 +215,7 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 
 	uint8_t *mem = (uint8_t *)p_ptr;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(ALLOC_PROFILER_ENABLED)
 	bool prepad = true;
 #else
 	bool prepad = p_pad_align;
@@ -202,8 +224,18 @@ void Memory::free_static(void *p_ptr, bool p_pad_align) {
 	if (prepad) {
 		mem -= DATA_OFFSET;
 
-#ifdef DEBUG_ENABLED
+#if defined(DEBUG_ENABLED) || defined(ALLOC_PROFILER_ENABLED)
 		uint64_t *s = (uint64_t *)(mem + SIZE_OFFSET);
+#endif
+
+#ifdef ALLOC_PROFILER_ENABLED
+		if (*s & AllocProfiler::SAMPLED_FLAG) {
+			*s &= ~AllocProfiler::SAMPLED_FLAG;
+			AllocProfiler::record_free(p_ptr);
+		}
+#endif
+
+#ifdef DEBUG_ENABLED
 		_current_mem_usage.sub(*s);
 #endif
 
@@ -179,6 +179,14 @@ public:
 	virtual Error close_dynamic_library(void *p_library_handle) { return ERR_UNAVAILABLE; }
 	virtual Error get_dynamic_library_symbol_handle(void *p_library_handle, const String &p_name, void *&p_symbol_handle, bool p_optional = false) { return ERR_UNAVAILABLE; }
 
+	// Maps the whole file at the absolute filesystem path p_path read-only into memory.
+	// Empty files succeed with a null r_data. r_handle must be passed back to unmap_file().
+	// Fails with ERR_UNAVAILABLE for files on network or removable storage, which could fault when read through the mapping.
+	virtual Error map_file(const String &p_path, const uint8_t *&r_data, uint64_t &r_size, void *&r_handle) { return ERR_UNAVAILABLE; }
+	virtual Error unmap_file(void *p_handle, const uint8_t *p_data, uint64_t p_size) { return ERR_UNAVAILABLE; }
+	// Hints that a range of a mapped file will be read soon, so it can be paged in ahead of time.
+	virtual void prefetch_mapped_range(const uint8_t *p_data, uint64_t p_size) {}
+
 	virtual void set_low_processor_usage_mode(bool p_enabled);
 	virtual bool is_in_low_processor_usage_mode() const;
 	virtual void set_low_processor_usage_mode_sleep_usec(int p_usec);
@@ -0,0 +1,421 @@
+/**************************************************************************/
+/*  alloc_profiler.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "alloc_profiler.h"
+
+#ifdef ALLOC_PROFILER_ENABLED
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/pair.h"
+#include "core/variant/dictionary.h"
+
+#if defined(_MSC_VER)
+// Exported by kernel32, declared here to avoid including windows.h in core.
+extern "C" __declspec(dllimport) unsigned short __stdcall RtlCaptureStackBackTrace(unsigned long p_frames_to_skip, unsigned long p_frames_to_capture, void **r_backtrace, unsigned long *r_backtrace_hash);
+#define ALLOC_PROFILER_BACKTRACE_RTL
+#elif (defined(__GNUC__) || defined(__clang__)) && !defined(WEB_ENABLED)
+#include <unwind.h>
+#define ALLOC_PROFILER_BACKTRACE_UNWIND
+#endif
+
+#if defined(UNIX_ENABLED) && !defined(WEB_ENABLED)
+#include <cxxabi.h>
+#include <dlfcn.h>
+#define ALLOC_PROFILER_SYMBOLS
+#endif
+
+#include <cstdlib>
+
+struct AllocSiteKey {
+	const char *scope = nullptr;
+	uint32_t frame_count = 0;
+	void *frames[AllocProfiler::MAX_FRAMES];
+
+	bool operator==(const AllocSiteKey &p_other) const {
+		if (scope != p_other.scope || frame_count != p_other.frame_count) {
+			return false;
+		}
+		for (uint32_t i = 0; i < frame_count; i++) {
+			if (frames[i] != p_other.frames[i]) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+struct AllocSiteKeyHasher {
+	static uint32_t hash(const AllocSiteKey &p_key) {
+		uint32_t h = hash_murmur3_one_64((uint64_t)(uintptr_t)p_key.scope);
+		for (uint32_t i = 0; i < p_key.frame_count; i++) {
+			h = hash_murmur3_one_64((uint64_t)(uintptr_t)p_key.frames[i], h);
+		}
+		return hash_fmix32(h);
+	}
+};
+
+struct AllocSite {
+	AllocSiteKey key;
+	uint64_t allocations = 0;
+	uint64_t bytes = 0;
+	uint64_t live_bytes = 0;
+};
+
+struct AllocSample {
+	uint32_t site = 0;
+	uint64_t weight = 0;
+};
+
+static constexpr int SIZE_HISTOGRAM_BUCKETS = 48;
+
+struct AllocProfilerState {
+	uint64_t interval = 0;
+	uint64_t allocations = 0;
+	uint64_t bytes = 0;
+	uint64_t size_histogram[SIZE_HISTOGRAM_BUCKETS] = {};
+	LocalVector<AllocSite> sites;
+	HashMap<AllocSiteKey, uint32_t, AllocSiteKeyHasher> site_indices;
+	HashMap<void *, AllocSample> samples;
+};
+
+static BinaryMutex state_mutex;
+static AllocProfilerState *state = nullptr;
+static thread_local uint32_t random_state = 0;
+
+// Bucket `i` counts allocations of up to 2^i bytes.
+static int _get_size_bucket(uint64_t p_bytes) {
+	int bucket = 0;
+	while (bucket < SIZE_HISTOGRAM_BUCKETS - 1 && (uint64_t(1) << bucket) < p_bytes) {
+		bucket++;
+	}
+	return bucket;
+}
+
+#ifdef ALLOC_PROFILER_BACKTRACE_UNWIND
+struct AllocUnwindState {
+	void **frames = nullptr;
+	int skip = 0;
+	int count = 0;
+};
+
+static _Unwind_Reason_Code _unwind_callback(struct _Unwind_Context *p_context, void *p_user) {
+	AllocUnwindState *unwind = (AllocUnwindState *)p_user;
+	const uintptr_t ip = _Unwind_GetIP(p_context);
+	if (ip == 0) {
+		return _URC_END_OF_STACK;
+	}
+	if (unwind->skip > 0) {
+		unwind->skip--;
+		return _URC_NO_REASON;
+	}
+	unwind->frames[unwind->count++] = (void *)ip;
+	return unwind->count < AllocProfiler::MAX_FRAMES ? _URC_NO_REASON : _URC_END_OF_STACK;
+}
+#endif
+
+static _NO_INLINE_ uint32_t _capture_backtrace(void **r_frames, int p_skip) {
+#if defined(ALLOC_PROFILER_BACKTRACE_RTL)
+	return RtlCaptureStackBackTrace(p_skip + 1, AllocProfiler::MAX_FRAMES, r_frames, nullptr);
+#elif defined(ALLOC_PROFILER_BACKTRACE_UNWIND)
+	AllocUnwindState unwind;
+	unwind.frames = r_frames;
+	unwind.skip = p_skip + 1;
+	_Unwind_Backtrace(_unwind_callback, &unwind);
+	return unwind.count;
+#else
+	return 0;
+#endif
+}
+
+static String _symbolize(void *p_address) {
+#ifdef ALLOC_PROFILER_SYMBOLS
+	Dl_info info;
+	if (dladdr(p_address, &info)) {
+		if (info.dli_sname) {
+			int status = 0;
+			char *demangled = abi::__cxa_demangle(info.dli_sname, nullptr, nullptr, &status);
+			const String name = String::utf8(status == 0 && demangled ? demangled : info.dli_sname);
+			if (demangled) {
+				free(demangled);
+			}
+			return vformat("%s+0x%x", name, (uint64_t)((uintptr_t)p_address - (uintptr_t)info.dli_saddr));
+		}
+		if (info.dli_fname) {
+			// Without symbols, the offset in the module can be resolved with addr2line or llvm-symbolizer.
+			return vformat("%s+0x%x", String::utf8(info.dli_fname).get_file(), (uint64_t)((uintptr_t)p_address - (uintptr_t)info.dli_fbase));
+		}
+	}
+#endif
+	return vformat("0x%x", (uint64_t)(uintptr_t)p_address);
+}
+
+bool AllocProfiler::_reached_sample_point() {
+	// Distances between samples are randomized around the interval, so periodic allocation patterns don't skew results.
+	if (random_state == 0) {
+		random_state = hash_murmur3_one_64((uint64_t)(uintptr_t)&random_state) | 1;
+	}
+	random_state ^= random_state << 13;
+	random_state ^= random_state >> 17;
+	random_state ^= random_state << 5;
+
+	const uint64_t interval = MAX(sample_interval.get(), uint64_t(2));
+	bytes_until_sample = int64_t(interval / 2 + random_state % interval);
+
+	// The first countdown of each thread only starts sampling.
+	if (!thread_initialized) {
+		thread_initialized = true;
+		return false;
+	}
+	return true;
+}
+
+void AllocProfiler::record_alloc(void *p_ptr, size_t p_bytes) {
+	const bool was_in_profiler = in_profiler;
+	in_profiler = true;
+
+	AllocSiteKey key;
+	key.scope = current_scope;
+	// Skip this function and Memory.
+	key.frame_count = _capture_backtrace(key.frames, 2);
+
+	{
+		MutexLock lock(state_mutex);
+		if (state) {
+			uint32_t site_index;
+			const uint32_t *existing = state->site_indices.getptr(key);
+			if (existing) {
+				site_index = *existing;
+			} else {
+				site_index = state->sites.size();
+				AllocSite site;
+				site.key = key;
+				state->sites.push_back(site);
+				state->site_indices.insert(key, site_index);
+			}
+
+			// Each sample stands for about one interval worth of bytes, or for itself if it's larger.
+			const uint64_t weight = MAX((uint64_t)p_bytes, state->interval);
+			const uint64_t allocations = weight / MAX((uint64_t)p_bytes, uint64_t(1));
+
+			AllocSite &site = state->sites[site_index];
+			site.allocations += allocations;
+			site.bytes += weight;
+			site.live_bytes += weight;
+			state->allocations += allocations;
+			state->bytes += weight;
+			state->size_histogram[_get_size_bucket(p_bytes)] += allocations;
+			state->samples.insert(p_ptr, { site_index, weight });
+		}
+	}
+
+	in_profiler = was_in_profiler;
+}
+
+void AllocProfiler::record_free(void *p_ptr) {
+	const bool was_in_profiler = in_profiler;
+	in_profiler = true;
+
+	{
+		MutexLock lock(state_mutex);
+		if (state) {
+			HashMap<void *, AllocSample>::Iterator E = state->samples.find(p_ptr);
+			if (E) {
+				state->sites[E->value.site].live_bytes -= E->value.weight;
+				state->samples.remove(E);
+			}
+		}
+	}
+
+	in_profiler = was_in_profiler;
+}
+
+void AllocProfiler::start(uint64_t p_sample_interval) {
+	ERR_FAIL_COND(p_sample_interval == 0);
+	const bool was_in_profiler = in_profiler;
+	in_profiler = true;
+
+	{
+		MutexLock lock(state_mutex);
+		if (!state) {
+			state = memnew(AllocProfilerState);
+		}
+		state->interval = p_sample_interval;
+		sample_interval.set(p_sample_interval);
+		active.set();
+	}
+
+	in_profiler = was_in_profiler;
+}
+
+void AllocProfiler::stop() {
+	const bool was_in_profiler = in_profiler;
+	in_profiler = true;
+
+	{
+		MutexLock lock(state_mutex);
+		active.clear();
+		if (state) {
+			memdelete(state);
+			state = nullptr;
+		}
+	}
+
+	in_profiler = was_in_profiler;
+}
+
+void AllocProfiler::clear() {
+	const bool was_in_profiler = in_profiler;
+	in_profiler = true;
+
+	{
+		MutexLock lock(state_mutex);
+		if (state) {
+			const uint64_t interval = state->interval;
+			memdelete(state);
+			state = memnew(AllocProfilerState);
+			state->interval = interval;
+		}
+	}
+
+	in_profiler = was_in_profiler;
+}
+
+struct AllocSiteBytesGreater {
+	_FORCE_INLINE_ bool operator()(const Pair<uint64_t, uint32_t> &p_a, const Pair<uint64_t, uint32_t> &p_b) const {
+		return p_a.first > p_b.first;
+	}
+};
+
+Dictionary AllocProfiler::get_report(int p_max_sites) {
+	Dictionary report;
+	const bool was_in_profiler = in_profiler;
+	in_profiler = true;
+
+	{
+		MutexLock lock(state_mutex);
+		if (state) {
+			report["sample_interval"] = state->interval;
+			report["allocations"] = state->allocations;
+			report["allocated_bytes"] = state->bytes;
+
+			uint64_t live_bytes = 0;
+			Dictionary scopes;
+			LocalVector<Pair<uint64_t, uint32_t>> order;
+			for (uint32_t i = 0; i < state->sites.size(); i++) {
+				const AllocSite &site = state->sites[i];
+				live_bytes += site.live_bytes;
+				const String scope = site.key.scope ? String::utf8(site.key.scope) : String("Other");
+				scopes[scope] = uint64_t(scopes.get(scope, 0)) + site.live_bytes;
+				order.push_back(Pair<uint64_t, uint32_t>(site.bytes, i));
+			}
+			report["live_bytes"] = live_bytes;
+			report["live_bytes_per_scope"] = scopes;
+
+			int last_bucket = SIZE_HISTOGRAM_BUCKETS - 1;
+			while (last_bucket >= 0 && state->size_histogram[last_bucket] == 0) {
+				last_bucket--;
+			}
+			PackedInt64Array histogram;
+			for (int i = 0; i <= last_bucket; i++) {
+				histogram.push_back(state->size_histogram[i]);
+			}
+			report["size_histogram"] = histogram;
+
+			order.sort_custom<AllocSiteBytesGreater>();
+			Array sites;
+			for (uint32_t i = 0; i < MIN(order.size(), (uint32_t)MAX(p_max_sites, 0)); i++) {
+				const AllocSite &site = state->sites[order[i].second];
+				PackedStringArray frames;
+				for (uint32_t j = 0; j < site.key.frame_count; j++) {
+					frames.push_back(_symbolize(site.key.frames[j]));
+				}
+				Dictionary entry;
+				entry["scope"] = site.key.scope ? String::utf8(site.key.scope) : String("Other");
+				entry["allocations"] = site.allocations;
+				entry["allocated_bytes"] = site.bytes;
+				entry["live_bytes"] = site.live_bytes;
+				entry["frames"] = frames;
+				sites.push_back(entry);
+			}
+			report["sites"] = sites;
+		}
+	}
+
+	in_profiler = was_in_profiler;
+	return report;
+}
+
+Error AllocProfiler::dump_to_file(const String &p_path, int p_max_sites) {
+	const Dictionary report = get_report(p_max_sites);
+	ERR_FAIL_COND_V_MSG(report.is_empty(), ERR_UNCONFIGURED, "The allocation profiler isn't running.");
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s' to write the allocation profile.", p_path));
+
+	f->store_line(vformat("Allocation profile, sampled every %s on average. All values are estimates.", String::humanize_size(report["sample_interval"])));
+	f->store_line(vformat("Allocated %s in %d allocations, %s still live.", String::humanize_size(report["allocated_bytes"]), report["allocations"], String::humanize_size(report["live_bytes"])));
+
+	f->store_line("");
+	f->store_line("Allocations per size:");
+	const PackedInt64Array histogram = report["size_histogram"];
+	for (int i = 0; i < histogram.size(); i++) {
+		if (histogram[i] > 0) {
+			f->store_line(vformat("  <= %s: %d", String::humanize_size(uint64_t(1) << i), histogram[i]));
+		}
+	}
+
+	f->store_line("");
+	f->store_line("Live bytes per scope:");
+	const Dictionary scopes = report["live_bytes_per_scope"];
+	for (const KeyValue<Variant, Variant> &E : scopes) {
+		f->store_line(vformat("  %s: %s", E.key, String::humanize_size(E.value)));
+	}
+
+	f->store_line("");
+	f->store_line("Call sites by allocated bytes:");
+	const Array sites = report["sites"];
+	for (int i = 0; i < sites.size(); i++) {
+		const Dictionary site = sites[i];
+		f->store_line(vformat("  #%d: %s in %d allocations, %s live [%s]", i + 1, String::humanize_size(site["allocated_bytes"]), site["allocations"], String::humanize_size(site["live_bytes"]), site["scope"]));
+		const PackedStringArray frames = site["frames"];
+		for (const String &frame : frames) {
+			f->store_line("      " + frame);
+		}
+	}
+
+	return OK;
+}
+
+#endif // ALLOC_PROFILER_ENABLED
@@ -0,0 +1,113 @@
+/**************************************************************************/
+/*  alloc_profiler.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/typedefs.h"
+
+// Built-in sampling allocation profiler, compiled in with the `alloc_profiler=yes` SCons option.
+//
+// While active, roughly one allocation every `sample_interval` bytes is sampled on each thread.
+// Samples record the native call stack, the allocation size and the current profile scope, which
+// is used to attribute memory to subsystems. Totals are estimated by weighting each sample by
+// the amount of bytes it stands for.
+
+#ifdef ALLOC_PROFILER_ENABLED
+
+#include "core/error/error_list.h"
+#include "core/templates/safe_refcount.h"
+
+class Dictionary;
+class String;
+
+class AllocProfiler {
+	static inline SafeFlag active{ false };
+	static inline SafeNumeric<uint64_t> sample_interval{ 0 };
+
+	static inline thread_local int64_t bytes_until_sample = 0;
+	static inline thread_local bool thread_initialized = false;
+	static inline thread_local bool in_profiler = false;
+	static inline thread_local const char *current_scope = nullptr;
+
+	static bool _reached_sample_point();
+
+public:
+	static constexpr uint64_t DEFAULT_SAMPLE_INTERVAL = 256 * 1024;
+	static constexpr int MAX_FRAMES = 24;
+
+	// Set on the size stored in front of sampled allocations, so frees know to report them.
+	static constexpr uint64_t SAMPLED_FLAG = uint64_t(1) << 63;
+
+	class Scope {
+		const char *previous = nullptr;
+
+	public:
+		_FORCE_INLINE_ explicit Scope(const char *p_name) {
+			previous = current_scope;
+			current_scope = p_name;
+		}
+		_FORCE_INLINE_ ~Scope() {
+			current_scope = previous;
+		}
+	};
+
+	// Called by Memory for each allocation, returns whether it must be recorded.
+	_FORCE_INLINE_ static bool should_sample(size_t p_bytes) {
+		if (likely(!active.is_set()) || in_profiler) {
+			return false;
+		}
+		bytes_until_sample -= (int64_t)p_bytes;
+		if (likely(bytes_until_sample > 0)) {
+			return false;
+		}
+		return _reached_sample_point();
+	}
+
+	static void record_alloc(void *p_ptr, size_t p_bytes);
+	static void record_free(void *p_ptr);
+
+	static void start(uint64_t p_sample_interval = DEFAULT_SAMPLE_INTERVAL);
+	static void stop();
+	static bool is_active() { return active.is_set(); }
+	static void clear();
+
+	// Estimated totals, size histogram, live bytes per scope and the call sites allocating the most.
+	static Dictionary get_report(int p_max_sites = 64);
+	static Error dump_to_file(const String &p_path, int p_max_sites = 64);
+};
+
+// Attributes allocations made until the end of the current scope to `m_name` (a string literal).
+#define ALLOC_PROFILE_SCOPE(m_name) AllocProfiler::Scope GD_UNIQUE_NAME(_alloc_profile_scope_)(m_name)
+
+#else
+
+#define ALLOC_PROFILE_SCOPE(m_name)
+
+#endif // ALLOC_PROFILER_ENABLED
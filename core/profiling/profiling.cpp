@@ -47,6 +47,10 @@ void godot_init_profiler() {
 	perfetto::Tracing::Initialize(args);
 	perfetto::TrackEvent::Register();
 }
+#elif defined(GODOT_USE_BUILTIN_TRACER)
+void godot_init_profiler() {
+	// Recording starts with TraceRecorder::start().
+}
 #else
 void godot_init_profiler() {
 	// Stub
@@ -106,6 +106,21 @@ struct PerfettoGroupedEventEnder {
 #define GodotProfileFree(m_ptr)
 void godot_init_profiler();
 
+#elif defined(GODOT_USE_BUILTIN_TRACER)
+// Use the built-in tracer, exported as Chrome trace-event JSON (see trace_recorder.h).
+
+#include "core/profiling/trace_recorder.h"
+
+#define GodotProfileFrameMark TraceRecorder::add_frame_mark()
+#define GodotProfileZone(m_zone_name) TraceZone GD_UNIQUE_NAME(__godot_trace_zone_)(m_zone_name)
+#define GodotProfileZoneGroupedFirst(m_group_name, m_zone_name) TraceZone __godot_trace_zone_##m_group_name(m_zone_name)
+#define GodotProfileZoneGroupedEndEarly(m_group_name, m_zone_name) __godot_trace_zone_##m_group_name.end()
+#define GodotProfileZoneGrouped(m_group_name, m_zone_name) __godot_trace_zone_##m_group_name.begin(m_zone_name)
+
+#define GodotProfileAlloc(m_ptr, m_size)
+#define GodotProfileFree(m_ptr)
+void godot_init_profiler();
+
 #else
 // No profiling; all macros are stubs.
 
@@ -11,3 +11,5 @@ def profiler_gen_builder(target, source, env):
                 file.write("#define TRACY_CALLSTACK 62\n")
         if env["profiler"] == "perfetto":
             file.write("#define GODOT_USE_PERFETTO\n")
+        if env["profiler"] == "builtin":
+            file.write("#define GODOT_USE_BUILTIN_TRACER\n")
@@ -0,0 +1,215 @@
+/**************************************************************************/
+/*  trace_recorder.cpp                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "profiling.h"
+
+#ifdef GODOT_USE_BUILTIN_TRACER
+
+#include "core/io/file_access.h"
+#include "core/os/mutex.h"
+#include "core/os/os.h"
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+
+#include <cstdio>
+
+struct TraceEvent {
+	const char *name = nullptr; // A null name marks a frame.
+	uint64_t begin = 0;
+	uint64_t duration = 0;
+};
+
+struct TraceThreadBuffer {
+	Thread::ID thread_id = 0;
+	bool main_thread = false;
+	bool thread_alive = true;
+	TraceEvent *events = nullptr;
+	// Only written by the owning thread, read when exporting.
+	SafeNumeric<uint64_t> write_count;
+};
+
+// Releases the buffer of a thread when it exits, once it's been exported.
+struct TraceThreadBufferOwner {
+	TraceThreadBuffer *buffer = nullptr;
+
+	~TraceThreadBufferOwner();
+};
+
+static BinaryMutex buffers_mutex;
+static LocalVector<TraceThreadBuffer *> buffers;
+static uint64_t start_time = 0;
+static thread_local TraceThreadBufferOwner thread_buffer;
+
+TraceThreadBufferOwner::~TraceThreadBufferOwner() {
+	if (buffer) {
+		MutexLock lock(buffers_mutex);
+		buffer->thread_alive = false;
+	}
+}
+
+static TraceThreadBuffer *_get_thread_buffer() {
+	if (likely(thread_buffer.buffer)) {
+		return thread_buffer.buffer;
+	}
+
+	TraceThreadBuffer *buffer = memnew(TraceThreadBuffer);
+	buffer->thread_id = Thread::get_caller_id();
+	buffer->main_thread = Thread::is_main_thread();
+	buffer->events = memnew_arr(TraceEvent, TraceRecorder::EVENTS_PER_THREAD);
+
+	MutexLock lock(buffers_mutex);
+	buffers.push_back(buffer);
+	thread_buffer.buffer = buffer;
+	return buffer;
+}
+
+static _FORCE_INLINE_ void _write_event(const char *p_name, uint64_t p_begin, uint64_t p_duration) {
+	TraceThreadBuffer *buffer = _get_thread_buffer();
+	const uint64_t count = buffer->write_count.get();
+	TraceEvent &event = buffer->events[count % TraceRecorder::EVENTS_PER_THREAD];
+	event.name = p_name;
+	event.begin = p_begin;
+	event.duration = p_duration;
+	buffer->write_count.set(count + 1);
+}
+
+uint64_t TraceRecorder::get_timestamp() {
+	return OS::get_singleton()->get_ticks_usec();
+}
+
+void TraceRecorder::add_zone(const char *p_name, uint64_t p_begin) {
+	if (!recording.is_set()) {
+		return;
+	}
+	_write_event(p_name, p_begin, get_timestamp() - p_begin);
+}
+
+void TraceRecorder::add_frame_mark() {
+	if (!recording.is_set()) {
+		return;
+	}
+	_write_event(nullptr, get_timestamp(), 0);
+}
+
+Error TraceRecorder::start() {
+	ERR_FAIL_COND_V_MSG(recording.is_set(), ERR_ALREADY_IN_USE, "A trace is already being recorded.");
+
+	{
+		MutexLock lock(buffers_mutex);
+		for (uint32_t i = 0; i < buffers.size(); i++) {
+			TraceThreadBuffer *buffer = buffers[i];
+			if (buffer->thread_alive) {
+				buffer->write_count.set(0);
+			} else {
+				memdelete_arr(buffer->events);
+				memdelete(buffer);
+				buffers.remove_at_unordered(i);
+				i--;
+			}
+		}
+		start_time = get_timestamp();
+	}
+
+	recording.set();
+	return OK;
+}
+
+static void _store_json_string(Ref<FileAccess> p_file, const char *p_string) {
+	CharString escaped;
+	for (const char *c = p_string; *c; c++) {
+		if (*c == '"' || *c == '\\') {
+			escaped += '\\';
+		}
+		if ((uint8_t)*c < 0x20) {
+			escaped += ' ';
+		} else {
+			escaped += *c;
+		}
+	}
+	p_file->store_buffer((const uint8_t *)escaped.get_data(), escaped.length());
+}
+
+Error TraceRecorder::stop(const String &p_path) {
+	ERR_FAIL_COND_V_MSG(!recording.is_set(), ERR_UNCONFIGURED, "No trace is being recorded.");
+	recording.clear();
+
+	Error err;
+	Ref<FileAccess> f = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(f.is_null(), err, vformat("Cannot open file '%s' to write the trace.", p_path));
+
+	MutexLock lock(buffers_mutex);
+
+	const int pid = OS::get_singleton()->get_process_id();
+	char line[256];
+	bool first = true;
+	f->store_string("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+	for (const TraceThreadBuffer *buffer : buffers) {
+		const uint64_t count = buffer->write_count.get();
+		if (count == 0) {
+			continue;
+		}
+
+		snprintf(line, sizeof(line), "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%llu,\"args\":{\"name\":\"",
+				first ? "" : ",\n", pid, (unsigned long long)buffer->thread_id);
+		f->store_string(line);
+		if (buffer->main_thread) {
+			f->store_string("Main Thread\"}}");
+		} else {
+			f->store_string(vformat("Thread %d\"}}", buffer->thread_id));
+		}
+		first = false;
+
+		// When the buffer wrapped around, skip the oldest slot, a late zone may still be writing to it.
+		const uint64_t from = count > EVENTS_PER_THREAD ? count - EVENTS_PER_THREAD + 1 : 0;
+		for (uint64_t i = from; i < count; i++) {
+			const TraceEvent &event = buffer->events[i % EVENTS_PER_THREAD];
+			if (event.begin < start_time) {
+				continue;
+			}
+			const uint64_t ts = event.begin - start_time;
+			if (event.name) {
+				f->store_string(",\n{\"cat\":\"godot\",\"name\":\"");
+				_store_json_string(f, event.name);
+				snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"pid\":%d,\"tid\":%llu,\"ts\":%llu,\"dur\":%llu}",
+						pid, (unsigned long long)buffer->thread_id, (unsigned long long)ts, (unsigned long long)event.duration);
+			} else {
+				snprintf(line, sizeof(line), ",\n{\"cat\":\"godot\",\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":%d,\"tid\":%llu,\"ts\":%llu}",
+						pid, (unsigned long long)buffer->thread_id, (unsigned long long)ts);
+			}
+			f->store_string(line);
+		}
+	}
+
+	f->store_string("\n]}\n");
+	return f->get_error() == OK ? OK : ERR_FILE_CANT_WRITE;
+}
+
+#endif // GODOT_USE_BUILTIN_TRACER
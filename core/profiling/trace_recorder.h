@@ -0,0 +1,89 @@
+/**************************************************************************/
+/*  trace_recorder.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/error/error_list.h"
+#include "core/templates/safe_refcount.h"
+
+class String;
+
+// Built-in tracer backing the GodotProfileZone macros when no external profiler is compiled in.
+//
+// While recording, every thread writes the zones it completes to its own ring buffer, which keeps
+// the most recent events. Stopping exports all buffers as Chrome trace-event JSON, which can be
+// opened in https://ui.perfetto.dev or chrome://tracing.
+// Zone names must be string literals, as only the pointers are stored.
+
+class TraceRecorder {
+	static inline SafeFlag recording{ false };
+
+public:
+	// Events kept per thread; older events are overwritten.
+	static constexpr uint32_t EVENTS_PER_THREAD = 1 << 15;
+
+	_FORCE_INLINE_ static bool is_recording() { return recording.is_set(); }
+
+	static uint64_t get_timestamp();
+	static void add_zone(const char *p_name, uint64_t p_begin);
+	static void add_frame_mark();
+
+	static Error start();
+	static Error stop(const String &p_path);
+};
+
+class TraceZone {
+	const char *name = nullptr;
+	uint64_t begin_time = 0;
+
+public:
+	_FORCE_INLINE_ void end() {
+		if (unlikely(name)) {
+			TraceRecorder::add_zone(name, begin_time);
+			name = nullptr;
+		}
+	}
+
+	_FORCE_INLINE_ void begin(const char *p_name) {
+		end();
+		if (unlikely(TraceRecorder::is_recording())) {
+			name = p_name;
+			begin_time = TraceRecorder::get_timestamp();
+		}
+	}
+
+	_FORCE_INLINE_ explicit TraceZone(const char *p_name) {
+		begin(p_name);
+	}
+
+	_FORCE_INLINE_ ~TraceZone() {
+		end();
+	}
+};
@@ -46,10 +46,12 @@
 #include "core/io/config_file.h"
 #include "core/io/dir_access.h"
 #include "core/io/dtls_server.h"
+#include "core/io/file_access_async.h"
 #include "core/io/file_access_encrypted.h"
 #include "core/io/http_client.h"
 #include "core/io/image_loader.h"
 #include "core/io/json.h"
+#include "core/io/json_stream.h"
 #include "core/io/marshalls.h"
 #include "core/io/missing_resource.h"
 #include "core/io/packet_peer.h"
@@ -106,6 +108,7 @@ static CoreBind::Marshalls *_marshalls = nullptr;
 static CoreBind::EngineDebugger *_engine_debugger = nullptr;
 
 static IP *ip = nullptr;
+static FileAccessAsync *file_access_async = nullptr;
 static Time *_time = nullptr;
 
 static CoreBind::Geometry2D *_geometry_2d = nullptr;
@@ -266,6 +269,8 @@ void register_core_types() {
 
 	GDREGISTER_CLASS(XMLParser);
 	GDREGISTER_CLASS(JSON);
+	GDREGISTER_CLASS(JSONStreamReader);
+	GDREGISTER_CLASS(JSONStreamWriter);
 
 	GDREGISTER_CLASS(ConfigFile);
 
@@ -322,6 +327,7 @@ void register_core_types() {
 	GDREGISTER_CLASS(ProjectSettings);
 
 	ip = IP::create();
+	file_access_async = FileAccessAsync::create();
 
 	_geometry_2d = memnew(CoreBind::Geometry2D);
 	_geometry_3d = memnew(CoreBind::Geometry3D);
@@ -352,6 +358,7 @@ void register_core_settings() {
 
 	GLOBAL_DEF("threading/worker_pool/max_threads", -1);
 	GLOBAL_DEF("threading/worker_pool/low_priority_thread_ratio", 0.3);
+	GLOBAL_DEF("threading/resource_loader/prefetch_dependency_graph", false);
 }
 
 void register_early_core_singletons() {
@@ -431,6 +438,10 @@ void unregister_core_types() {
 		memdelete(ip);
 	}
 
+	if (file_access_async) {
+		memdelete(file_access_async);
+	}
+
 	if constexpr (GD_IS_CLASS_ENABLED(Image)) {
 		ResourceLoader::remove_resource_format_loader(resource_format_image);
 		resource_format_image.unref();
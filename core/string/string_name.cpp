@@ -30,8 +30,9 @@
 
 #include "string_name.h"
 
-#include "core/os/mutex.h"
 #include "core/os/os.h"
+#include "core/os/rw_lock.h"
+#include "core/os/thread.h"
 #include "core/string/print_string.h"
 
 struct StringName::Table {
@@ -39,9 +40,96 @@ struct StringName::Table {
 	constexpr static uint32_t TABLE_LEN = 1 << TABLE_BITS;
 	constexpr static uint32_t TABLE_MASK = TABLE_LEN - 1;
 
+	// Buckets are split between shards by their lowest bits. Looking up an existing name only takes
+	// the shard lock for reading, so lookups never block each other, and inserts or removals
+	// only block the threads using the same shard.
+	constexpr static uint32_t SHARD_BITS = 6;
+	constexpr static uint32_t SHARD_LEN = 1 << SHARD_BITS;
+	constexpr static uint32_t SHARD_MASK = SHARD_LEN - 1;
+
+	struct alignas(Thread::CACHE_LINE_BYTES) Shard {
+		RWLock lock;
+		PagedAllocator<_Data, false, 256> allocator;
+		SafeNumeric<uint64_t> hits;
+		SafeNumeric<uint64_t> inserts;
+	};
+
 	static inline _Data *table[TABLE_LEN];
-	static inline BinaryMutex mutex;
-	static inline PagedAllocator<_Data> allocator;
+	static inline Shard shards[SHARD_LEN];
+
+	static inline uint64_t total_hits = 0;
+	static inline uint64_t total_inserts = 0;
+	static inline InternStats frame_stats;
+
+	_FORCE_INLINE_ static Shard &get_shard(uint32_t p_idx) {
+		return shards[p_idx & SHARD_MASK];
+	}
+
+	// Must be called with the shard locked, at least for reading.
+	template <typename T>
+	static _Data *find_and_ref(const T &p_name, uint32_t p_hash, uint32_t p_idx, bool p_static) {
+		for (_Data *data = table[p_idx]; data; data = data->next) {
+			// Compare hash first. If the reference can't be taken, the entry is about to be removed.
+			if (data->hash == p_hash && data->name == p_name && data->refcount.ref()) {
+				if (p_static) {
+					data->static_count.increment();
+				}
+#ifdef DEBUG_ENABLED
+				if (unlikely(debug_stringname)) {
+					data->debug_references.increment();
+				}
+#endif
+				return data;
+			}
+		}
+		return nullptr;
+	}
+
+	template <typename T>
+	static _Data *intern(const T &p_name, uint32_t p_hash, bool p_static) {
+		const uint32_t idx = p_hash & TABLE_MASK;
+		Shard &shard = get_shard(idx);
+
+		{
+			RWLockRead read_lock(shard.lock);
+			_Data *data = find_and_ref(p_name, p_hash, idx, p_static);
+			if (data) {
+				shard.hits.increment();
+				return data;
+			}
+		}
+
+		RWLockWrite write_lock(shard.lock);
+
+		// Another thread may have added it while the lock was released.
+		_Data *data = find_and_ref(p_name, p_hash, idx, p_static);
+		if (data) {
+			shard.hits.increment();
+			return data;
+		}
+		shard.inserts.increment();
+
+		data = shard.allocator.alloc();
+		data->name = p_name;
+		data->refcount.init();
+		data->static_count.set(p_static ? 1 : 0);
+		data->hash = p_hash;
+		data->next = table[idx];
+		data->prev = nullptr;
+
+#ifdef DEBUG_ENABLED
+		if (unlikely(debug_stringname)) {
+			// Keep in memory, force static.
+			data->refcount.ref();
+			data->static_count.increment();
+		}
+#endif
+		if (table[idx]) {
+			table[idx]->prev = data;
+		}
+		table[idx] = data;
+		return data;
+	}
 };
 
 void StringName::setup() {
@@ -53,7 +141,9 @@ void StringName::setup() {
 }
 
 void StringName::cleanup() {
-	MutexLock lock(Table::mutex);
+	for (Table::Shard &shard : Table::shards) {
+		shard.lock.write_lock();
+	}
 
 #ifdef DEBUG_ENABLED
 	if (unlikely(debug_stringname)) {
@@ -72,10 +162,10 @@ void StringName::cleanup() {
 		int unreferenced_stringnames = 0;
 		int rarely_referenced_stringnames = 0;
 		for (int i = 0; i < data.size(); i++) {
-			print_line(itos(i + 1) + ": " + data[i]->name + " - " + itos(data[i]->debug_references));
-			if (data[i]->debug_references == 0) {
+			print_line(itos(i + 1) + ": " + data[i]->name + " - " + itos(data[i]->debug_references.get()));
+			if (data[i]->debug_references.get() == 0) {
 				unreferenced_stringnames += 1;
-			} else if (data[i]->debug_references < 5) {
+			} else if (data[i]->debug_references.get() < 5) {
 				rarely_referenced_stringnames += 1;
 			}
 		}
@@ -97,9 +187,12 @@ void StringName::cleanup() {
 			}
 
 			Table::table[i] = Table::table[i]->next;
-			Table::allocator.free(d);
+			Table::get_shard(i).allocator.free(d);
 		}
 	}
+	for (Table::Shard &shard : Table::shards) {
+		shard.lock.write_unlock();
+	}
 	if (lost_strings) {
 		print_verbose(vformat("StringName: %d unclaimed string names at exit.", lost_strings));
 	}
@@ -110,7 +203,9 @@ void StringName::unref() {
 	ERR_FAIL_COND(!configured);
 
 	if (_data && _data->refcount.unref()) {
-		MutexLock lock(Table::mutex);
+		const uint32_t idx = _data->hash & Table::TABLE_MASK;
+		Table::Shard &shard = Table::get_shard(idx);
+		RWLockWrite lock(shard.lock);
 
 		if (CoreGlobals::leak_reporting_enabled && _data->static_count.get() > 0) {
 			ERR_PRINT("BUG: Unreferenced static string to 0: " + _data->name);
@@ -118,19 +213,37 @@ void StringName::unref() {
 		if (_data->prev) {
 			_data->prev->next = _data->next;
 		} else {
-			const uint32_t idx = _data->hash & Table::TABLE_MASK;
 			Table::table[idx] = _data->next;
 		}
 
 		if (_data->next) {
 			_data->next->prev = _data->prev;
 		}
-		Table::allocator.free(_data);
+		shard.allocator.free(_data);
 	}
 
 	_data = nullptr;
 }
 
+void StringName::update_frame_stats() {
+	uint64_t hits = 0;
+	uint64_t inserts = 0;
+	for (const Table::Shard &shard : Table::shards) {
+		hits += shard.hits.get();
+		inserts += shard.inserts.get();
+	}
+
+	Table::frame_stats.hits = hits - Table::total_hits;
+	Table::frame_stats.inserts = inserts - Table::total_inserts;
+	Table::frame_stats.lookups = Table::frame_stats.hits + Table::frame_stats.inserts;
+	Table::total_hits = hits;
+	Table::total_inserts = inserts;
+}
+
+StringName::InternStats StringName::get_frame_intern_stats() {
+	return Table::frame_stats;
+}
+
 uint32_t StringName::get_empty_hash() {
 	static uint32_t empty_hash = String::hash("");
 	return empty_hash;
@@ -210,52 +323,7 @@ StringName::StringName(const char *p_name, bool p_static) {
 		return; //empty, ignore
 	}
 
-	const uint32_t hash = String::hash(p_name);
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		// compare hash first
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, String::hash(p_name), p_static);
 }
 
 StringName::StringName(const String &p_name, bool p_static) {
@@ -267,51 +335,7 @@ StringName::StringName(const String &p_name, bool p_static) {
 		return;
 	}
 
-	const uint32_t hash = p_name.hash();
-	const uint32_t idx = hash & Table::TABLE_MASK;
-
-	MutexLock lock(Table::mutex);
-	_data = Table::table[idx];
-
-	while (_data) {
-		if (_data->hash == hash && _data->name == p_name) {
-			break;
-		}
-		_data = _data->next;
-	}
-
-	if (_data && _data->refcount.ref()) {
-		// exists
-		if (p_static) {
-			_data->static_count.increment();
-		}
-#ifdef DEBUG_ENABLED
-		if (unlikely(debug_stringname)) {
-			_data->debug_references++;
-		}
-#endif
-		return;
-	}
-
-	_data = Table::allocator.alloc();
-	_data->name = p_name;
-	_data->refcount.init();
-	_data->static_count.set(p_static ? 1 : 0);
-	_data->hash = hash;
-	_data->next = Table::table[idx];
-	_data->prev = nullptr;
-#ifdef DEBUG_ENABLED
-	if (unlikely(debug_stringname)) {
-		// Keep in memory, force static.
-		_data->refcount.ref();
-		_data->static_count.increment();
-	}
-#endif
-
-	if (Table::table[idx]) {
-		Table::table[idx]->prev = _data;
-	}
-	Table::table[idx] = _data;
+	_data = Table::intern(p_name, p_name.hash(), p_static);
 }
 
 bool operator==(const String &p_name, const StringName &p_string_name) {
@@ -45,7 +45,7 @@ class [[nodiscard]] StringName {
 		SafeNumeric<uint32_t> static_count;
 		String name;
 #ifdef DEBUG_ENABLED
-		uint32_t debug_references = 0;
+		SafeNumeric<uint32_t> debug_references;
 #endif
 
 		uint32_t hash = 0;
@@ -62,11 +62,12 @@ class [[nodiscard]] StringName {
 	static void setup();
 	static void cleanup();
 	static uint32_t get_empty_hash();
+	static void update_frame_stats();
 	static inline bool configured = false;
 #ifdef DEBUG_ENABLED
 	struct DebugSortReferences {
 		bool operator()(const _Data *p_left, const _Data *p_right) const {
-			return p_left->debug_references > p_right->debug_references;
+			return p_left->debug_references.get() > p_right->debug_references.get();
 		}
 	};
 
@@ -76,6 +77,15 @@ class [[nodiscard]] StringName {
 	StringName(_Data *p_data) { _data = p_data; }
 
 public:
+	struct InternStats {
+		uint64_t lookups = 0;
+		uint64_t hits = 0;
+		uint64_t inserts = 0;
+	};
+
+	// Intern table activity (constructions from a String or C string) during the last frame.
+	static InternStats get_frame_intern_stats();
+
 	_FORCE_INLINE_ explicit operator bool() const { return _data; }
 
 	bool operator==(const String &p_name) const;
@@ -52,8 +52,13 @@ GODOT_GCC_PRAGMA(GCC diagnostic warning "-Wstringop-overflow=0") // Can't "ignor
 GODOT_GCC_PRAGMA(GCC diagnostic warning "-Wdangling-pointer=0") // Can't "ignore" this for some reason.
 #endif
 
+template <typename T>
+class UniqueVector;
+
 template <typename T>
 class CowData {
+	friend class UniqueVector<T>;
+
 public:
 	typedef int64_t Size;
 	typedef uint64_t USize;
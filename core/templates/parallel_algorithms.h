@@ -0,0 +1,234 @@
+/**************************************************************************/
+/*  parallel_algorithms.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/sort_array.h"
+
+// Data-parallel algorithms running on the WorkerThreadPool.
+//
+// Work is always split in chunks of `p_grain` elements, which only depends on the element count
+// and grain size, never on the amount of threads. Results are therefore the same on every machine,
+// including floating-point reductions and the order of equivalent elements after sorting.
+//
+// Chunks are processed in order on the calling thread instead if there is only one chunk, if there is
+// no thread pool, or if called from a thread pool task (which must not block waiting on a group).
+
+static constexpr int64_t PARALLEL_DEFAULT_GRAIN = 1024;
+static constexpr int64_t PARALLEL_SORT_GRAIN = 8192;
+
+template <typename F>
+struct _ParallelChunks {
+	F *func = nullptr;
+	int64_t count = 0;
+	int64_t grain = 0;
+
+	void process(uint32_t p_chunk, void *p_userdata) {
+		const int64_t from = p_chunk * grain;
+		(*func)(p_chunk, from, MIN(count, from + grain));
+	}
+};
+
+// Grain actually used for `p_count` elements. It's larger than `p_grain` when there would be more
+// chunks than the thread pool can count, so per-chunk storage must be sized from this.
+_FORCE_INLINE_ int64_t parallel_get_grain(int64_t p_count, int64_t p_grain) {
+	return MAX(p_grain, (p_count + INT32_MAX - 1) / INT32_MAX);
+}
+
+_FORCE_INLINE_ int64_t parallel_get_chunk_count(int64_t p_count, int64_t p_grain) {
+	const int64_t grain = parallel_get_grain(p_count, p_grain);
+	return (p_count + grain - 1) / grain;
+}
+
+// Calls `p_func(chunk_index, from, to)` for every chunk of `parallel_get_grain(p_count, p_grain)` elements.
+// `p_description` names the thread pool tasks.
+template <typename F>
+void parallel_for_chunks(int64_t p_count, int64_t p_grain, F &&p_func, const StringName &p_description = SNAME("ParallelForChunks")) {
+	ERR_FAIL_COND(p_count < 0);
+	ERR_FAIL_COND(p_grain <= 0);
+	p_grain = parallel_get_grain(p_count, p_grain);
+	const int64_t chunks = (p_count + p_grain - 1) / p_grain;
+
+	WorkerThreadPool *pool = WorkerThreadPool::get_singleton();
+	if (chunks <= 1 || pool == nullptr || pool->get_thread_count() <= 1 || pool->get_thread_index() != -1) {
+		for (int64_t i = 0; i < chunks; i++) {
+			const int64_t from = i * p_grain;
+			p_func((uint32_t)i, from, MIN(p_count, from + p_grain));
+		}
+		return;
+	}
+
+	_ParallelChunks<std::remove_reference_t<F>> chunk_task;
+	chunk_task.func = &p_func;
+	chunk_task.count = p_count;
+	chunk_task.grain = p_grain;
+	WorkerThreadPool::GroupID group = pool->add_template_group_task(&chunk_task, &_ParallelChunks<std::remove_reference_t<F>>::process, (void *)nullptr, chunks, -1, true, p_description);
+	pool->wait_for_group_task_completion(group);
+}
+
+// Calls `p_func(index)` for every index in [0, p_count).
+template <typename F>
+void parallel_for(int64_t p_count, F &&p_func, int64_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+	parallel_for_chunks(p_count, p_grain, [&p_func](uint32_t p_chunk, int64_t p_from, int64_t p_to) {
+		for (int64_t i = p_from; i < p_to; i++) {
+			p_func(i);
+		}
+	},
+			SNAME("ParallelFor"));
+}
+
+// Returns the combination of `p_func(index)` for every index in [0, p_count), using `p_combine(a, b)`.
+// Each chunk is reduced starting from `p_identity`, then the chunk results are combined in order.
+template <typename T, typename F, typename C>
+T parallel_reduce(int64_t p_count, const T &p_identity, F &&p_func, C &&p_combine, int64_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+	ERR_FAIL_COND_V(p_grain <= 0, p_identity);
+	LocalVector<T> partials;
+	partials.resize(parallel_get_chunk_count(p_count, p_grain));
+
+	parallel_for_chunks(p_count, p_grain, [&](uint32_t p_chunk, int64_t p_from, int64_t p_to) {
+		T value = p_identity;
+		for (int64_t i = p_from; i < p_to; i++) {
+			value = p_combine(value, p_func(i));
+		}
+		partials[p_chunk] = value;
+	},
+			SNAME("ParallelReduce"));
+
+	T result = p_identity;
+	for (const T &partial : partials) {
+		result = p_combine(result, partial);
+	}
+	return result;
+}
+
+// Writes the inclusive prefix sum of `p_src` into `p_dst`. Both may point to the same array.
+template <typename T>
+void parallel_prefix_sum(const T *p_src, T *p_dst, int64_t p_count, int64_t p_grain = PARALLEL_DEFAULT_GRAIN) {
+	ERR_FAIL_COND(p_grain <= 0);
+	if (p_count <= 0) {
+		return;
+	}
+
+	// Sum each chunk, then offset each chunk by the sum of the ones before it.
+	LocalVector<T> offsets;
+	offsets.resize(parallel_get_chunk_count(p_count, p_grain));
+
+	parallel_for_chunks(p_count, p_grain, [&](uint32_t p_chunk, int64_t p_from, int64_t p_to) {
+		T sum = p_src[p_from];
+		for (int64_t i = p_from + 1; i < p_to; i++) {
+			sum += p_src[i];
+		}
+		offsets[p_chunk] = sum;
+	},
+			SNAME("ParallelPrefixSumChunks"));
+
+	T running = offsets[0];
+	offsets[0] = T();
+	for (uint32_t i = 1; i < offsets.size(); i++) {
+		const T sum = offsets[i];
+		offsets[i] = running;
+		running += sum;
+	}
+
+	parallel_for_chunks(p_count, p_grain, [&](uint32_t p_chunk, int64_t p_from, int64_t p_to) {
+		T sum = p_chunk == 0 ? p_src[p_from] : offsets[p_chunk] + p_src[p_from];
+		p_dst[p_from] = sum;
+		for (int64_t i = p_from + 1; i < p_to; i++) {
+			sum += p_src[i];
+			p_dst[i] = sum;
+		}
+	},
+			SNAME("ParallelPrefixSumOffsets"));
+}
+
+// Sorts each chunk with SortArray, then merges pairs of sorted runs until one is left.
+template <typename T, typename Comparator = Comparator<T>>
+void parallel_sort(T *p_array, int64_t p_len, int64_t p_grain = PARALLEL_SORT_GRAIN) {
+	ERR_FAIL_COND(p_grain <= 0);
+	if (p_len <= 1) {
+		return;
+	}
+	// Merges start from the runs the chunks leave.
+	p_grain = parallel_get_grain(p_len, p_grain);
+
+	parallel_for_chunks(p_len, p_grain, [p_array](uint32_t p_chunk, int64_t p_from, int64_t p_to) {
+		SortArray<T, Comparator> sorter;
+		sorter.sort(p_array + p_from, p_to - p_from);
+	},
+			SNAME("ParallelSortChunks"));
+
+	if (p_len <= p_grain) {
+		return;
+	}
+
+	LocalVector<T> buffer;
+	buffer.resize(p_len);
+	T *src = p_array;
+	T *dst = buffer.ptr();
+
+	for (int64_t width = p_grain; width < p_len; width *= 2) {
+		parallel_for_chunks((p_len + width * 2 - 1) / (width * 2), 1, [src, dst, width, p_len](uint32_t p_chunk, int64_t p_from, int64_t p_to) {
+			Comparator compare;
+			const int64_t begin = p_chunk * width * 2;
+			const int64_t mid = MIN(p_len, begin + width);
+			const int64_t end = MIN(p_len, begin + width * 2);
+			int64_t l = begin;
+			int64_t r = mid;
+			int64_t w = begin;
+			while (l < mid && r < end) {
+				// Take from the left run on ties, which keeps the merge stable.
+				if (compare(src[r], src[l])) {
+					dst[w++] = std::move(src[r++]);
+				} else {
+					dst[w++] = std::move(src[l++]);
+				}
+			}
+			while (l < mid) {
+				dst[w++] = std::move(src[l++]);
+			}
+			while (r < end) {
+				dst[w++] = std::move(src[r++]);
+			}
+		},
+				SNAME("ParallelSortMerge"));
+		SWAP(src, dst);
+	}
+
+	if (src != p_array) {
+		parallel_for_chunks(p_len, PARALLEL_SORT_GRAIN, [src, p_array](uint32_t p_chunk, int64_t p_from, int64_t p_to) {
+			for (int64_t i = p_from; i < p_to; i++) {
+				p_array[i] = std::move(src[i]);
+			}
+		},
+				SNAME("ParallelSortCopy"));
+	}
+}
@@ -0,0 +1,866 @@
+/**************************************************************************/
+/*  swiss_hash_map.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/memory.h"
+#include "core/string/print_string.h"
+#include "core/templates/hashfuncs.h"
+#include "core/templates/pair.h"
+
+#include <initializer_list>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SWISS_HASH_MAP_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define SWISS_HASH_MAP_NEON
+#include <arm_neon.h>
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+class String;
+class StringName;
+class Variant;
+
+// Control bytes and group probing helpers shared by all SwissHashMap instantiations.
+namespace SwissHashMapGroup {
+
+// Must be a power of two.
+static constexpr uint32_t WIDTH = 16;
+
+// A control byte is either one of these two values (high bit set),
+// or the low 7 bits of the hash of the element stored in the slot.
+static constexpr uint8_t CTRL_EMPTY = 0x80;
+static constexpr uint8_t CTRL_DELETED = 0xFE;
+
+_FORCE_INLINE_ uint32_t count_trailing_zeros(uint64_t p_value) {
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctzll(p_value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+	unsigned long index;
+	_BitScanForward64(&index, p_value);
+	return index;
+#else
+	uint32_t count = 0;
+	while (!(p_value & 1)) {
+		p_value >>= 1;
+		count++;
+	}
+	return count;
+#endif
+}
+
+// Set of matching slots within a group. Each slot maps to `1 << SHIFT` bits of the mask,
+// only the lowest of which can be set.
+struct BitMask {
+#ifdef SWISS_HASH_MAP_NEON
+	static constexpr uint32_t SHIFT = 2;
+#else
+	static constexpr uint32_t SHIFT = 0;
+#endif
+
+	uint64_t mask = 0;
+
+	_FORCE_INLINE_ explicit operator bool() const { return mask != 0; }
+	_FORCE_INLINE_ uint32_t lowest() const { return count_trailing_zeros(mask) >> SHIFT; }
+	_FORCE_INLINE_ void clear_lowest() { mask &= mask - 1; }
+};
+
+// Loads WIDTH control bytes and matches them all at once.
+struct Group {
+#if defined(SWISS_HASH_MAP_SSE2)
+	__m128i ctrl;
+
+	_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) {
+		ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p_ctrl));
+	}
+
+	_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+		return BitMask{ (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)p_h2))) };
+	}
+
+	_FORCE_INLINE_ BitMask match_empty() const {
+		return BitMask{ (uint64_t)(uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8((char)CTRL_EMPTY))) };
+	}
+
+	// Both special values have the high bit set, which is exactly what movemask extracts.
+	_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+		return BitMask{ (uint64_t)(uint32_t)_mm_movemask_epi8(ctrl) };
+	}
+#elif defined(SWISS_HASH_MAP_NEON)
+	uint8x16_t ctrl;
+
+	_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) {
+		ctrl = vld1q_u8(p_ctrl);
+	}
+
+	// Narrow each 0x00/0xFF comparison byte to a nibble, there is no movemask on NEON.
+	static _FORCE_INLINE_ BitMask _to_mask(uint8x16_t p_cmp) {
+		const uint8x8_t narrowed = vshrn_n_u16(vreinterpretq_u16_u8(p_cmp), 4);
+		return BitMask{ vget_lane_u64(vreinterpret_u64_u8(narrowed), 0) & 0x8888888888888888ull };
+	}
+
+	_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+		return _to_mask(vceqq_u8(ctrl, vdupq_n_u8(p_h2)));
+	}
+
+	_FORCE_INLINE_ BitMask match_empty() const {
+		return _to_mask(vceqq_u8(ctrl, vdupq_n_u8(CTRL_EMPTY)));
+	}
+
+	_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+		return _to_mask(vtstq_u8(ctrl, vdupq_n_u8(0x80)));
+	}
+#else
+	const uint8_t *ctrl;
+
+	_FORCE_INLINE_ explicit Group(const uint8_t *p_ctrl) {
+		ctrl = p_ctrl;
+	}
+
+	_FORCE_INLINE_ BitMask match(uint8_t p_h2) const {
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= (uint64_t)(ctrl[i] == p_h2) << i;
+		}
+		return BitMask{ mask };
+	}
+
+	_FORCE_INLINE_ BitMask match_empty() const {
+		return match(CTRL_EMPTY);
+	}
+
+	_FORCE_INLINE_ BitMask match_empty_or_deleted() const {
+		uint64_t mask = 0;
+		for (uint32_t i = 0; i < WIDTH; i++) {
+			mask |= (uint64_t)(ctrl[i] >> 7) << i;
+		}
+		return BitMask{ mask };
+	}
+#endif
+};
+
+} // namespace SwissHashMapGroup
+
+/**
+ * A Swiss table style hash map, with the same interface as `AHashMap`.
+ *
+ * Elements are stored in a dense array in insertion order, exactly like `AHashMap`,
+ * so iteration, `get_by_index` and the erase semantics are the same (the last element
+ * takes the place of the erased one). The difference is in the index: slots are
+ * grouped by 16, and each slot has a one byte control value holding 7 bits of
+ * the hash. A lookup compares a whole group of control bytes at once using SSE2 or
+ * NEON (with a scalar fallback), so only slots whose 7 bits match need to be
+ * checked against the key. This makes both hits and misses much cheaper than the
+ * scalar Robin Hood probing used by `AHashMap` when the table is large or keys
+ * are expensive to compare.
+ *
+ * Erased slots become tombstones unless their group still has an empty slot.
+ * Tombstones are cleaned up on the next rehash.
+ *
+ * Use `AHashMap` for small maps where memory matters more, since each slot
+ * costs one byte more here.
+ */
+template <typename TKey, typename TValue,
+		typename Hasher = HashMapHasherDefault,
+		typename Comparator = HashMapComparatorDefault<TKey>>
+class SwissHashMap {
+public:
+	// Must be a power of two and at least one group.
+	static constexpr uint32_t INITIAL_CAPACITY = 16;
+	static constexpr uint32_t GROUP_WIDTH = SwissHashMapGroup::WIDTH;
+	static_assert(INITIAL_CAPACITY >= GROUP_WIDTH);
+
+private:
+	struct Metadata {
+		uint32_t hash;
+		uint32_t element_idx;
+	};
+
+	static_assert(sizeof(Metadata) == 8);
+
+	typedef KeyValue<TKey, TValue> MapKeyValue;
+	MapKeyValue *_elements = nullptr;
+	Metadata *_metadata = nullptr;
+	uint8_t *_ctrl = nullptr;
+
+	// Due to optimization, this is `capacity - 1`. Use + 1 to get normal capacity.
+	uint32_t _capacity_mask = 0;
+	uint32_t _size = 0;
+	// Empty slots that can still be used before a rehash is needed. Tombstones don't count.
+	uint32_t _growth_left = 0;
+
+	_FORCE_INLINE_ static uint32_t _hash(const TKey &p_key) {
+		return Hasher::hash(p_key);
+	}
+
+	_FORCE_INLINE_ static uint8_t _h2(uint32_t p_hash) {
+		return p_hash & 0x7F;
+	}
+
+	_FORCE_INLINE_ static uint32_t _h1(uint32_t p_hash) {
+		return p_hash >> 7;
+	}
+
+	// Max load factor is 7/8.
+	static _FORCE_INLINE_ uint32_t _get_max_load(uint32_t p_capacity_mask) {
+		return p_capacity_mask - (p_capacity_mask >> 3);
+	}
+
+	static uint32_t _get_capacity_mask_for(uint32_t p_elements) {
+		// Capacity can't be lower than a group and must be 2^n.
+		uint32_t capacity = MAX(INITIAL_CAPACITY, p_elements + p_elements / 7 + 1);
+		return next_power_of_2(capacity) - 1;
+	}
+
+	// Probes groups using triangular numbers, which visits every group once when the group count is 2^n.
+	bool _lookup_idx_with_hash(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_meta_idx, uint32_t p_hash) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+
+		const uint8_t h2 = _h2(p_hash);
+		uint32_t group_idx = (_h1(p_hash) * GROUP_WIDTH) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			SwissHashMapGroup::Group group(_ctrl + group_idx);
+			for (SwissHashMapGroup::BitMask match = group.match(h2); match; match.clear_lowest()) {
+				const uint32_t meta_idx = group_idx + match.lowest();
+				const Metadata &metadata = _metadata[meta_idx];
+				if (metadata.hash == p_hash && Comparator::compare(_elements[metadata.element_idx].key, p_key)) {
+					r_element_idx = metadata.element_idx;
+					r_meta_idx = meta_idx;
+					return true;
+				}
+			}
+
+			if (group.match_empty()) {
+				return false;
+			}
+
+			step += GROUP_WIDTH;
+			group_idx = (group_idx + step) & _capacity_mask;
+		}
+	}
+
+	bool _lookup_idx(const TKey &p_key, uint32_t &r_element_idx, uint32_t &r_meta_idx) const {
+		if (unlikely(_elements == nullptr)) {
+			return false; // Failed lookups, no _elements.
+		}
+		return _lookup_idx_with_hash(p_key, r_element_idx, r_meta_idx, _hash(p_key));
+	}
+
+	// Finds the slot pointing to a known element, without comparing keys.
+	uint32_t _find_meta_idx(uint32_t p_hash, uint32_t p_element_idx) const {
+		const uint8_t h2 = _h2(p_hash);
+		uint32_t group_idx = (_h1(p_hash) * GROUP_WIDTH) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			SwissHashMapGroup::Group group(_ctrl + group_idx);
+			for (SwissHashMapGroup::BitMask match = group.match(h2); match; match.clear_lowest()) {
+				const uint32_t meta_idx = group_idx + match.lowest();
+				if (_metadata[meta_idx].element_idx == p_element_idx) {
+					return meta_idx;
+				}
+			}
+			step += GROUP_WIDTH;
+			group_idx = (group_idx + step) & _capacity_mask;
+		}
+	}
+
+	uint32_t _find_insert_slot(uint32_t p_hash) const {
+		uint32_t group_idx = (_h1(p_hash) * GROUP_WIDTH) & _capacity_mask;
+		uint32_t step = 0;
+		while (true) {
+			SwissHashMapGroup::BitMask match = SwissHashMapGroup::Group(_ctrl + group_idx).match_empty_or_deleted();
+			if (match) {
+#ifdef DEV_ENABLED
+				if (unlikely(step > GROUP_WIDTH * 12)) {
+					WARN_PRINT("Excessive collision count, is the right hash function being used?");
+				}
+#endif
+				return group_idx + match.lowest();
+			}
+			step += GROUP_WIDTH;
+			group_idx = (group_idx + step) & _capacity_mask;
+		}
+	}
+
+	void _insert_metadata(uint32_t p_hash, uint32_t p_element_idx) {
+		const uint32_t meta_idx = _find_insert_slot(p_hash);
+		if (_ctrl[meta_idx] == SwissHashMapGroup::CTRL_EMPTY) {
+			_growth_left--;
+		}
+		_ctrl[meta_idx] = _h2(p_hash);
+		_metadata[meta_idx] = Metadata{ p_hash, p_element_idx };
+	}
+
+	void _erase_metadata(uint32_t p_meta_idx) {
+		// A probe only ever skipped this group if it had no empty slot. If it still has one,
+		// nothing can depend on this slot being occupied and it can be emptied right away.
+		const uint32_t group_idx = p_meta_idx & ~(GROUP_WIDTH - 1);
+		if (SwissHashMapGroup::Group(_ctrl + group_idx).match_empty()) {
+			_ctrl[p_meta_idx] = SwissHashMapGroup::CTRL_EMPTY;
+			_growth_left++;
+		} else {
+			_ctrl[p_meta_idx] = SwissHashMapGroup::CTRL_DELETED;
+		}
+	}
+
+	void _allocate_index(uint32_t p_capacity_mask) {
+		const uint32_t real_capacity = p_capacity_mask + 1;
+		_capacity_mask = p_capacity_mask;
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(sizeof(uint8_t) * real_capacity));
+		memset(_ctrl, SwissHashMapGroup::CTRL_EMPTY, real_capacity);
+		_metadata = reinterpret_cast<Metadata *>(Memory::alloc_static(sizeof(Metadata) * real_capacity));
+		_growth_left = _get_max_load(_capacity_mask);
+	}
+
+	void _resize_and_rehash(uint32_t p_new_capacity_mask) {
+		const uint32_t real_old_capacity = _capacity_mask + 1;
+		uint8_t *old_ctrl = _ctrl;
+		Metadata *old_metadata = _metadata;
+
+		_allocate_index(p_new_capacity_mask);
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::realloc_static(_elements, sizeof(MapKeyValue) * _get_max_load(_capacity_mask)));
+
+		for (uint32_t i = 0; i < real_old_capacity; i++) {
+			if (!(old_ctrl[i] & 0x80)) {
+				_insert_metadata(old_metadata[i].hash, old_metadata[i].element_idx);
+			}
+		}
+		_growth_left = _get_max_load(_capacity_mask) - _size;
+
+		Memory::free_static(old_ctrl);
+		Memory::free_static(old_metadata);
+	}
+
+	int32_t _insert_element(const TKey &p_key, const TValue &p_value, uint32_t p_hash) {
+		if (unlikely(_elements == nullptr)) {
+			// Allocate on demand to save memory.
+			_allocate_index(_capacity_mask);
+			_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * _get_max_load(_capacity_mask)));
+		}
+
+		if (unlikely(_growth_left == 0)) {
+			// If most of the used slots are tombstones, clean them up instead of growing.
+			if (_size < _get_max_load(_capacity_mask) / 2) {
+				_resize_and_rehash(_capacity_mask);
+			} else {
+				_resize_and_rehash(_capacity_mask * 2 + 1);
+			}
+		}
+
+		memnew_placement(&_elements[_size], MapKeyValue(p_key, p_value));
+
+		_insert_metadata(p_hash, _size);
+		_size++;
+		return _size - 1;
+	}
+
+	void _init_from(const SwissHashMap &p_other) {
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+
+		if (p_other._elements == nullptr) {
+			return;
+		}
+
+		const uint32_t real_capacity = _capacity_mask + 1;
+		_ctrl = reinterpret_cast<uint8_t *>(Memory::alloc_static(sizeof(uint8_t) * real_capacity));
+		_metadata = reinterpret_cast<Metadata *>(Memory::alloc_static(sizeof(Metadata) * real_capacity));
+		_elements = reinterpret_cast<MapKeyValue *>(Memory::alloc_static(sizeof(MapKeyValue) * _get_max_load(_capacity_mask)));
+
+		if constexpr (std::is_trivially_copyable_v<TKey> && std::is_trivially_copyable_v<TValue>) {
+			void *destination = _elements;
+			const void *source = p_other._elements;
+			memcpy(destination, source, sizeof(MapKeyValue) * _size);
+		} else {
+			for (uint32_t i = 0; i < _size; i++) {
+				memnew_placement(&_elements[i], MapKeyValue(p_other._elements[i]));
+			}
+		}
+
+		memcpy(_ctrl, p_other._ctrl, sizeof(uint8_t) * real_capacity);
+		memcpy(_metadata, p_other._metadata, sizeof(Metadata) * real_capacity);
+	}
+
+public:
+	/* Standard Godot Container API */
+
+	_FORCE_INLINE_ uint32_t get_capacity() const { return _capacity_mask + 1; }
+	_FORCE_INLINE_ uint32_t size() const { return _size; }
+
+	_FORCE_INLINE_ bool is_empty() const {
+		return _size == 0;
+	}
+
+	void clear() {
+		if (_elements == nullptr || _size == 0) {
+			return;
+		}
+
+		memset(_ctrl, SwissHashMapGroup::CTRL_EMPTY, _capacity_mask + 1);
+		if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+			for (uint32_t i = 0; i < _size; i++) {
+				_elements[i].key.~TKey();
+				_elements[i].value.~TValue();
+			}
+		}
+
+		_size = 0;
+		_growth_left = _get_max_load(_capacity_mask);
+	}
+
+	TValue &get(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue &get(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+		CRASH_COND_MSG(!exists, "SwissHashMap key not found.");
+		return _elements[element_idx].value;
+	}
+
+	const TValue *getptr(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	TValue *getptr(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+
+		if (exists) {
+			return &_elements[element_idx].value;
+		}
+		return nullptr;
+	}
+
+	bool has(const TKey &p_key) const {
+		uint32_t _idx = 0;
+		uint32_t meta_idx = 0;
+		return _lookup_idx(p_key, _idx, meta_idx);
+	}
+
+	bool erase(const TKey &p_key) {
+		uint32_t meta_idx = 0;
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+
+		if (!exists) {
+			return false;
+		}
+
+		_erase_metadata(meta_idx);
+		_elements[element_idx].key.~TKey();
+		_elements[element_idx].value.~TValue();
+		_size--;
+
+		if (element_idx < _size) {
+			memcpy((void *)&_elements[element_idx], (const void *)&_elements[_size], sizeof(MapKeyValue));
+			uint32_t moved_meta_idx = _find_meta_idx(_hash(_elements[element_idx].key), _size);
+			_metadata[moved_meta_idx].element_idx = element_idx;
+		}
+
+		return true;
+	}
+
+	// Replace the key of an entry in-place, without invalidating iterators or changing the entries position during iteration.
+	// p_old_key must exist in the map and p_new_key must not, unless it is equal to p_old_key.
+	bool replace_key(const TKey &p_old_key, const TKey &p_new_key) {
+		if (p_old_key == p_new_key) {
+			return true;
+		}
+		uint32_t meta_idx = 0;
+		uint32_t element_idx = 0;
+		ERR_FAIL_COND_V(_lookup_idx(p_new_key, element_idx, meta_idx), false);
+		ERR_FAIL_COND_V(!_lookup_idx(p_old_key, element_idx, meta_idx), false);
+		MapKeyValue &element = _elements[element_idx];
+		const_cast<TKey &>(element.key) = p_new_key;
+
+		_erase_metadata(meta_idx);
+		if (unlikely(_growth_left == 0)) {
+			_resize_and_rehash(_capacity_mask);
+		}
+		_insert_metadata(_hash(p_new_key), element_idx);
+
+		return true;
+	}
+
+	// Reserves space for a number of elements, useful to avoid many resizes and rehashes.
+	// If adding a known (possibly large) number of elements at once, must be larger than old capacity.
+	void reserve(uint32_t p_new_capacity) {
+		const uint32_t new_capacity_mask = _get_capacity_mask_for(p_new_capacity);
+		if (_elements == nullptr) {
+			_capacity_mask = MAX(_capacity_mask, new_capacity_mask);
+			return; // Unallocated yet.
+		}
+		if (new_capacity_mask <= _capacity_mask) {
+			if (p_new_capacity < size()) {
+				WARN_VERBOSE("reserve() called with a capacity smaller than the current size. This is likely a mistake.");
+			}
+			return;
+		}
+		_resize_and_rehash(new_capacity_mask);
+	}
+
+	/** Iterator API **/
+
+	struct ConstIterator {
+		_FORCE_INLINE_ const MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ const MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ ConstIterator &operator++() {
+			pair++;
+			return *this;
+		}
+
+		_FORCE_INLINE_ ConstIterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const ConstIterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const ConstIterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ ConstIterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ ConstIterator() {}
+		_FORCE_INLINE_ ConstIterator(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const ConstIterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	struct Iterator {
+		_FORCE_INLINE_ MapKeyValue &operator*() const {
+			return *pair;
+		}
+		_FORCE_INLINE_ MapKeyValue *operator->() const {
+			return pair;
+		}
+		_FORCE_INLINE_ Iterator &operator++() {
+			pair++;
+			return *this;
+		}
+		_FORCE_INLINE_ Iterator &operator--() {
+			pair--;
+			if (pair < begin) {
+				pair = end;
+			}
+			return *this;
+		}
+
+		_FORCE_INLINE_ bool operator==(const Iterator &b) const { return pair == b.pair; }
+		_FORCE_INLINE_ bool operator!=(const Iterator &b) const { return pair != b.pair; }
+
+		_FORCE_INLINE_ explicit operator bool() const {
+			return pair != end;
+		}
+
+		_FORCE_INLINE_ Iterator(MapKeyValue *p_key, MapKeyValue *p_begin, MapKeyValue *p_end) {
+			pair = p_key;
+			begin = p_begin;
+			end = p_end;
+		}
+		_FORCE_INLINE_ Iterator() {}
+		_FORCE_INLINE_ Iterator(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+		_FORCE_INLINE_ void operator=(const Iterator &p_it) {
+			pair = p_it.pair;
+			begin = p_it.begin;
+			end = p_it.end;
+		}
+
+		operator ConstIterator() const {
+			return ConstIterator(pair, begin, end);
+		}
+
+	private:
+		MapKeyValue *pair = nullptr;
+		MapKeyValue *begin = nullptr;
+		MapKeyValue *end = nullptr;
+	};
+
+	_FORCE_INLINE_ Iterator begin() {
+		return Iterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator end() {
+		return Iterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ Iterator last() {
+		if (unlikely(_size == 0)) {
+			return Iterator(nullptr, nullptr, nullptr);
+		}
+		return Iterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	Iterator find(const TKey &p_key) {
+		uint32_t meta_idx = 0;
+		uint32_t element_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+		if (!exists) {
+			return end();
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	void remove(const Iterator &p_iter) {
+		if (p_iter) {
+			erase(p_iter->key);
+		}
+	}
+
+	_FORCE_INLINE_ ConstIterator begin() const {
+		return ConstIterator(_elements, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator end() const {
+		return ConstIterator(_elements + _size, _elements, _elements + _size);
+	}
+	_FORCE_INLINE_ ConstIterator last() const {
+		if (unlikely(_size == 0)) {
+			return ConstIterator(nullptr, nullptr, nullptr);
+		}
+		return ConstIterator(_elements + _size - 1, _elements, _elements + _size);
+	}
+
+	ConstIterator find(const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+		if (!exists) {
+			return end();
+		}
+		return ConstIterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Indexing */
+
+	const TValue &operator[](const TKey &p_key) const {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+		CRASH_COND(!exists);
+		return _elements[element_idx].value;
+	}
+
+	TValue &operator[](const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		uint32_t hash = _hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, meta_idx, hash);
+
+		if (exists) {
+			return _elements[element_idx].value;
+		} else {
+			element_idx = _insert_element(p_key, TValue(), hash);
+			return _elements[element_idx].value;
+		}
+	}
+
+	/* Insert */
+
+	Iterator insert(const TKey &p_key, const TValue &p_value) {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		uint32_t hash = _hash(p_key);
+		bool exists = _lookup_idx_with_hash(p_key, element_idx, meta_idx, hash);
+
+		if (!exists) {
+			element_idx = _insert_element(p_key, p_value, hash);
+		} else {
+			_elements[element_idx].value = p_value;
+		}
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	// Inserts an element without checking if it already exists.
+	Iterator insert_new(const TKey &p_key, const TValue &p_value) {
+		DEV_ASSERT(!has(p_key));
+		uint32_t hash = _hash(p_key);
+		uint32_t element_idx = _insert_element(p_key, p_value, hash);
+		return Iterator(_elements + element_idx, _elements, _elements + _size);
+	}
+
+	/* Array methods. */
+
+	// Unsafe. Changing keys and going outside the bounds of an array can lead to undefined behavior.
+	KeyValue<TKey, TValue> *get_elements_ptr() {
+		return _elements;
+	}
+
+	// Returns the element index. If not found, returns -1.
+	int get_index(const TKey &p_key) {
+		uint32_t element_idx = 0;
+		uint32_t meta_idx = 0;
+		bool exists = _lookup_idx(p_key, element_idx, meta_idx);
+		if (!exists) {
+			return -1;
+		}
+		return element_idx;
+	}
+
+	KeyValue<TKey, TValue> &get_by_index(uint32_t p_index) {
+		CRASH_BAD_UNSIGNED_INDEX(p_index, _size);
+		return _elements[p_index];
+	}
+
+	bool erase_by_index(uint32_t p_index) {
+		if (p_index >= size()) {
+			return false;
+		}
+		return erase(_elements[p_index].key);
+	}
+
+	/* Constructors */
+
+	SwissHashMap(SwissHashMap &&p_other) {
+		_elements = p_other._elements;
+		_metadata = p_other._metadata;
+		_ctrl = p_other._ctrl;
+		_capacity_mask = p_other._capacity_mask;
+		_size = p_other._size;
+		_growth_left = p_other._growth_left;
+
+		p_other._elements = nullptr;
+		p_other._metadata = nullptr;
+		p_other._ctrl = nullptr;
+		p_other._capacity_mask = INITIAL_CAPACITY - 1;
+		p_other._size = 0;
+		p_other._growth_left = 0;
+	}
+
+	SwissHashMap(const SwissHashMap &p_other) {
+		_init_from(p_other);
+	}
+
+	void operator=(const SwissHashMap &p_other) {
+		if (this == &p_other) {
+			return; // Ignore self assignment.
+		}
+
+		reset();
+
+		_init_from(p_other);
+	}
+
+	SwissHashMap(uint32_t p_initial_capacity) {
+		// Capacity can't be lower than a group and must be 2^n - 1.
+		_capacity_mask = MAX(INITIAL_CAPACITY, p_initial_capacity);
+		_capacity_mask = next_power_of_2(_capacity_mask) - 1;
+	}
+	SwissHashMap() :
+			_capacity_mask(INITIAL_CAPACITY - 1) {
+	}
+
+	SwissHashMap(std::initializer_list<KeyValue<TKey, TValue>> p_init) :
+			_capacity_mask(INITIAL_CAPACITY - 1) {
+		reserve(p_init.size());
+		for (const KeyValue<TKey, TValue> &E : p_init) {
+			insert(E.key, E.value);
+		}
+	}
+
+	void reset() {
+		if (_elements != nullptr) {
+			if constexpr (!(std::is_trivially_destructible_v<TKey> && std::is_trivially_destructible_v<TValue>)) {
+				for (uint32_t i = 0; i < _size; i++) {
+					_elements[i].key.~TKey();
+					_elements[i].value.~TValue();
+				}
+			}
+			Memory::free_static(_elements);
+			Memory::free_static(_metadata);
+			Memory::free_static(_ctrl);
+			_elements = nullptr;
+			_metadata = nullptr;
+			_ctrl = nullptr;
+		}
+		_capacity_mask = INITIAL_CAPACITY - 1;
+		_size = 0;
+		_growth_left = 0;
+	}
+
+	~SwissHashMap() {
+		reset();
+	}
+};
+
+extern template class SwissHashMap<int, int>;
+extern template class SwissHashMap<String, int>;
+extern template class SwissHashMap<StringName, StringName>;
+extern template class SwissHashMap<StringName, Variant>;
+extern template class SwissHashMap<StringName, int>;
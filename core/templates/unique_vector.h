@@ -0,0 +1,141 @@
+/**************************************************************************/
+/*  unique_vector.h                                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/vector.h"
+
+/**
+ * @class UniqueVector
+ * Vector with a single owner and no copy-on-write.
+ *
+ * Uses the same buffer layout as Vector, but is move-only, so it is always
+ * the only owner of its buffer. Mutable access never has to check the
+ * reference count or fork the buffer, which makes it a better fit for tight
+ * loops in servers and resource processing.
+ *
+ * Converting from a Vector takes over its buffer, and only copies it if it
+ * is shared with other Vectors. Converting back to a Vector never copies.
+ */
+template <typename T>
+class UniqueVector {
+public:
+	typedef typename CowData<T>::Size Size;
+	typedef typename CowData<T>::USize USize;
+
+private:
+	// Invariant: the reference count of the buffer is always 1.
+	CowData<T> _cowdata;
+
+public:
+	_FORCE_INLINE_ T *ptrw() { return _cowdata._ptr; }
+	_FORCE_INLINE_ const T *ptr() const { return _cowdata._ptr; }
+	_FORCE_INLINE_ Size size() const { return _cowdata.size(); }
+	_FORCE_INLINE_ USize capacity() const { return _cowdata.capacity(); }
+
+	_FORCE_INLINE_ operator Span<T>() const { return _cowdata.span(); }
+	_FORCE_INLINE_ Span<T> span() const { return _cowdata.span(); }
+
+	_FORCE_INLINE_ void clear() { _cowdata.clear(); }
+	_FORCE_INLINE_ bool is_empty() const { return _cowdata.is_empty(); }
+
+	_FORCE_INLINE_ T &operator[](Size p_index) {
+		CRASH_BAD_INDEX(p_index, size());
+		return _cowdata._ptr[p_index];
+	}
+	_FORCE_INLINE_ const T &operator[](Size p_index) const {
+		CRASH_BAD_INDEX(p_index, size());
+		return _cowdata._ptr[p_index];
+	}
+
+	// Must take a copy instead of a reference (see GH-31736).
+	_FORCE_INLINE_ bool push_back(T p_elem) { return _cowdata.push_back(std::move(p_elem)); }
+	void remove_at(Size p_index) { _cowdata.remove_at(p_index); }
+
+	void fill(const T &p_elem) {
+		T *p = ptrw();
+		for (Size i = 0; i < size(); i++) {
+			p[i] = p_elem;
+		}
+	}
+
+	/// Resize the vector.
+	/// Elements are initialized (or not) depending on what the default C++ behavior for this type is.
+	_FORCE_INLINE_ Error resize(Size p_size) {
+		return _cowdata.template resize<!std::is_trivially_constructible_v<T>>(p_size);
+	}
+
+	/// Resize and set all values to 0 / false / nullptr.
+	/// This is only available for zero constructible types.
+	_FORCE_INLINE_ Error resize_initialized(Size p_size) {
+		return _cowdata.template resize<true>(p_size);
+	}
+
+	/// Resize without initializing the new elements.
+	/// This is only available for trivially destructible types (otherwise, trivial resize might be UB).
+	_FORCE_INLINE_ Error resize_uninitialized(Size p_size) {
+		return _cowdata.template resize<false>(p_size);
+	}
+
+	Error reserve(Size p_size) {
+		ERR_FAIL_COND_V(p_size < 0, ERR_INVALID_PARAMETER);
+		return _cowdata.reserve(p_size);
+	}
+
+	// Moves the buffer into a Vector, without copying. This vector is left empty.
+	Vector<T> release() {
+		Vector<T> ret;
+		ret._cowdata = std::move(_cowdata);
+		return ret;
+	}
+
+	_FORCE_INLINE_ T *begin() { return ptrw(); }
+	_FORCE_INLINE_ T *end() { return ptrw() + size(); }
+	_FORCE_INLINE_ const T *begin() const { return ptr(); }
+	_FORCE_INLINE_ const T *end() const { return ptr() + size(); }
+
+	void operator=(const UniqueVector &p_from) = delete;
+	void operator=(UniqueVector &&p_from) { _cowdata = std::move(p_from._cowdata); }
+
+	_FORCE_INLINE_ UniqueVector() {}
+	UniqueVector(const UniqueVector &p_from) = delete;
+	_FORCE_INLINE_ UniqueVector(UniqueVector &&p_from) = default;
+
+	// Takes over the buffer of the Vector. It is only copied if other Vectors share it.
+	explicit UniqueVector(Vector<T> &&p_from) :
+			_cowdata(std::move(p_from._cowdata)) {
+		// If forking fails, we can only crash.
+		CRASH_COND(_cowdata._copy_on_write());
+	}
+};
+
+// Zero-constructing UniqueVector initializes CowData.ptr() to nullptr and thus empty.
+template <typename T>
+struct is_zero_constructible<UniqueVector<T>> : std::true_type {};
@@ -47,6 +47,9 @@
 template <typename T>
 class Vector;
 
+template <typename T>
+class UniqueVector;
+
 template <typename T>
 class VectorWriteProxy {
 public:
@@ -60,6 +63,7 @@ public:
 template <typename T>
 class Vector {
 	friend class VectorWriteProxy<T>;
+	friend class UniqueVector<T>;
 
 public:
 	VectorWriteProxy<T> write;
@@ -38,6 +38,7 @@ STATIC_ASSERT_INCOMPLETE_TYPE(class, String);
 #include "core/math/math_funcs.h"
 #include "core/object/script_language.h"
 #include "core/templates/hashfuncs.h"
+#include "core/templates/parallel_algorithms.h"
 #include "core/templates/vector.h"
 #include "core/variant/callable.h"
 #include "core/variant/dictionary.h"
@@ -735,6 +736,11 @@ void Array::sort() {
 	_p->array.sort_custom<_ArrayVariantSort>();
 }
 
+void Array::sort_parallel() {
+	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
+	parallel_sort<Variant, _ArrayVariantSort>(_p->array.ptrw(), _p->array.size());
+}
+
 void Array::sort_custom(const Callable &p_callable) {
 	ERR_FAIL_COND_MSG(_p->read_only, "Array is in read-only state.");
 	_p->array.sort_custom<CallableComparator, true>(p_callable);
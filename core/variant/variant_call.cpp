@@ -34,10 +34,12 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/io/compression.h"
 #include "core/io/marshalls.h"
+#include "core/math/bulk_math.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
 #include "core/templates/a_hash_map.h"
 #include "core/templates/local_vector.h"
+#include "core/templates/parallel_algorithms.h"
 
 typedef void (*VariantFunc)(Variant &r_ret, Variant &p_self, const Variant **p_args);
 typedef void (*VariantConstructFunc)(Variant &r_ret, const Variant **p_args);
@@ -1155,6 +1157,59 @@ struct _VariantCall {
 		return len;
 	}
 
+	static void func_PackedFloat32Array_sort_parallel(PackedFloat32Array *p_instance) {
+		parallel_sort(p_instance->ptrw(), p_instance->size());
+	}
+
+	static double func_PackedFloat32Array_sum(PackedFloat32Array *p_instance) {
+		return BulkMath::sum(p_instance->ptr(), p_instance->size());
+	}
+
+	static float func_PackedFloat32Array_min(PackedFloat32Array *p_instance) {
+		return BulkMath::min(p_instance->ptr(), p_instance->size());
+	}
+
+	static float func_PackedFloat32Array_max(PackedFloat32Array *p_instance) {
+		return BulkMath::max(p_instance->ptr(), p_instance->size());
+	}
+
+	static void func_PackedFloat32Array_fma(PackedFloat32Array *p_instance, float p_multiplier, float p_addend) {
+		BulkMath::fma(p_instance->ptrw(), p_multiplier, p_addend, p_instance->size());
+	}
+
+	static void func_PackedVector3Array_transform_by(PackedVector3Array *p_instance, const Transform3D &p_transform) {
+		BulkMath::vector3_transform(p_instance->ptrw(), p_transform, p_instance->size());
+	}
+
+	static void func_PackedVector3Array_add(PackedVector3Array *p_instance, const PackedVector3Array &p_array) {
+		ERR_FAIL_COND_MSG(p_array.size() != p_instance->size(), "Both arrays must have the same size.");
+		BulkMath::vector3_add(p_instance->ptrw(), p_array.ptr(), p_instance->size());
+	}
+
+	static void func_PackedVector3Array_mul_scalar(PackedVector3Array *p_instance, real_t p_scalar) {
+		BulkMath::vector3_mul_scalar(p_instance->ptrw(), p_scalar, p_instance->size());
+	}
+
+	static void func_PackedVector3Array_lerp_to(PackedVector3Array *p_instance, const PackedVector3Array &p_to, real_t p_weight) {
+		ERR_FAIL_COND_MSG(p_to.size() != p_instance->size(), "Both arrays must have the same size.");
+		BulkMath::vector3_lerp(p_instance->ptrw(), p_to.ptr(), p_weight, p_instance->size());
+	}
+
+	static PackedFloat32Array func_PackedVector3Array_dot(PackedVector3Array *p_instance, const PackedVector3Array &p_array) {
+		PackedFloat32Array dest;
+		ERR_FAIL_COND_V_MSG(p_array.size() != p_instance->size(), dest, "Both arrays must have the same size.");
+		dest.resize(p_instance->size());
+		BulkMath::vector3_dot(dest.ptrw(), p_instance->ptr(), p_array.ptr(), p_instance->size());
+		return dest;
+	}
+
+	static PackedFloat32Array func_PackedVector3Array_length_squared(PackedVector3Array *p_instance) {
+		PackedFloat32Array dest;
+		dest.resize(p_instance->size());
+		BulkMath::vector3_length_squared(dest.ptrw(), p_instance->ptr(), p_instance->size());
+		return dest;
+	}
+
 	static PackedByteArray func_PackedStringArray_to_byte_array(PackedStringArray *p_instance) {
 		PackedByteArray ret;
 		uint64_t size = p_instance->size();
@@ -2702,6 +2757,7 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(Array, pop_front, sarray(), varray());
 	bind_method(Array, pop_at, sarray("position"), varray());
 	bind_method(Array, sort, sarray(), varray());
+	bind_method(Array, sort_parallel, sarray(), varray());
 	bind_method(Array, sort_custom, sarray("func"), varray());
 	bind_method(Array, shuffle, sarray(), varray());
 	bind_method(Array, bsearch, sarray("value", "before"), varray(true));
@@ -2899,6 +2955,7 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, slice, sarray("begin", "end"), varray(INT_MAX));
 	bind_method(PackedFloat32Array, to_byte_array, sarray(), varray());
 	bind_method(PackedFloat32Array, sort, sarray(), varray());
+	bind_functionnc(PackedFloat32Array, sort_parallel, _VariantCall::func_PackedFloat32Array_sort_parallel, sarray(), varray());
 	bind_method(PackedFloat32Array, bsearch, sarray("value", "before"), varray(true));
 	bind_method(PackedFloat32Array, duplicate, sarray(), varray());
 #ifndef DISABLE_DEPRECATED
@@ -2909,6 +2966,10 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedFloat32Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedFloat32Array, count, sarray("value"), varray());
 	bind_method(PackedFloat32Array, erase, sarray("value"), varray());
+	bind_function(PackedFloat32Array, sum, _VariantCall::func_PackedFloat32Array_sum, sarray(), varray());
+	bind_function(PackedFloat32Array, min, _VariantCall::func_PackedFloat32Array_min, sarray(), varray());
+	bind_function(PackedFloat32Array, max, _VariantCall::func_PackedFloat32Array_max, sarray(), varray());
+	bind_functionnc(PackedFloat32Array, fma, _VariantCall::func_PackedFloat32Array_fma, sarray("multiplier", "addend"), varray());
 
 	/* Float64 Array */
 
@@ -3021,6 +3082,12 @@ static void _register_variant_builtin_methods_array() {
 	bind_method(PackedVector3Array, rfind, sarray("value", "from"), varray(-1));
 	bind_method(PackedVector3Array, count, sarray("value"), varray());
 	bind_method(PackedVector3Array, erase, sarray("value"), varray());
+	bind_functionnc(PackedVector3Array, transform_by, _VariantCall::func_PackedVector3Array_transform_by, sarray("transform"), varray());
+	bind_functionnc(PackedVector3Array, add, _VariantCall::func_PackedVector3Array_add, sarray("array"), varray());
+	bind_functionnc(PackedVector3Array, mul_scalar, _VariantCall::func_PackedVector3Array_mul_scalar, sarray("scalar"), varray());
+	bind_functionnc(PackedVector3Array, lerp_to, _VariantCall::func_PackedVector3Array_lerp_to, sarray("to", "weight"), varray());
+	bind_function(PackedVector3Array, dot, _VariantCall::func_PackedVector3Array_dot, sarray("array"), varray());
+	bind_function(PackedVector3Array, length_squared, _VariantCall::func_PackedVector3Array_length_squared, sarray(), varray());
 
 	/* Color Array */
 
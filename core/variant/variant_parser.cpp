@@ -34,25 +34,21 @@
 #include "core/io/resource_loader.h"
 #include "core/io/resource_uid.h"
 #include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
 #include "core/string/string_buffer.h"
 
-char32_t VariantParser::Stream::get_char() {
-	// is within buffer?
-	if (readahead_pointer < readahead_filled) {
-		return readahead_buffer[readahead_pointer++];
-	}
-
+char32_t VariantParser::Stream::_get_char_slow() {
 	// attempt to readahead
 	readahead_filled = _read_buffer(readahead_buffer, readahead_enabled ? READAHEAD_SIZE : 1);
 	if (readahead_filled) {
-		readahead_pointer = 0;
-	} else {
-		// EOF
 		readahead_pointer = 1;
-		eof = true;
-		return 0;
+		return readahead_buffer[0];
 	}
-	return get_char();
+
+	// EOF
+	readahead_pointer = 1;
+	eof = true;
+	return 0;
 }
 
 bool VariantParser::Stream::is_eof() const {
@@ -158,7 +154,32 @@ static double stor_fix(const String &p_str) {
 	return -1;
 }
 
+static _FORCE_INLINE_ void _append_utf8(LocalVector<char> &r_buffer, char32_t p_char) {
+	if (p_char < 0x80) {
+		r_buffer.push_back(char(p_char));
+	} else if (p_char < 0x800) {
+		r_buffer.push_back(char(0xc0 | (p_char >> 6)));
+		r_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	} else if (p_char < 0x10000) {
+		r_buffer.push_back(char(0xe0 | (p_char >> 12)));
+		r_buffer.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		r_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	} else {
+		r_buffer.push_back(char(0xf0 | ((p_char >> 18) & 0x07)));
+		r_buffer.push_back(char(0x80 | ((p_char >> 12) & 0x3f)));
+		r_buffer.push_back(char(0x80 | ((p_char >> 6) & 0x3f)));
+		r_buffer.push_back(char(0x80 | (p_char & 0x3f)));
+	}
+}
+
 Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str) {
+	return _get_token(p_stream, r_token, line, r_err_str, nullptr);
+}
+
+// When `r_number_text` is given, numbers are not converted. Their text is appended to it
+// (null-terminated) and the token value is set to whether the number is a float, so
+// long number lists can be converted in bulk by the caller.
+Error VariantParser::_get_token(Stream *p_stream, Token &r_token, int &line, String &r_err_str, LocalVector<char> *r_number_text) {
 	bool string_name = false;
 
 	while (true) {
@@ -274,7 +295,11 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				[[fallthrough]];
 			}
 			case '"': {
-				String str;
+				// UTF-8 streams keep the raw bytes and decode them once at the end.
+				const bool utf8 = p_stream->is_utf8();
+				LocalVector<char> &utf8_str = p_stream->token_buffer;
+				utf8_str.clear();
+				StringBuffer<> str;
 				char32_t prev = 0;
 				while (true) {
 					char32_t ch = p_stream->get_char();
@@ -377,7 +402,11 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 							r_token.type = TK_ERROR;
 							return ERR_PARSE_ERROR;
 						}
-						str += res;
+						if (utf8) {
+							_append_utf8(utf8_str, res);
+						} else {
+							str += res;
+						}
 					} else {
 						if (prev != 0) {
 							r_err_str = "Invalid UTF-16 sequence in string, unpaired lead surrogate";
@@ -387,7 +416,11 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						if (ch == '\n') {
 							line++;
 						}
-						str += ch;
+						if (utf8) {
+							utf8_str.push_back(char(ch));
+						} else {
+							str += ch;
+						}
 					}
 				}
 				if (prev != 0) {
@@ -396,18 +429,18 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 					return ERR_PARSE_ERROR;
 				}
 
-				if (p_stream->is_utf8()) {
-					// Re-interpret the string we built as ascii.
-					CharString string_as_ascii = str.ascii(true);
-					str.clear();
-					str.append_utf8(string_as_ascii);
+				String result;
+				if (!utf8) {
+					result = str.as_string();
+				} else if (utf8_str.size()) {
+					result.append_utf8(utf8_str.ptr(), utf8_str.size());
 				}
 				if (string_name) {
 					r_token.type = TK_STRING_NAME;
-					r_token.value = StringName(str);
+					r_token.value = StringName(result);
 				} else {
 					r_token.type = TK_STRING;
-					r_token.value = str;
+					r_token.value = result;
 				}
 				return OK;
 
@@ -416,12 +449,21 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 				if (cchar <= 32) {
 					break;
 				}
-				StringBuffer<> token_text;
+				bool negative = false;
 				if (cchar == '-') {
-					token_text += '-';
+					negative = true;
 					cchar = p_stream->get_char();
 				}
 				if (cchar >= '0' && cchar <= '9') {
+					LocalVector<char> &number_text = r_number_text ? *r_number_text : p_stream->token_buffer;
+					if (!r_number_text) {
+						number_text.clear();
+					}
+					const uint32_t number_start = number_text.size();
+					if (negative) {
+						number_text.push_back('-');
+					}
+
 					//a number
 #define READING_SIGN 0
 #define READING_INT 1
@@ -476,21 +518,28 @@ Error VariantParser::get_token(Stream *p_stream, Token &r_token, int &line, Stri
 						if (reading == READING_DONE) {
 							break;
 						}
-						token_text += c;
+						number_text.push_back(char(c));
 						c = p_stream->get_char();
 					}
+					number_text.push_back(0);
 
 					p_stream->saved = c;
 
 					r_token.type = TK_NUMBER;
 
-					if (is_float) {
-						r_token.value = token_text.as_double();
+					if (r_number_text) {
+						r_token.value = is_float;
+					} else if (is_float) {
+						r_token.value = String::to_float(number_text.ptr() + number_start);
 					} else {
-						r_token.value = token_text.as_int();
+						r_token.value = String::to_int(number_text.ptr() + number_start);
 					}
 					return OK;
 				} else if (is_ascii_alphabet_char(cchar) || is_underscore(cchar)) {
+					StringBuffer<> token_text;
+					if (negative) {
+						token_text += '-';
+					}
 					bool first = true;
 
 					while (is_ascii_alphabet_char(cchar) || is_underscore(cchar) || (!first && is_digit(cchar))) {
@@ -548,6 +597,42 @@ Error VariantParser::_parse_enginecfg(Stream *p_stream, Vector<String> &strings,
 	}
 }
 
+// Numbers of long constructs (packed arrays in scenes and meshes) are converted in blocks,
+// spread over the WorkerThreadPool once there are enough of them.
+static constexpr uint32_t NUMBER_BLOCK_SIZE = 4096;
+static constexpr uint32_t NUMBER_PARALLEL_MIN = 16 * NUMBER_BLOCK_SIZE;
+
+struct VariantParserNumber {
+	uint32_t text_ofs = 0;
+	bool is_float = false;
+	bool is_fixed = false;
+	double fixed = 0.0; // Identifiers such as `inf` and `nan`.
+};
+
+template <typename T>
+struct VariantParserNumberBlocks {
+	const char *text = nullptr;
+	const VariantParserNumber *numbers = nullptr;
+	T *dst = nullptr;
+	uint32_t count = 0;
+
+	static void convert_block(void *p_userdata, uint32_t p_block) {
+		const VariantParserNumberBlocks *blocks = (const VariantParserNumberBlocks *)p_userdata;
+		const uint32_t from = p_block * NUMBER_BLOCK_SIZE;
+		const uint32_t to = MIN(from + NUMBER_BLOCK_SIZE, blocks->count);
+		for (uint32_t i = from; i < to; i++) {
+			const VariantParserNumber &number = blocks->numbers[i];
+			if (number.is_fixed) {
+				blocks->dst[i] = T(number.fixed);
+			} else if (number.is_float) {
+				blocks->dst[i] = T(String::to_float(blocks->text + number.text_ofs));
+			} else {
+				blocks->dst[i] = T(String::to_int(blocks->text + number.text_ofs));
+			}
+		}
+	}
+};
+
 template <typename T>
 Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct, int &line, String &r_err_str) {
 	Token token;
@@ -557,6 +642,9 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 		return ERR_PARSE_ERROR;
 	}
 
+	LocalVector<char> text;
+	LocalVector<VariantParserNumber> numbers;
+
 	bool first = true;
 	while (true) {
 		if (!first) {
@@ -570,17 +658,21 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 				return ERR_PARSE_ERROR;
 			}
 		}
-		get_token(p_stream, token, line, r_err_str);
+		VariantParserNumber number;
+		number.text_ofs = text.size();
+		_get_token(p_stream, token, line, r_err_str, &text);
 
 		if (first && token.type == TK_PARENTHESIS_CLOSE) {
 			break;
-		} else if (token.type != TK_NUMBER) {
+		} else if (token.type == TK_NUMBER) {
+			number.is_float = token.value;
+		} else {
 			bool valid = false;
 			if (token.type == TK_IDENTIFIER) {
 				double real = stor_fix(token.value);
 				if (real != -1) {
-					token.type = TK_NUMBER;
-					token.value = real;
+					number.is_fixed = true;
+					number.fixed = real;
 					valid = true;
 				}
 			}
@@ -590,10 +682,29 @@ Error VariantParser::_parse_construct(Stream *p_stream, Vector<T> &r_construct,
 			}
 		}
 
-		r_construct.push_back(token.value);
+		numbers.push_back(number);
 		first = false;
 	}
 
+	const uint32_t prev_size = r_construct.size();
+	r_construct.resize(prev_size + numbers.size());
+
+	VariantParserNumberBlocks<T> blocks;
+	blocks.text = text.ptr();
+	blocks.numbers = numbers.ptr();
+	blocks.dst = r_construct.ptrw() + prev_size;
+	blocks.count = numbers.size();
+
+	const uint32_t block_count = Math::division_round_up(blocks.count, NUMBER_BLOCK_SIZE);
+	if (blocks.count >= NUMBER_PARALLEL_MIN && WorkerThreadPool::get_singleton()) {
+		WorkerThreadPool::GroupID group_task = WorkerThreadPool::get_singleton()->add_native_group_task(&VariantParserNumberBlocks<T>::convert_block, &blocks, block_count, -1, true);
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group_task);
+	} else {
+		for (uint32_t i = 0; i < block_count; i++) {
+			VariantParserNumberBlocks<T>::convert_block(&blocks, i);
+		}
+	}
+
 	return OK;
 }
 
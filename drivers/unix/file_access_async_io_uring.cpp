@@ -0,0 +1,321 @@
+/**************************************************************************/
+/*  file_access_async_io_uring.cpp                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "file_access_async_io_uring.h"
+
+#ifdef IO_URING_ENABLED
+
+#include "core/os/os.h"
+#include "core/string/print_string.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+
+void FileAccessAsyncIOUring::make_default() {
+	_create = _create_io_uring;
+}
+
+FileAccessAsync *FileAccessAsyncIOUring::_create_io_uring() {
+	return memnew(FileAccessAsyncIOUring);
+}
+
+bool FileAccessAsyncIOUring::_setup_ring() {
+	io_uring_params params;
+	memset(&params, 0, sizeof(params));
+	ring_fd = syscall(__NR_io_uring_setup, QUEUE_DEPTH, &params);
+	if (ring_fd < 0) {
+		return false;
+	}
+
+	sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+	cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+	const bool single_mmap = params.features & IORING_FEAT_SINGLE_MMAP;
+	if (single_mmap) {
+		sq_ring_size = MAX(sq_ring_size, cq_ring_size);
+		cq_ring_size = sq_ring_size;
+	}
+
+	sq_ring = mmap(nullptr, sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQ_RING);
+	if (sq_ring == MAP_FAILED) {
+		sq_ring = nullptr;
+		_teardown_ring();
+		return false;
+	}
+	if (single_mmap) {
+		cq_ring = sq_ring;
+	} else {
+		cq_ring = mmap(nullptr, cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_CQ_RING);
+		if (cq_ring == MAP_FAILED) {
+			cq_ring = nullptr;
+			_teardown_ring();
+			return false;
+		}
+	}
+	sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+	void *sqes_ptr = mmap(nullptr, sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd, IORING_OFF_SQES);
+	if (sqes_ptr == MAP_FAILED) {
+		_teardown_ring();
+		return false;
+	}
+	sqes = static_cast<io_uring_sqe *>(sqes_ptr);
+
+	uint8_t *sq = static_cast<uint8_t *>(sq_ring);
+	sq_head = reinterpret_cast<uint32_t *>(sq + params.sq_off.head);
+	sq_tail = reinterpret_cast<uint32_t *>(sq + params.sq_off.tail);
+	sq_mask = *reinterpret_cast<uint32_t *>(sq + params.sq_off.ring_mask);
+	sq_array = reinterpret_cast<uint32_t *>(sq + params.sq_off.array);
+	uint8_t *cq = static_cast<uint8_t *>(cq_ring);
+	cq_head = reinterpret_cast<uint32_t *>(cq + params.cq_off.head);
+	cq_tail = reinterpret_cast<uint32_t *>(cq + params.cq_off.tail);
+	cq_mask = *reinterpret_cast<uint32_t *>(cq + params.cq_off.ring_mask);
+	cqes = reinterpret_cast<io_uring_cqe *>(cq + params.cq_off.cqes);
+	sq_entries = params.sq_entries;
+
+	return true;
+}
+
+void FileAccessAsyncIOUring::_teardown_ring() {
+	if (sqes) {
+		munmap(sqes, sqes_size);
+		sqes = nullptr;
+	}
+	if (cq_ring && cq_ring != sq_ring) {
+		munmap(cq_ring, cq_ring_size);
+	}
+	cq_ring = nullptr;
+	if (sq_ring) {
+		munmap(sq_ring, sq_ring_size);
+		sq_ring = nullptr;
+	}
+	if (ring_fd >= 0) {
+		::close(ring_fd);
+		ring_fd = -1;
+	}
+}
+
+bool FileAccessAsyncIOUring::_submit_sqe(const io_uring_sqe &p_sqe) {
+	// Only called with the mutex held, which makes this the only thread submitting.
+	const uint32_t tail = *sq_tail;
+	const uint32_t index = tail & sq_mask;
+	sqes[index] = p_sqe;
+	sq_array[index] = index;
+	__atomic_store_n(sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+	_enter(1, 0);
+	if (__atomic_load_n(sq_head, __ATOMIC_ACQUIRE) == tail) {
+		// The kernel can't take it right now (EAGAIN or EBUSY). Take it back, so the caller can do without.
+		__atomic_store_n(sq_tail, tail, __ATOMIC_RELEASE);
+		return false;
+	}
+	return true;
+}
+
+bool FileAccessAsyncIOUring::_push_read(uint64_t p_id, PendingRead &p_pending) {
+	const Ref<FileAccessAsyncRead> &read = p_pending.read;
+	p_pending.iov.iov_base = read->get_destination() + p_pending.done;
+	p_pending.iov.iov_len = MIN(read->get_length() - p_pending.done, MAX_READ_CHUNK);
+
+	io_uring_sqe sqe;
+	memset(&sqe, 0, sizeof(io_uring_sqe));
+	sqe.opcode = IORING_OP_READV;
+	sqe.fd = p_pending.fd;
+	sqe.off = read->get_offset() + p_pending.done;
+	sqe.addr = (uint64_t)(uintptr_t)&p_pending.iov;
+	sqe.len = 1;
+	sqe.user_data = p_id;
+
+	if (!_submit_sqe(sqe)) {
+		return false;
+	}
+	in_flight++;
+	return true;
+}
+
+void FileAccessAsyncIOUring::_push_exit() {
+	io_uring_sqe sqe;
+	memset(&sqe, 0, sizeof(io_uring_sqe));
+	sqe.opcode = IORING_OP_NOP;
+	sqe.user_data = 0;
+
+	// The reaper only exits once it gets this, so it's retried until the kernel takes it.
+	while (!_submit_sqe(sqe)) {
+		OS::get_singleton()->delay_usec(1000);
+	}
+}
+
+int FileAccessAsyncIOUring::_enter(uint32_t p_to_submit, uint32_t p_min_complete) {
+	const unsigned flags = p_min_complete ? IORING_ENTER_GETEVENTS : 0;
+	int ret;
+	do {
+		ret = syscall(__NR_io_uring_enter, ring_fd, p_to_submit, p_min_complete, flags, nullptr, 0);
+	} while (ret < 0 && errno == EINTR);
+	return ret;
+}
+
+void FileAccessAsyncIOUring::_complete(uint64_t p_id, int32_t p_result) {
+	MutexLock lock(mutex);
+	in_flight--;
+
+	HashMap<uint64_t, PendingRead>::Iterator E = pending.find(p_id);
+	ERR_FAIL_COND(!E);
+	PendingRead &pending_read = E->value;
+
+	if (p_result > 0) {
+		pending_read.done += p_result;
+		if (pending_read.done < pending_read.read->get_length()) {
+			// A split or short read, continue until the end of the file.
+			if (_push_read(p_id, pending_read)) {
+				return;
+			}
+			// The kernel can't take more right now, read the rest right here.
+			p_result = _read_rest(pending_read);
+		}
+	}
+
+	const Ref<FileAccessAsyncRead> read = pending_read.read;
+	const int fd = pending_read.fd;
+	const uint64_t done = pending_read.done;
+	pending.remove(E);
+	lock.temp_unlock();
+
+	::close(fd);
+	read->complete(p_result < 0 ? ERR_FILE_CANT_READ : OK, done);
+}
+
+int32_t FileAccessAsyncIOUring::_read_rest(PendingRead &p_pending) {
+	const Ref<FileAccessAsyncRead> &read = p_pending.read;
+	while (p_pending.done < read->get_length()) {
+		const ssize_t ret = pread(p_pending.fd, read->get_destination() + p_pending.done, MIN(read->get_length() - p_pending.done, MAX_READ_CHUNK), read->get_offset() + p_pending.done);
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ret <= 0) {
+			return ret < 0 ? -errno : 0;
+		}
+		p_pending.done += ret;
+	}
+	return 1;
+}
+
+void FileAccessAsyncIOUring::_reaper_func(void *p_self) {
+	FileAccessAsyncIOUring *self = static_cast<FileAccessAsyncIOUring *>(p_self);
+
+	bool exit_requested = false;
+	while (true) {
+		// Only waits, reads are submitted by whoever starts them.
+		self->_enter(0, 1);
+
+		uint32_t head = *self->cq_head;
+		const uint32_t tail = __atomic_load_n(self->cq_tail, __ATOMIC_ACQUIRE);
+		for (; head != tail; head++) {
+			const io_uring_cqe *cqe = &self->cqes[head & self->cq_mask];
+			const uint64_t id = cqe->user_data;
+			const int32_t result = cqe->res;
+			// Hand the entry back before completing, completing may queue more.
+			__atomic_store_n(self->cq_head, head + 1, __ATOMIC_RELEASE);
+
+			if (id == 0) {
+				exit_requested = true;
+			} else {
+				self->_complete(id, result);
+			}
+		}
+
+		if (exit_requested) {
+			// Reads still in flight are completed first, something may be waiting for them.
+			MutexLock lock(self->mutex);
+			if (self->pending.is_empty()) {
+				break;
+			}
+		}
+	}
+}
+
+bool FileAccessAsyncIOUring::_submit_native(const Ref<FileAccessAsyncRead> &p_read, int p_fd) {
+	if (ring_fd < 0) {
+		return false;
+	}
+	if (p_read->get_length() == 0) {
+		p_read->complete(OK, 0);
+		return true;
+	}
+
+	MutexLock lock(mutex);
+	// One slot is kept for the exit request.
+	if (exiting || in_flight >= sq_entries - 1) {
+		return false;
+	}
+
+	const int fd = fcntl(p_fd, F_DUPFD_CLOEXEC, 0);
+	if (fd < 0) {
+		return false;
+	}
+
+	const uint64_t id = ++last_id;
+	PendingRead &pending_read = pending.insert(id, PendingRead())->value;
+	pending_read.read = p_read;
+	pending_read.fd = fd;
+	if (!_push_read(id, pending_read)) {
+		// The kernel can't take it right now, it's queued for the threads instead.
+		pending.erase(id);
+		::close(fd);
+		return false;
+	}
+	return true;
+}
+
+FileAccessAsyncIOUring::FileAccessAsyncIOUring() {
+	if (!_setup_ring()) {
+		print_verbose("io_uring is not available, asynchronous file reads use threads instead.");
+		return;
+	}
+	reaper.start(&FileAccessAsyncIOUring::_reaper_func, this);
+}
+
+FileAccessAsyncIOUring::~FileAccessAsyncIOUring() {
+	if (ring_fd < 0) {
+		return;
+	}
+
+	{
+		MutexLock lock(mutex);
+		exiting = true;
+		_push_exit();
+	}
+	reaper.wait_to_finish();
+	_teardown_ring();
+}
+
+#endif // IO_URING_ENABLED
@@ -0,0 +1,108 @@
+/**************************************************************************/
+/*  file_access_async_io_uring.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef IO_URING_ENABLED
+
+#include "core/io/file_access_async.h"
+#include "core/templates/hash_map.h"
+
+#include <sys/uio.h>
+
+struct io_uring_sqe;
+struct io_uring_cqe;
+
+// Hands asynchronous reads to the kernel through an io_uring, so any number of them can be in flight without a thread
+// blocked on each. Talks to the kernel directly, so it doesn't need liburing. Falls back to the reader threads if the
+// kernel doesn't support io_uring or doesn't allow it (e.g. in some containers), or when it can't take more reads.
+class FileAccessAsyncIOUring : public FileAccessAsync {
+	static constexpr uint32_t QUEUE_DEPTH = 64;
+	// Longer reads are split, Linux won't read more than about 2 GiB at once anyway.
+	static constexpr uint64_t MAX_READ_CHUNK = 1 << 30;
+
+	struct PendingRead {
+		Ref<FileAccessAsyncRead> read;
+		int fd = -1; // Our own duplicate, so closing the file doesn't affect the read.
+		uint64_t done = 0;
+		iovec iov = {};
+	};
+
+	int ring_fd = -1;
+	uint32_t sq_entries = 0;
+
+	void *sq_ring = nullptr;
+	size_t sq_ring_size = 0;
+	void *cq_ring = nullptr;
+	size_t cq_ring_size = 0;
+	io_uring_sqe *sqes = nullptr;
+	size_t sqes_size = 0;
+
+	uint32_t *sq_head = nullptr;
+	uint32_t *sq_tail = nullptr;
+	uint32_t sq_mask = 0;
+	uint32_t *sq_array = nullptr;
+	uint32_t *cq_head = nullptr;
+	uint32_t *cq_tail = nullptr;
+	uint32_t cq_mask = 0;
+	io_uring_cqe *cqes = nullptr;
+
+	// Guards the submission queue and everything below.
+	Mutex mutex;
+	HashMap<uint64_t, PendingRead> pending;
+	uint64_t last_id = 0;
+	uint32_t in_flight = 0;
+	bool exiting = false;
+
+	Thread reaper;
+
+	bool _setup_ring();
+	void _teardown_ring();
+	bool _submit_sqe(const io_uring_sqe &p_sqe);
+	bool _push_read(uint64_t p_id, PendingRead &p_pending);
+	void _push_exit();
+	int _enter(uint32_t p_to_submit, uint32_t p_min_complete);
+	void _complete(uint64_t p_id, int32_t p_result);
+	static int32_t _read_rest(PendingRead &p_pending);
+	static void _reaper_func(void *p_self);
+
+	static FileAccessAsync *_create_io_uring();
+
+protected:
+	virtual bool _submit_native(const Ref<FileAccessAsyncRead> &p_read, int p_fd) override;
+
+public:
+	static void make_default();
+
+	FileAccessAsyncIOUring();
+	~FileAccessAsyncIOUring();
+};
+
+#endif // IO_URING_ENABLED
@@ -32,6 +32,7 @@
 
 #if defined(UNIX_ENABLED)
 
+#include "core/io/file_access_async.h"
 #include "core/os/os.h"
 #include "core/string/print_string.h"
 
@@ -309,6 +310,47 @@ uint64_t FileAccessUnix::get_buffer(uint8_t *p_dst, uint64_t p_length) const {
 	return read;
 }
 
+uint64_t FileAccessUnix::get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) {
+	ERR_FAIL_NULL_V_MSG(f, -1, "File must be opened before use.");
+	ERR_FAIL_COND_V(!p_dst && p_length > 0, -1);
+
+	if (flags & WRITE) {
+		fflush(f); // Otherwise buffered writes wouldn't be read back.
+	}
+
+	// Doesn't touch the stream position, so it's safe to use from other threads.
+	const int fd = fileno(f);
+	uint64_t read = 0;
+	while (read < p_length) {
+		const ssize_t ret = ::pread(fd, p_dst + read, MIN(p_length - read, (uint64_t)INT32_MAX), p_offset + read);
+		if (ret < 0 && errno == EINTR) {
+			continue;
+		}
+		if (ret <= 0) {
+			break;
+		}
+		read += ret;
+	}
+	return read;
+}
+
+bool FileAccessUnix::can_read_async() const {
+	return f && FileAccessAsync::get_singleton();
+}
+
+void FileAccessUnix::_read_async(const Ref<FileAccessAsyncRead> &p_read) {
+	FileAccessAsync *async = FileAccessAsync::get_singleton();
+	if (!f || !async) {
+		FileAccess::_read_async(p_read);
+		return;
+	}
+
+	if (flags & WRITE) {
+		fflush(f);
+	}
+	async->submit(p_read, fileno(f));
+}
+
 Error FileAccessUnix::get_error() const {
 	return last_error;
 }
@@ -71,6 +71,8 @@ public:
 	virtual bool eof_reached() const override; ///< reading passed EOF
 
 	virtual uint64_t get_buffer(uint8_t *p_dst, uint64_t p_length) const override;
+	virtual uint64_t get_buffer_at(uint64_t p_offset, uint8_t *p_dst, uint64_t p_length) override;
+	virtual bool can_read_async() const override;
 
 	virtual Error get_error() const override; ///< get last error
 
@@ -96,6 +98,8 @@ public:
 	virtual Error _remove_extended_attribute(const String &p_file, const String &p_attribute_name) override;
 	virtual PackedStringArray _get_extended_attributes_list(const String &p_file) override;
 
+	virtual void _read_async(const Ref<FileAccessAsyncRead> &p_read) override;
+
 	virtual void close() override;
 
 	FileAccessUnix() {}
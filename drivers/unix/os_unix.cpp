@@ -36,6 +36,7 @@
 #include "core/debugger/engine_debugger.h"
 #include "core/debugger/script_debugger.h"
 #include "drivers/unix/dir_access_unix.h"
+#include "drivers/unix/file_access_async_io_uring.h"
 #include "drivers/unix/file_access_unix.h"
 #include "drivers/unix/file_access_unix_pipe.h"
 #include "drivers/unix/net_socket_unix.h"
@@ -68,8 +69,16 @@
 #include <uvm/uvm_extern.h>
 #endif
 
+#if defined(__linux__)
+#include <sys/statfs.h>
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+#include <sys/mount.h>
+#endif
+
 #include <dlfcn.h>
+#include <fcntl.h>
 #include <poll.h>
+#include <sys/mman.h>
 #include <sys/resource.h>
 #include <sys/stat.h>
 #include <sys/time.h>
@@ -169,6 +178,9 @@ void OS_Unix::initialize_core() {
 	FileAccess::make_default<FileAccessUnix>(FileAccess::ACCESS_USERDATA);
 	FileAccess::make_default<FileAccessUnix>(FileAccess::ACCESS_FILESYSTEM);
 	FileAccess::make_default<FileAccessUnixPipe>(FileAccess::ACCESS_PIPE);
+#ifdef IO_URING_ENABLED
+	FileAccessAsyncIOUring::make_default();
+#endif
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_RESOURCES);
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_USERDATA);
 	DirAccess::make_default<DirAccessUnix>(DirAccess::ACCESS_FILESYSTEM);
@@ -1088,6 +1100,115 @@ Error OS_Unix::get_dynamic_library_symbol_handle(void *p_library_handle, const S
 	return OK;
 }
 
+// Reading a mapped page that can't be fetched raises SIGBUS instead of failing like read() does.
+// Files on network filesystems and on removable media can go away under the mapping, so they aren't mapped.
+static bool _can_map_file_safely(int p_fd) {
+#if defined(__linux__)
+	struct statfs fs;
+	if (fstatfs(p_fd, &fs) != 0) {
+		return false;
+	}
+	switch (static_cast<unsigned int>(fs.f_type)) {
+		// Network filesystems.
+		case 0x6969: // NFS
+		case 0x517B: // SMB
+		case 0xFF534D42: // CIFS
+		case 0xFE534D42: // SMB2
+		case 0x5346414f: // AFS
+		case 0x00c36400: // CEPH
+		case 0x73757245: // CODA
+		case 0x01021997: // 9P
+		case 0x65735546: // FUSE (also used for sshfs, and for exFAT and NTFS drives by some distributions)
+		// Filesystems of removable media.
+		case 0x4d44: // FAT32
+		case 0x2011bab0: // EXFAT
+		case 0x9660: // ISOFS
+		case 0x15013346: // UDF
+			return false;
+		default:
+			return true;
+	}
+#elif defined(__APPLE__) || defined(__FreeBSD__) || defined(__OpenBSD__)
+	struct statfs fs;
+	if (fstatfs(p_fd, &fs) != 0) {
+		return false;
+	}
+#ifdef MNT_REMOVABLE
+	if (fs.f_flags & MNT_REMOVABLE) {
+		return false;
+	}
+#endif
+	return fs.f_flags & MNT_LOCAL;
+#else
+	return true;
+#endif
+}
+
+Error OS_Unix::map_file(const String &p_path, const uint8_t *&r_data, uint64_t &r_size, void *&r_handle) {
+	r_data = nullptr;
+	r_size = 0;
+	r_handle = nullptr;
+
+#ifdef WEB_ENABLED
+	// Emscripten emulates mmap() by copying the whole file into the heap, which defeats the purpose.
+	return ERR_UNAVAILABLE;
+#else
+	int fd = ::open(p_path.utf8().get_data(), O_RDONLY | O_CLOEXEC);
+	if (fd == -1) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	struct stat st = {};
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+		::close(fd);
+		return ERR_FILE_CANT_OPEN;
+	}
+	if (!_can_map_file_safely(fd)) {
+		::close(fd);
+		return ERR_UNAVAILABLE;
+	}
+	if (st.st_size == 0) {
+		::close(fd);
+		return OK; // Nothing to map, mmap() rejects zero-length mappings.
+	}
+	if ((uint64_t)st.st_size > (uint64_t)SIZE_MAX) {
+		::close(fd);
+		return ERR_OUT_OF_MEMORY; // Can't fit into the address space (32-bit).
+	}
+
+	void *data = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	if (data == MAP_FAILED) {
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	r_data = (const uint8_t *)data;
+	r_size = st.st_size;
+	return OK;
+#endif
+}
+
+Error OS_Unix::unmap_file(void *p_handle, const uint8_t *p_data, uint64_t p_size) {
+	if (!p_data) {
+		return OK;
+	}
+	if (munmap((void *)p_data, (size_t)p_size) != 0) {
+		return FAILED;
+	}
+	return OK;
+}
+
+void OS_Unix::prefetch_mapped_range(const uint8_t *p_data, uint64_t p_size) {
+	if (!p_data || !p_size) {
+		return;
+	}
+	// madvise() needs a page-aligned start.
+	static const uintptr_t page_size = sysconf(_SC_PAGESIZE);
+	uintptr_t start = (uintptr_t)p_data & ~(page_size - 1);
+	madvise((void *)start, (uintptr_t)p_data - start + p_size, MADV_WILLNEED);
+}
+
 Error OS_Unix::set_cwd(const String &p_cwd) {
 	if (chdir(p_cwd.utf8().get_data()) != 0) {
 		return ERR_CANT_OPEN;
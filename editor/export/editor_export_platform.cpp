@@ -41,6 +41,7 @@
 #include "core/io/file_access_pack.h" // PACK_HEADER_MAGIC, PACK_FORMAT_VERSION
 #include "core/io/image.h"
 #include "core/io/image_loader.h"
+#include "core/io/pck_packer.h"
 #include "core/io/resource_uid.h"
 #include "core/math/random_pcg.h"
 #include "core/os/shared_object.h"
@@ -237,21 +238,26 @@ void EditorExportPlatform::_unload_patches() {
 	PackedData::get_singleton()->clear();
 }
 
-Error EditorExportPlatform::_encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt) {
-	r_encrypt = false;
+bool EditorExportPlatform::_should_encrypt_file(const String &p_path, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters) {
+	bool encrypt = false;
 	for (int i = 0; i < p_enc_in_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_in_filters[i]) || p_path.trim_prefix("res://").matchn(p_enc_in_filters[i])) {
-			r_encrypt = true;
+			encrypt = true;
 			break;
 		}
 	}
 
 	for (int i = 0; i < p_enc_ex_filters.size(); ++i) {
 		if (p_path.matchn(p_enc_ex_filters[i]) || p_path.trim_prefix("res://").matchn(p_enc_ex_filters[i])) {
-			r_encrypt = false;
+			encrypt = false;
 			break;
 		}
 	}
+	return encrypt;
+}
+
+Error EditorExportPlatform::_encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt) {
+	r_encrypt = _should_encrypt_file(p_path, p_enc_in_filters, p_enc_ex_filters);
 
 	Ref<FileAccessEncrypted> fae;
 	Ref<FileAccess> ftmp = p_fd;
@@ -310,18 +316,51 @@ Error EditorExportPlatform::_save_pack_file(const Ref<EditorExportPreset> &p_pre
 	sd.ofs = (pd->use_sparse_pck) ? 0 : pd->f->get_position();
 	sd.size = p_data.size();
 	sd.delta = p_delta;
-	Error err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
-	if (err != OK) {
-		return err;
-	}
-	if (!pd->use_sparse_pck) {
-		ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+
+	// Same as PCKPacker: files with the same contents share their storage, and are compressed
+	// if that makes them smaller. Encrypted and delta files aren't compressed.
+	const SavedData *stored = nullptr;
+	String content_key;
+	if (!pd->use_sparse_pck && !p_delta) {
+		sd.encrypted = _should_encrypt_file(simplified_path, p_enc_in_filters, p_enc_ex_filters);
+		if (pd->deduplicate_files) {
+			content_key = PCKPacker::get_content_key(p_data, sd.encrypted, pd->compress_files);
+			HashMap<String, int>::ConstIterator E = pd->stored_contents.find(content_key);
+			if (E) {
+				stored = &pd->file_ofs[E->value];
+			}
+		}
 	}
 
-	if (!pd->use_sparse_pck) {
-		int pad = _get_pad(PCK_PADDING, pd->f->get_position());
-		for (int i = 0; i < pad; i++) {
-			pd->f->store_8(0);
+	if (stored) {
+		sd.ofs = stored->ofs;
+		sd.stored_size = stored->stored_size;
+		sd.compressed = stored->compressed;
+	} else {
+		if (!pd->use_sparse_pck && !p_delta && pd->compress_files && !sd.encrypted && !p_data.is_empty()) {
+			// If not kept, the tail is overwritten by what follows or truncated once the pack is complete.
+			sd.compressed = PCKPacker::store_compressed(pd->f, p_data, sd.stored_size);
+		}
+
+		if (!sd.compressed) {
+			Error err = _encrypt_and_store_data(ftmp, simplified_path, p_data, p_enc_in_filters, p_enc_ex_filters, p_key, p_seed, sd.encrypted);
+			if (err != OK) {
+				return err;
+			}
+			if (!pd->use_sparse_pck) {
+				ERR_FAIL_COND_V(pd->f->get_position() - sd.ofs < (uint64_t)p_data.size(), ERR_FILE_CANT_WRITE);
+			}
+		}
+
+		if (!pd->use_sparse_pck) {
+			int pad = _get_pad(PCK_PADDING, pd->f->get_position());
+			for (int i = 0; i < pad; i++) {
+				pd->f->store_8(0);
+			}
+		}
+
+		if (!content_key.is_empty()) {
+			pd->stored_contents[content_key] = pd->file_ofs.size();
 		}
 	}
 
@@ -2015,18 +2054,21 @@ bool EditorExportPlatform::_encrypt_and_store_directory(Ref<FileAccess> p_fd, Pa
 
 		fhead = fae;
 	}
+
+	// Paths go to a string table after the fixed size entries, so the index can be used in place once mapped.
+	uint32_t strings_size = 0;
 	for (int i = 0; i < p_pack_data.file_ofs.size(); i++) {
-		uint32_t string_len = p_pack_data.file_ofs[i].path_utf8.length();
-		uint32_t pad = _get_pad(4, string_len);
+		strings_size += p_pack_data.file_ofs[i].path_utf8.length();
+	}
+	fhead->store_32(strings_size);
 
-		fhead->store_32(string_len + pad);
-		fhead->store_buffer((const uint8_t *)p_pack_data.file_ofs[i].path_utf8.get_data(), string_len);
-		for (uint32_t j = 0; j < pad; j++) {
-			fhead->store_8(0);
-		}
+	uint32_t path_offset = 0;
+	for (int i = 0; i < p_pack_data.file_ofs.size(); i++) {
+		uint32_t string_len = p_pack_data.file_ofs[i].path_utf8.length();
 
 		fhead->store_64(p_pack_data.file_ofs[i].ofs - p_file_base);
 		fhead->store_64(p_pack_data.file_ofs[i].size); // pay attention here, this is where file is
+		fhead->store_64(p_pack_data.file_ofs[i].compressed ? p_pack_data.file_ofs[i].stored_size : p_pack_data.file_ofs[i].size);
 		fhead->store_buffer(p_pack_data.file_ofs[i].md5.ptr(), 16); //also save md5 for file
 		uint32_t flags = 0;
 		if (p_pack_data.file_ofs[i].encrypted) {
@@ -2038,7 +2080,18 @@ bool EditorExportPlatform::_encrypt_and_store_directory(Ref<FileAccess> p_fd, Pa
 		if (p_pack_data.file_ofs[i].delta) {
 			flags |= PACK_FILE_DELTA;
 		}
+		if (p_pack_data.file_ofs[i].compressed) {
+			flags |= PACK_FILE_COMPRESSED;
+		}
 		fhead->store_32(flags);
+		fhead->store_32(path_offset);
+		fhead->store_32(string_len);
+		fhead->store_32(0); // Reserved.
+		path_offset += string_len;
+	}
+
+	for (int i = 0; i < p_pack_data.file_ofs.size(); i++) {
+		fhead->store_buffer((const uint8_t *)p_pack_data.file_ofs[i].path_utf8.get_data(), p_pack_data.file_ofs[i].path_utf8.length());
 	}
 
 	if (fae.is_valid()) {
@@ -2113,6 +2166,8 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 	pd.f = f;
 	pd.so_files = p_so_files;
 	pd.path = p_path;
+	pd.compress_files = get_project_setting(p_preset, "editor/export/compress_pck_files");
+	pd.deduplicate_files = get_project_setting(p_preset, "editor/export/deduplicate_pck_files");
 
 	Error err = export_project_files(p_preset, p_debug, p_save_func, p_remove_func, &pd, _pack_add_shared_object);
 
@@ -2191,6 +2246,11 @@ Error EditorExportPlatform::save_pack(const Ref<EditorExportPreset> &p_preset, b
 			*r_embedded_size = f->get_position() - embed_pos;
 		}
 	}
+
+	// Drop what is left of a compressed file that was replaced by its smaller raw contents.
+	if (f->get_length() > f->get_position()) {
+		f->resize(f->get_position());
+	}
 	f->close();
 
 	return OK;
@@ -81,7 +81,9 @@ public:
 	struct SavedData {
 		uint64_t ofs = 0;
 		uint64_t size = 0;
+		uint64_t stored_size = 0; // Only used if compressed.
 		bool encrypted = false;
+		bool compressed = false;
 		bool removal = false;
 		bool delta = false;
 		Vector<uint8_t> md5;
@@ -99,10 +101,15 @@ public:
 		EditorProgress *ep = nullptr;
 		Vector<SharedObject> *so_files = nullptr;
 		bool use_sparse_pck = false;
+		// Files are stored the same way PCKPacker does.
+		bool compress_files = false;
+		bool deduplicate_files = true;
+		HashMap<String, int> stored_contents; // Content key to the first file storing it.
 	};
 
 	static bool _store_header(Ref<FileAccess> p_fd, bool p_enc, bool p_sparse, uint64_t &r_file_base_ofs, uint64_t &r_dir_base_ofs);
 	static bool _encrypt_and_store_directory(Ref<FileAccess> p_fd, PackData &p_pack_data, const Vector<uint8_t> &p_key, uint64_t p_seed, uint64_t p_file_base);
+	static bool _should_encrypt_file(const String &p_path, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters);
 	static Error _encrypt_and_store_data(Ref<FileAccess> p_fd, const String &p_path, const Vector<uint8_t> &p_data, const Vector<String> &p_enc_in_filters, const Vector<String> &p_enc_ex_filters, const Vector<uint8_t> &p_key, uint64_t p_seed, bool &r_encrypt);
 	String _get_script_encryption_key(const Ref<EditorExportPreset> &p_preset) const;
 
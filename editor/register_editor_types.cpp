@@ -297,7 +297,9 @@ void register_editor_types() {
 
 	GLOBAL_DEF(PropertyInfo(Variant::INT, "editor/import/atlas_max_width", PROPERTY_HINT_RANGE, "128,8192,1,or_greater"), 2048);
 
+	GLOBAL_DEF("editor/export/compress_pck_files", false);
 	GLOBAL_DEF("editor/export/convert_text_resources_to_binary", true);
+	GLOBAL_DEF("editor/export/deduplicate_pck_files", true);
 
 	GLOBAL_DEF("editor/version_control/plugin_name", "");
 	GLOBAL_DEF("editor/version_control/autoload_on_startup", false);
@@ -49,8 +49,10 @@
 #include "core/io/resource_loader.h"
 #include "core/object/message_queue.h"
 #include "core/object/script_language.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/os/time.h"
+#include "core/profiling/alloc_profiler.h"
 #include "core/profiling/profiling.h"
 #include "core/register_core_types.h"
 #include "core/string/translation_server.h"
@@ -144,6 +146,9 @@
 
 #ifdef MODULE_GDSCRIPT_ENABLED
 #include "modules/gdscript/gdscript.h"
+#ifdef TOOLS_ENABLED
+#include "modules/gdscript/editor/gdscript_transpiler.h"
+#endif // TOOLS_ENABLED
 #if defined(TOOLS_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 #include "modules/gdscript/language_server/gdscript_language_server.h"
 #endif // TOOLS_ENABLED && !GDSCRIPT_NO_LSP
@@ -269,6 +274,12 @@ static bool debug_avoidance = false;
 static bool debug_canvas_item_redraw = false;
 static bool debug_mute_audio = false;
 #endif
+#ifdef ALLOC_PROFILER_ENABLED
+static String alloc_profile_file;
+#endif
+#ifdef GODOT_USE_BUILTIN_TRACER
+static String trace_file;
+#endif
 static int max_fps = -1;
 static int frame_delay = 0;
 static int audio_output_latency = 0;
@@ -641,6 +652,12 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--ignore-error-breaks", "If debugger is connected, prevents sending error breakpoints.\n");
 	print_help_option("--profiling", "Enable profiling in the script debugger.\n");
 	print_help_option("--gpu-profile", "Show a GPU profile of the tasks that took the most time during frame rendering.\n");
+#ifdef GODOT_USE_BUILTIN_TRACER
+	print_help_option("--trace <file>", "Record a trace of the engine's profile zones from startup and write it to the given file on exit, in the Chrome trace-event JSON format.\n");
+#endif
+#ifdef ALLOC_PROFILER_ENABLED
+	print_help_option("--dump-alloc-profile <file>", "Sample allocations from startup and write the allocation profile to the given file on exit.\n");
+#endif
 	print_help_option("--gpu-validation", "Enable graphics API validation layers for debugging.\n");
 #ifdef DEBUG_ENABLED
 	print_help_option("--gpu-abort", "Abort on graphics API usage errors (usually validation layer errors). May help see the problem if your system freezes.\n", CLI_OPTION_AVAILABILITY_TEMPLATE_DEBUG);
@@ -706,6 +723,7 @@ void Main::print_help(const char *p_binary) {
 	print_help_option("--gdextension-docs", "Rather than dumping the engine API, generate API reference from all the GDExtensions loaded in the current project (used with --doctool).\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #ifdef MODULE_GDSCRIPT_ENABLED
 	print_help_option("--gdscript-docs <path>", "Rather than dumping the engine API, generate API reference from the inline documentation in the GDScript files found in <path> (used with --doctool).\n", CLI_OPTION_AVAILABILITY_EDITOR);
+	print_help_option("--gdscript-transpile <file>", "Translate the fully typed functions of the project's GDScript files to a C++ <file>, to build into export templates with the \"gdscript_aot_source\" SCons option.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 #endif
 	print_help_option("--build-solutions", "Build the scripting solutions (e.g. for C# projects). Implies --editor and requires a valid project to edit.\n", CLI_OPTION_AVAILABILITY_EDITOR);
 	print_help_option("--dump-gdextension-interface", "Generate a GDExtension header file \"gdextension_interface.h\" in the current folder. This file is the base file required to implement a GDExtension.\n", CLI_OPTION_AVAILABILITY_EDITOR);
@@ -1701,6 +1719,18 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing relative or absolute path to project for --gdscript-docs, aborting.\n");
 				goto error;
 			}
+		} else if (arg == "--gdscript-transpile") {
+			if (N) {
+				// Will be handled in start()
+				main_args.push_back(arg);
+				main_args.push_back(N->get());
+				N = N->next();
+				// Like docgen, scripts may require Autoloads, which also create a main loop.
+				quit_after = 1;
+			} else {
+				OS::get_singleton()->print("Missing output file path for --gdscript-transpile, aborting.\n");
+				goto error;
+			}
 #endif // MODULE_GDSCRIPT_ENABLED
 #endif // TOOLS_ENABLED
 
@@ -1940,6 +1970,28 @@ Error Main::setup(const char *execpath, int argc, char *argv[], bool p_second_ph
 				OS::get_singleton()->print("Missing <path> argument for --benchmark-file <path>.\n");
 				goto error;
 			}
+#ifdef GODOT_USE_BUILTIN_TRACER
+		} else if (arg == "--trace") {
+			if (N) {
+				trace_file = N->get();
+				TraceRecorder::start();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --trace <file>.\n");
+				goto error;
+			}
+#endif
+#ifdef ALLOC_PROFILER_ENABLED
+		} else if (arg == "--dump-alloc-profile") {
+			if (N) {
+				alloc_profile_file = N->get();
+				AllocProfiler::start();
+				N = N->next();
+			} else {
+				OS::get_singleton()->print("Missing <file> argument for --dump-alloc-profile <file>.\n");
+				goto error;
+			}
+#endif
 #if defined(TOOLS_ENABLED) && defined(MODULE_GDSCRIPT_ENABLED) && !defined(GDSCRIPT_NO_LSP)
 		} else if (arg == "--lsp-port") {
 			if (N) {
@@ -3897,6 +3949,7 @@ int Main::start() {
 	bool export_patch = false;
 #ifdef MODULE_GDSCRIPT_ENABLED
 	String gdscript_docs_path;
+	String gdscript_transpile_path;
 #endif
 #ifndef DISABLE_DEPRECATED
 	bool converting_project = false;
@@ -3993,6 +4046,8 @@ int Main::start() {
 #ifdef MODULE_GDSCRIPT_ENABLED
 			} else if (E->get() == "--gdscript-docs") {
 				gdscript_docs_path = E->next()->get();
+			} else if (E->get() == "--gdscript-transpile") {
+				gdscript_transpile_path = E->next()->get();
 #endif
 			} else if (E->get() == "--export-release") {
 				ERR_FAIL_COND_V_MSG(!editor && !found_project, EXIT_FAILURE, "Please provide a valid project path when exporting, aborting.");
@@ -4458,6 +4513,22 @@ int Main::start() {
 
 			return EXIT_SUCCESS;
 		}
+
+		if (!gdscript_transpile_path.is_empty()) {
+			GDScriptTranspiler transpiler;
+			for (const String &path : get_files_with_extension("res://", "gd")) {
+				Ref<GDScript> gdscript = ResourceLoader::load(path);
+				if (gdscript.is_valid()) {
+					transpiler.add_script(gdscript);
+				}
+			}
+
+			Error err = transpiler.save(gdscript_transpile_path);
+			ERR_FAIL_COND_V_MSG(err != OK, EXIT_FAILURE, "Error saving translated GDScript functions: " + itos(err));
+
+			print_line(vformat("Translated %d GDScript functions to C++, %d left to bytecode.", transpiler.get_translated_count(), transpiler.get_skipped().size()));
+			return EXIT_SUCCESS;
+		}
 #endif // MODULE_GDSCRIPT_ENABLED
 
 		EditorNode *editor_node = nullptr;
@@ -4753,6 +4824,8 @@ bool Main::iteration() {
 	GodotProfileZoneGroupedFirst(_profile_zone, "prepare");
 	iterating++;
 
+	FrameArena::begin_frame();
+
 	const uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 	Engine::get_singleton()->_frame_ticks = ticks;
 	main_timer_sync.set_cpu_ticks_usec(ticks);
@@ -4799,6 +4872,7 @@ bool Main::iteration() {
 	GodotProfileZoneGrouped(_profile_zone, "physics");
 	for (int iters = 0; iters < advance.physics_steps; ++iters) {
 		GodotProfileZone("Physics Step");
+		ALLOC_PROFILE_SCOPE("Physics");
 		GodotProfileZoneGroupedFirst(_physics_zone, "setup");
 		if (Input::get_singleton()->is_agile_input_event_flushing()) {
 			Input::get_singleton()->flush_buffered_events();
@@ -4945,6 +5019,10 @@ bool Main::iteration() {
 		EngineDebugger::get_singleton()->iteration(frame_time, process_ticks, physics_process_ticks, physics_step);
 	}
 
+	FrameArena::end_frame();
+	StringName::update_frame_stats();
+	MessageQueue::update_frame_stats();
+
 	frames++;
 	Engine::get_singleton()->_process_frames++;
 
@@ -5050,6 +5128,19 @@ void Main::cleanup(bool p_force) {
 		ERR_FAIL_COND(!_start_success);
 	}
 
+#ifdef GODOT_USE_BUILTIN_TRACER
+	if (!trace_file.is_empty() && TraceRecorder::is_recording()) {
+		TraceRecorder::stop(trace_file);
+	}
+#endif
+
+#ifdef ALLOC_PROFILER_ENABLED
+	if (!alloc_profile_file.is_empty()) {
+		AllocProfiler::dump_to_file(alloc_profile_file);
+		AllocProfiler::stop();
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	if (input) {
 		input->flush_frame_parsed_events();
@@ -31,6 +31,8 @@
 #include "performance.h"
 #include "performance.compat.inc"
 
+#include "core/object/message_queue.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 #include "core/variant/typed_array.h"
 #include "scene/main/node.h"
@@ -133,6 +135,13 @@ void Performance::_bind_methods() {
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_EDGE_FREE_COUNT);
 	BIND_ENUM_CONSTANT(NAVIGATION_3D_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_ALLOCATIONS);
+	BIND_ENUM_CONSTANT(MEMORY_FRAME_ARENA_BYTES);
+	BIND_ENUM_CONSTANT(OBJECT_STRING_NAME_LOOKUPS);
+	BIND_ENUM_CONSTANT(OBJECT_STRING_NAME_HITS);
+	BIND_ENUM_CONSTANT(OBJECT_STRING_NAME_INSERTS);
+	BIND_ENUM_CONSTANT(OBJECT_DEFERRED_CALLS);
+	BIND_ENUM_CONSTANT(TIME_MESSAGE_QUEUE_FLUSH);
 	BIND_ENUM_CONSTANT(MONITOR_MAX);
 
 	BIND_ENUM_CONSTANT(MONITOR_TYPE_QUANTITY);
@@ -228,6 +237,13 @@ String Performance::get_monitor_name(Monitor p_monitor) const {
 		PNAME("navigation_3d/edges_free"),
 		PNAME("navigation_3d/obstacles"),
 #endif // NAVIGATION_3D_DISABLED
+		PNAME("memory/frame_arena_allocs"),
+		PNAME("memory/frame_arena_bytes"),
+		PNAME("object/string_name_lookups"),
+		PNAME("object/string_name_hits"),
+		PNAME("object/string_name_inserts"),
+		PNAME("object/deferred_calls"),
+		PNAME("time/message_queue_flush"),
 	};
 	static_assert(std_size(names) == MONITOR_MAX);
 
@@ -453,6 +469,21 @@ double Performance::get_monitor(Monitor p_monitor) const {
 			return NavigationServer3D::get_singleton()->get_process_info(NavigationServer3D::INFO_OBSTACLE_COUNT);
 #endif // NAVIGATION_3D_DISABLED
 
+		case MEMORY_FRAME_ARENA_ALLOCATIONS:
+			return FrameArena::get_frame_allocation_count();
+		case MEMORY_FRAME_ARENA_BYTES:
+			return FrameArena::get_frame_allocated_bytes();
+		case OBJECT_STRING_NAME_LOOKUPS:
+			return StringName::get_frame_intern_stats().lookups;
+		case OBJECT_STRING_NAME_HITS:
+			return StringName::get_frame_intern_stats().hits;
+		case OBJECT_STRING_NAME_INSERTS:
+			return StringName::get_frame_intern_stats().inserts;
+		case OBJECT_DEFERRED_CALLS:
+			return MessageQueue::get_frame_flush_stats().calls;
+		case TIME_MESSAGE_QUEUE_FLUSH:
+			return USEC_TO_SEC(MessageQueue::get_frame_flush_stats().usec);
+
 		default: {
 		}
 	}
@@ -525,6 +556,13 @@ Performance::MonitorType Performance::get_monitor_type(Monitor p_monitor) const
 		MONITOR_TYPE_QUANTITY,
 		MONITOR_TYPE_QUANTITY,
 #endif // _3D_DISABLED
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_MEMORY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_QUANTITY,
+		MONITOR_TYPE_TIME,
 
 	};
 	static_assert((sizeof(types) / sizeof(MonitorType)) == MONITOR_MAX);
@@ -121,6 +121,13 @@ public:
 		NAVIGATION_3D_EDGE_FREE_COUNT,
 		NAVIGATION_3D_OBSTACLE_COUNT,
 #endif // _3D_DISABLED
+		MEMORY_FRAME_ARENA_ALLOCATIONS,
+		MEMORY_FRAME_ARENA_BYTES,
+		OBJECT_STRING_NAME_LOOKUPS,
+		OBJECT_STRING_NAME_HITS,
+		OBJECT_STRING_NAME_INSERTS,
+		OBJECT_DEFERRED_CALLS,
+		TIME_MESSAGE_QUEUE_FLUSH,
 		MONITOR_MAX
 	};
 
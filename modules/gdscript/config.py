@@ -3,6 +3,16 @@ def can_build(env, platform):
     return True
 
 
+def get_opts(platform):
+    return [
+        (
+            "gdscript_aot_source",
+            "C++ file generated with --gdscript-transpile, built in to run translated GDScript functions",
+            "",
+        ),
+    ]
+
+
 def configure(env):
     pass
 
@@ -0,0 +1,583 @@
+/**************************************************************************/
+/*  gdscript_transpiler.cpp                                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_transpiler.h"
+
+#include "../gdscript_aot.h"
+#include "../gdscript_function.h"
+
+#include "core/io/file_access.h"
+#include "core/templates/hash_set.h"
+
+typedef GDScriptFunction F;
+
+static const char *type_adjust_names[] = {
+	"bool",
+	"int64_t",
+	"double",
+	"String",
+	"Vector2",
+	"Vector2i",
+	"Rect2",
+	"Rect2i",
+	"Vector3",
+	"Vector3i",
+	"Transform2D",
+	"Vector4",
+	"Vector4i",
+	"Plane",
+	"Quaternion",
+	"AABB",
+	"Basis",
+	"Transform3D",
+	"Projection",
+	"Color",
+	"StringName",
+	"NodePath",
+	"RID",
+	"Object *",
+	"Callable",
+	"Signal",
+	"Dictionary",
+	"Array",
+	"PackedByteArray",
+	"PackedInt32Array",
+	"PackedInt64Array",
+	"PackedFloat32Array",
+	"PackedFloat64Array",
+	"PackedStringArray",
+	"PackedVector2Array",
+	"PackedVector3Array",
+	"PackedColorArray",
+	"PackedVector4Array",
+};
+
+static_assert(std_size(type_adjust_names) == F::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY - F::OPCODE_TYPE_ADJUST_BOOL + 1, "Type adjust names don't match the opcodes.");
+
+// Returns the size of a supported instruction and its jump target (or -1),
+// or 0 if the instruction can't be translated.
+static int _get_instruction_length(const int *p_code, int p_ip, int p_code_size, int &r_target) {
+	r_target = -1;
+	int length = 0;
+
+	switch (p_code[p_ip]) {
+		case F::OPCODE_OPERATOR_VALIDATED:
+		case F::OPCODE_SET_KEYED_VALIDATED:
+		case F::OPCODE_GET_KEYED_VALIDATED:
+		case F::OPCODE_SET_INDEXED_VALIDATED:
+		case F::OPCODE_GET_INDEXED_VALIDATED:
+			length = 5;
+			break;
+		case F::OPCODE_SET_NAMED_VALIDATED:
+		case F::OPCODE_GET_NAMED_VALIDATED:
+		case F::OPCODE_ASSIGN_TYPED_BUILTIN:
+			length = 4;
+			break;
+		case F::OPCODE_ASSIGN:
+		case F::OPCODE_INCREMENT_INT:
+		case F::OPCODE_RETURN_TYPED_BUILTIN:
+		case F::OPCODE_ASSERT:
+			length = 3;
+			break;
+		case F::OPCODE_ASSIGN_NULL:
+		case F::OPCODE_ASSIGN_TRUE:
+		case F::OPCODE_ASSIGN_FALSE:
+		case F::OPCODE_RETURN:
+		case F::OPCODE_LINE:
+			length = 2;
+			break;
+		case F::OPCODE_CONSTRUCT_VALIDATED:
+		case F::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case F::OPCODE_CALL_UTILITY_VALIDATED:
+			if (p_ip + 1 >= p_code_size || p_code[p_ip + 1] < 0) {
+				return 0;
+			}
+			length = p_code[p_ip + 1] + 4;
+			break;
+		case F::OPCODE_JUMP:
+			length = 2;
+			r_target = 1;
+			break;
+		case F::OPCODE_JUMP_IF:
+		case F::OPCODE_JUMP_IF_NOT:
+			length = 3;
+			r_target = 2;
+			break;
+		case F::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			length = 6;
+			r_target = 5;
+			break;
+		case F::OPCODE_ITERATE_BEGIN_INT:
+		case F::OPCODE_ITERATE_INT:
+			length = 5;
+			r_target = 4;
+			break;
+		case F::OPCODE_ITERATE_BEGIN_RANGE:
+			length = 7;
+			r_target = 6;
+			break;
+		case F::OPCODE_ITERATE_RANGE:
+			length = 6;
+			r_target = 5;
+			break;
+		case F::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case F::OPCODE_END:
+			length = 1;
+			break;
+		default:
+			if (p_code[p_ip] >= F::OPCODE_TYPE_ADJUST_BOOL && p_code[p_ip] <= F::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+				length = 2;
+				break;
+			}
+			// Untyped operations, script and engine calls, awaits...
+			return 0;
+	}
+
+	if (p_ip + length > p_code_size) {
+		return 0;
+	}
+	if (r_target >= 0) {
+		r_target = p_code[p_ip + r_target];
+	}
+	return length;
+}
+
+bool GDScriptTranspiler::_translate_function(const GDScriptFunction *p_function, const String &p_symbol, String &r_source) const {
+	const int *code = p_function->_code_ptr;
+	const int code_size = p_function->_code_size;
+	if (!code || code_size == 0 || code[code_size - 1] != F::OPCODE_END) {
+		return false;
+	}
+
+	// Instruction boundaries and labels (entry, jump and default argument targets).
+	HashSet<int> starts;
+	HashSet<int> labels;
+	labels.insert(0);
+	for (int ip = 0; ip < code_size;) {
+		int target;
+		const int length = _get_instruction_length(code, ip, code_size, target);
+		if (length == 0) {
+			return false;
+		}
+		starts.insert(ip);
+		if (target >= 0) {
+			labels.insert(target);
+		}
+		ip += length;
+	}
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		labels.insert(p_function->_default_arg_ptr[i]);
+	}
+	for (const int label : labels) {
+		if (!starts.has(label)) {
+			return false;
+		}
+	}
+
+	bool valid = true;
+	bool uses_members = false;
+
+	auto address = [&](int p_address) -> String {
+		const int type = (p_address & F::ADDR_TYPE_MASK) >> F::ADDR_BITS;
+		const int index = p_address & F::ADDR_MASK;
+		switch (type) {
+			case F::ADDR_TYPE_STACK:
+				valid = valid && index < p_function->_stack_size;
+				return vformat("&stack[%d]", index);
+			case F::ADDR_TYPE_CONSTANT:
+				valid = valid && index < p_function->_constant_count;
+				return vformat("&constants[%d]", index);
+			case F::ADDR_TYPE_MEMBER:
+				uses_members = true;
+				return vformat("&members[%d]", index);
+			default:
+				valid = false;
+				return String();
+		}
+	};
+	auto check_index = [&](int p_index, int p_count) -> int {
+		valid = valid && p_index >= 0 && p_index < p_count;
+		return p_index;
+	};
+
+	const String end = itos(code_size - 1);
+	String body;
+
+	for (int ip = 0; ip < code_size && valid;) {
+		int target;
+		const int length = _get_instruction_length(code, ip, code_size, target);
+		const String exit = vformat("return %d;", ip);
+
+		if (labels.has(ip)) {
+			body += vformat("ip_%d:\n", ip);
+		}
+		body += "\t{\n";
+
+		// Operands of fixed size instructions.
+		auto operand = [&](int p_index) -> String {
+			return address(code[ip + 1 + p_index]);
+		};
+
+		switch (code[ip]) {
+			case F::OPCODE_OPERATOR_VALIDATED:
+			case F::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				const int idx = check_index(code[ip + 4], p_function->_operator_funcs_count);
+				Variant::Operator op = Variant::OP_MAX;
+				Variant::Type type_a = Variant::NIL;
+				Variant::Type type_b = Variant::NIL;
+				if (valid) {
+					GDScriptAOT::get_operator_info(p_function->_operator_funcs_ptr[idx], op, type_a, type_b);
+				}
+
+				String c_type;
+				String getter;
+				if (type_a == Variant::INT && type_b == Variant::INT) {
+					c_type = "int64_t";
+					getter = "get_int";
+				} else if (type_a == Variant::FLOAT && type_b == Variant::FLOAT) {
+					c_type = "double";
+					getter = "get_float";
+				}
+
+				String expression;
+				bool comparison = false;
+				switch (op) {
+					case Variant::OP_ADD:
+						expression = "a + b";
+						break;
+					case Variant::OP_SUBTRACT:
+						expression = "a - b";
+						break;
+					case Variant::OP_MULTIPLY:
+						expression = "a * b";
+						break;
+					case Variant::OP_LESS:
+						expression = "a < b";
+						comparison = true;
+						break;
+					case Variant::OP_LESS_EQUAL:
+						expression = "a <= b";
+						comparison = true;
+						break;
+					case Variant::OP_GREATER:
+						expression = "a > b";
+						comparison = true;
+						break;
+					case Variant::OP_GREATER_EQUAL:
+						expression = "a >= b";
+						comparison = true;
+						break;
+					case Variant::OP_EQUAL:
+						// Exact float comparisons are left to the evaluator.
+						expression = type_a == Variant::INT ? "a == b" : "";
+						comparison = true;
+						break;
+					case Variant::OP_NOT_EQUAL:
+						expression = type_a == Variant::INT ? "a != b" : "";
+						comparison = true;
+						break;
+					default:
+						break;
+				}
+
+				if (!c_type.is_empty() && !expression.is_empty()) {
+					body += vformat("\t\tconst %s a = *VariantInternal::%s(%s);\n", c_type, getter, operand(0));
+					body += vformat("\t\tconst %s b = *VariantInternal::%s(%s);\n", c_type, getter, operand(1));
+					body += vformat("\t\tVariant *dst = %s;\n", operand(2));
+					if (comparison) {
+						body += "\t\tVariantTypeChanger<bool>::change(dst);\n";
+						body += vformat("\t\t*VariantInternal::get_bool(dst) = %s;\n", expression);
+					} else {
+						body += vformat("\t\tVariantTypeChanger<%s>::change(dst);\n", c_type);
+						body += vformat("\t\t*VariantInternal::%s(dst) = %s;\n", getter, expression);
+					}
+				} else {
+					body += vformat("\t\tf.operator_funcs[%d](%s, %s, %s);\n", idx, operand(0), operand(1), operand(2));
+				}
+				if (code[ip] == F::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+					body += vformat("\t\tif (!(%s)->booleanize()) {\n\t\t\tgoto ip_%d;\n\t\t}\n", operand(2), target);
+				}
+			} break;
+			case F::OPCODE_INCREMENT_INT: {
+				body += vformat("\t\t*VariantInternal::get_int(%s) += *VariantInternal::get_int(%s);\n", operand(0), operand(1));
+			} break;
+			case F::OPCODE_SET_KEYED_VALIDATED: {
+				const int idx = check_index(code[ip + 4], p_function->_keyed_setters_count);
+				body += "\t\tbool valid;\n";
+				body += vformat("\t\tf.keyed_setters[%d](%s, %s, %s, &valid);\n", idx, operand(0), operand(1), operand(2));
+				body += vformat("\t\tif (unlikely(!valid)) {\n\t\t\t%s\n\t\t}\n", exit);
+			} break;
+			case F::OPCODE_GET_KEYED_VALIDATED: {
+				const int idx = check_index(code[ip + 4], p_function->_keyed_getters_count);
+				body += "\t\tVariant ret;\n";
+				body += "\t\tbool valid;\n";
+				body += vformat("\t\tf.keyed_getters[%d](%s, %s, &ret, &valid);\n", idx, operand(0), operand(1));
+				body += vformat("\t\tif (unlikely(!valid)) {\n\t\t\t%s\n\t\t}\n", exit);
+				body += vformat("\t\t*%s = ret;\n", operand(2));
+			} break;
+			case F::OPCODE_SET_INDEXED_VALIDATED: {
+				const int idx = check_index(code[ip + 4], p_function->_indexed_setters_count);
+				body += "\t\tbool oob;\n";
+				body += vformat("\t\tf.indexed_setters[%d](%s, *VariantInternal::get_int(%s), %s, &oob);\n", idx, operand(0), operand(1), operand(2));
+				body += vformat("\t\tif (unlikely(oob)) {\n\t\t\t%s\n\t\t}\n", exit);
+			} break;
+			case F::OPCODE_GET_INDEXED_VALIDATED: {
+				const int idx = check_index(code[ip + 4], p_function->_indexed_getters_count);
+				body += "\t\tbool oob;\n";
+				body += vformat("\t\tf.indexed_getters[%d](%s, *VariantInternal::get_int(%s), %s, &oob);\n", idx, operand(0), operand(1), operand(2));
+				body += vformat("\t\tif (unlikely(oob)) {\n\t\t\t%s\n\t\t}\n", exit);
+			} break;
+			case F::OPCODE_SET_NAMED_VALIDATED: {
+				const int idx = check_index(code[ip + 3], p_function->_setters_count);
+				body += vformat("\t\tf.setters[%d](%s, %s);\n", idx, operand(0), operand(1));
+			} break;
+			case F::OPCODE_GET_NAMED_VALIDATED: {
+				const int idx = check_index(code[ip + 3], p_function->_getters_count);
+				body += vformat("\t\tf.getters[%d](%s, %s);\n", idx, operand(0), operand(1));
+			} break;
+			case F::OPCODE_ASSIGN: {
+				body += vformat("\t\t*%s = *%s;\n", operand(0), operand(1));
+			} break;
+			case F::OPCODE_ASSIGN_NULL: {
+				body += vformat("\t\t*%s = Variant();\n", operand(0));
+			} break;
+			case F::OPCODE_ASSIGN_TRUE: {
+				body += vformat("\t\t*%s = true;\n", operand(0));
+			} break;
+			case F::OPCODE_ASSIGN_FALSE: {
+				body += vformat("\t\t*%s = false;\n", operand(0));
+			} break;
+			case F::OPCODE_ASSIGN_TYPED_BUILTIN: {
+				const int type = check_index(code[ip + 3], Variant::VARIANT_MAX);
+				// Conversions and their errors are left to the interpreter.
+				body += vformat("\t\tconst Variant *src = %s;\n", operand(1));
+				body += vformat("\t\tif (unlikely(src->get_type() != (Variant::Type)%d)) {\n\t\t\t%s\n\t\t}\n", type, exit);
+				body += vformat("\t\t*%s = *src;\n", operand(0));
+			} break;
+			case F::OPCODE_CONSTRUCT_VALIDATED:
+			case F::OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+			case F::OPCODE_CALL_UTILITY_VALIDATED: {
+				const int count = code[ip + 1];
+				const int argc = code[ip + 2 + count];
+				const bool is_method = code[ip] == F::OPCODE_CALL_BUILTIN_TYPE_VALIDATED;
+				valid = valid && count <= p_function->_instruction_args_size && argc >= 0 && argc + (is_method ? 2 : 1) <= count;
+				if (!valid) {
+					break;
+				}
+
+				Vector<String> args;
+				for (int i = 0; i < argc; i++) {
+					args.push_back(address(code[ip + 2 + i]));
+				}
+				const String argptrs = argc > 0 ? "args" : "nullptr";
+				if (argc > 0) {
+					body += vformat("\t\tconst Variant *args[] = { %s };\n", String(", ").join(args));
+				}
+
+				if (code[ip] == F::OPCODE_CONSTRUCT_VALIDATED) {
+					const int idx = check_index(code[ip + 3 + count], p_function->_constructors_count);
+					body += vformat("\t\tf.constructors[%d](%s, %s);\n", idx, address(code[ip + 2 + argc]), argptrs);
+				} else if (is_method) {
+					const int idx = check_index(code[ip + 3 + count], p_function->_builtin_methods_count);
+					body += vformat("\t\tf.builtin_methods[%d](%s, %s, %d, %s);\n", idx, address(code[ip + 2 + argc]), argptrs, argc, address(code[ip + 3 + argc]));
+				} else {
+					const int idx = check_index(code[ip + 3 + count], p_function->_utilities_count);
+					body += vformat("\t\tf.utilities[%d](%s, %s, %d);\n", idx, address(code[ip + 2 + argc]), argptrs, argc);
+				}
+			} break;
+			case F::OPCODE_JUMP: {
+				body += vformat("\t\tgoto ip_%d;\n", target);
+			} break;
+			case F::OPCODE_JUMP_IF: {
+				body += vformat("\t\tif ((%s)->booleanize()) {\n\t\t\tgoto ip_%d;\n\t\t}\n", operand(0), target);
+			} break;
+			case F::OPCODE_JUMP_IF_NOT: {
+				body += vformat("\t\tif (!(%s)->booleanize()) {\n\t\t\tgoto ip_%d;\n\t\t}\n", operand(0), target);
+			} break;
+			case F::OPCODE_JUMP_TO_DEF_ARGUMENT: {
+				body += "\t\tswitch (f.defarg) {\n";
+				for (int i = 0; i < p_function->default_arguments.size(); i++) {
+					body += vformat("\t\t\tcase %d:\n\t\t\t\tgoto ip_%d;\n", i, p_function->_default_arg_ptr[i]);
+				}
+				body += vformat("\t\t\tdefault:\n\t\t\t\t%s\n\t\t}\n", exit);
+			} break;
+			case F::OPCODE_RETURN: {
+				body += vformat("\t\t*f.retvalue = *%s;\n", operand(0));
+				body += vformat("\t\treturn %s;\n", end);
+			} break;
+			case F::OPCODE_RETURN_TYPED_BUILTIN: {
+				const int type = check_index(code[ip + 2], Variant::VARIANT_MAX);
+				body += vformat("\t\tconst Variant *r = %s;\n", operand(0));
+				body += vformat("\t\tif (unlikely(r->get_type() != (Variant::Type)%d)) {\n\t\t\t%s\n\t\t}\n", type, exit);
+				body += "\t\t*f.retvalue = *r;\n";
+				body += vformat("\t\treturn %s;\n", end);
+			} break;
+			case F::OPCODE_ITERATE_BEGIN_INT: {
+				body += vformat("\t\tVariant *counter = %s;\n", operand(0));
+				body += vformat("\t\tconst int64_t size = *VariantInternal::get_int(%s);\n", operand(1));
+				body += "\t\tVariantInternal::initialize(counter, Variant::INT);\n";
+				body += "\t\t*VariantInternal::get_int(counter) = 0;\n";
+				body += vformat("\t\tif (size <= 0) {\n\t\t\tgoto ip_%d;\n\t\t}\n", target);
+				body += vformat("\t\tVariant *iterator = %s;\n", operand(2));
+				body += "\t\tVariantInternal::initialize(iterator, Variant::INT);\n";
+				body += "\t\t*VariantInternal::get_int(iterator) = 0;\n";
+			} break;
+			case F::OPCODE_ITERATE_INT: {
+				body += vformat("\t\tconst int64_t size = *VariantInternal::get_int(%s);\n", operand(1));
+				body += vformat("\t\tint64_t *count = VariantInternal::get_int(%s);\n", operand(0));
+				body += "\t\t(*count)++;\n";
+				body += vformat("\t\tif (*count >= size) {\n\t\t\tgoto ip_%d;\n\t\t}\n", target);
+				body += vformat("\t\t*VariantInternal::get_int(%s) = *count;\n", operand(2));
+			} break;
+			case F::OPCODE_ITERATE_BEGIN_RANGE: {
+				body += vformat("\t\tVariant *counter = %s;\n", operand(0));
+				body += vformat("\t\tconst int64_t from = *VariantInternal::get_int(%s);\n", operand(1));
+				body += vformat("\t\tconst int64_t to = *VariantInternal::get_int(%s);\n", operand(2));
+				body += vformat("\t\tconst int64_t step = *VariantInternal::get_int(%s);\n", operand(3));
+				body += "\t\tVariantInternal::initialize(counter, Variant::INT);\n";
+				body += "\t\t*VariantInternal::get_int(counter) = from;\n";
+				body += "\t\tconst bool do_continue = from == to ? false : (from < to ? step > 0 : step < 0);\n";
+				body += vformat("\t\tif (!do_continue) {\n\t\t\tgoto ip_%d;\n\t\t}\n", target);
+				body += vformat("\t\tVariant *iterator = %s;\n", operand(4));
+				body += "\t\tVariantInternal::initialize(iterator, Variant::INT);\n";
+				body += "\t\t*VariantInternal::get_int(iterator) = from;\n";
+			} break;
+			case F::OPCODE_ITERATE_RANGE: {
+				body += vformat("\t\tconst int64_t to = *VariantInternal::get_int(%s);\n", operand(1));
+				body += vformat("\t\tconst int64_t step = *VariantInternal::get_int(%s);\n", operand(2));
+				body += vformat("\t\tint64_t *count = VariantInternal::get_int(%s);\n", operand(0));
+				body += "\t\t*count += step;\n";
+				body += vformat("\t\tif ((step < 0 && *count <= to) || (step > 0 && *count >= to)) {\n\t\t\tgoto ip_%d;\n\t\t}\n", target);
+				body += vformat("\t\t*VariantInternal::get_int(%s) = *count;\n", operand(3));
+			} break;
+			case F::OPCODE_LINE: {
+				body += vformat("\t\t*f.line = %d;\n", code[ip + 1]);
+			} break;
+			case F::OPCODE_ASSERT: {
+				body += "#ifdef DEBUG_ENABLED\n";
+				body += vformat("\t\tif (unlikely(!(%s)->booleanize())) {\n\t\t\t%s\n\t\t}\n", operand(0), exit);
+				body += "#endif\n";
+			} break;
+			case F::OPCODE_END: {
+				body += vformat("\t\t%s\n", exit);
+			} break;
+			default: {
+				// Type adjustment, the only other instructions accepted when measuring lengths.
+				body += vformat("\t\tVariantTypeAdjust<%s>::adjust(%s);\n", type_adjust_names[code[ip] - F::OPCODE_TYPE_ADJUST_BOOL], operand(0));
+			} break;
+		}
+
+		body += "\t}\n";
+		ip += length;
+	}
+
+	if (!valid) {
+		return false;
+	}
+
+	LocalVector<int> sorted_labels;
+	for (const int label : labels) {
+		sorted_labels.push_back(label);
+	}
+	sorted_labels.sort();
+
+	r_source += vformat("// %s\n", GDScriptAOT::get_function_key(p_function));
+	r_source += vformat("static int %s(GDScriptAOT::Frame &f) {\n", p_symbol);
+	r_source += "\t[[maybe_unused]] Variant *stack = f.addresses[0];\n";
+	r_source += "\t[[maybe_unused]] Variant *constants = f.addresses[1];\n";
+	r_source += "\t[[maybe_unused]] Variant *members = f.addresses[2];\n";
+	if (uses_members) {
+		r_source += "\tif (!members) {\n\t\treturn f.ip;\n\t}\n";
+	}
+	r_source += "\n\tswitch (f.ip) {\n";
+	for (const int label : sorted_labels) {
+		r_source += vformat("\t\tcase %d:\n\t\t\tgoto ip_%d;\n", label, label);
+	}
+	r_source += "\t\tdefault:\n\t\t\treturn f.ip;\n\t}\n\n";
+	r_source += body;
+	r_source += "}\n\n";
+	return true;
+}
+
+void GDScriptTranspiler::_add_function(const GDScriptFunction *p_function) {
+	const String key = GDScriptAOT::get_function_key(p_function);
+
+	uint64_t signature = 0;
+	if (!GDScriptAOT::get_signature(p_function, signature)) {
+		skipped.push_back(key);
+		return;
+	}
+
+	const String symbol = vformat("_gdscript_aot_%d", translated.size());
+	if (!_translate_function(p_function, symbol, functions_source)) {
+		skipped.push_back(key);
+		return;
+	}
+
+	TranslatedFunction function;
+	function.key = key;
+	function.symbol = symbol;
+	function.signature = signature;
+	translated.push_back(function);
+}
+
+void GDScriptTranspiler::add_script(const Ref<GDScript> &p_script) {
+	ERR_FAIL_COND(p_script.is_null());
+
+	for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->get_member_functions()) {
+		if (E.value) {
+			_add_function(E.value);
+		}
+	}
+	for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->get_subclasses()) {
+		add_script(E.value);
+	}
+}
+
+String GDScriptTranspiler::get_source() const {
+	String source = "/* THIS FILE IS GENERATED DO NOT EDIT */\n\n";
+	source += "#include \"modules/gdscript/gdscript_aot.h\"\n\n";
+	source += "#include \"core/variant/variant_internal.h\"\n\n";
+	source += functions_source;
+	source += "void register_gdscript_aot_functions() {\n";
+	for (const TranslatedFunction &function : translated) {
+		source += vformat("\tGDScriptAOT::register_function(String::utf8(\"%s\"), 0x%sULL, &%s);\n", function.key.c_escape(), String::num_uint64(function.signature, 16), function.symbol);
+	}
+	source += "}\n";
+	return source;
+}
+
+Error GDScriptTranspiler::save(const String &p_path) const {
+	Error err;
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE, &err);
+	ERR_FAIL_COND_V_MSG(err != OK, err, vformat("Cannot write GDScript translation to \"%s\".", p_path));
+	file->store_string(get_source());
+	return OK;
+}
@@ -0,0 +1,68 @@
+/**************************************************************************/
+/*  gdscript_transpiler.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "core/templates/local_vector.h"
+
+// Translates compiled GDScript functions to C++ source, to be built into
+// export templates with the `gdscript_aot_source` build option.
+//
+// Only functions made of validated, fully typed instructions are translated;
+// others (and anything whose bytecode changes later) keep running as bytecode.
+// Translated code leaves to the interpreter at the same instruction whenever a
+// runtime check fails, so errors are reported the same way.
+class GDScriptTranspiler {
+	struct TranslatedFunction {
+		String key;
+		String symbol;
+		uint64_t signature = 0;
+	};
+
+	LocalVector<TranslatedFunction> translated;
+	LocalVector<String> skipped;
+	String functions_source;
+
+	bool _translate_function(const GDScriptFunction *p_function, const String &p_symbol, String &r_source) const;
+	void _add_function(const GDScriptFunction *p_function);
+
+public:
+	// Translates the member functions of the script and its inner classes.
+	void add_script(const Ref<GDScript> &p_script);
+
+	String get_source() const;
+	Error save(const String &p_path) const;
+
+	int get_translated_count() const { return translated.size(); }
+	// Keys of the functions left to bytecode.
+	const LocalVector<String> &get_skipped() const { return skipped; }
+};
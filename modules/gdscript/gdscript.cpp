@@ -31,6 +31,7 @@
 #include "gdscript.h"
 
 #include "gdscript_analyzer.h"
+#include "gdscript_bytecode_cache.h"
 #include "gdscript_cache.h"
 #include "gdscript_compiler.h"
 #include "gdscript_parser.h"
@@ -810,9 +811,25 @@ Error GDScript::reload(bool p_keep_state) {
 	}
 #endif
 
+	const bool use_bytecode_cache = GDScriptBytecodeCache::is_enabled_for(this);
+
 	valid = false;
+	GDScriptFunction::invalidate_inline_caches();
 	GDScriptParser parser;
 	Error err;
+
+	if (use_bytecode_cache) {
+		err = GDScriptBytecodeCache::load(this);
+		// Also valid when only its dependencies failed to compile, which is reported like a compilation error.
+		if (valid) {
+			if (err == OK && (ScriptServer::is_scripting_enabled() || tool)) {
+				err = _static_init();
+			}
+			reloading = false;
+			return err;
+		}
+	}
+
 	if (!binary_tokens.is_empty()) {
 		err = parser.parse_binary(binary_tokens, path);
 	} else {
@@ -865,6 +882,10 @@ Error GDScript::reload(bool p_keep_state) {
 		}
 	}
 
+	if (use_bytecode_cache) {
+		GDScriptBytecodeCache::save(this, &parser);
+	}
+
 #ifdef TOOLS_ENABLED
 	// Done after compilation because it needs the GDScript object's inner class GDScript objects,
 	// which are made by calling make_scripts() within compiler.compile() above.
@@ -1534,6 +1555,9 @@ void GDScript::_recurse_replace_function_ptrs(const HashMap<GDScriptFunction *,
 }
 
 void GDScript::clear(ClearData *p_clear_data) {
+	// Also covers a new script reusing the address of this one.
+	GDScriptFunction::invalidate_inline_caches();
+
 	if (clearing) {
 		return;
 	}
@@ -2962,6 +2986,8 @@ GDScriptLanguage::GDScriptLanguage() {
 	_debug_max_call_stack = GLOBAL_DEF_RST(PropertyInfo(Variant::INT, "debug/settings/gdscript/max_call_stack", PROPERTY_HINT_RANGE, "512," + itos(GDScriptFunction::MAX_CALL_DEPTH - 1) + ",1"), 1024);
 	track_call_stack = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_call_stacks", false);
 	track_locals = GLOBAL_DEF_RST("debug/settings/gdscript/always_track_local_variables", false);
+	optimize_bytecode = GLOBAL_DEF_RST("debug/settings/gdscript/optimize_bytecode", true);
+	bytecode_cache = GLOBAL_DEF_RST("debug/settings/gdscript/bytecode_cache", false);
 
 #ifdef DEBUG_ENABLED
 	track_call_stack = true;
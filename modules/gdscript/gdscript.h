@@ -89,6 +89,7 @@ class GDScript : public Script {
 	friend class GDScriptLambdaCallable;
 	friend class GDScriptLambdaSelfCallable;
 	friend class GDScriptLanguage;
+	friend class GDScriptBytecodeCache;
 	friend struct GDScriptUtilityFunctionsDefinitions;
 
 	Ref<GDScriptNativeClass> native;
@@ -447,6 +448,8 @@ class GDScriptLanguage : public ScriptLanguage {
 
 	bool track_call_stack = false;
 	bool track_locals = false;
+	bool optimize_bytecode = true;
+	bool bytecode_cache = false;
 
 	static CallLevel *_get_stack_level(uint32_t p_level);
 
@@ -577,6 +580,8 @@ public:
 
 	_FORCE_INLINE_ bool should_track_call_stack() const { return track_call_stack; }
 	_FORCE_INLINE_ bool should_track_locals() const { return track_locals; }
+	_FORCE_INLINE_ bool should_optimize_bytecode() const { return optimize_bytecode; }
+	_FORCE_INLINE_ bool should_use_bytecode_cache() const { return bytecode_cache; }
 	_FORCE_INLINE_ int get_global_array_size() const { return global_array.size(); }
 	_FORCE_INLINE_ Variant *get_global_array() { return _global_array; }
 	_FORCE_INLINE_ const HashMap<StringName, int> &get_global_map() const { return globals; }
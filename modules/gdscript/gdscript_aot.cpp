@@ -0,0 +1,270 @@
+/**************************************************************************/
+/*  gdscript_aot.cpp                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_aot.h"
+
+#include "gdscript.h"
+#include "gdscript_function.h"
+#include "gdscript_utility_functions.h"
+
+#ifdef GDSCRIPT_AOT_ENABLED
+// Defined in the source generated with `--gdscript-transpile`.
+void register_gdscript_aot_functions();
+#endif
+
+HashMap<String, GDScriptAOT::Entry> GDScriptAOT::functions;
+
+struct GDScriptAOTOperatorInfo {
+	Variant::Operator op = Variant::OP_MAX;
+	Variant::Type type_a = Variant::NIL;
+	Variant::Type type_b = Variant::NIL;
+};
+
+// Stable names for the validated pointers used by compiled functions. Their
+// addresses differ between binaries, so signatures are built from these.
+struct GDScriptAOTDescriptors {
+	HashMap<uintptr_t, String> names;
+	HashMap<String, uintptr_t> pointers;
+	HashMap<uintptr_t, GDScriptAOTOperatorInfo> operators;
+
+	template <typename T>
+	void add(T p_pointer, const String &p_name) {
+		const uintptr_t key = reinterpret_cast<uintptr_t>(p_pointer);
+		if (p_pointer && !names.has(key)) {
+			names.insert(key, p_name);
+			pointers.insert(p_name, key);
+		}
+	}
+
+	template <typename T>
+	const String *get(T p_pointer) const {
+		return names.getptr(reinterpret_cast<uintptr_t>(p_pointer));
+	}
+};
+
+static GDScriptAOTDescriptors _make_descriptors() {
+	GDScriptAOTDescriptors descriptors;
+
+	for (int i = 0; i < Variant::VARIANT_MAX; i++) {
+		const Variant::Type type = (Variant::Type)i;
+		const String type_name = Variant::get_type_name(type);
+
+		for (int op = 0; op < Variant::OP_MAX; op++) {
+			for (int j = 0; j < Variant::VARIANT_MAX; j++) {
+				Variant::ValidatedOperatorEvaluator evaluator = Variant::get_validated_operator_evaluator((Variant::Operator)op, type, (Variant::Type)j);
+				if (!evaluator || descriptors.names.has(reinterpret_cast<uintptr_t>(evaluator))) {
+					continue;
+				}
+				descriptors.add(evaluator, vformat("operator %s(%s, %s)", Variant::get_operator_name((Variant::Operator)op), type_name, Variant::get_type_name((Variant::Type)j)));
+				GDScriptAOTOperatorInfo info;
+				info.op = (Variant::Operator)op;
+				info.type_a = type;
+				info.type_b = (Variant::Type)j;
+				descriptors.operators.insert(reinterpret_cast<uintptr_t>(evaluator), info);
+			}
+		}
+
+		List<StringName> members;
+		Variant::get_member_list(type, &members);
+		for (const StringName &member : members) {
+			descriptors.add(Variant::get_member_validated_setter(type, member), vformat("set %s.%s", type_name, member));
+			descriptors.add(Variant::get_member_validated_getter(type, member), vformat("get %s.%s", type_name, member));
+		}
+
+		descriptors.add(Variant::get_member_validated_keyed_setter(type), vformat("keyed set %s", type_name));
+		descriptors.add(Variant::get_member_validated_keyed_getter(type), vformat("keyed get %s", type_name));
+		descriptors.add(Variant::get_member_validated_indexed_setter(type), vformat("indexed set %s", type_name));
+		descriptors.add(Variant::get_member_validated_indexed_getter(type), vformat("indexed get %s", type_name));
+
+		List<StringName> methods;
+		Variant::get_builtin_method_list(type, &methods);
+		for (const StringName &method : methods) {
+			descriptors.add(Variant::get_validated_builtin_method(type, method), vformat("method %s.%s", type_name, method));
+		}
+
+		for (int j = 0; j < Variant::get_constructor_count(type); j++) {
+			descriptors.add(Variant::get_validated_constructor(type, j), vformat("constructor %s #%d", type_name, j));
+		}
+	}
+
+	List<StringName> utilities;
+	Variant::get_utility_function_list(&utilities);
+	for (const StringName &utility : utilities) {
+		descriptors.add(Variant::get_validated_utility_function(utility), vformat("utility %s", utility));
+	}
+
+	List<StringName> gds_utilities;
+	GDScriptUtilityFunctions::get_function_list(&gds_utilities);
+	for (const StringName &utility : gds_utilities) {
+		descriptors.add(GDScriptUtilityFunctions::get_function(utility), vformat("gdscript utility %s", utility));
+	}
+
+	return descriptors;
+}
+
+static const GDScriptAOTDescriptors &_get_descriptors() {
+	static const GDScriptAOTDescriptors descriptors = _make_descriptors();
+	return descriptors;
+}
+
+template <typename T>
+static bool _hash_pointers(const GDScriptAOTDescriptors &p_descriptors, const T *p_pointers, int p_count, uint64_t &r_hash) {
+	r_hash = hash64_murmur3_64(p_count, r_hash);
+	for (int i = 0; i < p_count; i++) {
+		const String *name = p_descriptors.get(p_pointers[i]);
+		if (!name) {
+			return false;
+		}
+		r_hash = hash64_murmur3_64(name->hash64(), r_hash);
+	}
+	return true;
+}
+
+String GDScriptAOT::get_function_key(const GDScriptFunction *p_function) {
+	ERR_FAIL_NULL_V(p_function, String());
+	const String script_name = p_function->get_script() ? p_function->get_script()->get_fully_qualified_name() : String();
+	return script_name + "::" + String(p_function->get_name());
+}
+
+bool GDScriptAOT::get_signature(const GDScriptFunction *p_function, uint64_t &r_signature) {
+	ERR_FAIL_NULL_V(p_function, false);
+
+	uint64_t hash = hash64_murmur3_64(p_function->_code_size, HASH_MURMUR3_SEED);
+	for (int i = 0; i < p_function->_code_size; i++) {
+		hash = hash64_murmur3_64((uint32_t)p_function->_code_ptr[i], hash);
+	}
+	hash = hash64_murmur3_64(p_function->_stack_size, hash);
+	hash = hash64_murmur3_64(p_function->_instruction_args_size, hash);
+	hash = hash64_murmur3_64(p_function->_constant_count, hash);
+	hash = hash64_murmur3_64(p_function->_argument_count, hash);
+	hash = hash64_murmur3_64(p_function->default_arguments.size(), hash);
+	for (int i = 0; i < p_function->default_arguments.size(); i++) {
+		hash = hash64_murmur3_64(p_function->_default_arg_ptr[i], hash);
+	}
+
+	const GDScriptAOTDescriptors &descriptors = _get_descriptors();
+	if (!_hash_pointers(descriptors, p_function->_operator_funcs_ptr, p_function->_operator_funcs_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_setters_ptr, p_function->_setters_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_getters_ptr, p_function->_getters_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_keyed_setters_ptr, p_function->_keyed_setters_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_keyed_getters_ptr, p_function->_keyed_getters_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_indexed_setters_ptr, p_function->_indexed_setters_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_indexed_getters_ptr, p_function->_indexed_getters_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_builtin_methods_ptr, p_function->_builtin_methods_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_constructors_ptr, p_function->_constructors_count, hash) ||
+			!_hash_pointers(descriptors, p_function->_utilities_ptr, p_function->_utilities_count, hash)) {
+		return false;
+	}
+
+	r_signature = hash;
+	return true;
+}
+
+bool GDScriptAOT::get_operator_info(Variant::ValidatedOperatorEvaluator p_evaluator, Variant::Operator &r_operator, Variant::Type &r_type_a, Variant::Type &r_type_b) {
+	const GDScriptAOTOperatorInfo *info = _get_descriptors().operators.getptr(reinterpret_cast<uintptr_t>(p_evaluator));
+	if (!info) {
+		return false;
+	}
+	r_operator = info->op;
+	r_type_a = info->type_a;
+	r_type_b = info->type_b;
+	return true;
+}
+
+const String *GDScriptAOT::get_pointer_name(uintptr_t p_pointer) {
+	return _get_descriptors().names.getptr(p_pointer);
+}
+
+uintptr_t GDScriptAOT::get_named_pointer(const String &p_name) {
+	const uintptr_t *pointer = _get_descriptors().pointers.getptr(p_name);
+	return pointer ? *pointer : 0;
+}
+
+void GDScriptAOT::register_function(const String &p_key, uint64_t p_signature, Function p_function) {
+	ERR_FAIL_NULL(p_function);
+	Entry entry;
+	entry.signature = p_signature;
+	entry.function = p_function;
+	functions.insert(p_key, entry);
+}
+
+void GDScriptAOT::unregister_function(const String &p_key) {
+	functions.erase(p_key);
+}
+
+GDScriptAOT::Function GDScriptAOT::find_function(const GDScriptFunction *p_function) {
+	if (functions.is_empty()) {
+		return nullptr;
+	}
+
+	const Entry *entry = functions.getptr(get_function_key(p_function));
+	if (!entry) {
+		return nullptr;
+	}
+
+	uint64_t signature = 0;
+	if (!get_signature(p_function, signature) || signature != entry->signature) {
+		// The script changed since it was translated, keep using bytecode.
+		return nullptr;
+	}
+	return entry->function;
+}
+
+void GDScriptAOT::register_generated_functions() {
+#ifdef GDSCRIPT_AOT_ENABLED
+	register_gdscript_aot_functions();
+#endif
+}
+
+void GDScriptAOT::clear_functions() {
+	functions.clear();
+}
+
+#ifdef GDSCRIPT_AOT_ENABLED
+int GDScriptFunction::_aot_execute(int p_ip, Variant *const *p_addresses, int p_defarg, int *r_line, Variant *r_retvalue) {
+	GDScriptAOT::Frame frame;
+	frame.addresses = p_addresses;
+	frame.retvalue = r_retvalue;
+	frame.line = r_line;
+	frame.defarg = p_defarg;
+	frame.ip = p_ip;
+	frame.operator_funcs = _operator_funcs_ptr;
+	frame.setters = _setters_ptr;
+	frame.getters = _getters_ptr;
+	frame.keyed_setters = _keyed_setters_ptr;
+	frame.keyed_getters = _keyed_getters_ptr;
+	frame.indexed_setters = _indexed_setters_ptr;
+	frame.indexed_getters = _indexed_getters_ptr;
+	frame.builtin_methods = _builtin_methods_ptr;
+	frame.constructors = _constructors_ptr;
+	frame.utilities = _utilities_ptr;
+	return aot_function(frame);
+}
+#endif // GDSCRIPT_AOT_ENABLED
@@ -0,0 +1,95 @@
+/**************************************************************************/
+/*  gdscript_aot.h                                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/hash_map.h"
+#include "core/variant/variant.h"
+
+class GDScriptFunction;
+
+// Runtime side of GDScript functions translated ahead of time to C++ (see
+// `GDScriptTranspiler` and the `--gdscript-transpile` command line option).
+//
+// Translated functions are registered by the generated source, and attached
+// to matching GDScriptFunctions when scripts are compiled. A function only
+// matches if its bytecode and the validated operators, getters, setters and
+// calls it resolved are exactly those it was translated from; otherwise it
+// keeps running as bytecode.
+class GDScriptAOT {
+public:
+	// State handed to translated functions. Validated pointers are the
+	// function's own, so generated code indexes them just like the VM.
+	struct Frame {
+		Variant *const *addresses = nullptr;
+		Variant *retvalue = nullptr;
+		int *line = nullptr;
+		int defarg = 0;
+		int ip = 0;
+		const Variant::ValidatedOperatorEvaluator *operator_funcs = nullptr;
+		const Variant::ValidatedSetter *setters = nullptr;
+		const Variant::ValidatedGetter *getters = nullptr;
+		const Variant::ValidatedKeyedSetter *keyed_setters = nullptr;
+		const Variant::ValidatedKeyedGetter *keyed_getters = nullptr;
+		const Variant::ValidatedIndexedSetter *indexed_setters = nullptr;
+		const Variant::ValidatedIndexedGetter *indexed_getters = nullptr;
+		const Variant::ValidatedBuiltInMethod *builtin_methods = nullptr;
+		const Variant::ValidatedConstructor *constructors = nullptr;
+		const Variant::ValidatedUtilityFunction *utilities = nullptr;
+	};
+
+	// Runs from `r_frame.ip` and returns the bytecode position the interpreter
+	// must resume at. After a return, that is the final `OPCODE_END`.
+	typedef int (*Function)(Frame &r_frame);
+
+private:
+	struct Entry {
+		uint64_t signature = 0;
+		Function function = nullptr;
+	};
+
+	static HashMap<String, Entry> functions;
+
+public:
+	static String get_function_key(const GDScriptFunction *p_function);
+	// Fails if the function uses a validated pointer that can't be identified.
+	static bool get_signature(const GDScriptFunction *p_function, uint64_t &r_signature);
+	static bool get_operator_info(Variant::ValidatedOperatorEvaluator p_evaluator, Variant::Operator &r_operator, Variant::Type &r_type_a, Variant::Type &r_type_b);
+	// Stable name of a validated pointer, and back. Also used by `GDScriptBytecodeCache`.
+	static const String *get_pointer_name(uintptr_t p_pointer);
+	static uintptr_t get_named_pointer(const String &p_name);
+
+	static void register_function(const String &p_key, uint64_t p_signature, Function p_function);
+	static void unregister_function(const String &p_key);
+	static Function find_function(const GDScriptFunction *p_function);
+
+	static void register_generated_functions();
+	static void clear_functions();
+};
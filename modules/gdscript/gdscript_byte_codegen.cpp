@@ -39,13 +39,27 @@ uint32_t GDScriptByteCodeGenerator::add_parameter(const StringName &p_name, bool
 		function->_default_arg_count++;
 	}
 
-	return add_local(p_name, p_type);
+	uint32_t stack_pos = add_local(p_name, p_type);
+	// Arguments can be passed without conversion, so don't rely on their type.
+	local_slot_types[stack_pos] = Variant::VARIANT_MAX;
+	return stack_pos;
 }
 
 uint32_t GDScriptByteCodeGenerator::add_local(const StringName &p_name, const GDScriptDataType &p_type) {
 	int stack_pos = locals.size() + GDScriptFunction::FIXED_ADDRESSES_MAX;
 	locals.push_back(StackSlot(p_type.builtin_type, p_type.can_contain_object()));
 	add_stack_identifier(p_name, stack_pos);
+
+	Variant::Type slot_type = Variant::VARIANT_MAX;
+	if (p_type.kind == GDScriptDataType::BUILTIN && p_type.builtin_type > Variant::NIL && p_type.builtin_type < Variant::OBJECT && !String(p_name).begins_with("@")) {
+		slot_type = p_type.builtin_type;
+	}
+	HashMap<int, Variant::Type>::Iterator E = local_slot_types.find(stack_pos);
+	if (!E) {
+		local_slot_types.insert(stack_pos, slot_type);
+	} else if (E->value != slot_type) {
+		E->value = Variant::VARIANT_MAX;
+	}
 	return stack_pos;
 }
 
@@ -193,6 +207,10 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		}
 	}
 
+	if (GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		optimize_bytecode();
+	}
+
 	if (constant_map.size()) {
 		function->_constant_count = constant_map.size();
 		function->constants.resize(constant_map.size());
@@ -392,6 +410,8 @@ GDScriptFunction *GDScriptByteCodeGenerator::write_end() {
 		function->_lambdas_count = 0;
 	}
 
+	function->inline_caches.resize(inline_cache_count);
+
 	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
 		function->stack_debug = stack_debug;
 	}
@@ -561,6 +581,7 @@ void GDScriptByteCodeGenerator::write_unary_operator(const Address &p_target, Va
 		append(Address());
 		append(p_target);
 		append(op_func);
+		operator_return_types[get_operation_pos(op_func)] = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, Variant::NIL);
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -618,6 +639,7 @@ void GDScriptByteCodeGenerator::write_binary_operator(const Address &p_target, V
 		append(p_right_operand);
 		append(p_target);
 		append(op_func);
+		operator_return_types[get_operation_pos(op_func)] = Variant::get_operator_return_type(p_operator, p_left_operand.type.builtin_type, p_right_operand.type.builtin_type);
 #ifdef DEBUG_ENABLED
 		add_debug_name(operator_names, get_operation_pos(op_func), Variant::get_operator_name(p_operator));
 #endif
@@ -859,6 +881,7 @@ void GDScriptByteCodeGenerator::write_set_named(const Address &p_target, const S
 	append(p_target);
 	append(p_source);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const StringName &p_name, const Address &p_source) {
@@ -877,6 +900,7 @@ void GDScriptByteCodeGenerator::write_get_named(const Address &p_target, const S
 	append(p_source);
 	append(p_target);
 	append(p_name);
+	append_inline_cache();
 }
 
 void GDScriptByteCodeGenerator::write_set_member(const Address &p_value, const StringName &p_name) {
@@ -1090,6 +1114,7 @@ void GDScriptByteCodeGenerator::write_call(const Address &p_target, const Addres
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1115,6 +1140,7 @@ void GDScriptByteCodeGenerator::write_call_async(const Address &p_target, const
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1349,6 +1375,7 @@ void GDScriptByteCodeGenerator::write_call_self(const Address &p_target, const S
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1362,6 +1389,7 @@ void GDScriptByteCodeGenerator::write_call_self_async(const Address &p_target, c
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -1375,6 +1403,7 @@ void GDScriptByteCodeGenerator::write_call_script_function(const Address &p_targ
 	append(ct.target);
 	append(p_arguments.size());
 	append(p_function_name);
+	append_inline_cache();
 	ct.cleanup();
 }
 
@@ -99,6 +99,7 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	int max_locals = 0;
 	int current_line = 0;
 	int instr_args_max = 0;
+	int inline_cache_count = 0;
 
 #ifdef DEBUG_ENABLED
 	List<int> temp_stack;
@@ -123,6 +124,17 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 	RBMap<MethodBind *, int> method_bind_map;
 	RBMap<GDScriptFunction *, int> lambdas_map;
 
+	// Used by the bytecode optimizer, see `gdscript_bytecode_optimizer.cpp`.
+	HashMap<int, Variant::Type> local_slot_types; // Built-in type of the typed locals, `VARIANT_MAX` for slots reused with another type.
+	HashMap<int, Variant::Type> operator_return_types; // By operation position.
+	struct OptimizerCode;
+	void optimize_bytecode();
+	int _add_optimizer_constant(OptimizerCode &r_code, const Variant &p_value);
+	void _fold_constants(OptimizerCode &r_code);
+	void _eliminate_member_loads(OptimizerCode &r_code);
+	bool _combine_assign(OptimizerCode &r_code, int p_index, int p_next);
+	void _combine_instructions(OptimizerCode &r_code);
+
 #ifdef DEBUG_ENABLED
 	// Keep method and property names for pointer and validated operations.
 	// Used when disassembling the bytecode.
@@ -451,6 +463,11 @@ class GDScriptByteCodeGenerator : public GDScriptCodeGenerator {
 		opcodes.push_back(get_lambda_function_pos(p_lambda_function));
 	}
 
+	// Reserves the inline cache of an untyped `GET_NAMED`, `SET_NAMED` or `CALL`.
+	void append_inline_cache() {
+		opcodes.push_back(inline_cache_count++);
+	}
+
 	void patch_jump(int p_address) {
 		opcodes.write[p_address] = opcodes.size();
 	}
@@ -0,0 +1,1649 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.cpp                                           */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_bytecode_cache.h"
+
+#include "gdscript.h"
+#include "gdscript_aot.h"
+#include "gdscript_cache.h"
+#include "gdscript_parser.h"
+
+#include "core/config/engine.h"
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/file_access_memory.h"
+#include "core/object/class_db.h"
+#include "core/os/mutex.h"
+#include "core/version.h"
+
+static const char *bytecode_cache_magic = "GDBC";
+static const uint32_t bytecode_cache_version = 2;
+static const int bytecode_cache_hash_size = 16;
+
+enum BytecodeCacheFlags {
+	BYTECODE_CACHE_FLAG_DEBUG = 1 << 0,
+	BYTECODE_CACHE_FLAG_TOOLS = 1 << 1,
+	BYTECODE_CACHE_FLAG_DOUBLE_PRECISION = 1 << 2,
+	BYTECODE_CACHE_FLAG_OPTIMIZE_BYTECODE = 1 << 3,
+	BYTECODE_CACHE_FLAG_TRACK_LOCALS = 1 << 4,
+};
+
+enum BytecodeCacheVariant {
+	BYTECODE_CACHE_VALUE,
+	BYTECODE_CACHE_ARRAY,
+	BYTECODE_CACHE_DICTIONARY,
+	BYTECODE_CACHE_OBJECT,
+};
+
+enum BytecodeCacheObject {
+	BYTECODE_CACHE_OBJECT_NULL,
+	BYTECODE_CACHE_OBJECT_LOCAL_CLASS, // A class of the script being cached.
+	BYTECODE_CACHE_OBJECT_SCRIPT_CLASS, // A class of another GDScript file.
+	BYTECODE_CACHE_OBJECT_NATIVE_CLASS,
+	BYTECODE_CACHE_OBJECT_RESOURCE,
+};
+
+static String _get_engine_build() {
+	return String(GODOT_VERSION_FULL_BUILD) + "." + GODOT_VERSION_HASH;
+}
+
+static uint32_t _get_flags() {
+	uint32_t flags = 0;
+#ifdef DEBUG_ENABLED
+	flags |= BYTECODE_CACHE_FLAG_DEBUG;
+#endif
+#ifdef TOOLS_ENABLED
+	flags |= BYTECODE_CACHE_FLAG_TOOLS;
+#endif
+#ifdef REAL_T_IS_DOUBLE
+	flags |= BYTECODE_CACHE_FLAG_DOUBLE_PRECISION;
+#endif
+	if (GDScriptLanguage::get_singleton()->should_optimize_bytecode()) {
+		flags |= BYTECODE_CACHE_FLAG_OPTIMIZE_BYTECODE;
+	}
+	if (GDScriptLanguage::get_singleton()->should_track_locals()) {
+		flags |= BYTECODE_CACHE_FLAG_TRACK_LOCALS;
+	}
+	return flags;
+}
+
+// Bytecode refers to globals by index, and the analyzer resolved global class names.
+static uint64_t _get_globals_hash() {
+	uint64_t hash = 0;
+	// Summed, so it doesn't depend on the iteration order.
+	for (const KeyValue<StringName, int> &E : GDScriptLanguage::get_singleton()->get_global_map()) {
+		hash += hash64_murmur3_64(E.key.hash(), E.value);
+	}
+
+	LocalVector<StringName> global_classes;
+	ScriptServer::get_global_class_list(global_classes);
+	for (const StringName &global_class : global_classes) {
+		hash += hash64_murmur3_64(global_class.hash(), ScriptServer::get_global_class_path(global_class).hash64());
+	}
+	return hash;
+}
+
+static String _get_source_hash(const GDScript *p_script) {
+	const Vector<uint8_t> &binary_tokens = p_script->get_binary_tokens_source();
+	if (!binary_tokens.is_empty()) {
+		unsigned char hash[16];
+		CryptoCore::md5(binary_tokens.ptr(), binary_tokens.size(), hash);
+		return String::md5(hash);
+	}
+	return p_script->get_source_code().md5_text();
+}
+
+struct BytecodeCacheFileHash {
+	uint64_t modified_time = 0;
+	String md5;
+};
+
+static HashMap<String, BytecodeCacheFileHash> file_hashes;
+static Mutex file_hashes_mutex;
+
+// Dependencies are checked by every script using them, so their hashes are kept until they're modified.
+static String _get_file_hash(const String &p_path) {
+	const String remapped_path = ResourceLoader::path_remap(p_path);
+	const uint64_t modified_time = FileAccess::get_modified_time(remapped_path);
+	{
+		MutexLock lock(file_hashes_mutex);
+		const BytecodeCacheFileHash *file_hash = file_hashes.getptr(remapped_path);
+		if (file_hash && file_hash->modified_time == modified_time) {
+			return file_hash->md5;
+		}
+	}
+
+	BytecodeCacheFileHash file_hash;
+	file_hash.modified_time = modified_time;
+	file_hash.md5 = FileAccess::get_md5(remapped_path);
+
+	MutexLock lock(file_hashes_mutex);
+	file_hashes.insert(remapped_path, file_hash);
+	return file_hash.md5;
+}
+
+struct GDScriptBytecodeCache::Writer {
+	Ref<FileAccess> file;
+	const GDScript *root = nullptr;
+	bool failed = false;
+
+	void store_bool(bool p_value) { file->store_8(p_value ? 1 : 0); }
+	void store_int(int p_value) { file->store_32((uint32_t)p_value); }
+	void store_string(const String &p_string) { file->store_pascal_string(p_string); }
+
+	void store_object(const Object *p_object) {
+		if (p_object == nullptr) {
+			file->store_8(BYTECODE_CACHE_OBJECT_NULL);
+			return;
+		}
+
+		const GDScript *script = Object::cast_to<GDScript>(p_object);
+		if (script) {
+			const GDScript *script_root = const_cast<GDScript *>(script)->get_root_script();
+			if (script_root == root) {
+				file->store_8(BYTECODE_CACHE_OBJECT_LOCAL_CLASS);
+				store_string(script->fully_qualified_name);
+				return;
+			}
+			// Built-in scripts can't be found again by path.
+			if (!script_root->path.is_resource_file()) {
+				failed = true;
+				return;
+			}
+			file->store_8(BYTECODE_CACHE_OBJECT_SCRIPT_CLASS);
+			store_string(script_root->path);
+			store_string(script->fully_qualified_name);
+			return;
+		}
+
+		const GDScriptNativeClass *native_class = Object::cast_to<GDScriptNativeClass>(p_object);
+		if (native_class) {
+			file->store_8(BYTECODE_CACHE_OBJECT_NATIVE_CLASS);
+			store_string(native_class->get_name());
+			return;
+		}
+
+		const Resource *resource = Object::cast_to<Resource>(p_object);
+		if (resource && resource->get_path().is_resource_file()) {
+			file->store_8(BYTECODE_CACHE_OBJECT_RESOURCE);
+			store_string(resource->get_path());
+			return;
+		}
+
+		// Other objects only exist at runtime.
+		failed = true;
+	}
+
+	void store_variant(const Variant &p_value) {
+		switch (p_value.get_type()) {
+			case Variant::OBJECT: {
+				file->store_8(BYTECODE_CACHE_OBJECT);
+				store_object(p_value.get_validated_object());
+			} break;
+			case Variant::ARRAY: {
+				const Array array = p_value;
+				file->store_8(BYTECODE_CACHE_ARRAY);
+				store_bool(array.is_read_only());
+				file->store_32(array.get_typed_builtin());
+				store_string(array.get_typed_class_name());
+				store_variant(array.get_typed_script());
+				file->store_32(array.size());
+				for (int i = 0; i < array.size() && !failed; i++) {
+					store_variant(array[i]);
+				}
+			} break;
+			case Variant::DICTIONARY: {
+				const Dictionary dictionary = p_value;
+				file->store_8(BYTECODE_CACHE_DICTIONARY);
+				store_bool(dictionary.is_read_only());
+				file->store_32(dictionary.get_typed_key_builtin());
+				store_string(dictionary.get_typed_key_class_name());
+				store_variant(dictionary.get_typed_key_script());
+				file->store_32(dictionary.get_typed_value_builtin());
+				store_string(dictionary.get_typed_value_class_name());
+				store_variant(dictionary.get_typed_value_script());
+				file->store_32(dictionary.size());
+				for (const KeyValue<Variant, Variant> &kv : dictionary) {
+					store_variant(kv.key);
+					store_variant(kv.value);
+				}
+			} break;
+			case Variant::RID:
+			case Variant::CALLABLE:
+			case Variant::SIGNAL: {
+				failed = true;
+			} break;
+			default: {
+				file->store_8(BYTECODE_CACHE_VALUE);
+				file->store_var(p_value);
+			} break;
+		}
+	}
+
+	void store_data_type(const GDScriptDataType &p_type) {
+		file->store_8(p_type.kind);
+		file->store_32(p_type.builtin_type);
+		store_string(p_type.native_type);
+		if (p_type.kind == GDScriptDataType::SCRIPT || p_type.kind == GDScriptDataType::GDSCRIPT) {
+			store_object(p_type.script_type);
+			store_bool(p_type.script_type_ref.is_valid());
+		}
+		file->store_32(p_type.container_element_types.size());
+		for (const GDScriptDataType &element_type : p_type.container_element_types) {
+			store_data_type(element_type);
+		}
+	}
+
+	void store_property_info(const PropertyInfo &p_info) {
+		file->store_32(p_info.type);
+		store_string(p_info.name);
+		store_string(p_info.class_name);
+		file->store_32(p_info.hint);
+		store_string(p_info.hint_string);
+		file->store_32(p_info.usage);
+	}
+
+	void store_method_info(const MethodInfo &p_info) {
+		store_string(p_info.name);
+		store_property_info(p_info.return_val);
+		file->store_32(p_info.flags);
+		store_int(p_info.id);
+		file->store_32(p_info.arguments.size());
+		for (const PropertyInfo &argument : p_info.arguments) {
+			store_property_info(argument);
+		}
+		file->store_32(p_info.default_arguments.size());
+		for (const Variant &default_argument : p_info.default_arguments) {
+			store_variant(default_argument);
+		}
+		store_int(p_info.return_val_metadata);
+		file->store_32(p_info.arguments_metadata.size());
+		for (int metadata : p_info.arguments_metadata) {
+			store_int(metadata);
+		}
+	}
+
+	void store_member_info(const GDScript::MemberInfo &p_info) {
+		store_int(p_info.index);
+		store_string(p_info.setter);
+		store_string(p_info.getter);
+		store_data_type(p_info.data_type);
+		store_property_info(p_info.property_info);
+	}
+
+	void store_strings(const Vector<String> &p_strings) {
+		file->store_32(p_strings.size());
+		for (const String &string : p_strings) {
+			store_string(string);
+		}
+	}
+
+	// Validated pointers are stored by name, their addresses change between runs.
+	template <typename T>
+	void store_pointers(const Vector<T> &p_pointers) {
+		file->store_32(p_pointers.size());
+		for (const T &pointer : p_pointers) {
+			const String *name = GDScriptAOT::get_pointer_name(reinterpret_cast<uintptr_t>(pointer));
+			if (name == nullptr) {
+				failed = true;
+				return;
+			}
+			store_string(*name);
+		}
+	}
+
+	void store_function(const GDScriptFunction *p_function) {
+		store_string(p_function->name);
+		store_string(p_function->source);
+		store_bool(p_function->_static);
+		file->store_32(p_function->argument_types.size());
+		for (const GDScriptDataType &argument_type : p_function->argument_types) {
+			store_data_type(argument_type);
+		}
+		store_data_type(p_function->return_type);
+		store_method_info(p_function->method_info);
+		store_variant(p_function->rpc_config);
+		store_int(p_function->_initial_line);
+		store_int(p_function->_argument_count);
+		store_int(p_function->_vararg_index);
+		store_int(p_function->_stack_size);
+		store_int(p_function->_instruction_args_size);
+
+		file->store_32(p_function->temporary_slots.size());
+		for (const KeyValue<int, Variant::Type> &E : p_function->temporary_slots) {
+			store_int(E.key);
+			file->store_32(E.value);
+		}
+
+		file->store_32(p_function->stack_debug.size());
+		for (const GDScriptFunction::StackDebug &stack_debug : p_function->stack_debug) {
+			store_int(stack_debug.line);
+			store_int(stack_debug.pos);
+			store_bool(stack_debug.added);
+			store_string(stack_debug.identifier);
+		}
+
+		// The cache is only read by the same build, so the code is stored in native byte order.
+		file->store_32(p_function->code.size());
+		file->store_buffer((const uint8_t *)p_function->code.ptr(), p_function->code.size() * sizeof(int));
+
+		file->store_32(p_function->default_arguments.size());
+		for (int default_argument : p_function->default_arguments) {
+			store_int(default_argument);
+		}
+
+		file->store_32(p_function->constants.size());
+		for (const Variant &constant : p_function->constants) {
+			store_variant(constant);
+		}
+
+		file->store_32(p_function->global_names.size());
+		for (const StringName &global_name : p_function->global_names) {
+			store_string(global_name);
+		}
+
+		store_pointers(p_function->operator_funcs);
+		store_pointers(p_function->setters);
+		store_pointers(p_function->getters);
+		store_pointers(p_function->keyed_setters);
+		store_pointers(p_function->keyed_getters);
+		store_pointers(p_function->indexed_setters);
+		store_pointers(p_function->indexed_getters);
+		store_pointers(p_function->builtin_methods);
+		store_pointers(p_function->constructors);
+		store_pointers(p_function->utilities);
+		store_pointers(p_function->gds_utilities);
+
+		file->store_32(p_function->methods.size());
+		for (const MethodBind *method : p_function->methods) {
+			store_string(method->get_instance_class());
+			store_string(method->get_name());
+			file->store_32(method->get_hash());
+		}
+
+		file->store_32(p_function->inline_caches.size());
+
+#ifdef DEBUG_ENABLED
+		store_strings(p_function->operator_names);
+		store_strings(p_function->setter_names);
+		store_strings(p_function->getter_names);
+		store_strings(p_function->builtin_methods_names);
+		store_strings(p_function->constructors_names);
+		store_strings(p_function->utilities_names);
+		store_strings(p_function->gds_utilities_names);
+#endif
+
+		file->store_32(p_function->lambdas.size());
+		for (GDScriptFunction *lambda : p_function->lambdas) {
+			const GDScript::LambdaInfo *lambda_info = lambda->_script->lambda_info.getptr(lambda);
+			store_bool(lambda_info != nullptr);
+			if (lambda_info) {
+				store_int(lambda_info->capture_count);
+				store_bool(lambda_info->use_self);
+			}
+			store_function(lambda);
+		}
+	}
+
+	void store_optional_function(const GDScriptFunction *p_function) {
+		store_bool(p_function != nullptr);
+		if (p_function) {
+			store_function(p_function);
+		}
+	}
+
+	void store_header(const GDScript *p_script, const Vector<String> &p_dependencies) {
+		file->store_buffer((const uint8_t *)bytecode_cache_magic, 4);
+		file->store_32(bytecode_cache_version);
+		store_string(_get_engine_build());
+		file->store_32(_get_flags());
+		file->store_64(_get_globals_hash());
+		store_string(_get_source_hash(p_script));
+
+		file->store_32(p_dependencies.size());
+		for (const String &dependency : p_dependencies) {
+			const String hash = _get_file_hash(dependency);
+			if (hash.is_empty()) {
+				failed = true;
+				return;
+			}
+			store_string(dependency);
+			store_string(hash);
+		}
+	}
+
+	void store_skeleton(const GDScript *p_script, LocalVector<const GDScript *> &r_classes) {
+		r_classes.push_back(p_script);
+		store_string(p_script->local_name);
+		store_string(p_script->global_name);
+		store_string(p_script->simplified_icon_path);
+		file->store_32(p_script->subclasses.size());
+		for (const KeyValue<StringName, Ref<GDScript>> &E : p_script->subclasses) {
+			store_string(E.key);
+			store_string(E.value->fully_qualified_name);
+			store_skeleton(E.value.ptr(), r_classes);
+		}
+	}
+
+	void store_class(const GDScript *p_script) {
+		store_bool(p_script->tool);
+		store_bool(p_script->_is_abstract);
+		store_object(p_script->native.ptr());
+		store_object(p_script->base.ptr());
+
+		file->store_32(p_script->member_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->member_indices) {
+			store_string(E.key);
+			store_member_info(E.value);
+		}
+
+		file->store_32(p_script->members.size());
+		for (const StringName &member : p_script->members) {
+			store_string(member);
+		}
+
+		file->store_32(p_script->static_variables_indices.size());
+		for (const KeyValue<StringName, GDScript::MemberInfo> &E : p_script->static_variables_indices) {
+			store_string(E.key);
+			store_member_info(E.value);
+		}
+
+		file->store_32(p_script->constants.size());
+		for (const KeyValue<StringName, Variant> &E : p_script->constants) {
+			store_string(E.key);
+			store_variant(E.value);
+		}
+
+		file->store_32(p_script->_signals.size());
+		for (const KeyValue<StringName, MethodInfo> &E : p_script->_signals) {
+			store_string(E.key);
+			store_method_info(E.value);
+		}
+
+		store_variant(p_script->rpc_config);
+
+#ifdef TOOLS_ENABLED
+		file->store_32(p_script->member_default_values.size());
+		for (const KeyValue<StringName, Variant> &E : p_script->member_default_values) {
+			store_string(E.key);
+			store_variant(E.value);
+		}
+#endif
+
+		file->store_32(p_script->member_functions.size());
+		for (const KeyValue<StringName, GDScriptFunction *> &E : p_script->member_functions) {
+			store_function(E.value);
+		}
+		store_optional_function(p_script->implicit_initializer);
+		store_optional_function(p_script->implicit_ready);
+		store_optional_function(p_script->static_initializer);
+	}
+
+	// The MD5 of everything written before it, stored at the end of the file.
+	void store_hash() {
+		const uint64_t length = file->get_position();
+		Vector<uint8_t> data;
+		data.resize(length);
+		file->seek(0);
+		if (file->get_buffer(data.ptrw(), length) != length) {
+			failed = true;
+			return;
+		}
+		unsigned char hash[bytecode_cache_hash_size];
+		CryptoCore::md5(data.ptr(), length, hash);
+		file->seek(length);
+		file->store_buffer(hash, bytecode_cache_hash_size);
+	}
+};
+
+struct GDScriptBytecodeCache::Reader {
+	// Read in full before any of it is applied to the script, so a damaged file changes nothing.
+	struct ClassData {
+		GDScript *script = nullptr;
+		bool tool = false;
+		bool is_abstract = false;
+		Ref<GDScriptNativeClass> native;
+		Ref<GDScript> base;
+		HashMap<StringName, GDScript::MemberInfo> member_indices;
+		HashSet<StringName> members;
+		HashMap<StringName, GDScript::MemberInfo> static_variables_indices;
+		HashMap<StringName, Variant> constants;
+		HashMap<StringName, MethodInfo> signals;
+		Dictionary rpc_config;
+#ifdef TOOLS_ENABLED
+		HashMap<StringName, Variant> member_default_values;
+#endif
+		HashMap<StringName, GDScriptFunction *> member_functions;
+		GDScriptFunction *implicit_initializer = nullptr;
+		GDScriptFunction *implicit_ready = nullptr;
+		GDScriptFunction *static_initializer = nullptr;
+		HashMap<GDScriptFunction *, GDScript::LambdaInfo> lambda_info;
+
+		void free_functions() {
+			for (const KeyValue<StringName, GDScriptFunction *> &E : member_functions) {
+				memdelete(E.value);
+			}
+			member_functions.clear();
+			if (implicit_initializer) {
+				memdelete(implicit_initializer);
+				implicit_initializer = nullptr;
+			}
+			if (implicit_ready) {
+				memdelete(implicit_ready);
+				implicit_ready = nullptr;
+			}
+			if (static_initializer) {
+				memdelete(static_initializer);
+				static_initializer = nullptr;
+			}
+		}
+
+		void apply() {
+			script->tool = tool;
+			script->_is_abstract = is_abstract;
+			script->native = native;
+			script->base = base;
+			script->member_indices = member_indices;
+			script->members = members;
+			script->static_variables_indices = static_variables_indices;
+			script->static_variables.resize(static_variables_indices.size());
+			script->constants = constants;
+			script->_signals = signals;
+			script->rpc_config = rpc_config;
+#ifdef TOOLS_ENABLED
+			script->member_default_values = member_default_values;
+#endif
+			script->member_functions = member_functions;
+			GDScriptFunction **initializer = member_functions.getptr(GDScriptLanguage::get_singleton()->strings._init);
+			script->initializer = initializer ? *initializer : nullptr;
+			script->implicit_initializer = implicit_initializer;
+			script->implicit_ready = implicit_ready;
+			script->static_initializer = static_initializer;
+			script->lambda_info = lambda_info;
+		}
+	};
+
+	Ref<FileAccess> file;
+	GDScript *root = nullptr;
+	bool failed = false;
+	Vector<uint8_t> data; // Read through `file` once the hash matches.
+
+	bool get_bool() { return file->get_8() != 0; }
+	int get_int() { return (int)file->get_32(); }
+	String get_string() { return file->get_pascal_string(); }
+
+	// Every element takes at least a byte, so a damaged size can't be larger than the rest of the file.
+	int get_count() {
+		const uint32_t count = file->get_32();
+		if (count > file->get_length() - file->get_position()) {
+			failed = true;
+			return 0;
+		}
+		return count;
+	}
+
+	Variant get_object() {
+		switch (file->get_8()) {
+			case BYTECODE_CACHE_OBJECT_NULL: {
+				return Variant((Object *)nullptr);
+			}
+			case BYTECODE_CACHE_OBJECT_LOCAL_CLASS: {
+				GDScript *script = root->find_class(get_string());
+				if (script) {
+					return Ref<GDScript>(script);
+				}
+			} break;
+			case BYTECODE_CACHE_OBJECT_SCRIPT_CLASS: {
+				const String path = get_string();
+				const String fully_qualified_name = get_string();
+				// Like the compiler, only needs its classes for now. It's fully loaded by `GDScriptCache::finish_compiling()`.
+				Error err = OK;
+				Ref<GDScript> script = GDScriptCache::get_shallow_script(path, err, root->path);
+				if (err == OK && script.is_valid()) {
+					GDScript *script_class = script->find_class(fully_qualified_name);
+					if (script_class) {
+						return Ref<GDScript>(script_class);
+					}
+				}
+			} break;
+			case BYTECODE_CACHE_OBJECT_NATIVE_CLASS: {
+				const StringName name = get_string();
+				const int *index = GDScriptLanguage::get_singleton()->get_global_map().getptr(name);
+				if (index) {
+					Ref<GDScriptNativeClass> native_class = GDScriptLanguage::get_singleton()->get_global_array()[*index];
+					if (native_class.is_valid() && native_class->get_name() == name) {
+						return native_class;
+					}
+				}
+			} break;
+			case BYTECODE_CACHE_OBJECT_RESOURCE: {
+				Ref<Resource> resource = ResourceLoader::load(get_string());
+				if (resource.is_valid()) {
+					return resource;
+				}
+			} break;
+		}
+		failed = true;
+		return Variant();
+	}
+
+	Variant get_variant() {
+		switch (file->get_8()) {
+			case BYTECODE_CACHE_VALUE: {
+				return file->get_var();
+			}
+			case BYTECODE_CACHE_ARRAY: {
+				const bool read_only = get_bool();
+				const uint32_t builtin_type = file->get_32();
+				const StringName class_name = get_string();
+				const Variant script = get_variant();
+				const int size = get_count();
+
+				Array array;
+				if (builtin_type != Variant::NIL) {
+					array.set_typed(builtin_type, class_name, script);
+				}
+				array.resize(size);
+				for (int i = 0; i < size && !failed; i++) {
+					array[i] = get_variant();
+				}
+				if (read_only) {
+					array.make_read_only();
+				}
+				return array;
+			}
+			case BYTECODE_CACHE_DICTIONARY: {
+				const bool read_only = get_bool();
+				const uint32_t key_builtin_type = file->get_32();
+				const StringName key_class_name = get_string();
+				const Variant key_script = get_variant();
+				const uint32_t value_builtin_type = file->get_32();
+				const StringName value_class_name = get_string();
+				const Variant value_script = get_variant();
+				const int size = get_count();
+
+				Dictionary dictionary;
+				if (key_builtin_type != Variant::NIL || value_builtin_type != Variant::NIL) {
+					dictionary.set_typed(key_builtin_type, key_class_name, key_script, value_builtin_type, value_class_name, value_script);
+				}
+				for (int i = 0; i < size && !failed; i++) {
+					const Variant key = get_variant();
+					dictionary[key] = get_variant();
+				}
+				if (read_only) {
+					dictionary.make_read_only();
+				}
+				return dictionary;
+			}
+			case BYTECODE_CACHE_OBJECT: {
+				return get_object();
+			}
+		}
+		failed = true;
+		return Variant();
+	}
+
+	GDScriptDataType get_data_type() {
+		GDScriptDataType type;
+		const uint8_t kind = file->get_8();
+		const uint32_t builtin_type = file->get_32();
+		if (kind > GDScriptDataType::GDSCRIPT || builtin_type >= Variant::VARIANT_MAX) {
+			failed = true;
+			return type;
+		}
+		type.kind = (GDScriptDataType::Kind)kind;
+		type.builtin_type = (Variant::Type)builtin_type;
+		type.native_type = get_string();
+		if (type.kind == GDScriptDataType::SCRIPT || type.kind == GDScriptDataType::GDSCRIPT) {
+			// Local classes aren't referenced, see `GDScriptCompiler::_gdtype_from_datatype()`.
+			const Variant script = get_object();
+			type.script_type = Object::cast_to<Script>(script.get_validated_object());
+			if (get_bool()) {
+				type.script_type_ref = Ref<Script>(type.script_type);
+			}
+		}
+		const int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			type.container_element_types.push_back(get_data_type());
+		}
+		return type;
+	}
+
+	PropertyInfo get_property_info() {
+		PropertyInfo info;
+		info.type = (Variant::Type)file->get_32();
+		info.name = get_string();
+		info.class_name = get_string();
+		info.hint = (PropertyHint)file->get_32();
+		info.hint_string = get_string();
+		info.usage = file->get_32();
+		return info;
+	}
+
+	MethodInfo get_method_info() {
+		MethodInfo info;
+		info.name = get_string();
+		info.return_val = get_property_info();
+		info.flags = file->get_32();
+		info.id = get_int();
+		int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			info.arguments.push_back(get_property_info());
+		}
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			info.default_arguments.push_back(get_variant());
+		}
+		info.return_val_metadata = get_int();
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			info.arguments_metadata.push_back(get_int());
+		}
+		return info;
+	}
+
+	GDScript::MemberInfo get_member_info() {
+		GDScript::MemberInfo info;
+		info.index = get_int();
+		info.setter = get_string();
+		info.getter = get_string();
+		info.data_type = get_data_type();
+		info.property_info = get_property_info();
+		return info;
+	}
+
+	Vector<String> get_strings() {
+		Vector<String> strings;
+		const int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			strings.push_back(get_string());
+		}
+		return strings;
+	}
+
+	template <typename T>
+	void get_pointers(Vector<T> &r_pointers, const T *&r_pointers_ptr, int &r_count) {
+		const int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const uintptr_t pointer = GDScriptAOT::get_named_pointer(get_string());
+			if (pointer == 0) {
+				failed = true;
+				break;
+			}
+			r_pointers.push_back(reinterpret_cast<T>(pointer));
+		}
+		r_count = r_pointers.size();
+		r_pointers_ptr = r_count ? r_pointers.ptr() : nullptr;
+	}
+
+	// Sets up the function like `GDScriptByteCodeGenerator::write_end()`. It is always returned, so it can be freed on failure.
+	GDScriptFunction *get_function(GDScript *p_script, HashMap<GDScriptFunction *, GDScript::LambdaInfo> &r_lambda_info, bool p_for_lambda) {
+		GDScriptFunction *function = memnew(GDScriptFunction);
+		function->_script = p_script;
+		function->name = get_string();
+		function->source = get_string();
+		function->_static = get_bool();
+
+		int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			function->argument_types.push_back(get_data_type());
+		}
+		function->return_type = get_data_type();
+		function->method_info = get_method_info();
+		function->rpc_config = get_variant();
+		function->_initial_line = get_int();
+		function->_argument_count = get_int();
+		function->_vararg_index = get_int();
+		function->_stack_size = get_int();
+		function->_instruction_args_size = get_int();
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const int slot = get_int();
+			function->temporary_slots[slot] = (Variant::Type)file->get_32();
+		}
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			GDScriptFunction::StackDebug stack_debug;
+			stack_debug.line = get_int();
+			stack_debug.pos = get_int();
+			stack_debug.added = get_bool();
+			stack_debug.identifier = get_string();
+			function->stack_debug.push_back(stack_debug);
+		}
+
+		count = get_count();
+		if (failed || count == 0) {
+			failed = true;
+			return function;
+		}
+		function->code.resize(count);
+		if (file->get_buffer((uint8_t *)function->code.ptrw(), count * sizeof(int)) != count * sizeof(int)) {
+			failed = true;
+			return function;
+		}
+		function->_code_ptr = function->code.ptrw();
+		function->_code_size = count;
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			function->default_arguments.push_back(get_int());
+		}
+		if (function->default_arguments.size()) {
+			function->_default_arg_count = function->default_arguments.size() - 1;
+			function->_default_arg_ptr = function->default_arguments.ptr();
+		}
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			function->constants.push_back(get_variant());
+		}
+		function->_constant_count = function->constants.size();
+		function->_constants_ptr = function->_constant_count ? function->constants.ptrw() : nullptr;
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			function->global_names.push_back(get_string());
+		}
+		function->_global_names_count = function->global_names.size();
+		function->_global_names_ptr = function->_global_names_count ? function->global_names.ptr() : nullptr;
+
+		get_pointers(function->operator_funcs, function->_operator_funcs_ptr, function->_operator_funcs_count);
+		get_pointers(function->setters, function->_setters_ptr, function->_setters_count);
+		get_pointers(function->getters, function->_getters_ptr, function->_getters_count);
+		get_pointers(function->keyed_setters, function->_keyed_setters_ptr, function->_keyed_setters_count);
+		get_pointers(function->keyed_getters, function->_keyed_getters_ptr, function->_keyed_getters_count);
+		get_pointers(function->indexed_setters, function->_indexed_setters_ptr, function->_indexed_setters_count);
+		get_pointers(function->indexed_getters, function->_indexed_getters_ptr, function->_indexed_getters_count);
+		get_pointers(function->builtin_methods, function->_builtin_methods_ptr, function->_builtin_methods_count);
+		get_pointers(function->constructors, function->_constructors_ptr, function->_constructors_count);
+		get_pointers(function->utilities, function->_utilities_ptr, function->_utilities_count);
+		get_pointers(function->gds_utilities, function->_gds_utilities_ptr, function->_gds_utilities_count);
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const StringName class_name = get_string();
+			const StringName method_name = get_string();
+			const uint32_t hash = file->get_32();
+			// Also catches extensions changing the method since the cache was written.
+			MethodBind *method = ClassDB::get_method(class_name, method_name);
+			if (method == nullptr || method->get_hash() != hash) {
+				failed = true;
+				break;
+			}
+			function->methods.push_back(method);
+		}
+		function->_methods_count = function->methods.size();
+		function->_methods_ptr = function->_methods_count ? function->methods.ptrw() : nullptr;
+
+		function->inline_caches.resize(get_count());
+
+#ifdef DEBUG_ENABLED
+		function->operator_names = get_strings();
+		function->setter_names = get_strings();
+		function->getter_names = get_strings();
+		function->builtin_methods_names = get_strings();
+		function->constructors_names = get_strings();
+		function->utilities_names = get_strings();
+		function->gds_utilities_names = get_strings();
+
+		function->func_cname = (String(function->source) + " - " + String(function->name)).utf8();
+		function->_func_cname = function->func_cname.get_data();
+#endif
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const bool has_lambda_info = get_bool();
+			GDScript::LambdaInfo lambda_info = { 0, false };
+			if (has_lambda_info) {
+				lambda_info.capture_count = get_int();
+				lambda_info.use_self = get_bool();
+			}
+			GDScriptFunction *lambda = get_function(p_script, r_lambda_info, true);
+			function->lambdas.push_back(lambda);
+			if (has_lambda_info) {
+				r_lambda_info.insert(lambda, lambda_info);
+			}
+		}
+		function->_lambdas_count = function->lambdas.size();
+		function->_lambdas_ptr = function->_lambdas_count ? function->lambdas.ptrw() : nullptr;
+
+#ifdef GDSCRIPT_AOT_ENABLED
+		if (!p_for_lambda && !failed) {
+			function->aot_function = GDScriptAOT::find_function(function);
+		}
+#endif
+
+		return function;
+	}
+
+	GDScriptFunction *get_optional_function(GDScript *p_script, HashMap<GDScriptFunction *, GDScript::LambdaInfo> &r_lambda_info) {
+		if (!get_bool() || failed) {
+			return nullptr;
+		}
+		return get_function(p_script, r_lambda_info, false);
+	}
+
+	bool check_header(const GDScript *p_script) {
+		char magic[5] = {};
+		file->get_buffer((uint8_t *)magic, 4);
+		if (String(magic) != bytecode_cache_magic || file->get_32() != bytecode_cache_version) {
+			return false;
+		}
+		if (get_string() != _get_engine_build() || file->get_32() != _get_flags() || file->get_64() != _get_globals_hash()) {
+			return false;
+		}
+		if (get_string() != _get_source_hash(p_script)) {
+			return false;
+		}
+
+		const int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const String dependency = get_string();
+			if (get_string() != _get_file_hash(dependency)) {
+				return false;
+			}
+		}
+		return !failed && !file->eof_reached();
+	}
+
+	// Compares the file with the hash at its end, so damaged files are rejected before anything in them is used.
+	bool check_hash() {
+		const uint64_t position = file->get_position();
+		const uint64_t length = file->get_length();
+		if (length < position + bytecode_cache_hash_size) {
+			return false;
+		}
+		data.resize(length - bytecode_cache_hash_size);
+		unsigned char stored_hash[bytecode_cache_hash_size];
+		file->seek(0);
+		if (file->get_buffer(data.ptrw(), data.size()) != (uint64_t)data.size() || file->get_buffer(stored_hash, bytecode_cache_hash_size) != bytecode_cache_hash_size) {
+			return false;
+		}
+		unsigned char hash[bytecode_cache_hash_size];
+		CryptoCore::md5(data.ptr(), data.size(), hash);
+		if (memcmp(hash, stored_hash, bytecode_cache_hash_size) != 0) {
+			return false;
+		}
+
+		Ref<FileAccessMemory> memory;
+		memory.instantiate();
+		if (memory->open_custom(data.ptr(), data.size()) != OK) {
+			return false;
+		}
+		memory->seek(position);
+		file = memory;
+		return true;
+	}
+
+	// Same as `GDScriptCompiler::make_scripts()`.
+	void get_skeleton(GDScript *p_script, const String &p_fully_qualified_name, LocalVector<GDScript *> &r_classes) {
+		r_classes.push_back(p_script);
+		p_script->fully_qualified_name = p_fully_qualified_name;
+		p_script->local_name = get_string();
+		p_script->global_name = get_string();
+		p_script->simplified_icon_path = get_string();
+
+		HashMap<StringName, Ref<GDScript>> old_subclasses = p_script->subclasses;
+		p_script->subclasses.clear();
+
+		const int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const StringName name = get_string();
+			const String fully_qualified_name = get_string();
+
+			Ref<GDScript> subclass;
+			if (old_subclasses.has(name)) {
+				subclass = old_subclasses[name];
+			} else {
+				subclass = GDScriptLanguage::get_singleton()->get_orphan_subclass(fully_qualified_name);
+			}
+			if (subclass.is_null()) {
+				subclass.instantiate();
+			}
+
+			subclass->_owner = p_script;
+			subclass->path = p_script->path;
+			p_script->subclasses.insert(name, subclass);
+
+			get_skeleton(subclass.ptr(), fully_qualified_name, r_classes);
+		}
+	}
+
+	void get_class(ClassData &r_data) {
+		r_data.tool = get_bool();
+		r_data.is_abstract = get_bool();
+		r_data.native = get_object();
+		r_data.base = get_object();
+		if (r_data.native.is_null()) {
+			failed = true;
+			return;
+		}
+
+		int count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const StringName name = get_string();
+			r_data.member_indices.insert(name, get_member_info());
+		}
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			r_data.members.insert(get_string());
+		}
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const StringName name = get_string();
+			r_data.static_variables_indices.insert(name, get_member_info());
+		}
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const StringName name = get_string();
+			r_data.constants.insert(name, get_variant());
+		}
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const StringName name = get_string();
+			r_data.signals.insert(name, get_method_info());
+		}
+
+		r_data.rpc_config = get_variant();
+
+#ifdef TOOLS_ENABLED
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			const StringName name = get_string();
+			r_data.member_default_values.insert(name, get_variant());
+		}
+#endif
+
+		count = get_count();
+		for (int i = 0; i < count && !failed; i++) {
+			GDScriptFunction *function = get_function(r_data.script, r_data.lambda_info, false);
+			r_data.member_functions.insert(function->name, function);
+		}
+		r_data.implicit_initializer = get_optional_function(r_data.script, r_data.lambda_info);
+		r_data.implicit_ready = get_optional_function(r_data.script, r_data.lambda_info);
+		r_data.static_initializer = get_optional_function(r_data.script, r_data.lambda_info);
+		if (r_data.implicit_initializer == nullptr) {
+			failed = true;
+		}
+	}
+
+	// The VM trusts the compiler for the operands of each instruction, and only checks some of them in debug builds.
+	// Every address, table index, type and jump target is checked here instead, so damaged code never runs.
+	bool is_code_valid(GDScriptFunction *p_function, int p_member_count, const HashMap<const GDScript *, int> &p_static_variable_counts) const {
+		const GDScriptFunction *function = p_function;
+		if (function->_argument_count < 0 || function->_argument_count != function->argument_types.size() || function->_instruction_args_size < 0) {
+			return false;
+		}
+		if (function->_stack_size < GDScriptFunction::FIXED_ADDRESSES_MAX + function->_argument_count || (function->is_vararg() && function->_vararg_index >= function->_stack_size)) {
+			return false;
+		}
+		for (const KeyValue<int, Variant::Type> &E : function->temporary_slots) {
+			if (E.key < 0 || E.key >= function->_stack_size || E.value < 0 || E.value >= Variant::VARIANT_MAX) {
+				return false;
+			}
+		}
+
+		int *code = p_function->_code_ptr;
+		const int code_size = function->_code_size;
+
+		// Jumps may also go to the end of the code.
+		LocalVector<bool> starts;
+		starts.resize(code_size + 1);
+		for (int ip = 0; ip < code_size;) {
+			const int size = GDScriptFunction::get_instruction_size(code, code_size, ip);
+			if (size == 0) {
+				return false;
+			}
+			for (int i = 0; i < size; i++) {
+				starts[ip + i] = i == 0;
+			}
+			ip += size;
+		}
+		starts[code_size] = true;
+
+		const int address_limits[GDScriptFunction::ADDR_TYPE_MAX] = { function->_stack_size, function->_constant_count, p_member_count };
+		const auto is_address = [&](int p_address) {
+			const int type = (p_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS;
+			return type >= 0 && type < GDScriptFunction::ADDR_TYPE_MAX && (p_address & GDScriptFunction::ADDR_MASK) < address_limits[type];
+		};
+		const auto is_index = [](int p_index, int p_count) {
+			return p_index >= 0 && p_index < p_count;
+		};
+		const auto is_type = [](int p_type) {
+			return p_type >= 0 && p_type < Variant::VARIANT_MAX;
+		};
+		const auto is_target = [&](int p_ip) {
+			return p_ip >= 0 && p_ip <= code_size && starts[p_ip];
+		};
+		const auto is_static_variable = [&](int p_class_address, int p_index) {
+			if (p_index < 0) {
+				return false;
+			}
+			// The layout of other scripts is covered by their hash.
+			if ((p_class_address & GDScriptFunction::ADDR_TYPE_MASK) >> GDScriptFunction::ADDR_BITS == GDScriptFunction::ADDR_TYPE_CONSTANT) {
+				const GDScript *script = Object::cast_to<GDScript>(function->constants[p_class_address & GDScriptFunction::ADDR_MASK].get_validated_object());
+				const int *count = p_static_variable_counts.getptr(script);
+				return count == nullptr || p_index < *count;
+			}
+			return true;
+		};
+		const auto is_method_bind_validated = [&](int p_method, int p_argc) {
+			return is_index(p_method, function->_methods_count) && !function->_methods_ptr[p_method]->is_vararg() && function->_methods_ptr[p_method]->get_argument_count() == p_argc;
+		};
+
+		if (function->default_arguments.size() > function->_argument_count + 1) {
+			return false;
+		}
+		for (int default_argument : function->default_arguments) {
+			if (!is_target(default_argument) || default_argument == code_size) {
+				return false;
+			}
+		}
+
+		for (int ip = 0; ip < code_size;) {
+			const int size = GDScriptFunction::get_instruction_size(code, code_size, ip);
+			const int *words = &code[ip];
+			const int *addresses = &words[1];
+			int address_count = 0;
+			const int *trailing = nullptr;
+			bool valid = true;
+
+			// Instructions with a variable amount of addresses store the count after the opcode, and their other words after the addresses.
+			const auto load_instruction_args = [&]() {
+				addresses = &words[2];
+				address_count = words[1];
+				trailing = &words[1 + address_count];
+				valid = address_count <= function->_instruction_args_size;
+			};
+			const auto has_args = [&](int p_argc, int p_count) {
+				return p_argc >= 0 && p_argc <= address_count - p_count;
+			};
+
+			switch (words[0]) {
+				case GDScriptFunction::OPCODE_OPERATOR: {
+					address_count = 3;
+					valid = is_index(words[4], Variant::OP_MAX);
+					// Holds the evaluator picked when it first runs, which is only valid in the process that picked it.
+					for (int i = 5; i < size; i++) {
+						code[ip + i] = 0;
+					}
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+					address_count = 3;
+					valid = is_index(words[4], function->_operator_funcs_count);
+				} break;
+				case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+					address_count = 3;
+					valid = is_index(words[4], function->_operator_funcs_count) && is_target(words[5]);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_BUILTIN:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+				case GDScriptFunction::OPCODE_CAST_TO_BUILTIN: {
+					address_count = 2;
+					valid = is_type(words[3]);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_ARRAY:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_ARRAY: {
+					address_count = 3;
+					valid = is_type(words[4]) && is_index(words[5], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_DICTIONARY:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_DICTIONARY: {
+					address_count = 4;
+					valid = is_type(words[5]) && is_index(words[6], function->_global_names_count) && is_type(words[7]) && is_index(words[8], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_NATIVE: {
+					address_count = 2;
+					valid = is_index(words[3], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_TYPE_TEST_SCRIPT:
+				case GDScriptFunction::OPCODE_SET_KEYED:
+				case GDScriptFunction::OPCODE_GET_KEYED:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_ASSIGN_TYPED_SCRIPT:
+				case GDScriptFunction::OPCODE_CAST_TO_NATIVE:
+				case GDScriptFunction::OPCODE_CAST_TO_SCRIPT: {
+					address_count = 3;
+				} break;
+				case GDScriptFunction::OPCODE_SET_KEYED_VALIDATED: {
+					address_count = 3;
+					valid = is_index(words[4], function->_keyed_setters_count);
+				} break;
+				case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED: {
+					address_count = 3;
+					valid = is_index(words[4], function->_keyed_getters_count);
+				} break;
+				case GDScriptFunction::OPCODE_SET_INDEXED_VALIDATED: {
+					address_count = 3;
+					valid = is_index(words[4], function->_indexed_setters_count);
+				} break;
+				case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED: {
+					address_count = 3;
+					valid = is_index(words[4], function->_indexed_getters_count);
+				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED:
+				case GDScriptFunction::OPCODE_GET_NAMED: {
+					address_count = 2;
+					valid = is_index(words[3], function->_global_names_count) && is_index(words[4], function->inline_caches.size());
+				} break;
+				case GDScriptFunction::OPCODE_SET_NAMED_VALIDATED: {
+					address_count = 2;
+					valid = is_index(words[3], function->_setters_count);
+				} break;
+				case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED: {
+					address_count = 2;
+					valid = is_index(words[3], function->_getters_count);
+				} break;
+				case GDScriptFunction::OPCODE_SET_MEMBER:
+				case GDScriptFunction::OPCODE_GET_MEMBER: {
+					address_count = 1;
+					valid = is_index(words[2], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_SET_STATIC_VARIABLE:
+				case GDScriptFunction::OPCODE_GET_STATIC_VARIABLE: {
+					address_count = 2;
+					valid = is_address(words[2]) && is_static_variable(words[2], words[3]);
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN:
+				case GDScriptFunction::OPCODE_INCREMENT_INT:
+				case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+				case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT: {
+					address_count = 2;
+				} break;
+				case GDScriptFunction::OPCODE_ASSIGN_NULL:
+				case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+				case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+				case GDScriptFunction::OPCODE_AWAIT_RESUME:
+				case GDScriptFunction::OPCODE_RETURN: {
+					address_count = 1;
+				} break;
+				case GDScriptFunction::OPCODE_AWAIT: {
+					// Also writes the result to the address of the instruction after it.
+					address_count = 1;
+					valid = ip + size < code_size && code[ip + size] == GDScriptFunction::OPCODE_AWAIT_RESUME;
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1) && is_type(trailing[2]);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1) && is_index(trailing[2], function->_constructors_count);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_ARRAY: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_ARRAY: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 2) && is_type(trailing[2]) && is_index(trailing[3], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_DICTIONARY: {
+					load_instruction_args();
+					valid = valid && trailing[1] >= 0 && has_args(trailing[1] * 2, 1);
+				} break;
+				case GDScriptFunction::OPCODE_CONSTRUCT_TYPED_DICTIONARY: {
+					load_instruction_args();
+					valid = valid && trailing[1] >= 0 && has_args(trailing[1] * 2, 3) && is_type(trailing[2]) && is_index(trailing[3], function->_global_names_count) && is_type(trailing[4]) && is_index(trailing[5], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_CALL:
+				case GDScriptFunction::OPCODE_CALL_RETURN:
+				case GDScriptFunction::OPCODE_CALL_ASYNC: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 2) && is_index(trailing[2], function->_global_names_count) && is_index(trailing[3], function->inline_caches.size());
+				} break;
+				case GDScriptFunction::OPCODE_CALL_UTILITY:
+				case GDScriptFunction::OPCODE_CALL_SELF_BASE: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1) && is_index(trailing[2], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_UTILITY_VALIDATED: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1) && is_index(trailing[2], function->_utilities_count);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_GDSCRIPT_UTILITY: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1) && is_index(trailing[2], function->_gds_utilities_count);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 2) && is_index(trailing[2], function->_builtin_methods_count);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_RET: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 2) && is_index(trailing[2], function->_methods_count);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_BUILTIN_STATIC: {
+					load_instruction_args();
+					valid = valid && is_type(trailing[1]) && is_index(trailing[2], function->_global_names_count) && has_args(trailing[3], 1);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC: {
+					load_instruction_args();
+					valid = valid && is_index(trailing[1], function->_methods_count) && has_args(trailing[2], 1);
+				} break;
+				// Validated calls pass exactly as many arguments as the method takes.
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+				case GDScriptFunction::OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1) && is_method_bind_validated(trailing[2], trailing[1]);
+				} break;
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+				case GDScriptFunction::OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 2) && is_method_bind_validated(trailing[2], trailing[1]);
+				} break;
+				case GDScriptFunction::OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 2) && is_index(trailing[2], function->_builtin_methods_count) && is_index(trailing[3], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_CREATE_LAMBDA:
+				case GDScriptFunction::OPCODE_CREATE_SELF_LAMBDA: {
+					load_instruction_args();
+					valid = valid && has_args(trailing[1], 1) && is_index(trailing[2], function->_lambdas_count);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP: {
+					valid = is_target(words[1]);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_IF:
+				case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+				case GDScriptFunction::OPCODE_JUMP_IF_SHARED: {
+					address_count = 1;
+					valid = is_target(words[2]);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN: {
+					address_count = 1;
+					valid = is_type(words[2]);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY: {
+					address_count = 2;
+					valid = is_type(words[3]) && is_index(words[4], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY: {
+					address_count = 3;
+					valid = is_type(words[4]) && is_index(words[5], function->_global_names_count) && is_type(words[6]) && is_index(words[7], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_STORE_GLOBAL: {
+					address_count = 1;
+					valid = is_index(words[2], GDScriptLanguage::get_singleton()->get_global_array_size());
+				} break;
+				case GDScriptFunction::OPCODE_STORE_NAMED_GLOBAL: {
+					address_count = 1;
+					valid = is_index(words[2], function->_global_names_count);
+				} break;
+				case GDScriptFunction::OPCODE_ASSERT: {
+					// The message is optional.
+					address_count = 1;
+					valid = words[2] == 0 || is_address(words[2]);
+				} break;
+				case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+				case GDScriptFunction::OPCODE_BREAKPOINT:
+				case GDScriptFunction::OPCODE_LINE:
+				case GDScriptFunction::OPCODE_END: {
+				} break;
+				default: {
+					if (words[0] >= GDScriptFunction::OPCODE_ITERATE_BEGIN && words[0] <= GDScriptFunction::OPCODE_ITERATE_RANGE) {
+						// Jumps past the loop when there's nothing left to iterate.
+						address_count = size - 2;
+						valid = is_target(words[size - 1]);
+					} else if (words[0] >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && words[0] <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY) {
+						address_count = 1;
+					} else {
+						valid = false;
+					}
+				} break;
+			}
+
+			for (int i = 0; i < address_count && valid; i++) {
+				valid = is_address(addresses[i]);
+			}
+			if (!valid) {
+				return false;
+			}
+			ip += size;
+		}
+
+		for (GDScriptFunction *lambda : p_function->lambdas) {
+			if (!is_code_valid(lambda, p_member_count, p_static_variable_counts)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	bool is_class_code_valid(const ClassData &p_data, const HashMap<const GDScript *, int> &p_static_variable_counts) const {
+		const int member_count = p_data.member_indices.size();
+		for (const KeyValue<StringName, GDScriptFunction *> &E : p_data.member_functions) {
+			if (!is_code_valid(E.value, member_count, p_static_variable_counts)) {
+				return false;
+			}
+		}
+		for (GDScriptFunction *function : { p_data.implicit_initializer, p_data.implicit_ready, p_data.static_initializer }) {
+			if (function && !is_code_valid(function, member_count, p_static_variable_counts)) {
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+bool GDScriptBytecodeCache::is_enabled_for(const GDScript *p_script) {
+	ERR_FAIL_NULL_V(p_script, false);
+	if (!GDScriptLanguage::get_singleton()->should_use_bytecode_cache() || EngineDebugger::is_active()) {
+		return false;
+	}
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false;
+	}
+#endif
+	// Only for scripts loaded from a file for the first time.
+	return p_script->is_root_script() && p_script->path.is_resource_file() && !p_script->valid && p_script->implicit_initializer == nullptr;
+}
+
+String GDScriptBytecodeCache::get_cache_path(const String &p_script_path) {
+	return String("user://gdscript_cache").path_join(p_script_path.md5_text() + ".cache");
+}
+
+Error GDScriptBytecodeCache::_load(GDScript *p_script, const String &p_cache_path, bool p_skeleton_only) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(!p_script->is_root_script() || p_script->implicit_initializer != nullptr, ERR_ALREADY_IN_USE, "Only scripts which haven't been compiled yet can be loaded from the bytecode cache.");
+
+	Reader reader;
+	reader.file = FileAccess::open(p_cache_path, FileAccess::READ);
+	if (reader.file.is_null()) {
+		return ERR_FILE_NOT_FOUND;
+	}
+	reader.root = p_script;
+
+	// Written by another build, or for another version of the script or its dependencies.
+	if (!reader.check_header(p_script)) {
+		return ERR_FILE_UNRECOGNIZED;
+	}
+	if (!reader.check_hash()) {
+		return ERR_FILE_CORRUPT;
+	}
+
+	LocalVector<GDScript *> classes;
+	reader.get_skeleton(p_script, reader.get_string(), classes);
+	if (reader.failed || reader.file->eof_reached()) {
+		return ERR_FILE_CORRUPT;
+	}
+	if (p_skeleton_only) {
+		return OK;
+	}
+
+	const bool add_static_script = reader.get_bool();
+
+	LocalVector<Reader::ClassData> class_data;
+	class_data.resize(classes.size());
+	for (uint32_t i = 0; i < classes.size() && !reader.failed; i++) {
+		class_data[i].script = classes[i];
+		reader.get_class(class_data[i]);
+	}
+	if (!reader.failed && !reader.file->eof_reached() && reader.file->get_position() == reader.file->get_length()) {
+		HashMap<const GDScript *, int> static_variable_counts;
+		for (const Reader::ClassData &data : class_data) {
+			static_variable_counts.insert(data.script, data.static_variables_indices.size());
+		}
+		for (uint32_t i = 0; i < class_data.size() && !reader.failed; i++) {
+			reader.failed = !reader.is_class_code_valid(class_data[i], static_variable_counts);
+		}
+	} else {
+		reader.failed = true;
+	}
+	if (reader.failed) {
+		for (Reader::ClassData &data : class_data) {
+			data.free_functions();
+		}
+		return ERR_FILE_CORRUPT;
+	}
+
+	// Nothing can fail from here on.
+	for (Reader::ClassData &data : class_data) {
+		data.apply();
+	}
+	for (GDScript *script : classes) {
+		script->_static_default_init();
+		script->valid = true;
+	}
+	GDScriptFunction::invalidate_inline_caches();
+
+	if (add_static_script) {
+		GDScriptCache::add_static_script(p_script);
+	}
+
+	if (!p_script->path.is_empty() && GDScriptCache::finish_compiling(p_script->path) != OK) {
+		return ERR_COMPILATION_FAILED;
+	}
+	return OK;
+}
+
+Error GDScriptBytecodeCache::make_scripts(GDScript *p_script) {
+	if (!is_enabled_for(p_script)) {
+		return ERR_UNAVAILABLE;
+	}
+	return _load(p_script, get_cache_path(p_script->path), true);
+}
+
+Error GDScriptBytecodeCache::load(GDScript *p_script) {
+	return _load(p_script, get_cache_path(p_script->path), false);
+}
+
+void GDScriptBytecodeCache::save(const GDScript *p_script, GDScriptParser *p_parser) {
+	ERR_FAIL_NULL(p_parser);
+
+	// Every script the analyzer looked into, since their constants and member layout may be part of the compiled code.
+	HashSet<String> dependencies;
+	LocalVector<GDScriptParser *> pending;
+	pending.push_back(p_parser);
+	while (!pending.is_empty()) {
+		GDScriptParser *parser = pending[pending.size() - 1];
+		pending.resize(pending.size() - 1);
+		for (const KeyValue<String, Ref<GDScriptParserRef>> &E : parser->get_depended_parsers()) {
+			if (E.key == p_script->path || dependencies.has(E.key)) {
+				continue;
+			}
+			if (E.value.is_null() || E.value->get_parser() == nullptr) {
+				// Can't tell what it depends on.
+				return;
+			}
+			dependencies.insert(E.key);
+			pending.push_back(E.value->get_parser());
+		}
+	}
+
+	Vector<String> dependency_paths;
+	for (const String &dependency : dependencies) {
+		dependency_paths.push_back(dependency);
+	}
+
+	const String cache_path = get_cache_path(p_script->path);
+	Error err = DirAccess::make_dir_recursive_absolute(cache_path.get_base_dir());
+	if (err == OK) {
+		err = save_to_file(p_script, dependency_paths, cache_path);
+	}
+	if (err != OK) {
+		print_verbose(vformat(R"(GDScript: "%s" was not added to the bytecode cache: %s.)", p_script->path, error_names[err]));
+	}
+}
+
+Error GDScriptBytecodeCache::load_from_file(GDScript *p_script, const String &p_cache_path) {
+	return _load(p_script, p_cache_path, false);
+}
+
+Error GDScriptBytecodeCache::save_to_file(const GDScript *p_script, const Vector<String> &p_dependencies, const String &p_cache_path) {
+	ERR_FAIL_NULL_V(p_script, ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V(!p_script->is_root_script() || !p_script->valid, ERR_INVALID_PARAMETER);
+
+	// Written next to the cache file and moved in place once complete, so a partial file is never read.
+	const String temp_path = p_cache_path + ".tmp";
+	Error err = OK;
+
+	Writer writer;
+	writer.file = FileAccess::open(temp_path, FileAccess::WRITE_READ, &err);
+	if (writer.file.is_null()) {
+		return err;
+	}
+	writer.root = p_script;
+
+	writer.store_header(p_script, p_dependencies);
+
+	LocalVector<const GDScript *> classes;
+	writer.store_string(p_script->fully_qualified_name);
+	writer.store_skeleton(p_script, classes);
+
+	// Decided by the compiler, since `@static_unload` isn't kept after compiling.
+	writer.store_bool(GDScriptCache::singleton->static_gdscript_cache.has(p_script->fully_qualified_name));
+
+	for (uint32_t i = 0; i < classes.size() && !writer.failed; i++) {
+		writer.store_class(classes[i]);
+	}
+	if (!writer.failed) {
+		writer.store_hash();
+	}
+
+	const bool failed = writer.failed || writer.file->get_error() != OK;
+	writer.file.unref();
+
+	if (failed) {
+		DirAccess::remove_absolute(temp_path);
+		// Only happens with constants which can't be found again when loading, e.g. built-in resources.
+		return ERR_UNAVAILABLE;
+	}
+	return DirAccess::rename_absolute(temp_path, p_cache_path);
+}
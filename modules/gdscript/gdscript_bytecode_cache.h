@@ -0,0 +1,71 @@
+/**************************************************************************/
+/*  gdscript_bytecode_cache.h                                             */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/string/ustring.h"
+#include "core/templates/vector.h"
+
+class GDScript;
+class GDScriptParser;
+
+// Persistent cache of compiled scripts, enabled with the
+// `debug/settings/gdscript/bytecode_cache` project setting.
+//
+// After a script compiles, its classes, member layout, constants and function
+// bytecode are written to `user://gdscript_cache`. The next time the script is
+// loaded, they are read back instead of parsing, analyzing and compiling the
+// source again. A cache file is only used if it was written by the same engine
+// build with the same settings, and if the script and every script it depends
+// on still have the same contents. Otherwise the script is compiled as usual
+// and the file is replaced. Files which don't match the hash stored at their
+// end, or which contain code the VM can't run safely, are treated the same way.
+//
+// The cache is never used in the editor or while the debugger is active, since
+// those need the parse tree for documentation, warnings and hot reloading.
+class GDScriptBytecodeCache {
+	struct Writer;
+	struct Reader;
+
+	static Error _load(GDScript *p_script, const String &p_cache_path, bool p_skeleton_only);
+
+public:
+	static bool is_enabled_for(const GDScript *p_script);
+	static String get_cache_path(const String &p_script_path);
+
+	// Creates the inner classes of a script, like `GDScriptCompiler::make_scripts()`, without parsing it.
+	static Error make_scripts(GDScript *p_script);
+	static Error load(GDScript *p_script);
+	static void save(const GDScript *p_script, GDScriptParser *p_parser);
+
+	// Paths in `p_dependencies` are the scripts the compiled code relies on, besides `p_script` itself.
+	static Error load_from_file(GDScript *p_script, const String &p_cache_path);
+	static Error save_to_file(const GDScript *p_script, const Vector<String> &p_dependencies, const String &p_cache_path);
+};
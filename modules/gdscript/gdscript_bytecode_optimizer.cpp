@@ -0,0 +1,671 @@
+/**************************************************************************/
+/*  gdscript_bytecode_optimizer.cpp                                       */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#include "gdscript_byte_codegen.h"
+
+#include "core/templates/hash_set.h"
+#include "core/variant/variant_internal.h"
+
+// The optimizer works on the finished bytecode of a function. The code is split into instructions which
+// remember their original position, so jumps keep working while instructions are rewritten or removed,
+// and it's encoded again at the end, relocating the jumps and default argument entry points.
+// Every transformation bails out on anything it doesn't understand, so the result behaves like the input.
+
+struct GDScriptByteCodeGenerator::OptimizerCode {
+	struct Instruction {
+		int position = 0; // In the original code.
+		LocalVector<int> code;
+		bool removed = false;
+	};
+
+	LocalVector<Instruction> instructions;
+	LocalVector<int> index; // Instruction starting at each original position, -1 inside instructions.
+	LocalVector<bool> targets; // Original positions which can be reached other than by falling through.
+	LocalVector<Variant> constants;
+	LocalVector<Variant::ValidatedOperatorEvaluator> operators;
+	LocalVector<Variant::Type> temporary_types;
+	int first_temporary = 0;
+	int size = 0;
+
+	bool decode(const Vector<int> &p_code, const Vector<int> &p_entry_points);
+	Vector<int> encode(Vector<int> &r_entry_points) const;
+
+	int next(int p_index) const;
+	bool is_target(int p_index) const { return targets[instructions[p_index].position]; }
+	bool is_temporary(int p_address) const { return p_address >= first_temporary && p_address < first_temporary + (int)temporary_types.size(); }
+	bool is_dead_after(int p_index, int p_address) const;
+};
+
+// Returns the word holding the jump target of the instruction, or -1 if it doesn't jump.
+static int _get_jump_offset(const LocalVector<int> &p_code) {
+	switch (p_code[0]) {
+		case GDScriptFunction::OPCODE_JUMP:
+			return 1;
+		case GDScriptFunction::OPCODE_JUMP_IF:
+		case GDScriptFunction::OPCODE_JUMP_IF_NOT:
+		case GDScriptFunction::OPCODE_JUMP_IF_SHARED:
+			return 2;
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			return 5;
+		default:
+			if (p_code[0] >= GDScriptFunction::OPCODE_ITERATE_BEGIN && p_code[0] <= GDScriptFunction::OPCODE_ITERATE_RANGE) {
+				// Jumps to the end of the loop when there's nothing left to iterate.
+				return p_code.size() - 1;
+			}
+			return -1;
+	}
+}
+
+// Whether execution never continues with the next instruction.
+static bool _is_terminator(int p_opcode) {
+	switch (p_opcode) {
+		case GDScriptFunction::OPCODE_JUMP:
+		case GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case GDScriptFunction::OPCODE_RETURN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_BUILTIN:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_ARRAY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_DICTIONARY:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_NATIVE:
+		case GDScriptFunction::OPCODE_RETURN_TYPED_SCRIPT:
+		case GDScriptFunction::OPCODE_END:
+			return true;
+		default:
+			return false;
+	}
+}
+
+static bool _is_type_adjust(int p_opcode) {
+	return p_opcode >= GDScriptFunction::OPCODE_TYPE_ADJUST_BOOL && p_opcode <= GDScriptFunction::OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY;
+}
+
+static bool _is_stack_address(int p_address) {
+	return (p_address >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_STACK && (p_address & GDScriptFunction::ADDR_MASK) >= GDScriptFunction::FIXED_ADDRESSES_MAX;
+}
+
+static bool _is_constant_address(int p_address) {
+	return (p_address >> GDScriptFunction::ADDR_BITS) == GDScriptFunction::ADDR_TYPE_CONSTANT;
+}
+
+enum AddressAccess {
+	ACCESS_NONE,
+	ACCESS_READ,
+	ACCESS_WRITE,
+};
+
+// Only the instructions which are known to overwrite an address count as writes,
+// any other mention of it is taken as a read (even in words which aren't addresses).
+static AddressAccess _get_address_access(const LocalVector<int> &p_code, int p_address) {
+	if (p_code[0] == GDScriptFunction::OPCODE_LINE) {
+		return ACCESS_NONE;
+	}
+	if (_is_type_adjust(p_code[0])) {
+		// Keeps the value when the type already matches, the next instructions decide.
+		return ACCESS_NONE;
+	}
+
+	int write_offset = -1;
+	switch (p_code[0]) {
+		case GDScriptFunction::OPCODE_ASSIGN:
+		case GDScriptFunction::OPCODE_ASSIGN_NULL:
+		case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+		case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+		case GDScriptFunction::OPCODE_ASSIGN_TYPED_BUILTIN:
+			write_offset = 1;
+			break;
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			write_offset = 3;
+			break;
+		default:
+			break;
+	}
+
+	bool written = false;
+	for (uint32_t i = 1; i < p_code.size(); i++) {
+		if (p_code[i] != p_address) {
+			continue;
+		}
+		if ((int)i != write_offset) {
+			return ACCESS_READ;
+		}
+		written = true;
+	}
+	return written ? ACCESS_WRITE : ACCESS_NONE;
+}
+
+// Returns the word holding the destination of instructions which only write their result, or -1.
+static int _get_result_offset(const LocalVector<int> &p_code) {
+	switch (p_code[0]) {
+		case GDScriptFunction::OPCODE_ASSIGN:
+			return 1;
+		case GDScriptFunction::OPCODE_GET_NAMED:
+			return 2;
+		case GDScriptFunction::OPCODE_OPERATOR:
+		case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+		case GDScriptFunction::OPCODE_GET_KEYED:
+			return 3;
+		case GDScriptFunction::OPCODE_CONSTRUCT_VALIDATED:
+			// The result is the last address.
+			return p_code[1] + 1;
+		default:
+			return -1;
+	}
+}
+
+// Evaluates operators without side effects or errors on constant booleans and numbers.
+static bool _fold_operator(Variant::ValidatedOperatorEvaluator p_evaluator, const Variant &p_left, const Variant &p_right, Variant &r_result) {
+	static const Variant::Operator foldable[] = {
+		Variant::OP_EQUAL,
+		Variant::OP_NOT_EQUAL,
+		Variant::OP_LESS,
+		Variant::OP_LESS_EQUAL,
+		Variant::OP_GREATER,
+		Variant::OP_GREATER_EQUAL,
+		Variant::OP_ADD,
+		Variant::OP_SUBTRACT,
+		Variant::OP_MULTIPLY,
+		Variant::OP_NEGATE,
+		Variant::OP_POSITIVE,
+		Variant::OP_BIT_AND,
+		Variant::OP_BIT_OR,
+		Variant::OP_BIT_XOR,
+		Variant::OP_BIT_NEGATE,
+		Variant::OP_AND,
+		Variant::OP_OR,
+		Variant::OP_XOR,
+		Variant::OP_NOT,
+	};
+
+	const Variant::Type left_type = p_left.get_type();
+	const Variant::Type right_type = p_right.get_type();
+	if (left_type != Variant::BOOL && left_type != Variant::INT && left_type != Variant::FLOAT) {
+		return false;
+	}
+	if (right_type != Variant::NIL && right_type != Variant::BOOL && right_type != Variant::INT && right_type != Variant::FLOAT) {
+		return false;
+	}
+
+	for (Variant::Operator op : foldable) {
+		if (Variant::get_validated_operator_evaluator(op, left_type, right_type) != p_evaluator) {
+			continue;
+		}
+		// Validated evaluators expect the result to have the right type already.
+		r_result = Variant();
+		VariantInternal::initialize(&r_result, Variant::get_operator_return_type(op, left_type, right_type));
+		p_evaluator(&p_left, &p_right, &r_result);
+		return true;
+	}
+	return false;
+}
+
+bool GDScriptByteCodeGenerator::OptimizerCode::decode(const Vector<int> &p_code, const Vector<int> &p_entry_points) {
+	size = p_code.size();
+	index.resize(size + 1);
+	targets.resize(size + 1);
+	for (int i = 0; i <= size; i++) {
+		index[i] = -1;
+		targets[i] = false;
+	}
+
+	for (int ip = 0; ip < size;) {
+		const int length = GDScriptFunction::get_instruction_size(p_code.ptr(), size, ip);
+		if (length == 0) {
+			return false;
+		}
+		index[ip] = instructions.size();
+
+		Instruction instruction;
+		instruction.position = ip;
+		instruction.code.resize(length);
+		for (int i = 0; i < length; i++) {
+			instruction.code[i] = p_code[ip + i];
+		}
+		instructions.push_back(instruction);
+		ip += length;
+	}
+	// Jumping to the end of the code leaves the function.
+	index[size] = instructions.size();
+
+	targets[0] = true;
+	for (const Instruction &instruction : instructions) {
+		const int offset = _get_jump_offset(instruction.code);
+		if (offset >= 0) {
+			const int target = instruction.code[offset];
+			if (target < 0 || target > size || index[target] < 0) {
+				return false;
+			}
+			targets[target] = true;
+		}
+		if (instruction.code[0] == GDScriptFunction::OPCODE_AWAIT_RESUME) {
+			// Entered again when the function is resumed.
+			targets[instruction.position] = true;
+		}
+	}
+	for (int entry : p_entry_points) {
+		if (entry < 0 || entry > size || index[entry] < 0) {
+			return false;
+		}
+		targets[entry] = true;
+	}
+
+	return true;
+}
+
+Vector<int> GDScriptByteCodeGenerator::OptimizerCode::encode(Vector<int> &r_entry_points) const {
+	LocalVector<int> new_positions;
+	new_positions.resize(size + 1);
+	int position = 0;
+	for (const Instruction &instruction : instructions) {
+		new_positions[instruction.position] = position;
+		if (!instruction.removed) {
+			position += instruction.code.size();
+		}
+	}
+	new_positions[size] = position;
+
+	Vector<int> code;
+	code.resize(position);
+	int *code_ptr = code.ptrw();
+	for (const Instruction &instruction : instructions) {
+		if (instruction.removed) {
+			continue;
+		}
+		for (uint32_t i = 0; i < instruction.code.size(); i++) {
+			code_ptr[i] = instruction.code[i];
+		}
+		const int offset = _get_jump_offset(instruction.code);
+		if (offset >= 0) {
+			code_ptr[offset] = new_positions[instruction.code[offset]];
+		}
+		code_ptr += instruction.code.size();
+	}
+
+	for (int i = 0; i < r_entry_points.size(); i++) {
+		r_entry_points.write[i] = new_positions[r_entry_points[i]];
+	}
+
+	return code;
+}
+
+int GDScriptByteCodeGenerator::OptimizerCode::next(int p_index) const {
+	for (uint32_t i = p_index + 1; i < instructions.size(); i++) {
+		if (!instructions[i].removed) {
+			return i;
+		}
+	}
+	return -1;
+}
+
+bool GDScriptByteCodeGenerator::OptimizerCode::is_dead_after(int p_index, int p_address) const {
+	// Follow every path until the address is overwritten or read. Give up on long searches.
+	const int max_visits = 256;
+
+	LocalVector<int> pending;
+	HashSet<int> visited;
+	pending.push_back(p_index + 1);
+
+	while (!pending.is_empty()) {
+		const int current = pending[pending.size() - 1];
+		pending.remove_at(pending.size() - 1);
+		if (current >= (int)instructions.size() || visited.has(current)) {
+			continue;
+		}
+		if ((int)visited.size() >= max_visits) {
+			return false;
+		}
+		visited.insert(current);
+
+		const Instruction &instruction = instructions[current];
+		if (instruction.removed) {
+			pending.push_back(current + 1);
+			continue;
+		}
+
+		const AddressAccess access = _get_address_access(instruction.code, p_address);
+		if (access == ACCESS_READ) {
+			return false;
+		}
+		if (access == ACCESS_WRITE) {
+			continue;
+		}
+
+		const int opcode = instruction.code[0];
+		if (opcode == GDScriptFunction::OPCODE_JUMP_TO_DEF_ARGUMENT) {
+			// Jumps somewhere depending on the arguments.
+			return false;
+		}
+		const int offset = _get_jump_offset(instruction.code);
+		if (offset >= 0) {
+			pending.push_back(index[instruction.code[offset]]);
+		}
+		if (!_is_terminator(opcode)) {
+			pending.push_back(current + 1);
+		}
+	}
+
+	return true;
+}
+
+int GDScriptByteCodeGenerator::_add_optimizer_constant(OptimizerCode &r_code, const Variant &p_value) {
+	const int pos = get_constant_pos(p_value);
+	if (pos == (int)r_code.constants.size()) {
+		r_code.constants.push_back(p_value);
+	}
+	return pos | (GDScriptFunction::ADDR_TYPE_CONSTANT << GDScriptFunction::ADDR_BITS);
+}
+
+// Propagates constants assigned to stack addresses, evaluates operators on constants and resolves
+// conditional jumps on them. Only done within basic blocks.
+void GDScriptByteCodeGenerator::_fold_constants(OptimizerCode &r_code) {
+	HashMap<int, int> known; // Stack address to the address of the constant it holds.
+	const Variant nil;
+
+	for (uint32_t i = 0; i < r_code.instructions.size(); i++) {
+		OptimizerCode::Instruction &instruction = r_code.instructions[i];
+		if (r_code.is_target(i)) {
+			known.clear();
+		}
+		LocalVector<int> &code = instruction.code;
+
+		switch (code[0]) {
+			case GDScriptFunction::OPCODE_ASSIGN: {
+				HashMap<int, int>::Iterator E = known.find(code[2]);
+				if (E) {
+					code[2] = E->value;
+				}
+				if (_is_constant_address(code[2]) && _is_stack_address(code[1])) {
+					known[code[1]] = code[2];
+				} else {
+					known.erase(code[1]);
+				}
+			} break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED: {
+				for (int j = 1; j <= 2; j++) {
+					HashMap<int, int>::Iterator E = known.find(code[j]);
+					if (E) {
+						code[j] = E->value;
+					}
+				}
+
+				const int destination = code[3];
+				known.erase(destination);
+
+				const bool left_constant = _is_constant_address(code[1]);
+				const bool right_constant = _is_constant_address(code[2]) || code[2] == GDScriptFunction::ADDR_NIL;
+				if (!left_constant || !right_constant || code[4] < 0 || code[4] >= (int)r_code.operators.size()) {
+					break;
+				}
+
+				const Variant &left = r_code.constants[code[1] & GDScriptFunction::ADDR_MASK];
+				const Variant &right = code[2] == GDScriptFunction::ADDR_NIL ? nil : r_code.constants[code[2] & GDScriptFunction::ADDR_MASK];
+				Variant result;
+				if (!_fold_operator(r_code.operators[code[4]], left, right, result)) {
+					break;
+				}
+
+				const int constant = _add_optimizer_constant(r_code, result);
+				code.resize(3);
+				code[0] = GDScriptFunction::OPCODE_ASSIGN;
+				code[1] = destination;
+				code[2] = constant;
+				if (_is_stack_address(destination)) {
+					known[destination] = constant;
+				}
+			} break;
+			case GDScriptFunction::OPCODE_LINE: {
+				// Only holds the line number.
+			} break;
+			case GDScriptFunction::OPCODE_JUMP_IF:
+			case GDScriptFunction::OPCODE_JUMP_IF_NOT: {
+				HashMap<int, int>::Iterator E = known.find(code[1]);
+				const int test = E ? E->value : code[1];
+				if (!_is_constant_address(test)) {
+					break;
+				}
+				const bool test_value = r_code.constants[test & GDScriptFunction::ADDR_MASK].booleanize();
+				if (test_value == (code[0] == GDScriptFunction::OPCODE_JUMP_IF)) {
+					const int target = code[2];
+					code.resize(2);
+					code[0] = GDScriptFunction::OPCODE_JUMP;
+					code[1] = target;
+				} else if (!r_code.is_target(i)) {
+					instruction.removed = true;
+				}
+			} break;
+			default: {
+				// Anything else may write the addresses it mentions.
+				for (uint32_t j = 1; j < code.size(); j++) {
+					known.erase(code[j]);
+				}
+			} break;
+		}
+	}
+}
+
+// Removes loads of native members which are already held by an address within the same statement.
+void GDScriptByteCodeGenerator::_eliminate_member_loads(OptimizerCode &r_code) {
+	HashMap<int, int> holders; // Name of the member to the address holding its value.
+
+	for (uint32_t i = 0; i < r_code.instructions.size(); i++) {
+		OptimizerCode::Instruction &instruction = r_code.instructions[i];
+		if (instruction.removed) {
+			continue;
+		}
+		if (r_code.is_target(i)) {
+			holders.clear();
+		}
+		LocalVector<int> &code = instruction.code;
+
+		int written = -1;
+		switch (code[0]) {
+			case GDScriptFunction::OPCODE_GET_MEMBER: {
+				const int destination = code[1];
+				const int name = code[2];
+				HashMap<int, int>::Iterator E = holders.find(name);
+				if (E && E->value == destination) {
+					instruction.removed = true;
+					continue;
+				}
+				if (E && r_code.is_temporary(E->value) && r_code.is_temporary(destination)) {
+					// Temporaries of the same built-in type hold copies, not references.
+					const Variant::Type type = r_code.temporary_types[E->value - r_code.first_temporary];
+					if (type != Variant::NIL && type == r_code.temporary_types[destination - r_code.first_temporary]) {
+						code[0] = GDScriptFunction::OPCODE_ASSIGN;
+						code[2] = E->value;
+					}
+				}
+				for (KeyValue<int, int> &K : holders) {
+					if (K.value == destination) {
+						K.value = -1;
+					}
+				}
+				holders[name] = destination;
+				continue;
+			}
+			case GDScriptFunction::OPCODE_ASSIGN:
+			case GDScriptFunction::OPCODE_ASSIGN_NULL:
+			case GDScriptFunction::OPCODE_ASSIGN_TRUE:
+			case GDScriptFunction::OPCODE_ASSIGN_FALSE:
+				written = code[1];
+				break;
+			case GDScriptFunction::OPCODE_GET_NAMED_VALIDATED:
+				written = code[2];
+				break;
+			case GDScriptFunction::OPCODE_OPERATOR_VALIDATED:
+			case GDScriptFunction::OPCODE_GET_KEYED_VALIDATED:
+			case GDScriptFunction::OPCODE_GET_INDEXED_VALIDATED:
+				written = code[3];
+				break;
+			default:
+				if (_is_type_adjust(code[0])) {
+					written = code[1];
+					break;
+				}
+				// May have side effects on the instance, including the end of the statement.
+				holders.clear();
+				continue;
+		}
+
+		for (KeyValue<int, int> &K : holders) {
+			if (K.value == written) {
+				K.value = -1;
+			}
+		}
+	}
+}
+
+// Replaces `ASSIGN(local, temp)` after the instruction computing `temp`.
+bool GDScriptByteCodeGenerator::_combine_assign(OptimizerCode &r_code, int p_index, int p_next) {
+	LocalVector<int> &code = r_code.instructions[p_index].code;
+	const LocalVector<int> &next_code = r_code.instructions[p_next].code;
+	const int target = next_code[1];
+	const int temporary = next_code[2];
+
+	const int result_offset = _get_result_offset(code);
+	if (result_offset < 0 || code[result_offset] != temporary || target == temporary || !r_code.is_temporary(temporary)) {
+		return false;
+	}
+	if (!r_code.is_dead_after(p_next, temporary)) {
+		return false;
+	}
+
+	if (code[0] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED && code[4] >= 0 && code[4] < (int)r_code.operators.size()) {
+		const Variant::ValidatedOperatorEvaluator evaluator = r_code.operators[code[4]];
+		int amount = -1;
+		if (evaluator == Variant::get_validated_operator_evaluator(Variant::OP_ADD, Variant::INT, Variant::INT)) {
+			if (code[1] == target) {
+				amount = code[2];
+			} else if (code[2] == target) {
+				amount = code[1];
+			}
+		} else if (evaluator == Variant::get_validated_operator_evaluator(Variant::OP_SUBTRACT, Variant::INT, Variant::INT) && code[1] == target && _is_constant_address(code[2])) {
+			const Variant &subtrahend = r_code.constants[code[2] & GDScriptFunction::ADDR_MASK];
+			if (subtrahend.get_type() == Variant::INT && (int64_t)subtrahend != INT64_MIN) {
+				amount = _add_optimizer_constant(r_code, -(int64_t)subtrahend);
+			}
+		}
+		if (amount != -1 && amount != target) {
+			code.resize(3);
+			code[0] = GDScriptFunction::OPCODE_INCREMENT_INT;
+			code[1] = target;
+			code[2] = amount;
+			return true;
+		}
+	}
+
+	// The target would change before the instruction is done with it.
+	for (uint32_t i = 1; i < code.size(); i++) {
+		if (code[i] == target && (int)i != result_offset) {
+			return false;
+		}
+	}
+
+	if (code[0] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED) {
+		// Validated operators don't change the type of their result, so only locals which always hold the
+		// result type can take it. They are initialized with that type when the function starts.
+		HashMap<int, Variant::Type>::ConstIterator L = local_slot_types.find(target);
+		HashMap<int, Variant::Type>::ConstIterator R = operator_return_types.find(code[4]);
+		if (!L || !R || L->value != R->value) {
+			return false;
+		}
+		function->temporary_slots[target] = L->value;
+	}
+
+	code[result_offset] = target;
+	return true;
+}
+
+// Fuses pairs of instructions into copy-free forms and superinstructions.
+void GDScriptByteCodeGenerator::_combine_instructions(OptimizerCode &r_code) {
+	for (uint32_t i = 0; i < r_code.instructions.size(); i++) {
+		if (r_code.instructions[i].removed) {
+			continue;
+		}
+		const int next = r_code.next(i);
+		if (next < 0 || r_code.is_target(next)) {
+			continue;
+		}
+		LocalVector<int> &code = r_code.instructions[i].code;
+		const LocalVector<int> &next_code = r_code.instructions[next].code;
+
+		bool combined = false;
+		if (next_code[0] == GDScriptFunction::OPCODE_ASSIGN) {
+			combined = _combine_assign(r_code, i, next);
+		} else if (code[0] == GDScriptFunction::OPCODE_OPERATOR_VALIDATED && next_code[0] == GDScriptFunction::OPCODE_JUMP_IF_NOT && next_code[1] == code[3]) {
+			// The result is still written, it may be used after the jump.
+			code[0] = GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT;
+			code.push_back(next_code[2]);
+			combined = true;
+		} else if (code[0] == GDScriptFunction::OPCODE_GET_MEMBER && next_code[0] == GDScriptFunction::OPCODE_CALL_BUILTIN_TYPE_VALIDATED) {
+			const int instr_arg_count = next_code[1];
+			const int argc = next_code[instr_arg_count + 2];
+			if (argc >= 0 && argc + 2 == instr_arg_count && next_code[argc + 2] == code[1]) {
+				const int name = code[2];
+				code = next_code;
+				code[0] = GDScriptFunction::OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED;
+				code.push_back(name);
+				combined = true;
+			}
+		}
+
+		if (combined) {
+			r_code.instructions[next].removed = true;
+			// The new instruction may combine with the following one as well.
+			i--;
+		}
+	}
+}
+
+void GDScriptByteCodeGenerator::optimize_bytecode() {
+	OptimizerCode code;
+	if (!code.decode(opcodes, function->default_arguments)) {
+		ERR_FAIL_MSG("Bytecode optimizer: Unable to decode the bytecode, leaving it unoptimized.");
+	}
+
+	code.constants.resize(constant_map.size());
+	for (const KeyValue<Variant, int> &K : constant_map) {
+		code.constants[K.value] = K.key;
+	}
+	code.operators.resize(operator_func_map.size());
+	for (const KeyValue<Variant::ValidatedOperatorEvaluator, int> &E : operator_func_map) {
+		code.operators[E.value] = E.key;
+	}
+	code.first_temporary = GDScriptFunction::FIXED_ADDRESSES_MAX + max_locals;
+	code.temporary_types.resize(temporaries.size());
+	for (int i = 0; i < temporaries.size(); i++) {
+		code.temporary_types[i] = temporaries[i].type;
+	}
+
+	_fold_constants(code);
+	_eliminate_member_loads(code);
+	_combine_instructions(code);
+
+	opcodes = code.encode(function->default_arguments);
+}
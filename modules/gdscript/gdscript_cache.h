@@ -91,6 +91,7 @@ class GDScriptCache {
 	friend class GDScript;
 	friend class GDScriptParserRef;
 	friend class GDScriptInstance;
+	friend class GDScriptBytecodeCache;
 
 	static GDScriptCache *singleton;
 
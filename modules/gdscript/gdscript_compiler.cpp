@@ -2527,6 +2527,12 @@ GDScriptFunction *GDScriptCompiler::_parse_function(Error &r_error, GDScript *p_
 
 	gd_function->method_info = method_info;
 
+#ifdef GDSCRIPT_AOT_ENABLED
+	if (!p_for_lambda) {
+		gd_function->aot_function = GDScriptAOT::find_function(gd_function);
+	}
+#endif
+
 	if (!is_implicit_initializer && !is_implicit_ready && !p_for_lambda) {
 		p_script->member_functions[func_name] = gd_function;
 	}
@@ -2753,6 +2759,9 @@ Error GDScriptCompiler::_prepare_compilation(GDScript *p_script, const GDScriptP
 
 	p_script->clearing = false;
 
+	// Accesses may have been cached with the old members and functions.
+	GDScriptFunction::invalidate_inline_caches();
+
 	p_script->tool = parser->is_tool();
 	p_script->_is_abstract = p_class->is_abstract;
 
@@ -3112,6 +3121,7 @@ Error GDScriptCompiler::_compile_class(GDScript *p_script, const GDScriptParser:
 	p_script->_static_default_init();
 
 	p_script->valid = true;
+	GDScriptFunction::invalidate_inline_caches();
 	return OK;
 }
 
@@ -97,6 +97,190 @@ static String _disassemble_address(const GDScript *p_script, const GDScriptFunct
 	return "<err>";
 }
 
+const char *GDScriptFunction::get_opcode_name(Opcode p_opcode) {
+	static const char *names[] = {
+		"OPERATOR",
+		"OPERATOR_VALIDATED",
+		"TYPE_TEST_BUILTIN",
+		"TYPE_TEST_ARRAY",
+		"TYPE_TEST_DICTIONARY",
+		"TYPE_TEST_NATIVE",
+		"TYPE_TEST_SCRIPT",
+		"SET_KEYED",
+		"SET_KEYED_VALIDATED",
+		"SET_INDEXED_VALIDATED",
+		"GET_KEYED",
+		"GET_KEYED_VALIDATED",
+		"GET_INDEXED_VALIDATED",
+		"SET_NAMED",
+		"SET_NAMED_VALIDATED",
+		"GET_NAMED",
+		"GET_NAMED_VALIDATED",
+		"SET_MEMBER",
+		"GET_MEMBER",
+		"SET_STATIC_VARIABLE",
+		"GET_STATIC_VARIABLE",
+		"ASSIGN",
+		"ASSIGN_NULL",
+		"ASSIGN_TRUE",
+		"ASSIGN_FALSE",
+		"ASSIGN_TYPED_BUILTIN",
+		"ASSIGN_TYPED_ARRAY",
+		"ASSIGN_TYPED_DICTIONARY",
+		"ASSIGN_TYPED_NATIVE",
+		"ASSIGN_TYPED_SCRIPT",
+		"CAST_TO_BUILTIN",
+		"CAST_TO_NATIVE",
+		"CAST_TO_SCRIPT",
+		"CONSTRUCT",
+		"CONSTRUCT_VALIDATED",
+		"CONSTRUCT_ARRAY",
+		"CONSTRUCT_TYPED_ARRAY",
+		"CONSTRUCT_DICTIONARY",
+		"CONSTRUCT_TYPED_DICTIONARY",
+		"CALL",
+		"CALL_RETURN",
+		"CALL_ASYNC",
+		"CALL_UTILITY",
+		"CALL_UTILITY_VALIDATED",
+		"CALL_GDSCRIPT_UTILITY",
+		"CALL_BUILTIN_TYPE_VALIDATED",
+		"CALL_SELF_BASE",
+		"CALL_METHOD_BIND",
+		"CALL_METHOD_BIND_RET",
+		"CALL_BUILTIN_STATIC",
+		"CALL_NATIVE_STATIC",
+		"CALL_NATIVE_STATIC_VALIDATED_RETURN",
+		"CALL_NATIVE_STATIC_VALIDATED_NO_RETURN",
+		"CALL_METHOD_BIND_VALIDATED_RETURN",
+		"CALL_METHOD_BIND_VALIDATED_NO_RETURN",
+		"AWAIT",
+		"AWAIT_RESUME",
+		"CREATE_LAMBDA",
+		"CREATE_SELF_LAMBDA",
+		"JUMP",
+		"JUMP_IF",
+		"JUMP_IF_NOT",
+		"JUMP_TO_DEF_ARGUMENT",
+		"JUMP_IF_SHARED",
+		"RETURN",
+		"RETURN_TYPED_BUILTIN",
+		"RETURN_TYPED_ARRAY",
+		"RETURN_TYPED_DICTIONARY",
+		"RETURN_TYPED_NATIVE",
+		"RETURN_TYPED_SCRIPT",
+		"ITERATE_BEGIN",
+		"ITERATE_BEGIN_INT",
+		"ITERATE_BEGIN_FLOAT",
+		"ITERATE_BEGIN_VECTOR2",
+		"ITERATE_BEGIN_VECTOR2I",
+		"ITERATE_BEGIN_VECTOR3",
+		"ITERATE_BEGIN_VECTOR3I",
+		"ITERATE_BEGIN_STRING",
+		"ITERATE_BEGIN_DICTIONARY",
+		"ITERATE_BEGIN_ARRAY",
+		"ITERATE_BEGIN_PACKED_BYTE_ARRAY",
+		"ITERATE_BEGIN_PACKED_INT32_ARRAY",
+		"ITERATE_BEGIN_PACKED_INT64_ARRAY",
+		"ITERATE_BEGIN_PACKED_FLOAT32_ARRAY",
+		"ITERATE_BEGIN_PACKED_FLOAT64_ARRAY",
+		"ITERATE_BEGIN_PACKED_STRING_ARRAY",
+		"ITERATE_BEGIN_PACKED_VECTOR2_ARRAY",
+		"ITERATE_BEGIN_PACKED_VECTOR3_ARRAY",
+		"ITERATE_BEGIN_PACKED_COLOR_ARRAY",
+		"ITERATE_BEGIN_PACKED_VECTOR4_ARRAY",
+		"ITERATE_BEGIN_OBJECT",
+		"ITERATE_BEGIN_RANGE",
+		"ITERATE",
+		"ITERATE_INT",
+		"ITERATE_FLOAT",
+		"ITERATE_VECTOR2",
+		"ITERATE_VECTOR2I",
+		"ITERATE_VECTOR3",
+		"ITERATE_VECTOR3I",
+		"ITERATE_STRING",
+		"ITERATE_DICTIONARY",
+		"ITERATE_ARRAY",
+		"ITERATE_PACKED_BYTE_ARRAY",
+		"ITERATE_PACKED_INT32_ARRAY",
+		"ITERATE_PACKED_INT64_ARRAY",
+		"ITERATE_PACKED_FLOAT32_ARRAY",
+		"ITERATE_PACKED_FLOAT64_ARRAY",
+		"ITERATE_PACKED_STRING_ARRAY",
+		"ITERATE_PACKED_VECTOR2_ARRAY",
+		"ITERATE_PACKED_VECTOR3_ARRAY",
+		"ITERATE_PACKED_COLOR_ARRAY",
+		"ITERATE_PACKED_VECTOR4_ARRAY",
+		"ITERATE_OBJECT",
+		"ITERATE_RANGE",
+		"STORE_GLOBAL",
+		"STORE_NAMED_GLOBAL",
+		"TYPE_ADJUST_BOOL",
+		"TYPE_ADJUST_INT",
+		"TYPE_ADJUST_FLOAT",
+		"TYPE_ADJUST_STRING",
+		"TYPE_ADJUST_VECTOR2",
+		"TYPE_ADJUST_VECTOR2I",
+		"TYPE_ADJUST_RECT2",
+		"TYPE_ADJUST_RECT2I",
+		"TYPE_ADJUST_VECTOR3",
+		"TYPE_ADJUST_VECTOR3I",
+		"TYPE_ADJUST_TRANSFORM2D",
+		"TYPE_ADJUST_VECTOR4",
+		"TYPE_ADJUST_VECTOR4I",
+		"TYPE_ADJUST_PLANE",
+		"TYPE_ADJUST_QUATERNION",
+		"TYPE_ADJUST_AABB",
+		"TYPE_ADJUST_BASIS",
+		"TYPE_ADJUST_TRANSFORM3D",
+		"TYPE_ADJUST_PROJECTION",
+		"TYPE_ADJUST_COLOR",
+		"TYPE_ADJUST_STRING_NAME",
+		"TYPE_ADJUST_NODE_PATH",
+		"TYPE_ADJUST_RID",
+		"TYPE_ADJUST_OBJECT",
+		"TYPE_ADJUST_CALLABLE",
+		"TYPE_ADJUST_SIGNAL",
+		"TYPE_ADJUST_DICTIONARY",
+		"TYPE_ADJUST_ARRAY",
+		"TYPE_ADJUST_PACKED_BYTE_ARRAY",
+		"TYPE_ADJUST_PACKED_INT32_ARRAY",
+		"TYPE_ADJUST_PACKED_INT64_ARRAY",
+		"TYPE_ADJUST_PACKED_FLOAT32_ARRAY",
+		"TYPE_ADJUST_PACKED_FLOAT64_ARRAY",
+		"TYPE_ADJUST_PACKED_STRING_ARRAY",
+		"TYPE_ADJUST_PACKED_VECTOR2_ARRAY",
+		"TYPE_ADJUST_PACKED_VECTOR3_ARRAY",
+		"TYPE_ADJUST_PACKED_COLOR_ARRAY",
+		"TYPE_ADJUST_PACKED_VECTOR4_ARRAY",
+		"OPERATOR_VALIDATED_JUMP_IF_NOT",
+		"INCREMENT_INT",
+		"GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED",
+		"ASSERT",
+		"BREAKPOINT",
+		"LINE",
+		"END",
+	};
+	static_assert(std_size(names) == (OPCODE_END + 1), "Opcode names aren't the same as opcodes in enum.");
+
+	ERR_FAIL_INDEX_V(p_opcode, OPCODE_END + 1, "<err>");
+	return names[p_opcode];
+}
+
+Vector<int> GDScriptFunction::get_opcode_statistics() const {
+	Vector<int> counts;
+	counts.resize_initialized(OPCODE_END + 1);
+
+	for (int ip = 0; ip < _code_size;) {
+		const int size = get_instruction_size(_code_ptr, _code_size, ip);
+		ERR_FAIL_COND_V_MSG(size == 0, counts, vformat("Invalid instruction at %d.", ip));
+		counts.write[_code_ptr[ip]]++;
+		ip += size;
+	}
+
+	return counts;
+}
+
 void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 #define DADDR(m_ip) (_disassemble_address(_script, *this, _code_ptr[ip + m_ip]))
 
@@ -308,7 +492,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += "\"] = ";
 				text += DADDR(2);
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_SET_NAMED_VALIDATED: {
 				text += "set_named validated ";
@@ -329,7 +513,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				text += _global_names_ptr[_code_ptr[ip + 3]];
 				text += "\"]";
 
-				incr += 4;
+				incr += 5;
 			} break;
 			case OPCODE_GET_NAMED_VALIDATED: {
 				text += "get_named validated ";
@@ -708,7 +892,7 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				}
 				text += ")";
 
-				incr = 5 + argc;
+				incr = 6 + argc;
 			} break;
 			case OPCODE_CALL_METHOD_BIND:
 			case OPCODE_CALL_METHOD_BIND_RET: {
@@ -1302,6 +1486,58 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 				DISASSEMBLE_TYPE_ADJUST(PACKED_COLOR_ARRAY);
 				DISASSEMBLE_TYPE_ADJUST(PACKED_VECTOR4_ARRAY);
 
+			case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT: {
+				text += "validated operator ";
+
+				text += DADDR(3);
+				text += " = ";
+				text += DADDR(1);
+				text += " ";
+				text += operator_names[_code_ptr[ip + 4]];
+				text += " ";
+				text += DADDR(2);
+				text += "; jump-if-not ";
+				text += DADDR(3);
+				text += " to ";
+				text += itos(_code_ptr[ip + 5]);
+
+				incr += 6;
+			} break;
+			case OPCODE_INCREMENT_INT: {
+				text += "increment int ";
+				text += DADDR(1);
+				text += " += ";
+				text += DADDR(2);
+
+				incr += 3;
+			} break;
+			case OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED: {
+				int instr_var_args = _code_ptr[++ip];
+				int argc = _code_ptr[ip + 1 + instr_var_args];
+
+				text += "get_member ";
+				text += DADDR(1 + argc);
+				text += " = [\"";
+				text += _global_names_ptr[_code_ptr[ip + 5 + argc]];
+				text += "\"]; call-builtin-method validated ";
+
+				text += DADDR(2 + argc) + " = ";
+
+				text += DADDR(1 + argc) + ".";
+				text += builtin_methods_names[_code_ptr[ip + 4 + argc]];
+
+				text += "(";
+
+				for (int i = 0; i < argc; i++) {
+					if (i > 0) {
+						text += ", ";
+					}
+					text += DADDR(1 + i);
+				}
+				text += ")";
+
+				incr = 6 + argc;
+			} break;
 			case OPCODE_ASSERT: {
 				text += "assert (";
 				text += DADDR(1);
@@ -1328,6 +1564,18 @@ void GDScriptFunction::disassemble(const Vector<String> &p_code_lines) const {
 			print_line(text.as_string());
 		}
 	}
+
+	const Vector<int> counts = get_opcode_statistics();
+	int total = 0;
+	for (int count : counts) {
+		total += count;
+	}
+	print_line(vformat(" Opcode statistics (%d instructions):", total));
+	for (int i = 0; i < counts.size(); i++) {
+		if (counts[i] > 0) {
+			print_line(vformat("  %s: %d", get_opcode_name(Opcode(i)), counts[i]));
+		}
+	}
 }
 
 #endif // DEBUG_ENABLED
@@ -42,6 +42,219 @@ StringName GDScriptFunction::get_global_name(int p_idx) const {
 	return global_names[p_idx];
 }
 
+int GDScriptFunction::get_instruction_size(const int *p_code, int p_code_size, int p_ip) {
+	ERR_FAIL_INDEX_V(p_ip, p_code_size, 0);
+
+	// Instructions with a variable amount of addresses store the count after
+	// the opcode, followed by the addresses and a fixed amount of words.
+	int trailing_words = -1;
+	int size = 0;
+
+	switch (Opcode(p_code[p_ip])) {
+		case OPCODE_OPERATOR:
+			size = 7 + sizeof(Variant::ValidatedOperatorEvaluator) / sizeof(*p_code);
+			break;
+		case OPCODE_TYPE_TEST_DICTIONARY:
+		case OPCODE_ASSIGN_TYPED_DICTIONARY:
+			size = 9;
+			break;
+		case OPCODE_RETURN_TYPED_DICTIONARY:
+			size = 8;
+			break;
+		case OPCODE_ITERATE_BEGIN_RANGE:
+			size = 7;
+			break;
+		case OPCODE_TYPE_TEST_ARRAY:
+		case OPCODE_ASSIGN_TYPED_ARRAY:
+		case OPCODE_ITERATE_RANGE:
+		case OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT:
+			size = 6;
+			break;
+		case OPCODE_OPERATOR_VALIDATED:
+		case OPCODE_SET_KEYED_VALIDATED:
+		case OPCODE_SET_INDEXED_VALIDATED:
+		case OPCODE_GET_KEYED_VALIDATED:
+		case OPCODE_GET_INDEXED_VALIDATED:
+		case OPCODE_RETURN_TYPED_ARRAY:
+		case OPCODE_ITERATE_BEGIN:
+		case OPCODE_ITERATE_BEGIN_INT:
+		case OPCODE_ITERATE_BEGIN_FLOAT:
+		case OPCODE_ITERATE_BEGIN_VECTOR2:
+		case OPCODE_ITERATE_BEGIN_VECTOR2I:
+		case OPCODE_ITERATE_BEGIN_VECTOR3:
+		case OPCODE_ITERATE_BEGIN_VECTOR3I:
+		case OPCODE_ITERATE_BEGIN_STRING:
+		case OPCODE_ITERATE_BEGIN_DICTIONARY:
+		case OPCODE_ITERATE_BEGIN_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_BYTE_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_INT32_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_INT64_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_FLOAT32_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_FLOAT64_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_STRING_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_VECTOR2_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_VECTOR3_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_COLOR_ARRAY:
+		case OPCODE_ITERATE_BEGIN_PACKED_VECTOR4_ARRAY:
+		case OPCODE_ITERATE_BEGIN_OBJECT:
+		case OPCODE_ITERATE:
+		case OPCODE_ITERATE_INT:
+		case OPCODE_ITERATE_FLOAT:
+		case OPCODE_ITERATE_VECTOR2:
+		case OPCODE_ITERATE_VECTOR2I:
+		case OPCODE_ITERATE_VECTOR3:
+		case OPCODE_ITERATE_VECTOR3I:
+		case OPCODE_ITERATE_STRING:
+		case OPCODE_ITERATE_DICTIONARY:
+		case OPCODE_ITERATE_ARRAY:
+		case OPCODE_ITERATE_PACKED_BYTE_ARRAY:
+		case OPCODE_ITERATE_PACKED_INT32_ARRAY:
+		case OPCODE_ITERATE_PACKED_INT64_ARRAY:
+		case OPCODE_ITERATE_PACKED_FLOAT32_ARRAY:
+		case OPCODE_ITERATE_PACKED_FLOAT64_ARRAY:
+		case OPCODE_ITERATE_PACKED_STRING_ARRAY:
+		case OPCODE_ITERATE_PACKED_VECTOR2_ARRAY:
+		case OPCODE_ITERATE_PACKED_VECTOR3_ARRAY:
+		case OPCODE_ITERATE_PACKED_COLOR_ARRAY:
+		case OPCODE_ITERATE_PACKED_VECTOR4_ARRAY:
+		case OPCODE_ITERATE_OBJECT:
+		case OPCODE_SET_NAMED:
+		case OPCODE_GET_NAMED:
+			size = 5;
+			break;
+		case OPCODE_TYPE_TEST_BUILTIN:
+		case OPCODE_TYPE_TEST_NATIVE:
+		case OPCODE_TYPE_TEST_SCRIPT:
+		case OPCODE_SET_KEYED:
+		case OPCODE_GET_KEYED:
+		case OPCODE_SET_NAMED_VALIDATED:
+		case OPCODE_GET_NAMED_VALIDATED:
+		case OPCODE_SET_STATIC_VARIABLE:
+		case OPCODE_GET_STATIC_VARIABLE:
+		case OPCODE_ASSIGN_TYPED_BUILTIN:
+		case OPCODE_ASSIGN_TYPED_NATIVE:
+		case OPCODE_ASSIGN_TYPED_SCRIPT:
+		case OPCODE_CAST_TO_BUILTIN:
+		case OPCODE_CAST_TO_NATIVE:
+		case OPCODE_CAST_TO_SCRIPT:
+			size = 4;
+			break;
+		case OPCODE_SET_MEMBER:
+		case OPCODE_GET_MEMBER:
+		case OPCODE_ASSIGN:
+		case OPCODE_JUMP_IF:
+		case OPCODE_JUMP_IF_NOT:
+		case OPCODE_JUMP_IF_SHARED:
+		case OPCODE_RETURN_TYPED_BUILTIN:
+		case OPCODE_RETURN_TYPED_NATIVE:
+		case OPCODE_RETURN_TYPED_SCRIPT:
+		case OPCODE_STORE_GLOBAL:
+		case OPCODE_STORE_NAMED_GLOBAL:
+		case OPCODE_INCREMENT_INT:
+		case OPCODE_ASSERT:
+			size = 3;
+			break;
+		case OPCODE_ASSIGN_NULL:
+		case OPCODE_ASSIGN_TRUE:
+		case OPCODE_ASSIGN_FALSE:
+		case OPCODE_AWAIT:
+		case OPCODE_AWAIT_RESUME:
+		case OPCODE_JUMP:
+		case OPCODE_RETURN:
+		case OPCODE_TYPE_ADJUST_BOOL:
+		case OPCODE_TYPE_ADJUST_INT:
+		case OPCODE_TYPE_ADJUST_FLOAT:
+		case OPCODE_TYPE_ADJUST_STRING:
+		case OPCODE_TYPE_ADJUST_VECTOR2:
+		case OPCODE_TYPE_ADJUST_VECTOR2I:
+		case OPCODE_TYPE_ADJUST_RECT2:
+		case OPCODE_TYPE_ADJUST_RECT2I:
+		case OPCODE_TYPE_ADJUST_VECTOR3:
+		case OPCODE_TYPE_ADJUST_VECTOR3I:
+		case OPCODE_TYPE_ADJUST_TRANSFORM2D:
+		case OPCODE_TYPE_ADJUST_VECTOR4:
+		case OPCODE_TYPE_ADJUST_VECTOR4I:
+		case OPCODE_TYPE_ADJUST_PLANE:
+		case OPCODE_TYPE_ADJUST_QUATERNION:
+		case OPCODE_TYPE_ADJUST_AABB:
+		case OPCODE_TYPE_ADJUST_BASIS:
+		case OPCODE_TYPE_ADJUST_TRANSFORM3D:
+		case OPCODE_TYPE_ADJUST_PROJECTION:
+		case OPCODE_TYPE_ADJUST_COLOR:
+		case OPCODE_TYPE_ADJUST_STRING_NAME:
+		case OPCODE_TYPE_ADJUST_NODE_PATH:
+		case OPCODE_TYPE_ADJUST_RID:
+		case OPCODE_TYPE_ADJUST_OBJECT:
+		case OPCODE_TYPE_ADJUST_CALLABLE:
+		case OPCODE_TYPE_ADJUST_SIGNAL:
+		case OPCODE_TYPE_ADJUST_DICTIONARY:
+		case OPCODE_TYPE_ADJUST_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_BYTE_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_INT32_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_INT64_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_FLOAT32_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_FLOAT64_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_STRING_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_VECTOR2_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY:
+		case OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY:
+		case OPCODE_LINE:
+			size = 2;
+			break;
+		case OPCODE_JUMP_TO_DEF_ARGUMENT:
+		case OPCODE_BREAKPOINT:
+		case OPCODE_END:
+			size = 1;
+			break;
+		case OPCODE_CONSTRUCT_TYPED_DICTIONARY:
+			trailing_words = 6;
+			break;
+		case OPCODE_CONSTRUCT_TYPED_ARRAY:
+		case OPCODE_CALL_BUILTIN_STATIC:
+		case OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED:
+		case OPCODE_CALL:
+		case OPCODE_CALL_RETURN:
+		case OPCODE_CALL_ASYNC:
+			trailing_words = 4;
+			break;
+		case OPCODE_CONSTRUCT:
+		case OPCODE_CONSTRUCT_VALIDATED:
+		case OPCODE_CALL_UTILITY:
+		case OPCODE_CALL_UTILITY_VALIDATED:
+		case OPCODE_CALL_GDSCRIPT_UTILITY:
+		case OPCODE_CALL_BUILTIN_TYPE_VALIDATED:
+		case OPCODE_CALL_SELF_BASE:
+		case OPCODE_CALL_METHOD_BIND:
+		case OPCODE_CALL_METHOD_BIND_RET:
+		case OPCODE_CALL_NATIVE_STATIC:
+		case OPCODE_CALL_NATIVE_STATIC_VALIDATED_RETURN:
+		case OPCODE_CALL_NATIVE_STATIC_VALIDATED_NO_RETURN:
+		case OPCODE_CALL_METHOD_BIND_VALIDATED_RETURN:
+		case OPCODE_CALL_METHOD_BIND_VALIDATED_NO_RETURN:
+		case OPCODE_CREATE_LAMBDA:
+		case OPCODE_CREATE_SELF_LAMBDA:
+			trailing_words = 3;
+			break;
+		case OPCODE_CONSTRUCT_ARRAY:
+		case OPCODE_CONSTRUCT_DICTIONARY:
+			trailing_words = 2;
+			break;
+	}
+
+	if (trailing_words >= 0) {
+		if (p_ip + 1 >= p_code_size || p_code[p_ip + 1] < 0) {
+			return 0;
+		}
+		size = 1 + p_code[p_ip + 1] + trailing_words;
+	}
+
+	if (size == 0 || p_ip + size > p_code_size) {
+		return 0;
+	}
+	return size;
+}
+
 struct _GDFKC {
 	int order = 0;
 	List<int> pos;
@@ -104,6 +317,9 @@ void GDScriptFunction::debug_get_stack_member_state(int p_line, List<Pair<String
 	}
 }
 
+SafeNumeric<uint32_t> GDScriptFunction::inline_cache_epoch;
+BinaryMutex GDScriptFunction::inline_cache_mutex;
+
 GDScriptFunction::GDScriptFunction() {
 	name = "<anonymous>";
 #ifdef DEBUG_ENABLED
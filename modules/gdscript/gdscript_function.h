@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "gdscript_aot.h"
 #include "gdscript_utility_functions.h"
 
 #include "core/object/ref_counted.h"
@@ -417,6 +418,10 @@ public:
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,
 		OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,
+		// Superinstructions, only emitted by the bytecode optimizer.
+		OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,
+		OPCODE_INCREMENT_INT,
+		OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED,
 		OPCODE_ASSERT,
 		OPCODE_BREAKPOINT,
 		OPCODE_LINE,
@@ -455,6 +460,9 @@ private:
 	friend class GDScriptCompiler;
 	friend class GDScriptByteCodeGenerator;
 	friend class GDScriptLanguage;
+	friend class GDScriptAOT;
+	friend class GDScriptTranspiler;
+	friend class GDScriptBytecodeCache;
 
 	StringName name;
 	StringName source;
@@ -494,6 +502,52 @@ private:
 	Vector<MethodBind *> methods;
 	Vector<GDScriptFunction *> lambdas;
 
+	// Remembers what an untyped `GET_NAMED`, `SET_NAMED` or `CALL` resolved to for the
+	// last few receiver classes, so the next access can skip the name lookup.
+	// Trivially copyable, so readers can copy it while another thread may be writing it.
+	struct InlineCacheEntry {
+		enum Kind {
+			SCRIPT_MEMBER,
+			NATIVE_PROPERTY,
+			SCRIPT_METHOD,
+			NATIVE_METHOD,
+		};
+
+		const void *class_id = nullptr; // `StringName::data_unique_pointer()` of the receiver class name.
+		const GDScript *script = nullptr;
+		Kind kind = SCRIPT_MEMBER;
+		int index = -1; // Member index, or property index for indexed native properties.
+		const GDScriptDataType *member_type = nullptr;
+		GDScriptFunction *function = nullptr;
+		MethodBind *method = nullptr;
+	};
+
+	// Entries are read without locking. Writers make `version` odd while changing the cache, readers
+	// copy the entry they need and discard it if `version` changed meanwhile.
+	struct InlineCache {
+		static constexpr int MAX_ENTRIES = 4;
+
+		std::atomic<uint32_t> version{ 0 };
+		std::atomic<uint32_t> epoch{ 0 };
+		std::atomic<uint32_t> count{ 0 };
+		InlineCacheEntry entries[MAX_ENTRIES];
+	};
+
+	LocalVector<InlineCache> inline_caches;
+	// Bumped whenever a script is cleared or recompiled, making every inline cache stale.
+	static SafeNumeric<uint32_t> inline_cache_epoch;
+	static BinaryMutex inline_cache_mutex;
+
+	static bool _inline_cache_get_receiver(const Variant &p_base, Object *&r_object, GDScriptInstance *&r_instance);
+	static bool _inline_cache_is_native(const GDScript *p_script, const StringName &p_name, const StringName &p_hook, const StringName &p_accessor);
+	static bool _inline_cache_resolve_property(const Object *p_object, const GDScript *p_script, const StringName &p_name, bool p_set, InlineCacheEntry &r_entry);
+	static bool _inline_cache_resolve_method(const Object *p_object, const GDScript *p_script, const StringName &p_name, InlineCacheEntry &r_entry);
+	bool _inline_cache_find(int p_cache, const Object *p_object, const GDScript *p_script, InlineCacheEntry &r_entry) const;
+	void _inline_cache_add(int p_cache, const InlineCacheEntry &p_entry);
+	bool _inline_cache_get_named(int p_cache, const Variant &p_base, const StringName &p_name, Variant &r_value);
+	bool _inline_cache_set_named(int p_cache, const Variant &p_base, const StringName &p_name, const Variant &p_value, bool &r_valid);
+	bool _inline_cache_call(int p_cache, const Variant &p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err);
+
 	int _code_size = 0;
 	int _default_arg_count = 0;
 	int _constant_count = 0;
@@ -563,6 +617,13 @@ private:
 	} profile;
 #endif
 
+#ifdef GDSCRIPT_AOT_ENABLED
+	// Translated to C++ by the `--gdscript-transpile` build step, if it matches this bytecode.
+	GDScriptAOT::Function aot_function = nullptr;
+
+	int _aot_execute(int p_ip, Variant *const *p_addresses, int p_defarg, int *r_line, Variant *r_retvalue);
+#endif
+
 	String _get_call_error(const String &p_where, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	String _get_callable_call_error(const String &p_where, const Callable &p_callable, const Variant **p_argptrs, int p_argcount, const Variant &p_ret, const Callable::CallError &p_err) const;
 	Variant _get_default_variant_for_data_type(const GDScriptDataType &p_data_type);
@@ -596,15 +657,23 @@ public:
 	_FORCE_INLINE_ Variant get_rpc_config() const { return rpc_config; }
 	_FORCE_INLINE_ int get_max_stack_size() const { return _stack_size; }
 
+	static void invalidate_inline_caches() { inline_cache_epoch.increment(); }
+
 	Variant get_constant(int p_idx) const;
 	StringName get_global_name(int p_idx) const;
 
+	// Returns the amount of words used by the instruction at `p_ip`, or 0 if it's invalid.
+	static int get_instruction_size(const int *p_code, int p_code_size, int p_ip);
+
 	Variant call(GDScriptInstance *p_instance, const Variant **p_args, int p_argcount, Callable::CallError &r_err, CallState *p_state = nullptr);
 	void debug_get_stack_member_state(int p_line, List<Pair<StringName, int>> *r_stackvars) const;
 
 #ifdef DEBUG_ENABLED
 	void _profile_native_call(uint64_t p_t_taken, const String &p_function_name, const String &p_instance_class_name = String());
 	void disassemble(const Vector<String> &p_code_lines) const;
+	// Amount of instructions using each opcode, indexed by `Opcode`.
+	Vector<int> get_opcode_statistics() const;
+	static const char *get_opcode_name(Opcode p_opcode);
 #endif
 
 	GDScriptFunction();
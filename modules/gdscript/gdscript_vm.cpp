@@ -32,7 +32,9 @@
 #include "gdscript_function.h"
 #include "gdscript_lambda_callable.h"
 
+#include "core/config/engine.h"
 #include "core/os/os.h"
+#include "scene/scene_string_names.h"
 
 #ifdef DEBUG_ENABLED
 
@@ -207,6 +209,303 @@ String GDScriptFunction::_get_callable_call_error(const String &p_where, const C
 	}
 }
 
+// Extension classes can be unloaded along with their method binds, and may handle properties themselves.
+static bool _is_extension_class(const StringName &p_class) {
+	const ClassDB::APIType api = ClassDB::get_api_type(p_class);
+	return api == ClassDB::API_EXTENSION || api == ClassDB::API_EDITOR_EXTENSION;
+}
+
+bool GDScriptFunction::_inline_cache_get_receiver(const Variant &p_base, Object *&r_object, GDScriptInstance *&r_instance) {
+	if (p_base.get_type() != Variant::OBJECT) {
+		return false;
+	}
+	r_object = p_base.get_validated_object();
+	if (!r_object) {
+		return false;
+	}
+
+	r_instance = nullptr;
+	ScriptInstance *script_instance = r_object->get_script_instance();
+	if (script_instance) {
+		if (script_instance->is_placeholder() || script_instance->get_language() != GDScriptLanguage::get_singleton()) {
+			return false;
+		}
+		r_instance = static_cast<GDScriptInstance *>(script_instance);
+	}
+	return true;
+}
+
+// Whether the scripts leave `p_name` to the native class: none of them declares it, nor defines
+// the `p_hook` virtual (`_get` or `_set`) or a function shadowing the native `p_accessor`.
+bool GDScriptFunction::_inline_cache_is_native(const GDScript *p_script, const StringName &p_name, const StringName &p_hook, const StringName &p_accessor) {
+	if (p_script && p_script->member_indices.has(p_name)) {
+		return false;
+	}
+	for (const GDScript *script = p_script; script; script = script->base.ptr()) {
+		if (!script->valid) {
+			return false;
+		}
+		if (script->constants.has(p_name) || script->static_variables_indices.has(p_name) || script->_signals.has(p_name) || script->member_functions.has(p_name) || script->subclasses.has(p_name)) {
+			return false;
+		}
+		if (script->member_functions.has(p_hook) || script->member_functions.has(p_accessor)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Mirrors the order of `GDScriptInstance::get()/set()` and `ClassDB::get_property()/set_property()`,
+// giving up on anything that depends on more than the receiver class and script.
+bool GDScriptFunction::_inline_cache_resolve_property(const Object *p_object, const GDScript *p_script, const StringName &p_name, bool p_set, InlineCacheEntry &r_entry) {
+	const StringName &class_name = p_object->get_class_name();
+	r_entry.class_id = class_name.data_unique_pointer();
+	r_entry.script = p_script;
+
+	if (p_script) {
+		if (!p_script->valid) {
+			return false;
+		}
+		HashMap<StringName, GDScript::MemberInfo>::ConstIterator E = p_script->member_indices.find(p_name);
+		if (E) {
+			if ((p_set ? E->value.setter : E->value.getter) != StringName()) {
+				return false;
+			}
+			r_entry.kind = InlineCacheEntry::SCRIPT_MEMBER;
+			r_entry.index = E->value.index;
+			r_entry.member_type = &E->value.data_type;
+			return true;
+		}
+	}
+
+	if (_is_extension_class(class_name) || !ClassDB::has_property(class_name, p_name)) {
+		return false;
+	}
+	if (!p_set && (ClassDB::has_integer_constant(class_name, p_name) || ClassDB::has_method(class_name, p_name) || ClassDB::has_signal(class_name, p_name))) {
+		// Might be found before the property when walking up the classes.
+		return false;
+	}
+
+	const StringName accessor = p_set ? ClassDB::get_property_setter(class_name, p_name) : ClassDB::get_property_getter(class_name, p_name);
+	if (accessor == StringName()) {
+		return false;
+	}
+	const GDScriptLanguage *language = GDScriptLanguage::get_singleton();
+	if (!_inline_cache_is_native(p_script, p_name, p_set ? language->strings._set : language->strings._get, accessor)) {
+		return false;
+	}
+	MethodBind *method = ClassDB::get_method(class_name, accessor);
+	if (!method) {
+		return false;
+	}
+
+	r_entry.kind = InlineCacheEntry::NATIVE_PROPERTY;
+	r_entry.index = ClassDB::get_property_index(class_name, p_name);
+	r_entry.method = method;
+	return true;
+}
+
+// Mirrors `Object::callp()` and `GDScriptInstance::callp()`.
+bool GDScriptFunction::_inline_cache_resolve_method(const Object *p_object, const GDScript *p_script, const StringName &p_name, InlineCacheEntry &r_entry) {
+	if (p_name == CoreStringName(free_) || p_name == SceneStringName(_ready)) {
+		return false;
+	}
+	const StringName &class_name = p_object->get_class_name();
+	r_entry.class_id = class_name.data_unique_pointer();
+	r_entry.script = p_script;
+
+	for (const GDScript *script = p_script; script; script = script->base.ptr()) {
+		if (!script->valid) {
+			return false;
+		}
+		HashMap<StringName, GDScriptFunction *>::ConstIterator E = script->member_functions.find(p_name);
+		if (E) {
+			r_entry.kind = InlineCacheEntry::SCRIPT_METHOD;
+			r_entry.function = E->value;
+			return true;
+		}
+	}
+
+	if (_is_extension_class(class_name)) {
+		return false;
+	}
+	MethodBind *method = ClassDB::get_method(class_name, p_name);
+	if (!method) {
+		return false;
+	}
+	r_entry.kind = InlineCacheEntry::NATIVE_METHOD;
+	r_entry.method = method;
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_find(int p_cache, const Object *p_object, const GDScript *p_script, InlineCacheEntry &r_entry) const {
+	const InlineCache &cache = inline_caches[p_cache];
+	const uint32_t epoch = inline_cache_epoch.get();
+	const uint32_t version = cache.version.load(std::memory_order_acquire);
+	if (version & 1) {
+		return false; // Being written.
+	}
+
+	const void *class_id = p_object->get_class_name().data_unique_pointer();
+	bool found = false;
+	if (cache.epoch.load(std::memory_order_relaxed) == epoch) {
+		const uint32_t count = MIN(cache.count.load(std::memory_order_relaxed), (uint32_t)InlineCache::MAX_ENTRIES);
+		for (uint32_t i = 0; i < count; i++) {
+			InlineCacheEntry entry;
+			memcpy((void *)&entry, (const void *)&cache.entries[i], sizeof(InlineCacheEntry));
+			if (entry.script == p_script && entry.class_id == class_id) {
+				r_entry = entry;
+				found = true;
+				break;
+			}
+		}
+	}
+
+	// The copy is only good if no writer started meanwhile, and no script was reloaded or freed since.
+	std::atomic_thread_fence(std::memory_order_acquire);
+	if (cache.version.load(std::memory_order_relaxed) != version) {
+		return false;
+	}
+	return found && inline_cache_epoch.get() == epoch;
+}
+
+void GDScriptFunction::_inline_cache_add(int p_cache, const InlineCacheEntry &p_entry) {
+	MutexLock lock(inline_cache_mutex);
+
+	InlineCache &cache = inline_caches[p_cache];
+	const uint32_t epoch = inline_cache_epoch.get();
+	uint32_t count = cache.epoch.load(std::memory_order_relaxed) == epoch ? cache.count.load(std::memory_order_relaxed) : 0;
+	for (uint32_t i = 0; i < count; i++) {
+		if (cache.entries[i].script == p_entry.script && cache.entries[i].class_id == p_entry.class_id) {
+			return; // Added by another thread.
+		}
+	}
+	if (count >= InlineCache::MAX_ENTRIES) {
+		return; // Megamorphic, keeps doing the lookup.
+	}
+
+	const uint32_t version = cache.version.load(std::memory_order_relaxed);
+	cache.version.store(version + 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	memcpy((void *)&cache.entries[count], (const void *)&p_entry, sizeof(InlineCacheEntry));
+	cache.count.store(count + 1, std::memory_order_relaxed);
+	cache.epoch.store(epoch, std::memory_order_relaxed);
+
+	cache.version.store(version + 2, std::memory_order_release);
+}
+
+bool GDScriptFunction::_inline_cache_get_named(int p_cache, const Variant &p_base, const StringName &p_name, Variant &r_value) {
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	if (!_inline_cache_get_receiver(p_base, object, instance)) {
+		return false;
+	}
+	const GDScript *script = instance ? instance->script.ptr() : nullptr;
+
+	InlineCacheEntry entry;
+	if (!_inline_cache_find(p_cache, object, script, entry)) {
+		if (!_inline_cache_resolve_property(object, script, p_name, false, entry)) {
+			return false;
+		}
+		_inline_cache_add(p_cache, entry);
+	}
+
+	// `r_value` may hold the base, so it's only assigned once done with it.
+	Variant value;
+	if (entry.kind == InlineCacheEntry::SCRIPT_MEMBER) {
+		value = instance->members[entry.index];
+	} else {
+		Callable::CallError ce;
+		if (entry.index >= 0) {
+			const Variant index = entry.index;
+			const Variant *args[1] = { &index };
+			value = entry.method->call(object, args, 1, ce);
+		} else {
+			value = entry.method->call(object, nullptr, 0, ce);
+		}
+		if (ce.error != Callable::CallError::CALL_OK) {
+			value = Variant();
+		}
+	}
+	r_value = value;
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_set_named(int p_cache, const Variant &p_base, const StringName &p_name, const Variant &p_value, bool &r_valid) {
+#ifdef TOOLS_ENABLED
+	if (Engine::get_singleton()->is_editor_hint()) {
+		return false; // `Object::set()` marks the object as edited.
+	}
+#endif
+
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	if (!_inline_cache_get_receiver(p_base, object, instance)) {
+		return false;
+	}
+	const GDScript *script = instance ? instance->script.ptr() : nullptr;
+
+	InlineCacheEntry entry;
+	if (!_inline_cache_find(p_cache, object, script, entry)) {
+		if (!_inline_cache_resolve_property(object, script, p_name, true, entry)) {
+			return false;
+		}
+		_inline_cache_add(p_cache, entry);
+	}
+
+	if (entry.kind == InlineCacheEntry::SCRIPT_MEMBER) {
+		if (!entry.member_type->is_type(p_value)) {
+			return false; // Let the instance convert it.
+		}
+		instance->members.write[entry.index] = p_value;
+		r_valid = true;
+		return true;
+	}
+
+	Callable::CallError ce;
+	if (entry.index >= 0) {
+		const Variant index = entry.index;
+		const Variant *args[2] = { &index, &p_value };
+		entry.method->call(object, args, 2, ce);
+	} else {
+		const Variant *args[1] = { &p_value };
+		entry.method->call(object, args, 1, ce);
+	}
+	r_valid = ce.error == Callable::CallError::CALL_OK;
+	return true;
+}
+
+bool GDScriptFunction::_inline_cache_call(int p_cache, const Variant &p_base, const StringName &p_name, const Variant **p_args, int p_argcount, Variant &r_ret, Callable::CallError &r_err) {
+	Object *object = nullptr;
+	GDScriptInstance *instance = nullptr;
+	if (!_inline_cache_get_receiver(p_base, object, instance)) {
+		return false;
+	}
+	const GDScript *script = instance ? instance->script.ptr() : nullptr;
+
+	InlineCacheEntry entry;
+	if (!_inline_cache_find(p_cache, object, script, entry)) {
+		if (!_inline_cache_resolve_method(object, script, p_name, entry)) {
+			return false;
+		}
+		_inline_cache_add(p_cache, entry);
+	}
+
+#ifdef DEBUG_ENABLED
+	// Same as `Object::callp()`, the object can't be freed by its own method.
+	_ObjectDebugLock debug_lock(object);
+#endif
+
+	r_err.error = Callable::CallError::CALL_OK;
+	if (entry.kind == InlineCacheEntry::SCRIPT_METHOD) {
+		r_ret = entry.function->call(instance, p_args, p_argcount, r_err);
+	} else {
+		r_ret = entry.method->call(object, p_args, p_argcount, r_err);
+	}
+	return true;
+}
+
 void (*type_init_function_table[])(Variant *) = {
 	nullptr, // NIL (shouldn't be called).
 	&VariantInitializer<bool>::init, // BOOL.
@@ -406,6 +705,9 @@ void (*type_init_function_table[])(Variant *) = {
 		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR3_ARRAY,       \
 		&&OPCODE_TYPE_ADJUST_PACKED_COLOR_ARRAY,         \
 		&&OPCODE_TYPE_ADJUST_PACKED_VECTOR4_ARRAY,       \
+		&&OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT,         \
+		&&OPCODE_INCREMENT_INT,                          \
+		&&OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED, \
 		&&OPCODE_ASSERT,                                 \
 		&&OPCODE_BREAKPOINT,                             \
 		&&OPCODE_LINE,                                   \
@@ -737,6 +1039,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 	bool awaited = false;
 	Variant *variant_addresses[ADDR_TYPE_MAX] = { stack, _constants_ptr, p_instance ? p_instance->members.ptrw() : nullptr };
 
+#ifdef GDSCRIPT_AOT_ENABLED
+	if (aot_function && !p_state && !EngineDebugger::is_active()) {
+		ip = _aot_execute(ip, variant_addresses, defarg, &line, &retvalue);
+	}
+#endif
+
 #ifdef DEBUG_ENABLED
 	OPCODE_WHILE(ip < _code_size) {
 		int last_opcode = _code_ptr[ip];
@@ -1193,7 +1501,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_SET_NAMED) {
-				CHECK_SPACE(3);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(dst, 0);
 				GET_VARIANT_PTR(value, 1);
@@ -1203,8 +1511,13 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= (int)inline_caches.size());
+
 				bool valid;
-				dst->set_named(*index, *value, valid);
+				if (!_inline_cache_set_named(inline_cache, *dst, *index, *value, valid)) {
+					dst->set_named(*index, *value, valid);
+				}
 
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1225,7 +1538,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 					OPCODE_BREAK;
 				}
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1245,7 +1558,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			DISPATCH_OPCODE;
 
 			OPCODE(OPCODE_GET_NAMED) {
-				CHECK_SPACE(4);
+				CHECK_SPACE(5);
 
 				GET_VARIANT_PTR(src, 0);
 				GET_VARIANT_PTR(dst, 1);
@@ -1255,13 +1568,21 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
 				const StringName *index = &_global_names_ptr[indexname];
 
-				bool valid;
+				int inline_cache = _code_ptr[ip + 4];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= (int)inline_caches.size());
+
+				bool valid = true;
 #ifdef DEBUG_ENABLED
 				//allow better error message in cases where src and dst are the same stack position
-				Variant ret = src->get_named(*index, valid);
+				Variant ret;
+				if (!_inline_cache_get_named(inline_cache, *src, *index, ret)) {
+					ret = src->get_named(*index, valid);
+				}
 
 #else
-				*dst = src->get_named(*index, valid);
+				if (!_inline_cache_get_named(inline_cache, *src, *index, *dst)) {
+					*dst = src->get_named(*index, valid);
+				}
 #endif
 #ifdef DEBUG_ENABLED
 				if (!valid) {
@@ -1270,7 +1591,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 				*dst = ret;
 #endif
-				ip += 4;
+				ip += 5;
 			}
 			DISPATCH_OPCODE;
 
@@ -1893,7 +2214,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				bool call_async = (_code_ptr[ip]) == OPCODE_CALL_ASYNC;
 #endif
 				LOAD_INSTRUCTION_ARGS
-				CHECK_SPACE(3 + instr_arg_count);
+				CHECK_SPACE(4 + instr_arg_count);
 
 				ip += instr_arg_count;
 
@@ -1904,6 +2225,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				GD_ERR_BREAK(methodname_idx < 0 || methodname_idx >= _global_names_count);
 				const StringName *methodname = &_global_names_ptr[methodname_idx];
 
+				int inline_cache = _code_ptr[ip + 3];
+				GD_ERR_BREAK(inline_cache < 0 || inline_cache >= (int)inline_caches.size());
+
 				GET_INSTRUCTION_ARG(base, argc);
 				Variant **argptrs = instruction_args;
 
@@ -1922,7 +2246,9 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				Callable::CallError err;
 				if (call_ret) {
 					GET_INSTRUCTION_ARG(ret, argc + 1);
-					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					if (!_inline_cache_call(inline_cache, *base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
+						base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
+					}
 					*ret = temp_ret;
 #ifdef DEBUG_ENABLED
 					if (ret->get_type() == Variant::NIL) {
@@ -1951,7 +2277,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 						}
 					}
 #endif
-				} else {
+				} else if (!_inline_cache_call(inline_cache, *base, *methodname, (const Variant **)argptrs, argc, temp_ret, err)) {
 					base->callp(*methodname, (const Variant **)argptrs, argc, temp_ret, err);
 				}
 #ifdef DEBUG_ENABLED
@@ -2007,7 +2333,7 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				}
 #endif // DEBUG_ENABLED
 
-				ip += 3;
+				ip += 4;
 			}
 			DISPATCH_OPCODE;
 
@@ -2709,6 +3035,12 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 				int to = _code_ptr[ip + 1];
 
 				GD_ERR_BREAK(to < 0 || to > _code_size);
+#ifdef GDSCRIPT_AOT_ENABLED
+				// Loop back-edge, continue in translated code after a deoptimization.
+				if (to < ip && aot_function && !EngineDebugger::is_active()) {
+					to = _aot_execute(to, variant_addresses, defarg, &line, &retvalue);
+				}
+#endif
 				ip = to;
 			}
 			DISPATCH_OPCODE;
@@ -3837,6 +4169,77 @@ Variant GDScriptFunction::call(GDScriptInstance *p_instance, const Variant **p_a
 			OPCODE_TYPE_ADJUST(PACKED_COLOR_ARRAY, PackedColorArray);
 			OPCODE_TYPE_ADJUST(PACKED_VECTOR4_ARRAY, PackedVector4Array);
 
+			OPCODE(OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT) {
+				CHECK_SPACE(6);
+
+				int operator_idx = _code_ptr[ip + 4];
+				GD_ERR_BREAK(operator_idx < 0 || operator_idx >= _operator_funcs_count);
+				Variant::ValidatedOperatorEvaluator operator_func = _operator_funcs_ptr[operator_idx];
+
+				GET_VARIANT_PTR(a, 0);
+				GET_VARIANT_PTR(b, 1);
+				GET_VARIANT_PTR(dst, 2);
+
+				operator_func(a, b, dst);
+
+				if (!dst->booleanize()) {
+					int to = _code_ptr[ip + 5];
+					GD_ERR_BREAK(to < 0 || to > _code_size);
+					ip = to;
+				} else {
+					ip += 6;
+				}
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_INCREMENT_INT) {
+				CHECK_SPACE(3);
+
+				GET_VARIANT_PTR(dst, 0);
+				GET_VARIANT_PTR(amount, 1);
+
+				*VariantInternal::get_int(dst) += *VariantInternal::get_int(amount);
+
+				ip += 3;
+			}
+			DISPATCH_OPCODE;
+
+			OPCODE(OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED) {
+				LOAD_INSTRUCTION_ARGS
+
+				CHECK_SPACE(4 + instr_arg_count);
+
+				ip += instr_arg_count;
+
+				int argc = _code_ptr[ip + 1];
+				GD_ERR_BREAK(argc < 0);
+
+				GET_INSTRUCTION_ARG(base, argc);
+
+				int indexname = _code_ptr[ip + 3];
+				GD_ERR_BREAK(indexname < 0 || indexname >= _global_names_count);
+				const StringName *index = &_global_names_ptr[indexname];
+#ifndef DEBUG_ENABLED
+				ClassDB::get_property(p_instance->owner, *index, *base);
+#else
+				bool ok = ClassDB::get_property(p_instance->owner, *index, *base);
+				if (!ok) {
+					err_text = "Internal error getting property: " + String(*index);
+					OPCODE_BREAK;
+				}
+#endif
+
+				GD_ERR_BREAK(_code_ptr[ip + 2] < 0 || _code_ptr[ip + 2] >= _builtin_methods_count);
+				Variant::ValidatedBuiltInMethod method = _builtin_methods_ptr[_code_ptr[ip + 2]];
+				Variant **argptrs = instruction_args;
+
+				GET_INSTRUCTION_ARG(ret, argc + 1);
+				method(base, (const Variant **)argptrs, argc, ret);
+
+				ip += 4;
+			}
+			DISPATCH_OPCODE;
+
 			OPCODE(OPCODE_ASSERT) {
 				CHECK_SPACE(3);
 
@@ -31,6 +31,7 @@
 #include "register_types.h"
 
 #include "gdscript.h"
+#include "gdscript_aot.h"
 #include "gdscript_cache.h"
 #include "gdscript_parser.h"
 #include "gdscript_tokenizer_buffer.h"
@@ -152,6 +153,7 @@ void initialize_gdscript_module(ModuleInitializationLevel p_level) {
 		gdscript_cache = memnew(GDScriptCache);
 
 		GDScriptUtilityFunctions::register_functions();
+		GDScriptAOT::register_generated_functions();
 	}
 
 #ifdef TOOLS_ENABLED
@@ -186,6 +188,7 @@ void uninitialize_gdscript_module(ModuleInitializationLevel p_level) {
 
 		GDScriptParser::cleanup();
 		GDScriptUtilityFunctions::unregister_functions();
+		GDScriptAOT::clear_functions();
 	}
 
 #ifdef TOOLS_ENABLED
@@ -32,6 +32,7 @@
 
 #include "gdscript_test_runner.h"
 
+#include "core/config/project_settings.h"
 #include "tests/test_macros.h"
 
 namespace GDScriptTests {
@@ -47,6 +48,19 @@ TEST_SUITE("[Modules][GDScript]") {
 		INFO("Make sure `*.out` files have expected results.");
 		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass.");
 	}
+
+	TEST_CASE("Script compilation and runtime without bytecode optimizer") {
+		ProjectSettings::get_singleton()->set_setting("debug/settings/gdscript/optimize_bytecode", false);
+
+		bool print_filenames = OS::get_singleton()->get_cmdline_args().find("--print-filenames") != nullptr;
+		bool use_binary_tokens = OS::get_singleton()->get_cmdline_args().find("--use-binary-tokens") != nullptr;
+		GDScriptTestRunner runner("modules/gdscript/tests/scripts", true, print_filenames, use_binary_tokens);
+		int fail_count = runner.run_tests();
+
+		ProjectSettings::get_singleton()->set_setting("debug/settings/gdscript/optimize_bytecode", true);
+		INFO("Make sure `*.out` files have expected results.");
+		REQUIRE_MESSAGE(fail_count == 0, "All GDScript tests should pass with the bytecode optimizer disabled.");
+	}
 }
 #endif // TOOLS_ENABLED
 
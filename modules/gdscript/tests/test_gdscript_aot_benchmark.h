@@ -0,0 +1,139 @@
+/**************************************************************************/
+/*  test_gdscript_aot_benchmark.h                                         */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+// Only meaningful in a build with translated functions. Generate them from the
+// test scripts, then build with them:
+//   godot --headless --editor --path modules/gdscript/tests/scripts --gdscript-transpile /path/to/gdscript_aot_tests.gen.cpp
+//   scons tests=yes gdscript_aot_source=/path/to/gdscript_aot_tests.gen.cpp
+#ifdef GDSCRIPT_AOT_ENABLED
+
+#include "gdscript_test_runner.h"
+
+#include "../gdscript_aot.h"
+#include "../gdscript_cache.h"
+
+#include "core/io/dir_access.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+// Runtime feature tests are short, so each one runs several times to outweigh the call setup.
+static const int AOT_BENCHMARK_REPEATS = 20;
+
+struct AOTBenchmarkRun {
+	uint64_t usec = 0;
+	int scripts = 0;
+	int functions = 0;
+	int translated = 0;
+};
+
+// Compiles and runs the runtime feature tests. Translated functions are picked
+// when a script compiles, so the caller sets up the registrations before.
+static AOTBenchmarkRun _run_aot_benchmark_scripts() {
+	AOTBenchmarkRun run;
+	const StringName test_function_name = "test";
+	const String dir = "res://runtime/features";
+	for (const String &file : DirAccess::get_files_at(dir)) {
+		if (!file.has_extension("gd") || file.ends_with(".notest.gd") || file.ends_with(".norun.gd")) {
+			continue;
+		}
+		const String path = dir.path_join(file);
+
+		Ref<GDScript> script;
+		script.instantiate();
+		// The path makes the fully qualified name, which translations are keyed on.
+		script->set_path(path);
+		if (script->load_source_code(path) != OK || script->reload() != OK || !script->get_member_functions().has(test_function_name)) {
+			GDScriptCache::remove_script(path);
+			continue;
+		}
+		for (const KeyValue<StringName, GDScriptFunction *> &E : script->get_member_functions()) {
+			run.functions++;
+			if (GDScriptAOT::find_function(E.value)) {
+				run.translated++;
+			}
+		}
+
+		// Like `GDScriptTest::execute_test_code()`.
+		Object *obj = ClassDB::instantiate(script->get_native()->get_name());
+		Ref<RefCounted> obj_ref;
+		if (obj->is_ref_counted()) {
+			obj_ref = Ref<RefCounted>(Object::cast_to<RefCounted>(obj));
+		}
+		obj->set_script(script);
+		ScriptInstance *instance = obj->get_script_instance();
+
+		const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		for (int i = 0; i < AOT_BENCHMARK_REPEATS; i++) {
+			Callable::CallError call_err;
+			instance->callp(test_function_name, nullptr, 0, call_err);
+		}
+		run.usec += OS::get_singleton()->get_ticks_usec() - begin;
+		run.scripts++;
+
+		if (obj_ref.is_null()) {
+			memdelete(obj);
+		}
+		GDScriptCache::remove_script(path);
+	}
+	return run;
+}
+
+// Run with `--test --no-skip`.
+TEST_CASE("[Modules][GDScript][Benchmark] Runtime tests with translated functions and with the VM" * doctest::skip()) {
+	init_language("modules/gdscript/tests/scripts");
+	// The tests print their results, which isn't what is timed here.
+	CoreGlobals::print_line_enabled = false;
+	ERR_PRINT_OFF;
+
+	GDScriptAOT::clear_functions();
+	const AOTBenchmarkRun vm = _run_aot_benchmark_scripts();
+	GDScriptAOT::register_generated_functions();
+	const AOTBenchmarkRun aot = _run_aot_benchmark_scripts();
+
+	ERR_PRINT_ON;
+	CoreGlobals::print_line_enabled = true;
+	finish_language();
+
+	CHECK(vm.scripts > 0);
+	CHECK(vm.scripts == aot.scripts);
+	CHECK(vm.translated == 0);
+	CHECK_MESSAGE(aot.translated > 0, "The build should include functions translated from the test scripts.");
+
+	MESSAGE(vformat("%d scripts run %d times each: VM %d ms, translated %d ms (%.2fx), %d of %d top-level functions translated.",
+			aot.scripts, AOT_BENCHMARK_REPEATS, vm.usec / 1000, aot.usec / 1000,
+			(double)vm.usec / MAX(aot.usec, (uint64_t)1), aot.translated, aot.functions));
+}
+
+} // namespace GDScriptTests
+
+#endif // GDSCRIPT_AOT_ENABLED
@@ -0,0 +1,190 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_cache.h                                        */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+#include "../gdscript_bytecode_cache.h"
+
+#include "core/crypto/crypto_core.h"
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/marshalls.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+static const char *_bytecode_cache_source = R"(
+extends RefCounted
+
+const SCALE = 3
+const NAMES = { "a": 1, "b": 2 }
+
+class Counter:
+	var count: int = 0
+
+	func add(amount: int) -> int:
+		count += amount
+		return count
+
+var items: Array[int] = [1, 2, 3]
+static var calls: int
+
+func sum() -> int:
+	var total := 0
+	for item in items:
+		total += item * SCALE
+	return total
+
+func count_to(amount: int) -> int:
+	var counter := Counter.new()
+	for i in amount:
+		counter.add(1)
+	return counter.count
+
+func apply(value: int) -> int:
+	var twice := func(x: int) -> int: return x * 2
+	calls += 1
+	return twice.call(value) + NAMES["b"]
+)";
+
+static Ref<GDScript> _bytecode_cache_test_script(const String &p_source) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	return gdscript;
+}
+
+static void _bytecode_cache_store(const String &p_path, const Vector<uint8_t> &p_data) {
+	Ref<FileAccess> file = FileAccess::open(p_path, FileAccess::WRITE);
+	REQUIRE(file.is_valid());
+	file->store_buffer(p_data);
+}
+
+// Updates the hash at the end of the file, as if it had been written like that.
+static void _bytecode_cache_rehash(Vector<uint8_t> &r_data) {
+	REQUIRE(r_data.size() > 16);
+	unsigned char hash[16];
+	CryptoCore::md5(r_data.ptr(), r_data.size() - 16, hash);
+	memcpy(r_data.ptrw() + r_data.size() - 16, hash, 16);
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode cache") {
+	GDScriptLanguage::get_singleton()->init();
+	const String cache_path = TestUtils::get_temp_path("gdscript_bytecode_cache.cache");
+
+	Ref<GDScript> compiled = _bytecode_cache_test_script(_bytecode_cache_source);
+	ERR_PRINT_OFF;
+	compiled->reload();
+	ERR_PRINT_ON;
+	REQUIRE(compiled->is_valid());
+	REQUIRE(GDScriptBytecodeCache::save_to_file(compiled.ptr(), Vector<String>(), cache_path) == OK);
+
+	SUBCASE("Loaded script runs like the compiled one") {
+		Ref<GDScript> loaded = _bytecode_cache_test_script(_bytecode_cache_source);
+		REQUIRE(GDScriptBytecodeCache::load_from_file(loaded.ptr(), cache_path) == OK);
+		CHECK(loaded->is_valid());
+		CHECK(loaded->get_member_functions().size() == compiled->get_member_functions().size());
+		CHECK(loaded->get_constants().size() == compiled->get_constants().size());
+
+		Ref<RefCounted> instance;
+		instance.instantiate();
+		instance->set_script(loaded);
+		CHECK(int(instance->call("sum")) == 18);
+		CHECK(int(instance->call("count_to", 4)) == 4);
+		CHECK(int(instance->call("apply", 5)) == 12);
+	}
+
+	SUBCASE("Changed source isn't loaded") {
+		Ref<GDScript> loaded = _bytecode_cache_test_script(String(_bytecode_cache_source) + "\nfunc extra():\n\tpass\n");
+		CHECK(GDScriptBytecodeCache::load_from_file(loaded.ptr(), cache_path) == ERR_FILE_UNRECOGNIZED);
+		CHECK_FALSE(loaded->is_valid());
+	}
+
+	SUBCASE("Damaged file isn't loaded") {
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_path);
+		REQUIRE(data.size() > 0);
+		data.resize(data.size() / 2);
+		_bytecode_cache_store(cache_path, data);
+
+		Ref<GDScript> loaded = _bytecode_cache_test_script(_bytecode_cache_source);
+		ERR_PRINT_OFF;
+		const Error err = GDScriptBytecodeCache::load_from_file(loaded.ptr(), cache_path);
+		ERR_PRINT_ON;
+		CHECK(err != OK);
+		CHECK_FALSE(loaded->is_valid());
+	}
+
+	SUBCASE("Flipped bytes aren't loaded") {
+		const Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_path);
+		REQUIRE(data.size() > 0);
+		// Past the header, down to the hash itself.
+		for (int position : { data.size() / 2, data.size() * 3 / 4, data.size() - 20, data.size() - 1 }) {
+			Vector<uint8_t> damaged = data;
+			damaged.write[position] ^= 0x5a;
+			_bytecode_cache_store(cache_path, damaged);
+
+			Ref<GDScript> loaded = _bytecode_cache_test_script(_bytecode_cache_source);
+			CHECK_MESSAGE(GDScriptBytecodeCache::load_from_file(loaded.ptr(), cache_path) == ERR_FILE_CORRUPT, vformat("Byte %d was flipped.", position));
+			CHECK_FALSE(loaded->is_valid());
+		}
+	}
+
+	SUBCASE("Code with addresses out of range isn't loaded, even when the hash matches") {
+		Vector<uint8_t> data = FileAccess::get_file_as_bytes(cache_path);
+		const GDScriptFunction *count_to = compiled->get_member_functions()["count_to"];
+
+		// The argument count, vararg index and stack size, stored in that order.
+		uint8_t frame[12];
+		encode_uint32(1, &frame[0]);
+		encode_uint32(-1, &frame[4]);
+		encode_uint32(count_to->get_max_stack_size(), &frame[8]);
+		int position = -1;
+		for (int i = 0; i + 12 <= data.size() && position < 0; i++) {
+			if (memcmp(data.ptr() + i, frame, 12) == 0) {
+				position = i;
+			}
+		}
+		REQUIRE(position >= 0);
+
+		// Only leaves room for the argument, but not for the locals the code uses.
+		encode_uint32(GDScriptFunction::FIXED_ADDRESSES_MAX + 1, data.ptrw() + position + 8);
+		_bytecode_cache_rehash(data);
+		_bytecode_cache_store(cache_path, data);
+
+		Ref<GDScript> loaded = _bytecode_cache_test_script(_bytecode_cache_source);
+		CHECK(GDScriptBytecodeCache::load_from_file(loaded.ptr(), cache_path) == ERR_FILE_CORRUPT);
+		CHECK_FALSE(loaded->is_valid());
+	}
+
+	DirAccess::remove_absolute(cache_path);
+}
+
+} // namespace GDScriptTests
@@ -0,0 +1,111 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_cache_benchmark.h                              */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "test_gdscript_bytecode_cache.h"
+
+#include "core/io/dir_access.h"
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace GDScriptTests {
+
+// As many scripts as the server that asked for the cache compiles at startup.
+static const int BYTECODE_CACHE_BENCHMARK_SCRIPTS = 3000;
+
+// Every script gets its own constant, so no two sources (and cache files) are the same.
+static String _bytecode_cache_benchmark_source(int p_index) {
+	return String(_bytecode_cache_source) + vformat("\nconst INDEX = %d\n\nfunc index() -> int:\n\treturn INDEX * SCALE\n", p_index);
+}
+
+// Run with `--test --no-skip`.
+TEST_CASE("[Modules][GDScript][Benchmark] Startup with a cold compile and a warm bytecode cache" * doctest::skip()) {
+	GDScriptLanguage::get_singleton()->init();
+	const String cache_dir = TestUtils::get_temp_path("gdscript_bytecode_cache_benchmark");
+	DirAccess::make_dir_recursive_absolute(cache_dir);
+
+	Vector<String> sources;
+	Vector<String> cache_paths;
+	for (int i = 0; i < BYTECODE_CACHE_BENCHMARK_SCRIPTS; i++) {
+		sources.push_back(_bytecode_cache_benchmark_source(i));
+		cache_paths.push_back(cache_dir.path_join(vformat("script_%d.cache", i)));
+	}
+
+	// Cold: parse, analyze and compile every script, as a launch without a cache does.
+	Vector<Ref<GDScript>> compiled;
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (const String &source : sources) {
+		Ref<GDScript> gdscript = _bytecode_cache_test_script(source);
+		gdscript->reload();
+		compiled.push_back(gdscript);
+	}
+	const uint64_t cold_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	// Written outside of the timings, the way the first launch leaves them for the next one.
+	int64_t cache_bytes = 0;
+	for (int i = 0; i < compiled.size(); i++) {
+		REQUIRE(compiled[i]->is_valid());
+		REQUIRE(GDScriptBytecodeCache::save_to_file(compiled[i].ptr(), Vector<String>(), cache_paths[i]) == OK);
+		cache_bytes += FileAccess::get_size(cache_paths[i]);
+	}
+	compiled.clear();
+
+	// Warm: read every script back from its cache file, which still hashes the source.
+	Vector<Ref<GDScript>> loaded;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < sources.size(); i++) {
+		Ref<GDScript> gdscript = _bytecode_cache_test_script(sources[i]);
+		GDScriptBytecodeCache::load_from_file(gdscript.ptr(), cache_paths[i]);
+		loaded.push_back(gdscript);
+	}
+	const uint64_t warm_usec = OS::get_singleton()->get_ticks_usec() - begin;
+
+	for (int i = 0; i < loaded.size(); i++) {
+		CHECK(loaded[i]->is_valid());
+	}
+	Ref<RefCounted> instance;
+	instance.instantiate();
+	instance->set_script(loaded[loaded.size() - 1]);
+	CHECK(int(instance->call("index")) == (BYTECODE_CACHE_BENCHMARK_SCRIPTS - 1) * 3);
+	instance.unref();
+	loaded.clear();
+
+	MESSAGE(vformat("%d scripts: cold compile %d ms, warm cache %d ms (%.1fx), %d KiB of cache files.",
+			BYTECODE_CACHE_BENCHMARK_SCRIPTS, cold_usec / 1000, warm_usec / 1000,
+			(double)cold_usec / MAX(warm_usec, (uint64_t)1), cache_bytes / 1024));
+
+	for (const String &cache_path : cache_paths) {
+		DirAccess::remove_absolute(cache_path);
+	}
+	DirAccess::remove_absolute(cache_dir);
+}
+
+} // namespace GDScriptTests
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  test_gdscript_bytecode_optimizer.h                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "core/config/project_settings.h"
+#include "scene/2d/node_2d.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static Ref<GDScript> _compile_optimizer_test_script() {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends Node2D
+
+func sum_below(n: int) -> int:
+	var total: int = 0
+	var i: int = 0
+	while i < n:
+		total += i
+		i += 1
+	return total
+
+func count_down(n: int) -> int:
+	var steps: int = 0
+	while n > 0:
+		n -= 2
+		steps += 1
+	return steps
+
+func folded() -> int:
+	var a: int = 5
+	return a * 4
+
+func distance() -> float:
+	return position.length()
+)");
+	// See "Load source code dynamically and run it".
+	ERR_PRINT_OFF;
+	gdscript->reload();
+	ERR_PRINT_ON;
+	return gdscript;
+}
+
+static void _check_optimizer_test_results(const Ref<GDScript> &p_script) {
+	Node2D *node = memnew(Node2D);
+	node->set_script(p_script);
+	node->set_position(Vector2(3, 4));
+
+	CHECK(int(node->call("sum_below", 10)) == 45);
+	CHECK(int(node->call("sum_below", 0)) == 0);
+	CHECK(int(node->call("count_down", 7)) == 4);
+	CHECK(int(node->call("folded")) == 20);
+	CHECK(double(node->call("distance")) == doctest::Approx(5.0));
+
+	memdelete(node);
+}
+
+TEST_CASE("[Modules][GDScript] Bytecode optimizer keeps results") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = _compile_optimizer_test_script();
+	REQUIRE(gdscript->get_member_functions().has("sum_below"));
+	_check_optimizer_test_results(gdscript);
+
+	ProjectSettings::get_singleton()->set_setting("debug/settings/gdscript/optimize_bytecode", false);
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> unoptimized = _compile_optimizer_test_script();
+	REQUIRE(unoptimized->get_member_functions().has("sum_below"));
+	_check_optimizer_test_results(unoptimized);
+
+	ProjectSettings::get_singleton()->set_setting("debug/settings/gdscript/optimize_bytecode", true);
+	GDScriptLanguage::get_singleton()->init();
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Bytecode optimizer emits superinstructions") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = _compile_optimizer_test_script();
+	const HashMap<StringName, GDScriptFunction *> &functions = gdscript->get_member_functions();
+	REQUIRE(functions.has("sum_below"));
+
+	const Vector<int> sum_below = functions["sum_below"]->get_opcode_statistics();
+	CHECK_MESSAGE(sum_below[GDScriptFunction::OPCODE_INCREMENT_INT] == 2, "Both compound assignments should become increments.");
+	CHECK_MESSAGE(sum_below[GDScriptFunction::OPCODE_OPERATOR_VALIDATED_JUMP_IF_NOT] == 1, "The loop condition should be fused with its jump.");
+	CHECK(sum_below[GDScriptFunction::OPCODE_JUMP_IF_NOT] == 0);
+
+	const Vector<int> count_down = functions["count_down"]->get_opcode_statistics();
+	CHECK_MESSAGE(count_down[GDScriptFunction::OPCODE_INCREMENT_INT] == 2, "Subtracting a constant should become an increment.");
+
+	const Vector<int> folded = functions["folded"]->get_opcode_statistics();
+	CHECK_MESSAGE(folded[GDScriptFunction::OPCODE_OPERATOR_VALIDATED] == 0, "Operations on known constants should be folded.");
+
+	const Vector<int> distance = functions["distance"]->get_opcode_statistics();
+	CHECK(distance[GDScriptFunction::OPCODE_GET_MEMBER_CALL_BUILTIN_TYPE_VALIDATED] == 1);
+	CHECK(distance[GDScriptFunction::OPCODE_GET_MEMBER] == 0);
+}
+#endif // DEBUG_ENABLED
+
+} // namespace GDScriptTests
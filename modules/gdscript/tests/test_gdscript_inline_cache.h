@@ -0,0 +1,257 @@
+/**************************************************************************/
+/*  test_gdscript_inline_cache.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "../gdscript.h"
+
+#include "scene/2d/node_2d.h"
+#include "scene/main/timer.h"
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static Ref<GDScript> _compile_inline_cache_test_script(const String &p_source) {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(p_source);
+	// See "Load source code dynamically and run it".
+	ERR_PRINT_OFF;
+	gdscript->reload();
+	ERR_PRINT_ON;
+	return gdscript;
+}
+
+static const char *_inline_cache_driver_source = R"(
+extends RefCounted
+
+func read_value(target):
+	return target.value
+
+func write_value(target, value):
+	target.value = value
+
+func read_position(target):
+	return target.position
+
+func write_position(target, position):
+	target.position = position
+
+func kind(target):
+	return target.get_kind()
+
+func class_of(target):
+	return target.get_class()
+
+func call_free_self(target):
+	return target.free_self()
+)";
+
+static const char *_inline_cache_a_source = R"(
+extends Node2D
+
+var value: int = 1
+
+func get_kind():
+	return "a"
+)";
+
+static const char *_inline_cache_b_source = R"(
+extends Node2D
+
+var value = "b"
+
+func get_kind():
+	return "b"
+
+func _get(property):
+	if property == &"position":
+		return "shadowed"
+	return null
+)";
+
+TEST_CASE("[Modules][GDScript] Inline caches follow the receiver") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> driver_script = _compile_inline_cache_test_script(_inline_cache_driver_source);
+	Ref<GDScript> a_script = _compile_inline_cache_test_script(_inline_cache_a_source);
+	Ref<GDScript> b_script = _compile_inline_cache_test_script(_inline_cache_b_source);
+	REQUIRE(driver_script->get_member_functions().has("read_value"));
+	REQUIRE(a_script->get_member_functions().has("get_kind"));
+	REQUIRE(b_script->get_member_functions().has("get_kind"));
+
+	Ref<RefCounted> driver;
+	driver.instantiate();
+	driver->set_script(driver_script);
+
+	Node2D *plain = memnew(Node2D);
+	plain->set_position(Vector2(1, 2));
+	Node2D *a = memnew(Node2D);
+	a->set_script(a_script);
+	a->set_position(Vector2(3, 4));
+	Node2D *b = memnew(Node2D);
+	b->set_script(b_script);
+	Node *node = memnew(Node);
+	Timer *timer = memnew(Timer);
+
+	SUBCASE("Script members") {
+		for (int i = 0; i < 2; i++) {
+			CHECK(int(driver->call("read_value", a)) == 1);
+			CHECK(String(driver->call("read_value", b)) == "b");
+		}
+
+		driver->call("write_value", a, 7);
+		driver->call("write_value", b, 8);
+		CHECK(a->get("value") == Variant(7));
+		CHECK(b->get("value") == Variant(8));
+
+		// Needs the conversion done by the instance.
+		driver->call("write_value", a, 9.5);
+		CHECK(a->get("value").get_type() == Variant::INT);
+		CHECK(int(a->get("value")) == 9);
+	}
+
+	SUBCASE("Native properties") {
+		for (int i = 0; i < 2; i++) {
+			CHECK(Vector2(driver->call("read_position", plain)) == Vector2(1, 2));
+			CHECK(Vector2(driver->call("read_position", a)) == Vector2(3, 4));
+			CHECK(String(driver->call("read_position", b)) == "shadowed");
+		}
+
+		driver->call("write_position", plain, Vector2(5, 6));
+		driver->call("write_position", a, Vector2(7, 8));
+		CHECK(plain->get_position() == Vector2(5, 6));
+		CHECK(a->get_position() == Vector2(7, 8));
+	}
+
+	SUBCASE("Methods") {
+		for (int i = 0; i < 2; i++) {
+			CHECK(String(driver->call("kind", a)) == "a");
+			CHECK(String(driver->call("kind", b)) == "b");
+		}
+
+		// More receivers than cache entries.
+		for (int i = 0; i < 2; i++) {
+			CHECK(String(driver->call("class_of", plain)) == "Node2D");
+			CHECK(String(driver->call("class_of", node)) == "Node");
+			CHECK(String(driver->call("class_of", timer)) == "Timer");
+			CHECK(String(driver->call("class_of", a)) == "Node2D");
+			CHECK(String(driver->call("class_of", b)) == "Node2D");
+		}
+	}
+
+	memdelete(timer);
+	memdelete(node);
+	memdelete(b);
+	memdelete(a);
+	memdelete(plain);
+}
+
+TEST_CASE("[Modules][GDScript] Inline caches are invalidated by reloading") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> driver_script = _compile_inline_cache_test_script(_inline_cache_driver_source);
+	Ref<GDScript> a_script = _compile_inline_cache_test_script(_inline_cache_a_source);
+	REQUIRE(a_script->get_member_functions().has("get_kind"));
+
+	Ref<RefCounted> driver;
+	driver.instantiate();
+	driver->set_script(driver_script);
+
+	Node2D *a = memnew(Node2D);
+	a->set_script(a_script);
+	CHECK(int(driver->call("read_value", a)) == 1);
+	CHECK(String(driver->call("kind", a)) == "a");
+	memdelete(a);
+
+	a_script->set_source_code(R"(
+extends Node2D
+
+var value: int = 1:
+	get:
+		return 100
+
+func get_kind():
+	return "reloaded"
+)");
+	ERR_PRINT_OFF;
+	a_script->reload();
+	ERR_PRINT_ON;
+	REQUIRE(a_script->get_member_functions().has("get_kind"));
+
+	a = memnew(Node2D);
+	a->set_script(a_script);
+	CHECK(int(driver->call("read_value", a)) == 100);
+	CHECK(String(driver->call("kind", a)) == "reloaded");
+	memdelete(a);
+}
+
+#ifdef DEBUG_ENABLED
+TEST_CASE("[Modules][GDScript] Untyped accesses go through inline caches") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> driver_script = _compile_inline_cache_test_script(_inline_cache_driver_source);
+	const HashMap<StringName, GDScriptFunction *> &functions = driver_script->get_member_functions();
+	REQUIRE(functions.has("read_value"));
+
+	CHECK(functions["read_value"]->get_opcode_statistics()[GDScriptFunction::OPCODE_GET_NAMED] == 1);
+	CHECK(functions["write_value"]->get_opcode_statistics()[GDScriptFunction::OPCODE_SET_NAMED] == 1);
+	CHECK(functions["kind"]->get_opcode_statistics()[GDScriptFunction::OPCODE_CALL_RETURN] == 1);
+}
+
+TEST_CASE("[Modules][GDScript] Objects can't be freed by their own cached method") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> driver_script = _compile_inline_cache_test_script(_inline_cache_driver_source);
+	Ref<GDScript> target_script = _compile_inline_cache_test_script(R"(
+extends Node
+
+func free_self():
+	free()
+	return "done"
+)");
+	REQUIRE(target_script->get_member_functions().has("free_self"));
+
+	Ref<RefCounted> driver;
+	driver.instantiate();
+	driver->set_script(driver_script);
+
+	// The second call uses the entry cached by the first.
+	for (int i = 0; i < 2; i++) {
+		Node *target = memnew(Node);
+		target->set_script(target_script);
+		const ObjectID target_id = target->get_instance_id();
+
+		ERR_PRINT_OFF;
+		const Variant result = driver->call("call_free_self", target);
+		ERR_PRINT_ON;
+		CHECK(String(result) == "done");
+		REQUIRE(ObjectDB::get_instance(target_id) == target);
+		memdelete(target);
+	}
+}
+#endif // DEBUG_ENABLED
+
+} // namespace GDScriptTests
@@ -0,0 +1,107 @@
+/**************************************************************************/
+/*  test_gdscript_transpiler.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#ifdef TOOLS_ENABLED
+
+#include "../editor/gdscript_transpiler.h"
+#include "../gdscript_aot.h"
+
+#include "tests/test_macros.h"
+
+namespace GDScriptTests {
+
+static Ref<GDScript> _compile_transpiler_test_script() {
+	Ref<GDScript> gdscript = memnew(GDScript);
+	gdscript->set_source_code(R"(
+extends RefCounted
+
+func add(a: int, b: int) -> int:
+	return a + b
+
+func untyped(value):
+	return value.get_something()
+)");
+	// See "Load source code dynamically and run it".
+	ERR_PRINT_OFF;
+	gdscript->reload();
+	ERR_PRINT_ON;
+	return gdscript;
+}
+
+TEST_CASE("[Modules][GDScript] Transpile typed functions to C++") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = _compile_transpiler_test_script();
+	REQUIRE(gdscript->get_member_functions().has("add"));
+
+	GDScriptTranspiler transpiler;
+	transpiler.add_script(gdscript);
+
+	CHECK_MESSAGE(transpiler.get_translated_count() == 1, "Only the fully typed function should be translated.");
+	REQUIRE(transpiler.get_skipped().size() == 1);
+	CHECK(transpiler.get_skipped()[0].ends_with("::untyped"));
+
+	const String source = transpiler.get_source();
+	CHECK(source.contains("void register_gdscript_aot_functions() {"));
+	CHECK(source.contains("::add\"), 0x"));
+	CHECK_MESSAGE(source.contains("*VariantInternal::get_int(dst) = a + b;"), "Integer addition should be inlined.");
+	CHECK_FALSE(source.contains("::untyped\""));
+}
+
+TEST_CASE("[Modules][GDScript] Translated functions only match the bytecode they come from") {
+	GDScriptLanguage::get_singleton()->init();
+	Ref<GDScript> gdscript = _compile_transpiler_test_script();
+	Ref<GDScript> recompiled = _compile_transpiler_test_script();
+	const GDScriptFunction *add = gdscript->get_member_functions()["add"];
+	const GDScriptFunction *add_recompiled = recompiled->get_member_functions()["add"];
+
+	uint64_t signature = 0;
+	uint64_t recompiled_signature = 0;
+	REQUIRE(GDScriptAOT::get_signature(add, signature));
+	REQUIRE(GDScriptAOT::get_signature(add_recompiled, recompiled_signature));
+	CHECK_MESSAGE(signature == recompiled_signature, "Signatures should not depend on where validated pointers are in memory.");
+
+	const String key = GDScriptAOT::get_function_key(add);
+	GDScriptAOT::Function function = [](GDScriptAOT::Frame &r_frame) { return r_frame.ip; };
+
+	GDScriptAOT::register_function(key, signature, function);
+	CHECK(GDScriptAOT::find_function(add) == function);
+
+	GDScriptAOT::register_function(key, signature + 1, function);
+	CHECK_MESSAGE(GDScriptAOT::find_function(add) == nullptr, "Changed bytecode should keep running in the interpreter.");
+
+	GDScriptAOT::unregister_function(key);
+	CHECK(GDScriptAOT::find_function(add) == nullptr);
+}
+
+} // namespace GDScriptTests
+
+#endif // TOOLS_ENABLED
@@ -33,6 +33,7 @@
 #include "godot_space_3d.h"
 
 #include "core/math/geometry_3d.h"
+#include "core/os/frame_arena.h"
 #include "servers/rendering/rendering_server.h"
 
 // Based on Bullet soft body.
@@ -949,7 +950,7 @@ void GodotSoftBody3D::add_velocity(const Vector3 &p_velocity) {
 	}
 }
 
-void GodotSoftBody3D::apply_forces(const LocalVector<GodotArea3D *> &p_wind_areas) {
+void GodotSoftBody3D::apply_forces(Span<GodotArea3D *> p_wind_areas) {
 	if (nodes.is_empty()) {
 		return;
 	}
@@ -1011,7 +1012,8 @@ void GodotSoftBody3D::predict_motion(real_t p_delta) {
 	bool gravity_done = false;
 	Vector3 gravity;
 
-	LocalVector<GodotArea3D *> wind_areas;
+	// Stepped within the FrameArena scope opened by GodotStep3D.
+	FrameLocalVector<GodotArea3D *> wind_areas;
 
 	int ac = areas.size();
 	if (ac) {
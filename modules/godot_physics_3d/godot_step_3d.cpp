@@ -33,6 +33,7 @@
 #include "godot_joint_3d.h"
 
 #include "core/object/worker_thread_pool.h"
+#include "core/os/frame_arena.h"
 #include "core/os/os.h"
 
 #define BODY_ISLAND_COUNT_RESERVE 128
@@ -183,6 +184,9 @@ void GodotStep3D::_check_suspend(const LocalVector<GodotBody3D *> &p_body_island
 }
 
 void GodotStep3D::step(GodotSpace3D *p_space, real_t p_delta) {
+	// Scratch data allocated while stepping (e.g. by soft bodies) is released at the end of the step.
+	FrameArena::Scope frame_arena_scope;
+
 	p_space->lock(); // can't access space during this
 
 	p_space->setup(); //update inertias, etc
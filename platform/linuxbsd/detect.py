@@ -46,6 +46,7 @@ def get_opts():
         BoolVariable("speechd", "Use Speech Dispatcher for Text-to-Speech support", True),
         BoolVariable("fontconfig", "Use fontconfig for system fonts support", True),
         BoolVariable("udev", "Use udev for gamepad connection callbacks", True),
+        BoolVariable("io_uring", "Use io_uring for asynchronous file reads", True),
         BoolVariable("x11", "Enable X11 display", True),
         BoolVariable("wayland", "Enable Wayland display", True),
         BoolVariable("libdecor", "Enable libdecor support", True),
@@ -400,6 +401,13 @@ def configure(env: "SConsEnvironment"):
     else:
         env["udev"] = False  # Linux specific
 
+    if platform.system() == "Linux" and env["threads"]:
+        if env["io_uring"]:
+            # Only the kernel header is needed, the driver talks to the kernel without liburing.
+            env.Append(CPPDEFINES=["IO_URING_ENABLED"])
+    else:
+        env["io_uring"] = False  # Linux specific, and completed on a thread
+
     if env["sdl"]:
         if env["builtin_sdl"]:
             env.Append(CPPDEFINES=["SDL_ENABLED"])
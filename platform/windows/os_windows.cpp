@@ -591,6 +591,81 @@ Error OS_Windows::get_dynamic_library_symbol_handle(void *p_library_handle, cons
 	return OK;
 }
 
+Error OS_Windows::map_file(const String &p_path, const uint8_t *&r_data, uint64_t &r_size, void *&r_handle) {
+	r_data = nullptr;
+	r_size = 0;
+	r_handle = nullptr;
+
+	const Char16String path = p_path.replace_char('/', '\\').utf16();
+
+	// Reading a mapped page that can't be fetched raises EXCEPTION_IN_PAGE_ERROR instead of failing like ReadFile() does.
+	// Files on network shares and on removable media can go away under the mapping, so they aren't mapped.
+	WCHAR volume[MAX_PATH];
+	if (!GetVolumePathNameW((LPCWSTR)path.get_data(), volume, MAX_PATH)) {
+		return ERR_FILE_CANT_OPEN;
+	}
+	UINT drive_type = GetDriveTypeW(volume);
+	if (drive_type == DRIVE_REMOTE || drive_type == DRIVE_REMOVABLE || drive_type == DRIVE_CDROM || drive_type == DRIVE_UNKNOWN) {
+		return ERR_UNAVAILABLE;
+	}
+
+	HANDLE file = CreateFileW((LPCWSTR)path.get_data(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		return ERR_FILE_CANT_OPEN;
+	}
+	if (size.QuadPart == 0) {
+		CloseHandle(file);
+		return OK; // Nothing to map, CreateFileMapping() rejects empty files.
+	}
+	if ((uint64_t)size.QuadPart > (uint64_t)SIZE_MAX) {
+		CloseHandle(file);
+		return ERR_OUT_OF_MEMORY; // Can't fit into the address space (32-bit).
+	}
+
+	HANDLE file_mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	// The mapping object keeps its own reference to the file.
+	CloseHandle(file);
+	if (!file_mapping) {
+		return ERR_FILE_CANT_OPEN;
+	}
+
+	void *data = MapViewOfFile(file_mapping, FILE_MAP_READ, 0, 0, 0);
+	if (!data) {
+		CloseHandle(file_mapping);
+		return ERR_OUT_OF_MEMORY;
+	}
+
+	r_data = (const uint8_t *)data;
+	r_size = size.QuadPart;
+	r_handle = file_mapping;
+	return OK;
+}
+
+Error OS_Windows::unmap_file(void *p_handle, const uint8_t *p_data, uint64_t p_size) {
+	if (!p_data) {
+		return OK;
+	}
+	bool unmapped = UnmapViewOfFile(p_data);
+	CloseHandle((HANDLE)p_handle);
+	return unmapped ? OK : FAILED;
+}
+
+void OS_Windows::prefetch_mapped_range(const uint8_t *p_data, uint64_t p_size) {
+	if (!p_data || !p_size) {
+		return;
+	}
+	WIN32_MEMORY_RANGE_ENTRY range;
+	range.VirtualAddress = (PVOID)p_data;
+	range.NumberOfBytes = (SIZE_T)p_size;
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
 String OS_Windows::get_name() const {
 	return "Windows";
 }
@@ -184,6 +184,10 @@ public:
 	virtual Error close_dynamic_library(void *p_library_handle) override;
 	virtual Error get_dynamic_library_symbol_handle(void *p_library_handle, const String &p_name, void *&p_symbol_handle, bool p_optional = false) override;
 
+	virtual Error map_file(const String &p_path, const uint8_t *&r_data, uint64_t &r_size, void *&r_handle) override;
+	virtual Error unmap_file(void *p_handle, const uint8_t *p_data, uint64_t p_size) override;
+	virtual void prefetch_mapped_range(const uint8_t *p_data, uint64_t p_size) override;
+
 	virtual MainLoop *get_main_loop() const override;
 
 	virtual String get_name() const override;
@@ -37,6 +37,7 @@
 #include "core/object/message_queue.h"
 #include "core/object/worker_thread_pool.h"
 #include "core/os/os.h"
+#include "core/profiling/alloc_profiler.h"
 #include "core/profiling/profiling.h"
 #include "node.h"
 #include "scene/animation/tween.h"
@@ -626,6 +627,8 @@ void SceneTree::iteration_prepare() {
 }
 
 bool SceneTree::physics_process(double p_time) {
+	ALLOC_PROFILE_SCOPE("SceneTree");
+
 	current_frame++;
 
 	flush_transform_notifications();
@@ -675,6 +678,8 @@ void SceneTree::iteration_end() {
 }
 
 bool SceneTree::process(double p_time) {
+	ALLOC_PROFILE_SCOPE("SceneTree");
+
 	// First pass of scene tree fixed timestep interpolation.
 	if (get_scene_tree_fti().is_enabled()) {
 		// Special, we need to ensure RenderingServer is up to date
@@ -36,6 +36,7 @@
 #include "core/io/resource_loader.h"
 #include "core/math/audio_frame.h"
 #include "core/os/os.h"
+#include "core/profiling/alloc_profiler.h"
 #include "core/string/string_name.h"
 #include "core/templates/pair.h"
 #include "scene/scene_string_names.h"
@@ -256,6 +257,7 @@ AudioDriver *AudioDriverManager::get_driver(int p_driver) {
 //////////////////////////////////////////////
 
 void AudioServer::_driver_process(int p_frames, int32_t *p_buffer) {
+	ALLOC_PROFILE_SCOPE("Audio");
 	mix_count++;
 	int todo = p_frames;
 
@@ -341,8 +343,8 @@ void AudioServer::_mix_step() {
 	for (int i = 0; i < buses.size(); i++) {
 		Bus *bus = buses[i];
 		bus->index_cache = i; //might be moved around by editor, so..
-		for (int k = 0; k < bus->channels.size(); k++) {
-			bus->channels.write[k].used = false;
+		for (uint32_t k = 0; k < bus->channels.size(); k++) {
+			bus->channels[k].used = false;
 		}
 
 		if (bus->solo) {
@@ -538,10 +540,10 @@ void AudioServer::_mix_step() {
 	for (int i = buses.size() - 1; i >= 0; i--) {
 		Bus *bus = buses[i];
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+		for (uint32_t k = 0; k < bus->channels.size(); k++) {
 			if (bus->channels[k].active && !bus->channels[k].used) {
 				// Buffer was not used, but it's still active, so it must be cleaned.
-				AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+				AudioFrame *buf = bus->channels[k].buffer.ptrw();
 
 				for (uint32_t j = 0; j < buffer_size; j++) {
 					buf[j] = AudioFrame(0, 0);
@@ -560,19 +562,19 @@ void AudioServer::_mix_step() {
 				uint64_t ticks = OS::get_singleton()->get_ticks_usec();
 #endif
 
-				for (int k = 0; k < bus->channels.size(); k++) {
+				for (uint32_t k = 0; k < bus->channels.size(); k++) {
 					if (!(bus->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
 						continue;
 					}
-					bus->channels.write[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer.write[k].ptrw(), buffer_size);
+					bus->channels[k].effect_instances.write[j]->process(bus->channels[k].buffer.ptr(), temp_buffer[k].ptrw(), buffer_size);
 				}
 
 				// Swap buffers, so internal buffer always has the right data.
-				for (int k = 0; k < bus->channels.size(); k++) {
+				for (uint32_t k = 0; k < bus->channels.size(); k++) {
 					if (!(buses[i]->channels[k].active || bus->channels[k].effect_instances[j]->process_silence())) {
 						continue;
 					}
-					SWAP(bus->channels.write[k].buffer, temp_buffer.write[k]);
+					SWAP(bus->channels[k].buffer, temp_buffer[k]);
 				}
 
 #ifdef DEBUG_ENABLED
@@ -597,13 +599,13 @@ void AudioServer::_mix_step() {
 			}
 		}
 
-		for (int k = 0; k < bus->channels.size(); k++) {
+		for (uint32_t k = 0; k < bus->channels.size(); k++) {
 			if (!bus->channels[k].active) {
-				bus->channels.write[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
+				bus->channels[k].peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
 				continue;
 			}
 
-			AudioFrame *buf = bus->channels.write[k].buffer.ptrw();
+			AudioFrame *buf = bus->channels[k].buffer.ptrw();
 
 			AudioFrame peak = AudioFrame(0, 0);
 
@@ -633,15 +635,15 @@ void AudioServer::_mix_step() {
 				}
 			}
 
-			bus->channels.write[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
+			bus->channels[k].peak_volume = AudioFrame(Math::linear_to_db(peak.left + AUDIO_PEAK_OFFSET), Math::linear_to_db(peak.right + AUDIO_PEAK_OFFSET));
 
 			if (!bus->channels[k].used) {
 				// See if any audio is contained, because channel was not used.
 
 				if (MAX(peak.right, peak.left) > Math::db_to_linear(channel_disable_threshold_db)) {
-					bus->channels.write[k].last_mix_with_audio = mix_frames;
+					bus->channels[k].last_mix_with_audio = mix_frames;
 				} else if (mix_frames - bus->channels[k].last_mix_with_audio > channel_disable_frames) {
-					bus->channels.write[k].active = false;
+					bus->channels[k].active = false;
 					continue; //went inactive, don't mix.
 				}
 			}
@@ -731,7 +733,7 @@ bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
 	if (p_bus < 0 || p_bus >= buses.size()) {
 		return false;
 	}
-	if (p_buffer < 0 || p_buffer >= buses[p_bus]->channels.size()) {
+	if (p_buffer < 0 || p_buffer >= (int)buses[p_bus]->channels.size()) {
 		return false;
 	}
 	return true;
@@ -739,14 +741,14 @@ bool AudioServer::thread_has_channel_mix_buffer(int p_bus, int p_buffer) const {
 
 AudioFrame *AudioServer::thread_get_channel_mix_buffer(int p_bus, int p_buffer) {
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), nullptr);
-	ERR_FAIL_INDEX_V(p_buffer, buses[p_bus]->channels.size(), nullptr);
+	ERR_FAIL_INDEX_V(p_buffer, (int)buses[p_bus]->channels.size(), nullptr);
 
-	AudioFrame *data = buses.write[p_bus]->channels.write[p_buffer].buffer.ptrw();
+	AudioFrame *data = buses[p_bus]->channels[p_buffer].buffer.ptrw();
 
 	if (!buses[p_bus]->channels[p_buffer].used) {
-		buses.write[p_bus]->channels.write[p_buffer].used = true;
-		buses.write[p_bus]->channels.write[p_buffer].active = true;
-		buses.write[p_bus]->channels.write[p_buffer].last_mix_with_audio = mix_frames;
+		buses[p_bus]->channels[p_buffer].used = true;
+		buses[p_bus]->channels[p_buffer].active = true;
+		buses[p_bus]->channels[p_buffer].last_mix_with_audio = mix_frames;
 		for (uint32_t i = 0; i < buffer_size; i++) {
 			data[i] = AudioFrame(0, 0);
 		}
@@ -816,9 +818,9 @@ void AudioServer::set_bus_count(int p_count) {
 		}
 
 		buses.write[i] = memnew(Bus);
-		buses.write[i]->channels.resize(channel_count);
+		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
-			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses[i]->channels[j].buffer.resize(buffer_size);
 		}
 		buses[i]->name = attempt;
 		buses[i]->solo = false;
@@ -891,7 +893,7 @@ void AudioServer::add_bus(int p_at_pos) {
 	Bus *bus = memnew(Bus);
 	bus->channels.resize(channel_count);
 	for (int j = 0; j < channel_count; j++) {
-		bus->channels.write[j].buffer.resize(buffer_size);
+		bus->channels[j].buffer.resize(buffer_size);
 	}
 	bus->name = attempt;
 	bus->solo = false;
@@ -1090,14 +1092,14 @@ bool AudioServer::is_bus_bypassing_effects(int p_bus) const {
 }
 
 void AudioServer::_update_bus_effects(int p_bus) {
-	for (int i = 0; i < buses[p_bus]->channels.size(); i++) {
-		buses.write[p_bus]->channels.write[i].effect_instances.resize(buses[p_bus]->effects.size());
+	for (uint32_t i = 0; i < buses[p_bus]->channels.size(); i++) {
+		buses[p_bus]->channels[i].effect_instances.resize(buses[p_bus]->effects.size());
 		for (int j = 0; j < buses[p_bus]->effects.size(); j++) {
 			Ref<AudioEffectInstance> fx = buses.write[p_bus]->effects.write[j].effect->instantiate();
 			if (Object::cast_to<AudioEffectCompressorInstance>(*fx)) {
 				Object::cast_to<AudioEffectCompressorInstance>(*fx)->set_current_channel(i);
 			}
-			buses.write[p_bus]->channels.write[i].effect_instances.write[j] = fx;
+			buses[p_bus]->channels[i].effect_instances.write[j] = fx;
 		}
 	}
 }
@@ -1151,7 +1153,7 @@ int AudioServer::get_bus_effect_count(int p_bus) {
 Ref<AudioEffectInstance> AudioServer::get_bus_effect_instance(int p_bus, int p_effect, int p_channel) {
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), Ref<AudioEffectInstance>());
 	ERR_FAIL_INDEX_V(p_effect, buses[p_bus]->effects.size(), Ref<AudioEffectInstance>());
-	ERR_FAIL_INDEX_V(p_channel, buses[p_bus]->channels.size(), Ref<AudioEffectInstance>());
+	ERR_FAIL_INDEX_V(p_channel, (int)buses[p_bus]->channels.size(), Ref<AudioEffectInstance>());
 
 	return buses[p_bus]->channels[p_channel].effect_instances[p_effect];
 }
@@ -1193,21 +1195,21 @@ bool AudioServer::is_bus_effect_enabled(int p_bus, int p_effect) const {
 
 float AudioServer::get_bus_peak_volume_left_db(int p_bus, int p_channel) const {
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), 0);
-	ERR_FAIL_INDEX_V(p_channel, buses[p_bus]->channels.size(), 0);
+	ERR_FAIL_INDEX_V(p_channel, (int)buses[p_bus]->channels.size(), 0);
 
 	return buses[p_bus]->channels[p_channel].peak_volume.left;
 }
 
 float AudioServer::get_bus_peak_volume_right_db(int p_bus, int p_channel) const {
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), 0);
-	ERR_FAIL_INDEX_V(p_channel, buses[p_bus]->channels.size(), 0);
+	ERR_FAIL_INDEX_V(p_channel, (int)buses[p_bus]->channels.size(), 0);
 
 	return buses[p_bus]->channels[p_channel].peak_volume.right;
 }
 
 bool AudioServer::is_bus_channel_active(int p_bus, int p_channel) const {
 	ERR_FAIL_INDEX_V(p_bus, buses.size(), false);
-	ERR_FAIL_INDEX_V(p_channel, buses[p_bus]->channels.size(), false);
+	ERR_FAIL_INDEX_V(p_channel, (int)buses[p_bus]->channels.size(), false);
 
 	return buses[p_bus]->channels[p_channel].active;
 }
@@ -1496,14 +1498,14 @@ void AudioServer::init_channels_and_buffers() {
 	temp_buffer.resize(channel_count);
 	mix_buffer.resize(buffer_size + LOOKAHEAD_BUFFER_SIZE);
 
-	for (int i = 0; i < temp_buffer.size(); i++) {
-		temp_buffer.write[i].resize(buffer_size);
+	for (uint32_t i = 0; i < temp_buffer.size(); i++) {
+		temp_buffer[i].resize(buffer_size);
 	}
 
 	for (int i = 0; i < buses.size(); i++) {
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
-			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses[i]->channels[j].buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
@@ -1782,7 +1784,7 @@ void AudioServer::set_bus_layout(const Ref<AudioBusLayout> &p_bus_layout) {
 
 		buses[i]->channels.resize(channel_count);
 		for (int j = 0; j < channel_count; j++) {
-			buses.write[i]->channels.write[j].buffer.resize(buffer_size);
+			buses[i]->channels[j].buffer.resize(buffer_size);
 		}
 		_update_bus_effects(i);
 	}
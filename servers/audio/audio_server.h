@@ -33,7 +33,9 @@
 #include "core/math/audio_frame.h"
 #include "core/object/class_db.h"
 #include "core/os/os.h"
+#include "core/templates/local_vector.h"
 #include "core/templates/safe_list.h"
+#include "core/templates/unique_vector.h"
 #include "core/variant/variant.h"
 #include "servers/audio/audio_effect.h"
 #include "servers/audio/audio_filter_sw.h"
@@ -245,13 +247,13 @@ private:
 			bool used = false;
 			bool active = false;
 			AudioFrame peak_volume = AudioFrame(AUDIO_MIN_PEAK_DB, AUDIO_MIN_PEAK_DB);
-			Vector<AudioFrame> buffer;
+			UniqueVector<AudioFrame> buffer;
 			Vector<Ref<AudioEffectInstance>> effect_instances;
 			uint64_t last_mix_with_audio = 0;
 			Channel() {}
 		};
 
-		Vector<Channel> channels;
+		LocalVector<Channel> channels;
 
 		struct Effect {
 			Ref<AudioEffect> effect;
@@ -315,8 +317,8 @@ private:
 	// TODO document if this is necessary.
 	SafeList<AudioStreamPlaybackBusDetails *> bus_details_graveyard_frame_old;
 
-	Vector<Vector<AudioFrame>> temp_buffer; //temp_buffer for each level
-	Vector<AudioFrame> mix_buffer;
+	LocalVector<UniqueVector<AudioFrame>> temp_buffer; //temp_buffer for each level
+	UniqueVector<AudioFrame> mix_buffer;
 	Vector<Bus *> buses;
 	HashMap<StringName, Bus *> bus_map;
 
@@ -31,6 +31,9 @@
 #pragma once
 
 #include "core/io/file_access.h"
+#include "core/io/file_access_async.h"
+#include "core/io/file_access_compressed.h"
+#include "core/io/file_access_mapped.h"
 #include "tests/test_macros.h"
 #include "tests/test_utils.h"
 
@@ -248,4 +251,268 @@ TEST_CASE("[FileAccess] Get/Store floating point half precision values") {
 	}
 }
 
+TEST_CASE("[FileAccess] Memory-mapped read") {
+	const String file_path = TestUtils::get_temp_path("mapped.bin");
+	{
+		Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(fw.is_valid());
+		for (int i = 0; i < 256; i++) {
+			fw->store_8(i);
+		}
+	}
+
+	SUBCASE("Whole file") {
+		Ref<FileAccessMapped> f;
+		f.instantiate();
+		REQUIRE(f->reopen(file_path, FileAccess::READ) == OK);
+		CHECK(f->get_length() == 256);
+		CHECK(f->get_8() == 0);
+		CHECK(f->get_16() == 0x0201);
+		CHECK(f->get_32() == 0x06050403);
+
+		Span<uint8_t> view = f->get_buffer_view(10);
+		REQUIRE(view.size() == 10);
+		CHECK(view[0] == 7);
+		CHECK(view[9] == 16);
+		CHECK(f->get_position() == 17);
+		CHECK_FALSE(f->eof_reached());
+
+		// Views are all or nothing, and don't move when short.
+		f->seek(250);
+		CHECK(f->get_buffer_view(7).is_empty());
+		CHECK(f->get_position() == 250);
+		CHECK_FALSE(f->eof_reached());
+		CHECK(f->get_buffer_view(6).size() == 6);
+		CHECK(f->get_position() == 256);
+
+		// Reading exactly up to the end doesn't set EOF, reading past it does.
+		f->seek(250);
+		uint8_t buf[16];
+		CHECK(f->get_buffer(buf, 6) == 6);
+		CHECK(buf[5] == 255);
+		CHECK_FALSE(f->eof_reached());
+		CHECK(f->get_buffer_view(1).is_empty());
+		CHECK_FALSE(f->eof_reached());
+		CHECK(f->get_buffer(buf, 1) == 0);
+		CHECK(f->eof_reached());
+
+		f->seek(0);
+		CHECK_FALSE(f->eof_reached());
+		ERR_PRINT_OFF;
+		CHECK_FALSE(f->store_8(1));
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Subrange of a shared mapping") {
+		Ref<FileMapping> mapping = FileMapping::map(file_path);
+		REQUIRE(mapping.is_valid());
+		CHECK(mapping->get_size() == 256);
+
+		Ref<FileAccessMapped> f;
+		f.instantiate();
+		REQUIRE(f->open_mapping(mapping, 100, 20, "res://sub.bin") == OK);
+		CHECK(f->get_path() == "res://sub.bin");
+		CHECK(f->get_length() == 20);
+		CHECK(f->get_8() == 100);
+		f->seek_end(-1);
+		CHECK(f->get_8() == 119);
+
+		Span<uint8_t> view = f->get_buffer_view(5);
+		CHECK(view.is_empty());
+		CHECK(f->get_position() == 20);
+		CHECK_FALSE(f->eof_reached());
+
+		ERR_PRINT_OFF;
+		CHECK(f->open_mapping(mapping, 250, 20, "res://out_of_range.bin") != OK);
+		ERR_PRINT_ON;
+	}
+
+	SUBCASE("Unmapped backends don't provide views") {
+		Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_buffer_view(4).is_empty());
+		CHECK(f->get_position() == 0);
+	}
+
+	DirAccess::remove_file_or_error(file_path);
+}
+
+TEST_CASE("[FileAccess] Compressed random access") {
+	const String file_path = TestUtils::get_temp_path("compressed.bin");
+
+	// Not very compressible, so blocks don't end up with the same size.
+	Vector<uint8_t> data;
+	data.resize(300000);
+	uint32_t state = 1234;
+	for (int i = 0; i < data.size(); i++) {
+		state = state * 1103515245 + 12345;
+		data.write[i] = (i % 7 == 0) ? (state >> 24) : (i % 251);
+	}
+
+	SUBCASE("Seeking back and forth across blocks") {
+		Ref<FileAccessCompressed> fw;
+		fw.instantiate();
+		fw->configure("TEST", Compression::MODE_ZSTD, 4096);
+		REQUIRE(fw->open_internal(file_path, FileAccess::WRITE) == OK);
+		fw->store_buffer(data.ptr(), data.size());
+		fw->close();
+
+		Ref<FileAccessCompressed> f;
+		f.instantiate();
+		f->configure("TEST");
+		REQUIRE(f->open_internal(file_path, FileAccess::READ) == OK);
+		CHECK(f->get_length() == (uint64_t)data.size());
+
+		const uint64_t positions[] = { 250000, 10, 4095, 4096, 299990, 8191, 123456, 0, 250001 };
+		for (uint64_t position : positions) {
+			f->seek(position);
+			uint8_t buf[8];
+			const uint64_t read = f->get_buffer(buf, 8);
+			CHECK(read == MIN((uint64_t)8, (uint64_t)data.size() - position));
+			CHECK(memcmp(buf, data.ptr() + position, read) == 0);
+			CHECK(f->get_position() == position + read);
+		}
+	}
+
+	SUBCASE("Sequential reads with prefetched blocks") {
+		Ref<FileAccessCompressed> fw;
+		fw.instantiate();
+		fw->configure("TEST", Compression::MODE_ZSTD, FileAccessCompressed::PREFETCH_MIN_BLOCK_SIZE);
+		REQUIRE(fw->open_internal(file_path, FileAccess::WRITE) == OK);
+		fw->store_buffer(data.ptr(), data.size());
+		fw->close();
+
+		Ref<FileAccessCompressed> f;
+		f.instantiate();
+		f->configure("TEST");
+		REQUIRE(f->open_internal(file_path, FileAccess::READ) == OK);
+
+		// Odd sized reads, so they straddle block boundaries.
+		Vector<uint8_t> result;
+		result.resize(data.size());
+		uint64_t pos = 0;
+		while (pos < (uint64_t)data.size()) {
+			const uint64_t read = f->get_buffer(result.ptrw() + pos, MIN((uint64_t)9999, data.size() - pos));
+			REQUIRE(read > 0);
+			pos += read;
+		}
+		CHECK(result == data);
+		CHECK_FALSE(f->eof_reached());
+
+		// Closing with prefetch tasks possibly still pending.
+		f->seek(0);
+		f->get_buffer(result.ptrw(), FileAccessCompressed::PREFETCH_MIN_BLOCK_SIZE + 1);
+		f->close();
+		CHECK_FALSE(f->is_open());
+	}
+
+	SUBCASE("Dictionary") {
+		// Small files sharing most of their content with the dictionary.
+		const String text = "[gd_resource type=\"StandardMaterial3D\" format=3]\n\n[resource]\nalbedo_color = Color(1, 0.5, 0.25, 1)\nmetallic = 0.5\nroughness = 0.75\n";
+		const CharString dictionary_text = (text + text.replace("0.5", "0.3")).utf8();
+		Vector<uint8_t> dictionary;
+		dictionary.resize(dictionary_text.length());
+		memcpy(dictionary.ptrw(), dictionary_text.get_data(), dictionary_text.length());
+		const CharString content = text.replace("0.75", "0.8").utf8();
+
+		Ref<FileAccessCompressed> fw;
+		fw.instantiate();
+		fw->configure("TEST");
+		fw->set_dictionary(dictionary);
+		REQUIRE(fw->open_internal(file_path, FileAccess::WRITE) == OK);
+		fw->store_buffer((const uint8_t *)content.get_data(), content.length());
+		fw->close();
+
+		Ref<FileAccessCompressed> f;
+		f.instantiate();
+		f->configure("TEST");
+		f->set_dictionary(dictionary);
+		REQUIRE(f->open_internal(file_path, FileAccess::READ) == OK);
+		CHECK(f->get_as_utf8_string() == String::utf8(content.get_data()));
+		f->close();
+
+		Ref<FileAccessCompressed> f_no_dictionary;
+		f_no_dictionary.instantiate();
+		f_no_dictionary->configure("TEST");
+		ERR_PRINT_OFF;
+		CHECK(f_no_dictionary->open_internal(file_path, FileAccess::READ) == ERR_INVALID_DATA);
+		ERR_PRINT_ON;
+
+		Ref<FileAccessCompressed> f_fastlz;
+		f_fastlz.instantiate();
+		f_fastlz->configure("TEST", Compression::MODE_FASTLZ);
+		f_fastlz->set_dictionary(dictionary);
+		ERR_PRINT_OFF;
+		CHECK(f_fastlz->open_internal(file_path, FileAccess::WRITE) == ERR_INVALID_PARAMETER);
+		ERR_PRINT_ON;
+	}
+
+	DirAccess::remove_file_or_error(file_path);
+}
+
+static void _async_read_callback(void *p_userdata, Error p_error, uint64_t p_read_length) {
+	SafeNumeric<uint64_t> *total = static_cast<SafeNumeric<uint64_t> *>(p_userdata);
+	total->add(p_read_length);
+}
+
+TEST_CASE("[FileAccess] Asynchronous read") {
+	const String file_path = TestUtils::get_temp_path("async.bin");
+	Vector<uint8_t> data;
+	data.resize(200000);
+	for (int i = 0; i < data.size(); i++) {
+		data.write[i] = (i * 7) % 256;
+	}
+	{
+		Ref<FileAccess> fw = FileAccess::open(file_path, FileAccess::WRITE);
+		REQUIRE(fw.is_valid());
+		fw->store_buffer(data);
+	}
+
+	Ref<FileAccess> f = FileAccess::open(file_path, FileAccess::READ);
+	REQUIRE(f.is_valid());
+	f->seek(10);
+
+	// Several reads in flight at once, one of them going past the end of the file.
+	const uint64_t offsets[] = { 0, 65536, 100, 150000, 199990 };
+	LocalVector<Vector<uint8_t>> buffers;
+	LocalVector<Ref<FileAccessAsyncRead>> reads;
+	SafeNumeric<uint64_t> total;
+	buffers.resize(std::size(offsets));
+	for (uint32_t i = 0; i < std::size(offsets); i++) {
+		buffers[i].resize(50000);
+		reads.push_back(f->read_async(offsets[i], buffers[i].ptrw(), buffers[i].size(), &_async_read_callback, &total));
+	}
+
+	uint64_t expected_total = 0;
+	for (uint32_t i = 0; i < std::size(offsets); i++) {
+		REQUIRE(reads[i].is_valid());
+		CHECK(reads[i]->wait() == OK);
+		CHECK(reads[i]->is_completed());
+		const uint64_t expected = MIN((uint64_t)buffers[i].size(), data.size() - offsets[i]);
+		CHECK(reads[i]->get_read_length() == expected);
+		CHECK(memcmp(buffers[i].ptr(), data.ptr() + offsets[i], expected) == 0);
+		expected_total += expected;
+	}
+	CHECK(total.get() == expected_total);
+
+	// The position is left alone.
+	CHECK(f->get_position() == 10);
+	CHECK(f->get_8() == data[10]);
+
+	SUBCASE("Memory-mapped files") {
+		Ref<FileAccessMapped> fm;
+		fm.instantiate();
+		REQUIRE(fm->reopen(file_path, FileAccess::READ) == OK);
+		uint8_t buf[16];
+		Ref<FileAccessAsyncRead> read = fm->read_async(1000, buf, 16);
+		CHECK(read->wait() == OK);
+		CHECK(read->get_read_length() == 16);
+		CHECK(memcmp(buf, data.ptr() + 1000, 16) == 0);
+		CHECK(fm->get_position() == 0);
+	}
+
+	f.unref();
+	DirAccess::remove_file_or_error(file_path);
+}
+
 } // namespace TestFileAccess
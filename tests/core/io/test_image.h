@@ -249,6 +249,24 @@ TEST_CASE("[Image] Resizing") {
 				"Resizing an image should also affect its content.");
 	}
 
+	// Resize with mipmaps
+	Ref<Image> image_mipmaps = memnew(Image(16, 16, true, Image::FORMAT_RGBA8));
+	image_mipmaps->fill(Color(1, 0, 0, 1));
+	const Vector<uint8_t> previous_data = image_mipmaps->get_data();
+	image_mipmaps->resize(4, 4, Image::INTERPOLATE_TRILINEAR);
+	CHECK_MESSAGE(
+			image_mipmaps->has_mipmaps(),
+			"Resizing an image with mipmaps should keep its mipmaps.");
+	CHECK_MESSAGE(
+			image_mipmaps->get_data().size() == Image::get_image_data_size(4, 4, Image::FORMAT_RGBA8, true),
+			"Resizing an image with mipmaps should regenerate its mipmaps.");
+	CHECK_MESSAGE(
+			image_mipmaps->get_pixel(3, 3).is_equal_approx(Color(1, 0, 0, 1)),
+			"Resizing an image with mipmaps should preserve its content.");
+	CHECK_MESSAGE(
+			previous_data.size() == Image::get_image_data_size(16, 16, Image::FORMAT_RGBA8, true),
+			"Resizing an image should not affect copies of its previous data.");
+
 	// shrink_x2()
 	image->shrink_x2();
 	CHECK_MESSAGE(
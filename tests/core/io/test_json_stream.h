@@ -0,0 +1,238 @@
+/**************************************************************************/
+/*  test_json_stream.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/json.h"
+#include "core/io/json_stream.h"
+
+#include "tests/test_utils.h"
+#include "thirdparty/doctest/doctest.h"
+
+namespace TestJSONStream {
+
+static Variant read_all(const Ref<JSONStreamReader> &p_reader) {
+	REQUIRE(p_reader->read() == OK);
+	Variant ret;
+	REQUIRE(p_reader->read_value(ret) == OK);
+	CHECK(p_reader->read() == ERR_FILE_EOF);
+	return ret;
+}
+
+TEST_CASE("[JSONStreamReader] Events") {
+	Ref<JSONStreamReader> reader;
+	reader.instantiate();
+	const CharString json = String(U"{\"a\": [1, true, null], \"é\": \"x\\u00e9\\ud83d\\ude00\"}").utf8();
+	reader->append_data((const uint8_t *)json.get_data(), json.length());
+	reader->finish_data();
+
+	const JSONStreamReader::Event events[] = {
+		JSONStreamReader::EVENT_OBJECT_BEGIN,
+		JSONStreamReader::EVENT_KEY,
+		JSONStreamReader::EVENT_ARRAY_BEGIN,
+		JSONStreamReader::EVENT_VALUE,
+		JSONStreamReader::EVENT_VALUE,
+		JSONStreamReader::EVENT_VALUE,
+		JSONStreamReader::EVENT_ARRAY_END,
+		JSONStreamReader::EVENT_KEY,
+		JSONStreamReader::EVENT_VALUE,
+		JSONStreamReader::EVENT_OBJECT_END,
+	};
+	for (JSONStreamReader::Event event : events) {
+		REQUIRE(reader->read() == OK);
+		CHECK(reader->get_event() == event);
+		if (event == JSONStreamReader::EVENT_ARRAY_BEGIN) {
+			CHECK(reader->get_depth() == 2);
+		}
+	}
+	CHECK(reader->read() == ERR_FILE_EOF);
+
+	reader->reset();
+	reader->append_data((const uint8_t *)json.get_data(), json.length());
+	reader->finish_data();
+	CHECK(read_all(reader) == JSON::parse_string(String::utf8(json.get_data())));
+}
+
+TEST_CASE("[JSONStreamReader] Chunks split anywhere") {
+	const String text = U"\xEF\xBB\xBF[{\"key\": \"long \\\"escaped\\\" value\\n\", \"n\": -1.5e3}, [], {}, 12345678901, false, \"ünicode\"]";
+	const CharString json = text.utf8();
+	const Variant expected = JSON::parse_string(String::utf8(json.get_data() + 3));
+
+	Ref<JSONStreamReader> reader;
+	reader.instantiate();
+	REQUIRE(reader->read() == ERR_BUSY);
+
+	// One byte at a time, every token gets split.
+	Variant result;
+	bool started = false;
+	for (int i = 0; i < json.length(); i++) {
+		reader->append_data((const uint8_t *)json.get_data() + i, 1);
+		if (!started) {
+			Error err = reader->read();
+			if (err == ERR_BUSY) {
+				continue;
+			}
+			REQUIRE(err == OK);
+			started = true;
+		}
+		Error err = reader->read_value(result);
+		if (err == OK) {
+			break;
+		}
+		REQUIRE(err == ERR_BUSY);
+	}
+	CHECK(result == expected);
+	CHECK(reader->read() == ERR_BUSY);
+	reader->finish_data();
+	CHECK(reader->read() == ERR_FILE_EOF);
+}
+
+TEST_CASE("[JSONStreamReader] Large file") {
+	// Larger than a few chunks, with a string value spanning several of them.
+	Array records;
+	for (int i = 0; i < 5000; i++) {
+		Dictionary record;
+		record["id"] = i;
+		record["name"] = vformat("record %d", i);
+		record["values"] = Array{ i * 0.5, -i, i % 2 == 0 };
+		records.push_back(record);
+	}
+	records.push_back(String("x").repeat(JSONStreamReader::CHUNK_SIZE * 3));
+
+	const String path = TestUtils::get_temp_path("json_stream_large.json");
+	const String text = JSON::stringify(records, "\t");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		f->store_string(text);
+	}
+
+	Ref<JSONStreamReader> reader;
+	reader.instantiate();
+	reader->set_file(FileAccess::open(path, FileAccess::READ));
+	CHECK(read_all(reader) == JSON::parse_string(text));
+}
+
+TEST_CASE("[JSONStreamReader] Errors") {
+	Ref<JSONStreamReader> reader;
+	reader.instantiate();
+
+	const char *invalid[] = { "", "[1 2]", "{\"a\" 1}", "{1: 2}", "[tru]", "\"unterminated", "[1]]", "\"\\x\"", "\"\\ud800\"" };
+	for (const char *json : invalid) {
+		reader->reset();
+		reader->append_data((const uint8_t *)json, strlen(json));
+		reader->finish_data();
+
+		Error err = OK;
+		while (err == OK) {
+			err = reader->read();
+		}
+		CHECK_MESSAGE(err == ERR_PARSE_ERROR, json);
+		CHECK(!reader->get_error_message().is_empty());
+		Ref<JSON> json_parser;
+		json_parser.instantiate();
+		CHECK_MESSAGE(json_parser->parse(json) != OK, json);
+	}
+
+	reader->reset();
+	const char *json = "[\n1,\n2\n3]";
+	reader->append_data((const uint8_t *)json, strlen(json));
+	reader->finish_data();
+	Variant value;
+	REQUIRE(reader->read() == OK);
+	CHECK(reader->read_value(value) == ERR_PARSE_ERROR);
+	CHECK(reader->get_error_line() == 4);
+	CHECK(reader->get_error_message() == "Expected ','");
+
+	// Trailing commas are accepted like JSON::parse() does.
+	reader->reset();
+	json = "[1, {\"a\": 2,},]";
+	reader->append_data((const uint8_t *)json, strlen(json));
+	reader->finish_data();
+	CHECK(read_all(reader) == JSON::parse_string(json));
+}
+
+TEST_CASE("[JSONStreamWriter] Same output as stringify") {
+	Dictionary inner;
+	inner["b"] = 1.5;
+	inner["a"] = "text \"quoted\"\n";
+	Array data = { 1, inner, Array(), Dictionary(), Variant(), false };
+	Dictionary root;
+	root["first"] = data;
+	root["second"] = -42;
+
+	for (const String indent : { "", "\t", "  " }) {
+		const String path = TestUtils::get_temp_path("json_stream_writer.json");
+		{
+			Ref<JSONStreamWriter> writer;
+			writer.instantiate();
+			writer->set_indent(indent);
+			writer->set_file(FileAccess::open(path, FileAccess::WRITE));
+			CHECK(writer->begin_object() == OK);
+			CHECK(writer->write_key("first") == OK);
+			CHECK(writer->begin_array() == OK);
+			CHECK(writer->write_value(1) == OK);
+			CHECK(writer->write_value(inner) == OK);
+			CHECK(writer->begin_array() == OK);
+			CHECK(writer->end_array() == OK);
+			CHECK(writer->begin_object() == OK);
+			CHECK(writer->end_object() == OK);
+			CHECK(writer->write_value(Variant()) == OK);
+			CHECK(writer->write_value(false) == OK);
+			CHECK(writer->end_array() == OK);
+			CHECK(writer->write_key("second") == OK);
+			CHECK(writer->write_value(-42) == OK);
+			CHECK(writer->end_object() == OK);
+
+			ERR_PRINT_OFF;
+			CHECK(writer->write_value(1) != OK);
+			ERR_PRINT_ON;
+			CHECK(writer->flush() == OK);
+		}
+		CHECK(FileAccess::get_file_as_string(path) == JSON::stringify(root, indent, false));
+	}
+}
+
+TEST_CASE("[JSONStreamWriter] Invalid structure") {
+	Ref<JSONStreamWriter> writer;
+	writer.instantiate();
+	ERR_PRINT_OFF;
+	CHECK(writer->begin_array() == ERR_UNCONFIGURED);
+	writer->set_file(FileAccess::open(TestUtils::get_temp_path("json_stream_invalid.json"), FileAccess::WRITE));
+	CHECK(writer->end_array() != OK);
+	CHECK(writer->begin_object() == OK);
+	CHECK(writer->write_value(1) != OK);
+	CHECK(writer->end_array() != OK);
+	CHECK(writer->write_key("a") == OK);
+	CHECK(writer->write_key("b") != OK);
+	CHECK(writer->end_object() != OK);
+	ERR_PRINT_ON;
+}
+
+} // namespace TestJSONStream
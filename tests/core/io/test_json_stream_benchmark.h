@@ -0,0 +1,173 @@
+/**************************************************************************/
+/*  test_json_stream_benchmark.h                                          */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/io/json_stream.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestJSONStreamBenchmark {
+
+// Telemetry records, over 200 MiB of JSON in total.
+static const int RECORD_COUNT = 2500000;
+
+struct Measure {
+	uint64_t begin_usec = 0;
+	uint64_t rss_before_kib = 0;
+
+	Measure() {
+		TestUtils::reset_peak_rss();
+		rss_before_kib = TestUtils::get_peak_rss_kib();
+		begin_usec = OS::get_singleton()->get_ticks_usec();
+	}
+
+	void report(const String &p_what, int64_t p_bytes) const {
+		const uint64_t total = OS::get_singleton()->get_ticks_usec() - begin_usec;
+		const uint64_t rss_peak = TestUtils::get_peak_rss_kib();
+		MESSAGE(vformat("%s: %d ms, %d MiB/s, peak RSS growth %s.", p_what, total / 1000,
+				int64_t(p_bytes * 1000000.0 / MAX(total, (uint64_t)1) / (1 << 20)),
+				rss_peak ? vformat("%d MiB", (rss_peak - MIN(rss_before_kib, rss_peak)) / 1024) : String("not measured")));
+	}
+};
+
+// Keys in sorted order, so the writer matches `JSON::stringify()` byte for byte.
+static void _write_record(const Ref<JSONStreamWriter> &p_writer, int p_index) {
+	p_writer->begin_object();
+	p_writer->write_key("id");
+	p_writer->write_value(p_index);
+	p_writer->write_key("name");
+	p_writer->write_value(vformat("event_%d", p_index % 1000));
+	p_writer->write_key("ok");
+	p_writer->write_value(p_index % 3 != 0);
+	p_writer->write_key("position");
+	p_writer->begin_array();
+	p_writer->write_value(p_index * 0.25);
+	p_writer->write_value(p_index * -0.5);
+	p_writer->write_value(1.5);
+	p_writer->end_array();
+	p_writer->write_key("time");
+	p_writer->write_value(p_index * 0.016);
+	p_writer->end_object();
+}
+
+static Dictionary _make_record(int p_index) {
+	Dictionary record;
+	record["id"] = p_index;
+	record["name"] = vformat("event_%d", p_index % 1000);
+	record["ok"] = p_index % 3 != 0;
+	record["position"] = Array({ p_index * 0.25, p_index * -0.5, 1.5 });
+	record["time"] = p_index * 0.016;
+	return record;
+}
+
+// Run with `--test --no-skip`, it needs about 1 GB of free disk space and 8 GB of memory for `JSON`.
+TEST_CASE("[JSONStreamReader][JSONStreamWriter][Benchmark] Streaming against JSON" * doctest::skip()) {
+	const String stream_path = TestUtils::get_temp_path("benchmark_stream.json");
+	const String stringify_path = TestUtils::get_temp_path("benchmark_stringify.json");
+
+	{
+		Measure measure;
+		Ref<JSONStreamWriter> writer;
+		writer.instantiate();
+		writer->set_file(FileAccess::open(stream_path, FileAccess::WRITE));
+		writer->begin_array();
+		for (int i = 0; i < RECORD_COUNT; i++) {
+			_write_record(writer, i);
+		}
+		writer->end_array();
+		REQUIRE(writer->flush() == OK);
+		writer->set_file(Ref<FileAccess>());
+		measure.report("JSONStreamWriter", FileAccess::get_size(stream_path));
+	}
+	const int64_t size = FileAccess::get_size(stream_path);
+	{
+		Measure measure;
+		Array records;
+		records.resize(RECORD_COUNT);
+		for (int i = 0; i < RECORD_COUNT; i++) {
+			records[i] = _make_record(i);
+		}
+		Ref<FileAccess> file = FileAccess::open(stringify_path, FileAccess::WRITE);
+		file->store_string(JSON::stringify(records));
+		file.unref();
+		measure.report("JSON::stringify()", size);
+	}
+	CHECK_MESSAGE(FileAccess::get_size(stringify_path) == size, "Both should write the same document.");
+	DirAccess::remove_file_or_error(stringify_path);
+
+	{
+		Measure measure;
+		Ref<JSONStreamReader> reader;
+		reader.instantiate();
+		reader->set_file(FileAccess::open(stream_path, FileAccess::READ));
+		int records = 0;
+		double time = 0;
+		while (reader->read() == OK) {
+			// Only what is needed is kept, like a telemetry query would.
+			if (reader->get_event() == JSONStreamReader::EVENT_OBJECT_BEGIN) {
+				records++;
+			} else if (reader->get_event() == JSONStreamReader::EVENT_KEY && String(reader->get_value()) == "time") {
+				REQUIRE(reader->read() == OK);
+				time = MAX(time, double(reader->get_value()));
+			}
+		}
+		CHECK(reader->get_error() == OK);
+		CHECK(records == RECORD_COUNT);
+		CHECK(time == doctest::Approx((RECORD_COUNT - 1) * 0.016));
+		measure.report("JSONStreamReader events", size);
+	}
+	{
+		Measure measure;
+		Ref<JSONStreamReader> reader;
+		reader.instantiate();
+		reader->set_file(FileAccess::open(stream_path, FileAccess::READ));
+		Variant value;
+		REQUIRE(reader->read() == OK);
+		REQUIRE(reader->read_value(value) == OK);
+		CHECK(Array(value).size() == RECORD_COUNT);
+		measure.report("JSONStreamReader::read_value()", size);
+	}
+	{
+		Measure measure;
+		JSON json;
+		REQUIRE(json.parse(FileAccess::get_file_as_string(stream_path)) == OK);
+		CHECK(Array(json.get_data()).size() == RECORD_COUNT);
+		measure.report("JSON::parse()", size);
+	}
+
+	DirAccess::remove_file_or_error(stream_path);
+}
+
+} // namespace TestJSONStreamBenchmark
@@ -489,4 +489,94 @@ TEST_CASE("[Marshalls] Typed dictionary decoding") {
 	CHECK(dictionary[Variant(uint64_t(0x0f123456789abcdef))] == Variant(uint64_t(0x0f123456789abcdef)));
 }
 
+TEST_CASE("[Marshalls] Compact typed array encoding") {
+	int r_len;
+	Array array;
+	array.set_typed(Variant::INT, StringName(), Ref<Script>());
+	array.push_back(1);
+	array.push_back(-1);
+	array.push_back(300);
+	array.push_back(0);
+	uint8_t buffer[20];
+
+	CHECK(encode_variant(array, nullptr, r_len, false, 0, true) == OK);
+	CHECK_MESSAGE(r_len == 20, "Length == 12 bytes for the array + 5 bytes for the elements + 3 bytes of padding.");
+	CHECK(encode_variant(array, buffer, r_len, false, 0, true) == OK);
+	CHECK_MESSAGE(buffer[0] == 0x1c, "Variant::ARRAY");
+	CHECK(buffer[1] == 0x00);
+	CHECK_MESSAGE(buffer[2] == 0x11, "CONTAINER_TYPE_KIND_BUILTIN | HEADER_DATA_FLAG_COMPACT");
+	CHECK(buffer[3] == 0x00);
+	CHECK_MESSAGE(buffer[4] == 0x02, "Variant::INT");
+	CHECK(buffer[8] == 0x04);
+	// Zigzag varints.
+	CHECK(buffer[12] == 0x02);
+	CHECK(buffer[13] == 0x01);
+	CHECK(buffer[14] == 0xd8);
+	CHECK(buffer[15] == 0x04);
+	CHECK(buffer[16] == 0x00);
+	// Padding.
+	CHECK(buffer[17] == 0x00);
+	CHECK(buffer[18] == 0x00);
+	CHECK(buffer[19] == 0x00);
+
+	Variant variant;
+	CHECK(decode_variant(variant, buffer, 20, &r_len) == OK);
+	CHECK(r_len == 20);
+	CHECK(variant == Variant(array));
+	CHECK(Array(variant).get_typed_builtin() == Variant::INT);
+}
+
+TEST_CASE("[Marshalls] Compact typed containers round trip") {
+	Array names;
+	names.set_typed(Variant::STRING_NAME, StringName(), Ref<Script>());
+	Dictionary values;
+	values.set_typed(Variant::STRING_NAME, StringName(), Ref<Script>(), Variant::FLOAT, StringName(), Ref<Script>());
+	Dictionary positions;
+	positions.set_typed(Variant::STRING, StringName(), Ref<Script>(), Variant::VECTOR3, StringName(), Ref<Script>());
+	for (int i = 0; i < 100; i++) {
+		const StringName name = vformat("property_%d", i % 10);
+		names.push_back(name);
+		values[StringName(vformat("value_%d", i))] = i * 0.5;
+		positions[vformat("position_%d", i)] = Vector3(i, -i, 0.25);
+	}
+	Array flags;
+	flags.set_typed(Variant::BOOL, StringName(), Ref<Script>());
+	flags.push_back(true);
+	flags.push_back(false);
+
+	Array root;
+	root.push_back(names);
+	root.push_back(values);
+	root.push_back(positions);
+	root.push_back(flags);
+	root.push_back(int64_t(INT64_MIN));
+
+	int regular_len;
+	CHECK(encode_variant(root, nullptr, regular_len) == OK);
+	int compact_len;
+	CHECK(encode_variant(root, nullptr, compact_len, false, 0, true) == OK);
+	CHECK(compact_len % 4 == 0);
+	CHECK_MESSAGE(compact_len < regular_len, "Compact encoding should be smaller.");
+
+	Vector<uint8_t> buffer;
+	buffer.resize(compact_len);
+	CHECK(encode_variant(root, buffer.ptrw(), compact_len, false, 0, true) == OK);
+
+	Variant variant;
+	int r_len;
+	CHECK(decode_variant(variant, buffer.ptr(), buffer.size(), &r_len) == OK);
+	CHECK(r_len == compact_len);
+	CHECK(variant == Variant(root));
+	const Array decoded = variant;
+	CHECK(Array(decoded[0]).get_typed_builtin() == Variant::STRING_NAME);
+	CHECK(Array(decoded[0])[3].get_type() == Variant::STRING_NAME);
+	CHECK(Dictionary(decoded[1]).get_typed_key_builtin() == Variant::STRING_NAME);
+	CHECK(Dictionary(decoded[2]).get_typed_value_builtin() == Variant::VECTOR3);
+
+	// Truncated input must fail cleanly.
+	ERR_PRINT_OFF;
+	CHECK(decode_variant(variant, buffer.ptr(), buffer.size() / 2, &r_len) != OK);
+	ERR_PRINT_ON;
+}
+
 } // namespace TestMarshalls
@@ -0,0 +1,134 @@
+/**************************************************************************/
+/*  test_marshalls_benchmark.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/marshalls.h"
+
+#include "tests/test_macros.h"
+
+namespace TestMarshallsBenchmark {
+
+// Elements per payload; each payload is encoded and decoded several times.
+static const int ELEMENT_COUNT = 100000;
+static const int REPEATS = 20;
+
+static Array _typed_array(Variant::Type p_type) {
+	Array array;
+	array.set_typed(p_type, StringName(), Ref<Script>());
+	return array;
+}
+
+static void _benchmark(const String &p_what, const Variant &p_payload) {
+	int legacy_len = 0;
+	int compact_len = 0;
+	REQUIRE(encode_variant(p_payload, nullptr, legacy_len) == OK);
+	REQUIRE(encode_variant(p_payload, nullptr, compact_len, false, 0, true) == OK);
+
+	Vector<uint8_t> legacy;
+	Vector<uint8_t> compact;
+	legacy.resize(legacy_len);
+	compact.resize(compact_len);
+
+	// Encoding includes the sizing pass, as `PacketPeer::put_var()` and `FileAccess::store_var()` do.
+	uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < REPEATS; i++) {
+		int len = 0;
+		encode_variant(p_payload, nullptr, len);
+		encode_variant(p_payload, legacy.ptrw(), len);
+	}
+	const uint64_t legacy_encode = OS::get_singleton()->get_ticks_usec() - begin;
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < REPEATS; i++) {
+		int len = 0;
+		encode_variant(p_payload, nullptr, len, false, 0, true);
+		encode_variant(p_payload, compact.ptrw(), len, false, 0, true);
+	}
+	const uint64_t compact_encode = OS::get_singleton()->get_ticks_usec() - begin;
+
+	Variant decoded;
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < REPEATS; i++) {
+		decode_variant(decoded, legacy.ptr(), legacy.size());
+	}
+	const uint64_t legacy_decode = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(decoded == p_payload);
+
+	begin = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < REPEATS; i++) {
+		decode_variant(decoded, compact.ptr(), compact.size());
+	}
+	const uint64_t compact_decode = OS::get_singleton()->get_ticks_usec() - begin;
+	CHECK(decoded == p_payload);
+
+	// Throughput in elements, since the two encodings don't have the same size.
+	const double elements = double(ELEMENT_COUNT) * REPEATS * 1000000.0;
+	MESSAGE(vformat("%s: %d -> %d bytes (%d%%). Encode %d -> %d k elements/s, decode %d -> %d k elements/s.",
+			p_what, legacy_len, compact_len, int64_t(compact_len * 100.0 / legacy_len),
+			int64_t(elements / MAX(legacy_encode, (uint64_t)1) / 1000), int64_t(elements / MAX(compact_encode, (uint64_t)1) / 1000),
+			int64_t(elements / MAX(legacy_decode, (uint64_t)1) / 1000), int64_t(elements / MAX(compact_decode, (uint64_t)1) / 1000)));
+}
+
+// Run with `--test --no-skip`.
+TEST_CASE("[Marshalls][Benchmark] Size and throughput of the compact encoding" * doctest::skip()) {
+	Array small_ints = _typed_array(Variant::INT);
+	Array large_ints = _typed_array(Variant::INT);
+	Array floats = _typed_array(Variant::FLOAT);
+	Array flags = _typed_array(Variant::BOOL);
+	Array strings = _typed_array(Variant::STRING);
+	Array names = _typed_array(Variant::STRING_NAME);
+	Dictionary properties;
+	properties.set_typed(Variant::STRING_NAME, StringName(), Ref<Script>(), Variant::INT, StringName(), Ref<Script>());
+	Array untyped;
+	for (int i = 0; i < ELEMENT_COUNT; i++) {
+		// Counters and IDs are mostly small, timestamps and hashes aren't.
+		small_ints.push_back(i % 200 - 100);
+		large_ints.push_back(int64_t(i) * int64_t(2654435761));
+		floats.push_back(i * 0.125);
+		flags.push_back(i % 3 == 0);
+		strings.push_back(vformat("player_%d", i));
+		// Network payloads repeat a few names many times.
+		names.push_back(StringName(vformat("action_%d", i % 16)));
+		properties[StringName(vformat("property_%d", i))] = i;
+		untyped.push_back(i % 2 ? Variant(i) : Variant(vformat("item_%d", i)));
+	}
+
+	_benchmark("Array[int], small values", small_ints);
+	_benchmark("Array[int], large values", large_ints);
+	_benchmark("Array[float]", floats);
+	_benchmark("Array[bool]", flags);
+	_benchmark("Array[String]", strings);
+	_benchmark("Array[StringName], 16 distinct names", names);
+	_benchmark("Dictionary[StringName, int]", properties);
+	_benchmark("Untyped Array, unchanged", untyped);
+}
+
+} // namespace TestMarshallsBenchmark
@@ -34,6 +34,7 @@
 #include "core/io/pck_packer.h"
 #include "core/os/os.h"
 
+#include "tests/test_macros.h"
 #include "tests/test_utils.h"
 #include "thirdparty/doctest/doctest.h"
 
@@ -116,4 +117,182 @@ TEST_CASE("[PCKPacker] Pack a PCK file with some files and directories") {
 			f->get_length() <= 27000,
 			"The generated non-empty PCK file shouldn't be too large.");
 }
+
+TEST_CASE("[PCKPacker] Deduplicated and compressed files") {
+	// Compressible, repeated contents, stored twice under different paths.
+	Vector<uint8_t> contents;
+	contents.resize(200000);
+	for (int i = 0; i < contents.size(); i++) {
+		contents.write[i] = (i / 7) % 61;
+	}
+	Vector<uint8_t> small_contents;
+	small_contents.push_back(42);
+
+	const String source_path = TestUtils::get_temp_path("pck_packer_source.bin");
+	const String small_source_path = TestUtils::get_temp_path("pck_packer_small.bin");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		f->store_buffer(contents);
+		f = FileAccess::open(small_source_path, FileAccess::WRITE);
+		f->store_buffer(small_contents);
+	}
+
+	PCKPacker pck_packer;
+	pck_packer.set_compression_enabled(true);
+	const String output_pck_path = TestUtils::get_temp_path("output_deduplicated.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_test/en/data.bin", source_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_test/fr/data.bin", source_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_test/small.bin", small_source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	CHECK_MESSAGE(
+			FileAccess::get_file_as_bytes(output_pck_path).size() < contents.size() / 4,
+			"Both copies should share a single compressed blob.");
+
+	PackedData *packed_data = PackedData::get_singleton();
+	REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+
+	for (const String path : { "pck_packer_test/en/data.bin", "pck_packer_test/fr/data.bin" }) {
+		CHECK(packed_data->get_size(path) == contents.size());
+		Ref<FileAccess> f = packed_data->try_open_path(path);
+		REQUIRE(f.is_valid());
+		CHECK(f->get_length() == (uint64_t)contents.size());
+		CHECK(f->get_buffer(contents.size()) == contents);
+
+		// Random access into the compressed file.
+		f->seek(123456);
+		CHECK(f->get_8() == contents[123456]);
+	}
+
+	// Too small to gain anything from compression, stored as is.
+	Ref<FileAccess> f = packed_data->try_open_path("pck_packer_test/small.bin");
+	REQUIRE(f.is_valid());
+	CHECK(f->get_buffer(16) == small_contents);
+
+	packed_data->remove_path("pck_packer_test/en/data.bin");
+	packed_data->remove_path("pck_packer_test/fr/data.bin");
+	packed_data->remove_path("pck_packer_test/small.bin");
+}
+
+TEST_CASE("[PCKPacker] Delta patches") {
+	// Three versions of a file, each one changing a few bytes of the previous one.
+	Vector<Vector<uint8_t>> versions;
+	Vector<String> version_paths;
+	Vector<uint8_t> contents;
+	contents.resize(100000);
+	for (int i = 0; i < contents.size(); i++) {
+		contents.write[i] = (i * 2654435761u) >> 24;
+	}
+	for (int v = 0; v < 3; v++) {
+		if (v > 0) {
+			contents.write[v * 1000] ^= 0xFF;
+			contents.push_back(v);
+		}
+		versions.push_back(contents);
+		version_paths.push_back(TestUtils::get_temp_path(vformat("pck_packer_delta_v%d.bin", v)));
+		Ref<FileAccess> f = FileAccess::open(version_paths[v], FileAccess::WRITE);
+		f->store_buffer(contents);
+	}
+
+	const String target_path = "pck_packer_test/delta.bin";
+	PackedData *packed_data = PackedData::get_singleton();
+	for (int v = 0; v < 3; v++) {
+		PCKPacker pck_packer;
+		const String output_pck_path = TestUtils::get_temp_path(vformat("output_delta_v%d.pck", v));
+		REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+		if (v == 0) {
+			CHECK(pck_packer.add_file(target_path, version_paths[v]) == OK);
+		} else {
+			CHECK(pck_packer.add_file_delta(target_path, version_paths[v], version_paths[v - 1]) == OK);
+		}
+		REQUIRE(pck_packer.flush() == OK);
+
+		if (v > 0) {
+			CHECK_MESSAGE(
+					FileAccess::get_file_as_bytes(output_pck_path).size() < versions[v].size() / 10,
+					"The patch should only hold the changes.");
+		}
+
+		REQUIRE(packed_data->add_pack(output_pck_path, true, 0) == OK);
+
+		// Rebuilt on the first read, then served from the cache.
+		for (int read = 0; read < 2; read++) {
+			Ref<FileAccess> f = packed_data->try_open_path(target_path);
+			REQUIRE(f.is_valid());
+			CHECK(f->get_length() == (uint64_t)versions[v].size());
+			CHECK(f->get_buffer(f->get_length()) == versions[v]);
+		}
+	}
+
+	packed_data->remove_path(target_path);
+}
+
+TEST_CASE("[PCKPacker] Packs with a corrupted directory aren't mounted") {
+	const String source_path = TestUtils::get_temp_path("pck_packer_corrupted_source.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		f->store_string("Corrupted pack test.");
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_corrupted.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_test/corrupted/a.txt", source_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_test/corrupted/b.txt", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		// Point the path of the last entry past the string table.
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		f->seek(32); // Directory offset, after the magic, versions, flags and files base.
+		const uint64_t dir_offset = f->get_64();
+		f->seek(dir_offset + 8 + PACK_INDEX_ENTRY_SIZE + 48);
+		f->store_32(UINT32_MAX);
+	}
+
+	PackedData *packed_data = PackedData::get_singleton();
+	ERR_PRINT_OFF;
+	CHECK(packed_data->add_pack(output_pck_path, true, 0) != OK);
+	ERR_PRINT_ON;
+
+	CHECK_MESSAGE(
+			!packed_data->has_path("res://pck_packer_test/corrupted/a.txt"),
+			"No entry of a rejected pack should be added, even those before the corrupted one.");
+}
+
+TEST_CASE("[PCKPacker] Packs with files out of their bounds aren't mounted") {
+	const String source_path = TestUtils::get_temp_path("pck_packer_out_of_bounds_source.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(source_path, FileAccess::WRITE);
+		f->store_string("Out of bounds pack test.");
+	}
+
+	PCKPacker pck_packer;
+	const String output_pck_path = TestUtils::get_temp_path("output_out_of_bounds.pck");
+	REQUIRE(pck_packer.pck_start(output_pck_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_test/out_of_bounds/a.txt", source_path) == OK);
+	CHECK(pck_packer.add_file("pck_packer_test/out_of_bounds/b.txt", source_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+
+	{
+		// Point the data of the last entry past the end of the pack.
+		Ref<FileAccess> f = FileAccess::open(output_pck_path, FileAccess::READ_WRITE);
+		REQUIRE(f.is_valid());
+		f->seek(32); // Directory offset, after the magic, versions, flags and files base.
+		const uint64_t dir_offset = f->get_64();
+		f->seek(dir_offset + 8 + PACK_INDEX_ENTRY_SIZE);
+		f->store_64(UINT64_MAX - 16);
+	}
+
+	PackedData *packed_data = PackedData::get_singleton();
+	ERR_PRINT_OFF;
+	CHECK(packed_data->add_pack(output_pck_path, true, 0) != OK);
+	ERR_PRINT_ON;
+
+	CHECK_MESSAGE(
+			!packed_data->has_path("res://pck_packer_test/out_of_bounds/a.txt"),
+			"No entry of a rejected pack should be added, even those before the out of bounds one.");
+}
 } // namespace TestPCKPacker
@@ -30,6 +30,7 @@
 
 #pragma once
 
+#include "core/config/project_settings.h"
 #include "core/io/resource.h"
 #include "core/io/resource_loader.h"
 #include "core/io/resource_saver.h"
@@ -573,6 +574,108 @@ TEST_CASE("[Resource] Saving and loading") {
 			"The loaded child resource name should be equal to the expected value.");
 }
 
+TEST_CASE("[Resource] Saving and loading packed arrays in binary format") {
+	PackedByteArray bytes;
+	PackedInt32Array ints;
+	PackedInt64Array longs;
+	PackedFloat32Array floats;
+	PackedFloat64Array doubles;
+	PackedVector2Array vec2s;
+	PackedVector3Array vec3s;
+	PackedColorArray colors;
+	PackedVector4Array vec4s;
+	// Odd sizes so the byte array needs padding.
+	for (int i = 0; i < 1001; i++) {
+		bytes.push_back(i * 7);
+		ints.push_back(i - 500);
+		longs.push_back(int64_t(i) << 33);
+		floats.push_back(i * 0.5f);
+		doubles.push_back(i * 0.25);
+		vec2s.push_back(Vector2(i, -i));
+		vec3s.push_back(Vector3(i, i + 1, i + 2));
+		colors.push_back(Color(i / 1000.0, 0.5, 0.25, 1.0));
+		vec4s.push_back(Vector4(i, 2 * i, 3 * i, 4 * i));
+	}
+
+	Ref<Resource> resource = memnew(Resource);
+	resource->set_meta("bytes", bytes);
+	resource->set_meta("ints", ints);
+	resource->set_meta("longs", longs);
+	resource->set_meta("floats", floats);
+	resource->set_meta("doubles", doubles);
+	resource->set_meta("vec2s", vec2s);
+	resource->set_meta("vec3s", vec3s);
+	resource->set_meta("colors", colors);
+	resource->set_meta("vec4s", vec4s);
+	resource->set_meta("empty", PackedFloat32Array());
+
+	const String save_path_binary = TestUtils::get_temp_path("packed_arrays.res");
+	REQUIRE(ResourceSaver::save(resource, save_path_binary) == OK);
+
+	const Ref<Resource> loaded = ResourceLoader::load(save_path_binary, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	REQUIRE(loaded.is_valid());
+	CHECK(PackedByteArray(loaded->get_meta("bytes")) == bytes);
+	CHECK(PackedInt32Array(loaded->get_meta("ints")) == ints);
+	CHECK(PackedInt64Array(loaded->get_meta("longs")) == longs);
+	CHECK(PackedFloat32Array(loaded->get_meta("floats")) == floats);
+	CHECK(PackedFloat64Array(loaded->get_meta("doubles")) == doubles);
+	CHECK(PackedVector2Array(loaded->get_meta("vec2s")) == vec2s);
+	CHECK(PackedVector3Array(loaded->get_meta("vec3s")) == vec3s);
+	CHECK(PackedColorArray(loaded->get_meta("colors")) == colors);
+	CHECK(PackedVector4Array(loaded->get_meta("vec4s")) == vec4s);
+	CHECK(PackedFloat32Array(loaded->get_meta("empty")).is_empty());
+}
+
+TEST_CASE("[Resource] Threaded loading with dependency graph prefetch") {
+	const String path_a = TestUtils::get_temp_path("graph_a.tres");
+	const String path_b = TestUtils::get_temp_path("graph_b.res");
+	const String path_c = TestUtils::get_temp_path("graph_c.tres");
+	const String path_d = TestUtils::get_temp_path("graph_d.res");
+	{
+		// A -> B -> D, A -> C -> D, saved to separate files so they're external dependencies.
+		Ref<Resource> d = memnew(Resource);
+		d->set_name("D");
+		REQUIRE(ResourceSaver::save(d, path_d) == OK);
+		d->set_path(path_d);
+		Ref<Resource> b = memnew(Resource);
+		b->set_name("B");
+		b->set_meta("next", d);
+		REQUIRE(ResourceSaver::save(b, path_b) == OK);
+		b->set_path(path_b);
+		Ref<Resource> c = memnew(Resource);
+		c->set_name("C");
+		c->set_meta("next", d);
+		REQUIRE(ResourceSaver::save(c, path_c) == OK);
+		c->set_path(path_c);
+		Ref<Resource> a = memnew(Resource);
+		a->set_name("A");
+		a->set_meta("b", b);
+		a->set_meta("c", c);
+		REQUIRE(ResourceSaver::save(a, path_a) == OK);
+	}
+	// Nothing is cached anymore, so every dependency goes through the prefetch.
+	REQUIRE_FALSE(ResourceCache::has(path_d));
+
+	ProjectSettings::get_singleton()->set_setting("threading/resource_loader/prefetch_dependency_graph", true);
+	REQUIRE(ResourceLoader::load_threaded_request(path_a, "", true) == OK);
+	const Ref<Resource> a = ResourceLoader::load_threaded_get(path_a);
+	ProjectSettings::get_singleton()->set_setting("threading/resource_loader/prefetch_dependency_graph", false);
+
+	REQUIRE(a.is_valid());
+	CHECK(a->get_name() == "A");
+	const Ref<Resource> b = a->get_meta("b");
+	const Ref<Resource> c = a->get_meta("c");
+	REQUIRE(b.is_valid());
+	REQUIRE(c.is_valid());
+	CHECK(b->get_name() == "B");
+	CHECK(c->get_name() == "C");
+	const Ref<Resource> d_from_b = b->get_meta("next");
+	const Ref<Resource> d_from_c = c->get_meta("next");
+	REQUIRE(d_from_b.is_valid());
+	CHECK(d_from_b->get_name() == "D");
+	CHECK_MESSAGE(d_from_b == d_from_c, "The shared dependency should be loaded only once.");
+}
+
 TEST_CASE("[Resource] Breaking circular references on save") {
 	Ref<Resource> resource_a = memnew(Resource);
 	resource_a->set_name("A");
@@ -0,0 +1,106 @@
+/**************************************************************************/
+/*  test_resource_format_binary_benchmark.h                               */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/file_access_pack.h"
+#include "core/io/pck_packer.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestResourceFormatBinaryBenchmark {
+
+// A scene-sized amount of mesh and texture data, split in arrays like real resources are.
+static const uint64_t DATA_SIZE = 2ull << 30;
+static const uint32_t ARRAY_COUNT = 64;
+
+static void _load_and_report(const String &p_what, const String &p_path) {
+	TestUtils::reset_peak_rss();
+	const uint64_t rss_before = TestUtils::get_peak_rss_kib();
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+
+	Ref<Resource> loaded = ResourceLoader::load(p_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+
+	const uint64_t total = OS::get_singleton()->get_ticks_usec() - begin;
+	const uint64_t rss_peak = TestUtils::get_peak_rss_kib();
+	REQUIRE(loaded.is_valid());
+	CHECK(PackedByteArray(loaded->get_meta("array_0")).size() == int64_t(DATA_SIZE / ARRAY_COUNT));
+
+	MESSAGE(vformat("%s: %d ms, %d MiB/s, peak RSS growth %s.", p_what, total / 1000,
+			int64_t(DATA_SIZE * 1000000.0 / MAX(total, (uint64_t)1) / (1 << 20)),
+			rss_peak ? vformat("%d MiB", (rss_peak - MIN(rss_before, rss_peak)) / 1024) : String("not measured")));
+}
+
+// Run with `--test --no-skip`, it needs about 6 GB of free disk space and 4 GB of memory.
+TEST_CASE("[ResourceFormatBinary][Benchmark] Loading large packed arrays" * doctest::skip()) {
+	const String res_path = TestUtils::get_temp_path("benchmark_large.res");
+	const String pck_path = TestUtils::get_temp_path("benchmark_large.pck");
+	{
+		// Half bytes (textures), half floats (meshes).
+		Ref<Resource> resource = memnew(Resource);
+		const uint64_t array_size = DATA_SIZE / ARRAY_COUNT;
+		for (uint32_t i = 0; i < ARRAY_COUNT; i++) {
+			if (i % 2 == 0) {
+				PackedByteArray bytes;
+				bytes.resize(array_size);
+				memset(bytes.ptrw(), i, array_size);
+				resource->set_meta(vformat("array_%d", i), bytes);
+			} else {
+				PackedFloat32Array floats;
+				floats.resize(array_size / sizeof(float));
+				float *ptr = floats.ptrw();
+				for (int64_t j = 0; j < floats.size(); j++) {
+					ptr[j] = j * 0.5f;
+				}
+				resource->set_meta(vformat("array_%d", i), floats);
+			}
+		}
+		REQUIRE(ResourceSaver::save(resource, res_path) == OK);
+	}
+
+	PCKPacker pck_packer;
+	REQUIRE(pck_packer.pck_start(pck_path) == OK);
+	REQUIRE(pck_packer.add_file("benchmark/large.res", res_path) == OK);
+	REQUIRE(pck_packer.flush() == OK);
+	REQUIRE(PackedData::get_singleton()->add_pack(pck_path, true, 0) == OK);
+
+	// Both are in the page cache after writing them, so this measures the copies rather than the disk.
+	_load_and_report("Regular file", res_path);
+	_load_and_report("Mapped pack", "res://benchmark/large.res");
+
+	DirAccess::remove_file_or_error(res_path);
+}
+
+} // namespace TestResourceFormatBinaryBenchmark
@@ -0,0 +1,169 @@
+/**************************************************************************/
+/*  test_bulk_math.h                                                      */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/bulk_math.h"
+#include "core/math/random_pcg.h"
+#include "core/variant/variant.h"
+
+#include "tests/test_macros.h"
+
+namespace TestBulkMath {
+
+// Sizes around the SIMD widths, so both the vector and scalar loops run.
+static const int64_t test_sizes[] = { 0, 1, 3, 4, 5, 7, 8, 9, 17, 1001 };
+
+static PackedFloat32Array random_floats(RandomPCG &p_rng, int64_t p_size) {
+	PackedFloat32Array array;
+	for (int64_t i = 0; i < p_size; i++) {
+		array.push_back(p_rng.random(-100.0f, 100.0f));
+	}
+	return array;
+}
+
+static PackedVector3Array random_vectors(RandomPCG &p_rng, int64_t p_size) {
+	PackedVector3Array array;
+	for (int64_t i = 0; i < p_size; i++) {
+		array.push_back(Vector3(p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f), p_rng.random(-100.0f, 100.0f)));
+	}
+	return array;
+}
+
+TEST_CASE("[BulkMath] Reductions") {
+	RandomPCG rng(5);
+	for (int64_t size : test_sizes) {
+		const PackedFloat32Array array = random_floats(rng, size);
+		double sum = 0.0;
+		float min = size > 0 ? array[0] : 0.0f;
+		float max = min;
+		for (float value : array) {
+			sum += value;
+			min = MIN(min, value);
+			max = MAX(max, value);
+		}
+		CHECK_MESSAGE(BulkMath::sum(array.ptr(), size) == doctest::Approx(sum), "Size ", size);
+		CHECK_MESSAGE(BulkMath::min(array.ptr(), size) == min, "Size ", size);
+		CHECK_MESSAGE(BulkMath::max(array.ptr(), size) == max, "Size ", size);
+	}
+}
+
+TEST_CASE("[BulkMath] Element-wise float operations") {
+	RandomPCG rng(6);
+	for (int64_t size : test_sizes) {
+		const PackedFloat32Array a = random_floats(rng, size);
+		const PackedFloat32Array b = random_floats(rng, size);
+
+		PackedFloat32Array added = a;
+		BulkMath::add(added.ptrw(), b.ptr(), size);
+		PackedFloat32Array scaled = a;
+		BulkMath::mul_scalar(scaled.ptrw(), 0.5f, size);
+		PackedFloat32Array fma = a;
+		BulkMath::fma(fma.ptrw(), 3.0f, -2.0f, size);
+		PackedFloat32Array lerped = a;
+		BulkMath::lerp(lerped.ptrw(), b.ptr(), 0.25f, size);
+
+		bool ok = true;
+		for (int64_t i = 0; i < size; i++) {
+			ok = ok && added[i] == a[i] + b[i];
+			ok = ok && scaled[i] == a[i] * 0.5f;
+			ok = ok && Math::is_equal_approx(fma[i], a[i] * 3.0f - 2.0f);
+			ok = ok && Math::is_equal_approx(lerped[i], Math::lerp(a[i], b[i], 0.25f));
+		}
+		CHECK_MESSAGE(ok, "Size ", size);
+	}
+}
+
+TEST_CASE("[BulkMath] Vector3 operations") {
+	RandomPCG rng(7);
+	const Transform3D transform(Basis(Vector3(0, 1, 0), 0.5).scaled(Vector3(1, 2, 3)), Vector3(4, -5, 6));
+	for (int64_t size : test_sizes) {
+		const PackedVector3Array a = random_vectors(rng, size);
+		const PackedVector3Array b = random_vectors(rng, size);
+
+		PackedVector3Array transformed = a;
+		BulkMath::vector3_transform(transformed.ptrw(), transform, size);
+		PackedVector3Array added = a;
+		BulkMath::vector3_add(added.ptrw(), b.ptr(), size);
+		PackedVector3Array scaled = a;
+		BulkMath::vector3_mul_scalar(scaled.ptrw(), 2.0, size);
+		PackedVector3Array lerped = a;
+		BulkMath::vector3_lerp(lerped.ptrw(), b.ptr(), 0.75, size);
+		Vector<float> dots;
+		dots.resize(size);
+		BulkMath::vector3_dot(dots.ptrw(), a.ptr(), b.ptr(), size);
+		Vector<float> lengths;
+		lengths.resize(size);
+		BulkMath::vector3_length_squared(lengths.ptrw(), a.ptr(), size);
+
+		bool ok = true;
+		for (int64_t i = 0; i < size; i++) {
+			ok = ok && transformed[i].is_equal_approx(transform.xform(a[i]));
+			ok = ok && added[i] == a[i] + b[i];
+			ok = ok && scaled[i] == a[i] * 2.0;
+			ok = ok && lerped[i].is_equal_approx(a[i].lerp(b[i], 0.75));
+			ok = ok && Math::is_equal_approx(dots[i], (float)a[i].dot(b[i]));
+			ok = ok && Math::is_equal_approx(lengths[i], (float)a[i].length_squared());
+		}
+		CHECK_MESSAGE(ok, "Size ", size);
+	}
+}
+
+TEST_CASE("[BulkMath] Packed array bindings") {
+	PackedFloat32Array floats = { 4.0f, -1.0f, 2.5f, 8.0f, 0.5f };
+	Variant floats_variant = floats;
+	CHECK(double(floats_variant.call("sum")) == doctest::Approx(14.0));
+	CHECK(double(floats_variant.call("min")) == -1.0);
+	CHECK(double(floats_variant.call("max")) == 8.0);
+	floats_variant.call("fma", 2.0, 1.0);
+	CHECK(PackedFloat32Array(floats_variant) == PackedFloat32Array({ 9.0f, -1.0f, 6.0f, 17.0f, 2.0f }));
+	CHECK(double(Variant(PackedFloat32Array()).call("min")) == 0.0);
+
+	PackedVector3Array vectors = { Vector3(1, 2, 3), Vector3(-1, 0, 2) };
+	const PackedVector3Array others = { Vector3(1, 1, 1), Vector3(3, 2, 1) };
+	Variant vectors_variant = vectors;
+	CHECK(PackedFloat32Array(vectors_variant.call("dot", others)) == PackedFloat32Array({ 6.0f, -1.0f }));
+	CHECK(PackedFloat32Array(vectors_variant.call("length_squared")) == PackedFloat32Array({ 14.0f, 5.0f }));
+	vectors_variant.call("add", others);
+	CHECK(PackedVector3Array(vectors_variant) == PackedVector3Array({ Vector3(2, 3, 4), Vector3(2, 2, 3) }));
+	vectors_variant.call("mul_scalar", 2.0);
+	CHECK(PackedVector3Array(vectors_variant) == PackedVector3Array({ Vector3(4, 6, 8), Vector3(4, 4, 6) }));
+	vectors_variant.call("lerp_to", others, 0.5);
+	CHECK(PackedVector3Array(vectors_variant) == PackedVector3Array({ Vector3(2.5, 3.5, 4.5), Vector3(3.5, 3, 3.5) }));
+	vectors_variant.call("transform_by", Transform3D(Basis(), Vector3(1, 0, 0)));
+	CHECK(PackedVector3Array(vectors_variant) == PackedVector3Array({ Vector3(3.5, 3.5, 4.5), Vector3(4.5, 3, 3.5) }));
+
+	ERR_PRINT_OFF;
+	vectors_variant.call("add", PackedVector3Array());
+	ERR_PRINT_ON;
+	CHECK_MESSAGE(PackedVector3Array(vectors_variant).size() == 2, "Mismatched sizes should leave the array unchanged.");
+}
+
+} // namespace TestBulkMath
@@ -0,0 +1,277 @@
+/**************************************************************************/
+/*  test_message_queue.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/class_db.h"
+#include "core/object/message_queue.h"
+#include "core/os/thread.h"
+
+#include "tests/test_macros.h"
+
+// Declared in global namespace because of GDCLASS macro warning (Windows):
+// "Unqualified friend declaration referring to type outside of the nearest enclosing namespace
+// is a Microsoft extension; add a nested name specifier".
+class _TestMessageQueueObject : public Object {
+	GDCLASS(_TestMessageQueueObject, Object);
+
+	int value = 0;
+
+protected:
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &_TestMessageQueueObject::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &_TestMessageQueueObject::get_value);
+		ClassDB::bind_method(D_METHOD("add", "amount", "scale"), &_TestMessageQueueObject::add);
+		ClassDB::bind_method(D_METHOD("append_name", "name"), &_TestMessageQueueObject::append_name);
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+	}
+
+public:
+	int set_count = 0;
+	LocalVector<String> log;
+
+	void set_value(int p_value) {
+		value = p_value;
+		set_count++;
+		log.push_back("set " + itos(p_value));
+	}
+	int get_value() const { return value; }
+
+	int add(int p_amount, double p_scale) {
+		value += int(p_amount * p_scale);
+		log.push_back("add " + itos(p_amount));
+		return value;
+	}
+
+	void append_name(const StringName &p_name) {
+		log.push_back(p_name);
+	}
+
+#ifdef THREADS_ENABLED
+	static void _append_name_from_thread(void *p_object) {
+		MessageQueue::get_singleton()->push_call((Object *)p_object, "append_name", StringName("thread"));
+	}
+
+	// Pushes from another thread while the main queue is being flushed.
+	void append_name_from_thread() {
+		Thread thread;
+		thread.start(_append_name_from_thread, this);
+		thread.wait_to_finish();
+	}
+#endif
+};
+
+namespace TestMessageQueue {
+
+TEST_CASE("[MessageQueue] Calls to native methods") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	CallQueue queue;
+	_TestMessageQueueObject object;
+
+	CHECK(queue.push_call(&object, "add", 2, 1.5) == OK);
+	// A String must be converted to the StringName argument.
+	CHECK(queue.push_call(&object, "append_name", "converted") == OK);
+	CHECK(queue.push_call(&object, "append_name", StringName("direct")) == OK);
+	// Default values and wrong types are handled by the regular call.
+	ERR_PRINT_OFF;
+	CHECK(queue.push_callp(object.get_instance_id(), "add", nullptr, 0, true) == OK);
+	ERR_PRINT_ON;
+	CHECK(queue.has_messages());
+	CHECK(object.log.is_empty());
+
+	ERR_PRINT_OFF;
+	CHECK(queue.flush() == OK);
+	ERR_PRINT_ON;
+	CHECK_FALSE(queue.has_messages());
+	REQUIRE(object.log.size() == 3);
+	CHECK(object.log[0] == "add 2");
+	CHECK(object.log[1] == "converted");
+	CHECK(object.log[2] == "direct");
+	CHECK(object.get_value() == 3);
+}
+
+TEST_CASE("[MessageQueue] Calls to freed objects are skipped") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	CallQueue queue;
+	_TestMessageQueueObject *object = memnew(_TestMessageQueueObject);
+
+	queue.push_call(object, "add", 1, 1.0);
+	queue.push_set(object, "value", 5);
+	memdelete(object);
+
+	CHECK(queue.flush() == OK);
+	CHECK_FALSE(queue.has_messages());
+}
+
+TEST_CASE("[MessageQueue] Repeated deferred sets are coalesced") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	CallQueue queue;
+	_TestMessageQueueObject object;
+	_TestMessageQueueObject other;
+
+	SUBCASE("Same property") {
+		queue.push_set(&object, "value", 1);
+		queue.push_set(&object, "value", 2);
+		queue.push_set(&object, "value", 3);
+		queue.flush();
+
+		CHECK(object.set_count == 1);
+		CHECK(object.get_value() == 3);
+	}
+
+	SUBCASE("Messages for other objects in between keep the earlier value") {
+		queue.push_set(&object, "value", 1);
+		queue.push_set(&other, "value", 10);
+		queue.push_set(&object, "value", 2);
+		queue.push_set(&object, "value", 3);
+		queue.flush();
+
+		REQUIRE(object.log.size() == 2);
+		CHECK(object.log[0] == "set 1");
+		CHECK(object.log[1] == "set 3");
+		CHECK(other.get_value() == 10);
+	}
+
+	SUBCASE("Calls in between keep the order") {
+		queue.push_set(&object, "value", 1);
+		queue.push_call(&object, "add", 1, 1.0);
+		queue.push_set(&object, "value", 5);
+		queue.flush();
+
+		REQUIRE(object.log.size() == 3);
+		CHECK(object.log[0] == "set 1");
+		CHECK(object.log[1] == "add 1");
+		CHECK(object.log[2] == "set 5");
+	}
+
+	SUBCASE("Sets pushed after a flush aren't merged with flushed ones") {
+		queue.push_set(&object, "value", 1);
+		queue.flush();
+		queue.push_set(&object, "value", 2);
+		queue.flush();
+
+		CHECK(object.set_count == 2);
+		CHECK(object.get_value() == 2);
+	}
+}
+
+#ifdef THREADS_ENABLED
+static constexpr int CALLS_PER_THREAD = 100;
+
+static void push_from_thread(void *p_object) {
+	for (int i = 0; i < CALLS_PER_THREAD; i++) {
+		MessageQueue::get_singleton()->push_call((Object *)p_object, "add", 1, 1.0);
+	}
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from other threads run on the main thread") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	CallQueue *main_queue = MessageQueue::get_main_singleton();
+	REQUIRE(main_queue);
+	main_queue->flush();
+	MessageQueue::update_frame_stats();
+
+	_TestMessageQueueObject object;
+
+	static constexpr int THREAD_COUNT = 4;
+	Thread threads[THREAD_COUNT];
+	for (Thread &thread : threads) {
+		thread.start(push_from_thread, &object);
+	}
+	for (Thread &thread : threads) {
+		thread.wait_to_finish();
+	}
+
+	CHECK(main_queue->has_messages());
+	CHECK(object.get_value() == 0);
+
+	main_queue->push_call(&object, "add", 1, 1.0);
+	main_queue->flush();
+	MessageQueue::update_frame_stats();
+
+	CHECK_FALSE(main_queue->has_messages());
+	CHECK(object.get_value() == THREAD_COUNT * CALLS_PER_THREAD + 1);
+	CHECK(MessageQueue::get_frame_flush_stats().calls == THREAD_COUNT * CALLS_PER_THREAD + 1);
+}
+
+TEST_CASE("[MessageQueue] Calls pushed from other threads keep the push order") {
+	GDREGISTER_CLASS(_TestMessageQueueObject);
+	CallQueue *main_queue = MessageQueue::get_main_singleton();
+	REQUIRE(main_queue);
+	main_queue->flush();
+
+	_TestMessageQueueObject object;
+
+	SUBCASE("Pushed before the main thread") {
+		object.append_name_from_thread();
+		main_queue->push_call(&object, "append_name", StringName("main"));
+		main_queue->flush();
+
+		REQUIRE(object.log.size() == 2);
+		CHECK(object.log[0] == "thread");
+		CHECK(object.log[1] == "main");
+	}
+
+	SUBCASE("Pushed after the main thread") {
+		main_queue->push_call(&object, "append_name", StringName("main"));
+		object.append_name_from_thread();
+		main_queue->flush();
+
+		REQUIRE(object.log.size() == 2);
+		CHECK(object.log[0] == "main");
+		CHECK(object.log[1] == "thread");
+	}
+
+	SUBCASE("Sets aren't merged across messages from other threads") {
+		main_queue->push_set(&object, "value", 1);
+		object.append_name_from_thread();
+		main_queue->push_set(&object, "value", 2);
+		main_queue->flush();
+
+		REQUIRE(object.log.size() == 3);
+		CHECK(object.log[0] == "set 1");
+		CHECK(object.log[1] == "thread");
+		CHECK(object.log[2] == "set 2");
+	}
+
+	SUBCASE("Pushed while flushing") {
+		main_queue->push_callable(callable_mp(&object, &_TestMessageQueueObject::append_name_from_thread));
+		main_queue->push_call(&object, "append_name", StringName("main"));
+		main_queue->flush();
+
+		CHECK_FALSE(main_queue->has_messages());
+		REQUIRE(object.log.size() == 2);
+		CHECK(object.log[0] == "main");
+		CHECK(object.log[1] == "thread");
+	}
+}
+#endif // THREADS_ENABLED
+
+} // namespace TestMessageQueue
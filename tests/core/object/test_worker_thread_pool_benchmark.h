@@ -0,0 +1,130 @@
+/**************************************************************************/
+/*  test_worker_thread_pool_benchmark.h                                   */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkerThreadPoolBenchmark {
+
+// Small enough to keep the test suite fast, big enough for the queues to matter.
+static const uint32_t TASK_COUNT = 20000;
+static const uint32_t NESTED_PARENTS = 64;
+
+struct Run {
+	WorkerThreadPool *pool = nullptr;
+	LocalVector<uint64_t> posted_usec;
+	LocalVector<uint64_t> started_usec;
+	SafeNumeric<uint32_t> done;
+};
+
+static Run run;
+
+static void _task(void *p_index) {
+	uint32_t index = (uint32_t)(uintptr_t)p_index;
+	run.started_usec[index] = OS::get_singleton()->get_ticks_usec();
+	run.done.increment();
+}
+
+static void _post_and_wait(uint32_t p_from, uint32_t p_to) {
+	LocalVector<WorkerThreadPool::TaskID> ids;
+	ids.resize(p_to - p_from);
+	for (uint32_t i = p_from; i < p_to; i++) {
+		run.posted_usec[i] = OS::get_singleton()->get_ticks_usec();
+		ids[i - p_from] = run.pool->add_native_task(_task, (void *)(uintptr_t)i, true);
+	}
+	for (WorkerThreadPool::TaskID id : ids) {
+		run.pool->wait_for_task_completion(id);
+	}
+}
+
+static void _parent_task(void *p_index) {
+	uint32_t index = (uint32_t)(uintptr_t)p_index;
+	uint32_t per_parent = TASK_COUNT / NESTED_PARENTS;
+	_post_and_wait(index * per_parent, (index + 1) * per_parent);
+}
+
+static void _report(const String &p_what, int p_threads, uint64_t p_total_usec) {
+	LocalVector<uint64_t> latencies;
+	latencies.resize(TASK_COUNT);
+	for (uint32_t i = 0; i < TASK_COUNT; i++) {
+		latencies[i] = run.started_usec[i] - run.posted_usec[i];
+	}
+	latencies.sort();
+
+	double tasks_per_second = TASK_COUNT * 1000000.0 / MAX(p_total_usec, (uint64_t)1);
+	MESSAGE(vformat("%s, %d threads: %d tasks/s, queue latency p50 %d us, p99 %d us, max %d us.",
+			p_what, p_threads, (int64_t)tasks_per_second,
+			latencies[TASK_COUNT / 2], latencies[TASK_COUNT * 99 / 100], latencies[TASK_COUNT - 1]));
+}
+
+// Run with `--test --no-skip`.
+TEST_CASE("[WorkerThreadPool][Benchmark] Throughput and latency of tiny tasks" * doctest::skip()) {
+	const int thread_counts[] = { 1, 8, 32 };
+	for (int thread_count : thread_counts) {
+		WorkerThreadPool pool(false);
+		pool.init(thread_count);
+		run.pool = &pool;
+		run.posted_usec.resize(TASK_COUNT);
+		run.started_usec.resize(TASK_COUNT);
+
+		// Posted from outside the pool, as the main thread does.
+		run.done.set(0);
+		uint64_t begin = OS::get_singleton()->get_ticks_usec();
+		_post_and_wait(0, TASK_COUNT);
+		uint64_t total = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(run.done.get() == TASK_COUNT);
+		_report("Posted from outside", thread_count, total);
+
+		// Posted from tasks, which wait for them, as nested jobs do.
+		run.done.set(0);
+		begin = OS::get_singleton()->get_ticks_usec();
+		LocalVector<WorkerThreadPool::TaskID> parents;
+		parents.resize(NESTED_PARENTS);
+		for (uint32_t i = 0; i < NESTED_PARENTS; i++) {
+			parents[i] = pool.add_native_task(_parent_task, (void *)(uintptr_t)i, true);
+		}
+		for (WorkerThreadPool::TaskID id : parents) {
+			pool.wait_for_task_completion(id);
+		}
+		total = OS::get_singleton()->get_ticks_usec() - begin;
+		CHECK(run.done.get() == TASK_COUNT);
+		_report("Posted from tasks", thread_count, total);
+
+		pool.finish();
+		run.pool = nullptr;
+	}
+	run.posted_usec.clear();
+	run.started_usec.clear();
+}
+
+} // namespace TestWorkerThreadPoolBenchmark
@@ -0,0 +1,129 @@
+/**************************************************************************/
+/*  test_frame_arena.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/frame_arena.h"
+
+#include "tests/test_macros.h"
+
+namespace TestFrameArena {
+
+TEST_CASE("[FrameArena] Scoped allocations are rewound when the scope exits") {
+	uint8_t *first = nullptr;
+	{
+		FrameArena::Scope scope;
+		first = (uint8_t *)FrameArena::alloc(64);
+		CHECK(first != nullptr);
+		CHECK(((uintptr_t)first % Memory::MAX_ALIGN) == 0);
+		memset(first, 0xAB, 64);
+
+		uint8_t *second = (uint8_t *)FrameArena::alloc(128);
+		CHECK(second >= first + 64);
+		CHECK(((uintptr_t)second % Memory::MAX_ALIGN) == 0);
+	}
+	{
+		FrameArena::Scope scope;
+		// The same memory is handed out again.
+		uint8_t *again = (uint8_t *)FrameArena::alloc(64);
+		CHECK(again == first);
+	}
+}
+
+TEST_CASE("[FrameArena] Nested scopes only rewind their own allocations") {
+	FrameArena::Scope outer;
+	uint32_t *outer_data = (uint32_t *)FrameArena::alloc(sizeof(uint32_t) * 4);
+	for (uint32_t i = 0; i < 4; i++) {
+		outer_data[i] = i;
+	}
+	uint8_t *inner_ptr = nullptr;
+	{
+		FrameArena::Scope inner;
+		inner_ptr = (uint8_t *)FrameArena::alloc(256);
+		memset(inner_ptr, 0, 256);
+	}
+	uint8_t *after = (uint8_t *)FrameArena::alloc(16);
+	CHECK(after == inner_ptr);
+	CHECK(outer_data[3] == 3);
+}
+
+TEST_CASE("[FrameArena] Realloc grows the last allocation in place and preserves contents") {
+	FrameArena::Scope scope;
+	uint8_t *data = (uint8_t *)FrameArena::alloc(16);
+	for (int i = 0; i < 16; i++) {
+		data[i] = i;
+	}
+	uint8_t *grown = (uint8_t *)FrameArena::realloc(data, 1024);
+	CHECK(grown == data);
+
+	// No longer on top, so it must move.
+	FrameArena::alloc(8);
+	uint8_t *moved = (uint8_t *)FrameArena::realloc(grown, 4096);
+	CHECK(moved != grown);
+	bool preserved = true;
+	for (int i = 0; i < 16; i++) {
+		preserved &= moved[i] == i;
+	}
+	CHECK(preserved);
+}
+
+TEST_CASE("[FrameArena] Allocations larger than a chunk are supported") {
+	FrameArena::Scope scope;
+	const size_t size = 1024 * 1024;
+	uint8_t *big = (uint8_t *)FrameArena::alloc(size);
+	REQUIRE(big != nullptr);
+	memset(big, 0x5A, size);
+	CHECK(big[size - 1] == 0x5A);
+}
+
+TEST_CASE("[FrameArena] Falls back to the heap outside of a scope") {
+	uint8_t *data = (uint8_t *)FrameArena::alloc(32);
+	REQUIRE(data != nullptr);
+	memset(data, 1, 32);
+	data = (uint8_t *)FrameArena::realloc(data, 64);
+	CHECK(data[31] == 1);
+	FrameArena::free(data);
+}
+
+TEST_CASE("[FrameArena] FrameLocalVector") {
+	FrameArena::Scope scope;
+	FrameLocalVector<int> vector;
+	for (int i = 0; i < 1000; i++) {
+		vector.push_back(i);
+	}
+	CHECK(vector.size() == 1000);
+	CHECK(vector[0] == 0);
+	CHECK(vector[999] == 999);
+
+	vector.reset();
+	CHECK(vector.is_empty());
+}
+
+} // namespace TestFrameArena
@@ -0,0 +1,182 @@
+/**************************************************************************/
+/*  test_alloc_profiler.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/profiling/alloc_profiler.h"
+#include "core/templates/local_vector.h"
+#include "core/variant/dictionary.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestAllocProfiler {
+
+#ifdef ALLOC_PROFILER_ENABLED
+
+static const uint64_t SAMPLE_INTERVAL = 4096;
+
+// Sampling only starts after the first countdown of each thread, see `AllocProfiler::_reached_sample_point()`.
+static void _start_sampling() {
+	AllocProfiler::start(SAMPLE_INTERVAL);
+	for (int i = 0; i < 4; i++) {
+		memfree(memalloc(SAMPLE_INTERVAL * 2));
+	}
+}
+
+static uint64_t _scope_live_bytes(const String &p_scope) {
+	const Dictionary scopes = AllocProfiler::get_report()["live_bytes_per_scope"];
+	return scopes.get(p_scope, 0);
+}
+
+TEST_CASE("[AllocProfiler] Sampling and live bytes per scope") {
+	static const int COUNT = 1000;
+	// Allocated before sampling starts, so they don't count in the scopes below.
+	LocalVector<void *> large;
+	large.resize(COUNT);
+	LocalVector<void *> small;
+	small.resize(COUNT * 64);
+
+	CHECK(AllocProfiler::get_report().is_empty());
+	_start_sampling();
+	CHECK(AllocProfiler::is_active());
+
+	SUBCASE("Allocations larger than the interval are all sampled, for their own size") {
+		{
+			ALLOC_PROFILE_SCOPE("Large");
+			for (int i = 0; i < COUNT; i++) {
+				large[i] = memalloc(SAMPLE_INTERVAL * 4);
+			}
+		}
+		CHECK(_scope_live_bytes("Large") == COUNT * SAMPLE_INTERVAL * 4);
+
+		const PackedInt64Array histogram = AllocProfiler::get_report()["size_histogram"];
+		// Bucket `i` counts allocations of up to 2^i bytes.
+		REQUIRE(histogram.size() > 14);
+		CHECK(histogram[14] >= COUNT);
+
+		for (int i = 0; i < COUNT / 2; i++) {
+			memfree(large[i]);
+		}
+		CHECK_MESSAGE(_scope_live_bytes("Large") == COUNT / 2 * SAMPLE_INTERVAL * 4, "Frees should be subtracted from the scope they were allocated in.");
+		for (int i = COUNT / 2; i < COUNT; i++) {
+			memfree(large[i]);
+		}
+		CHECK(_scope_live_bytes("Large") == 0);
+	}
+
+	SUBCASE("Small allocations are estimated from samples") {
+		{
+			ALLOC_PROFILE_SCOPE("Small");
+			for (int i = 0; i < COUNT * 64; i++) {
+				small[i] = memalloc(64);
+			}
+		}
+		// Sample points are randomized around the interval, so the estimate is close but not exact.
+		const double expected = COUNT * 64 * 64;
+		CHECK(double(_scope_live_bytes("Small")) == doctest::Approx(expected).epsilon(0.2));
+		CHECK_MESSAGE(_scope_live_bytes("Large") == 0, "Other scopes shouldn't be charged.");
+
+		for (int i = 0; i < COUNT * 64; i++) {
+			memfree(small[i]);
+		}
+		CHECK(_scope_live_bytes("Small") == 0);
+	}
+
+	SUBCASE("Nested scopes attribute allocations to the innermost one") {
+		void *outer;
+		void *inner;
+		{
+			ALLOC_PROFILE_SCOPE("Outer");
+			{
+				ALLOC_PROFILE_SCOPE("Inner");
+				inner = memalloc(SAMPLE_INTERVAL * 8);
+			}
+			outer = memalloc(SAMPLE_INTERVAL * 16);
+		}
+		CHECK(_scope_live_bytes("Inner") == SAMPLE_INTERVAL * 8);
+		CHECK(_scope_live_bytes("Outer") == SAMPLE_INTERVAL * 16);
+		memfree(inner);
+		memfree(outer);
+	}
+
+	AllocProfiler::stop();
+	CHECK_FALSE(AllocProfiler::is_active());
+	CHECK(AllocProfiler::get_report().is_empty());
+}
+
+TEST_CASE("[AllocProfiler] Dump format") {
+	const String path = TestUtils::get_temp_path("alloc_profile.txt");
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(AllocProfiler::dump_to_file(path) == ERR_UNCONFIGURED, "Dumping requires the profiler to run.");
+	ERR_PRINT_ON;
+
+	_start_sampling();
+	void *memory;
+	{
+		ALLOC_PROFILE_SCOPE("Dumped \"scope\"");
+		memory = memalloc(SAMPLE_INTERVAL * 256);
+	}
+	REQUIRE(AllocProfiler::dump_to_file(path, 8) == OK);
+	memfree(memory);
+	AllocProfiler::stop();
+
+	const Vector<String> lines = FileAccess::get_file_as_string(path).split("\n");
+	REQUIRE(lines.size() > 8);
+	const String size = String::humanize_size(SAMPLE_INTERVAL * 256);
+	CHECK(lines[0] == vformat("Allocation profile, sampled every %s on average. All values are estimates.", String::humanize_size(SAMPLE_INTERVAL)));
+	CHECK(lines[1].begins_with("Allocated "));
+	CHECK(lines[2].is_empty());
+	CHECK(lines[3] == "Allocations per size:");
+	CHECK(lines.has(vformat("  <= %s: 1", size)));
+	CHECK(lines.has("Live bytes per scope:"));
+	CHECK(lines.has(vformat("  Dumped \"scope\": %s", size)));
+
+	const int sites = lines.find("Call sites by allocated bytes:");
+	REQUIRE(sites > 0);
+	REQUIRE(sites + 1 < lines.size());
+	// The largest site comes first, followed by its frames.
+	CHECK(lines[sites + 1] == vformat("  #1: %s in 1 allocations, %s live [Dumped \"scope\"]", size, size));
+	int site_count = 0;
+	for (int i = sites + 1; i < lines.size(); i++) {
+		if (lines[i].begins_with("  #")) {
+			site_count++;
+		} else if (!lines[i].is_empty()) {
+			CHECK_MESSAGE(lines[i].begins_with("      "), "Frames should be indented under their site.");
+		}
+	}
+	CHECK(site_count <= 8);
+}
+
+#endif // ALLOC_PROFILER_ENABLED
+
+} // namespace TestAllocProfiler
@@ -0,0 +1,118 @@
+/**************************************************************************/
+/*  test_trace_recorder.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/file_access.h"
+#include "core/io/json.h"
+#include "core/profiling/profiling.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestTraceRecorder {
+
+#ifdef GODOT_USE_BUILTIN_TRACER
+
+static int count_events(const Array &p_events, const String &p_name, const String &p_phase) {
+	int count = 0;
+	for (const Variant &event : p_events) {
+		const Dictionary dict = event;
+		if (dict.get("name", String()) == p_name && dict.get("ph", String()) == p_phase) {
+			count++;
+		}
+	}
+	return count;
+}
+
+TEST_CASE("[TraceRecorder] Export recorded zones as Chrome trace events") {
+	const String path = TestUtils::get_temp_path("trace.json");
+
+	{
+		GodotProfileZone("Before recording");
+	}
+
+	REQUIRE(TraceRecorder::start() == OK);
+	CHECK(TraceRecorder::is_recording());
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(TraceRecorder::start() == ERR_ALREADY_IN_USE, "Recording can't be started twice.");
+	ERR_PRINT_ON;
+
+	{
+		GodotProfileZone("Outer \"zone\"");
+		for (int i = 0; i < 3; i++) {
+			GodotProfileZone("Inner zone");
+		}
+		GodotProfileZoneGroupedFirst(_group, "First grouped zone");
+		GodotProfileZoneGrouped(_group, "Second grouped zone");
+		GodotProfileZoneGroupedEndEarly(_group, "Second grouped zone");
+	}
+	GodotProfileFrameMark;
+
+	REQUIRE(TraceRecorder::stop(path) == OK);
+	CHECK_FALSE(TraceRecorder::is_recording());
+
+	{
+		GodotProfileZone("After recording");
+	}
+
+	const Variant trace = JSON::parse_string(FileAccess::get_file_as_string(path));
+	REQUIRE(trace.get_type() == Variant::DICTIONARY);
+	const Array events = Dictionary(trace)["traceEvents"];
+
+	CHECK(count_events(events, "Outer \"zone\"", "X") == 1);
+	CHECK(count_events(events, "Inner zone", "X") == 3);
+	CHECK(count_events(events, "First grouped zone", "X") == 1);
+	CHECK(count_events(events, "Second grouped zone", "X") == 1);
+	CHECK(count_events(events, "Frame", "i") == 1);
+	CHECK(count_events(events, "Before recording", "X") == 0);
+	CHECK(count_events(events, "After recording", "X") == 0);
+
+	int main_thread_names = 0;
+	for (const Variant &event : events) {
+		const Dictionary dict = event;
+		if (dict["name"] == "thread_name" && Dictionary(dict["args"])["name"] == "Main Thread") {
+			main_thread_names++;
+		}
+		if (dict["name"] == "Outer \"zone\"") {
+			CHECK(int64_t(dict["ts"]) >= 0);
+			CHECK(int64_t(dict["dur"]) >= 0);
+		}
+	}
+	CHECK_MESSAGE(main_thread_names == 1, "The main thread should be named once.");
+
+	ERR_PRINT_OFF;
+	CHECK_MESSAGE(TraceRecorder::stop(path) == ERR_UNCONFIGURED, "Stopping requires a recording.");
+	ERR_PRINT_ON;
+}
+
+#endif // GODOT_USE_BUILTIN_TRACER
+
+} // namespace TestTraceRecorder
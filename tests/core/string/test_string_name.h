@@ -0,0 +1,97 @@
+/**************************************************************************/
+/*  test_string_name.h                                                    */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/object/worker_thread_pool.h"
+#include "core/string/string_name.h"
+
+#include "tests/test_macros.h"
+
+namespace TestStringName {
+
+TEST_CASE("[StringName] Interning") {
+	const StringName a = "test_string_name_interning";
+	const StringName b = String("test_string_name_interning");
+	const StringName c = StringName("test_string_name_interning_other");
+
+	CHECK(a == b);
+	CHECK(a.data_unique_pointer() == b.data_unique_pointer());
+	CHECK(a != c);
+	CHECK(a == String("test_string_name_interning"));
+	CHECK(a.hash() == String("test_string_name_interning").hash());
+
+	CHECK(StringName().is_empty());
+	CHECK(StringName("").is_empty());
+	CHECK(StringName(String()).is_empty());
+}
+
+TEST_CASE("[StringName] Re-interning after release") {
+	const String name = "test_string_name_released";
+	{
+		const StringName a = name;
+		CHECK(a == name);
+	}
+	// The entry was freed, a new one must be created.
+	const StringName b = name;
+	CHECK(b == name);
+	CHECK(b == StringName(name));
+}
+
+static constexpr uint32_t THREAD_NAME_COUNT = 64;
+static StringName thread_names[THREAD_NAME_COUNT * 8];
+
+static void intern_names(void *p_arg, uint32_t p_index) {
+	// Each name is interned, released and interned again from several threads at once.
+	for (int i = 0; i < 50; i++) {
+		StringName name = "test_string_name_thread_" + itos(p_index % THREAD_NAME_COUNT);
+		name = StringName();
+	}
+	thread_names[p_index] = StringName("test_string_name_thread_" + itos(p_index % THREAD_NAME_COUNT));
+}
+
+TEST_CASE("[StringName] Concurrent interning") {
+	WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(intern_names, nullptr, THREAD_NAME_COUNT * 8);
+	WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+
+	bool all_unique = true;
+	for (uint32_t i = 0; i < THREAD_NAME_COUNT * 8; i++) {
+		const StringName &name = thread_names[i];
+		all_unique &= name == StringName("test_string_name_thread_" + itos(i % THREAD_NAME_COUNT));
+		all_unique &= name.data_unique_pointer() == thread_names[i % THREAD_NAME_COUNT].data_unique_pointer();
+	}
+	CHECK(all_unique);
+
+	for (StringName &name : thread_names) {
+		name = StringName();
+	}
+}
+
+} // namespace TestStringName
@@ -0,0 +1,185 @@
+/**************************************************************************/
+/*  test_parallel_algorithms.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "core/templates/parallel_algorithms.h"
+
+#include "tests/test_macros.h"
+
+namespace TestParallelAlgorithms {
+
+TEST_CASE("[ParallelAlgorithms] parallel_for visits every index once") {
+	LocalVector<int> visits;
+	visits.resize_initialized(10000);
+
+	parallel_for(visits.size(), [&visits](int64_t p_index) {
+		visits[p_index]++;
+	}, 64);
+
+	bool all_once = true;
+	for (int visit : visits) {
+		all_once = all_once && visit == 1;
+	}
+	CHECK(all_once);
+
+	// Empty range.
+	parallel_for(0, [&visits](int64_t p_index) {
+		visits[p_index]++;
+	});
+}
+
+TEST_CASE("[ParallelAlgorithms] Grain is enlarged to keep the chunk count in range") {
+	CHECK(parallel_get_grain(10000, 64) == 64);
+	CHECK(parallel_get_chunk_count(10000, 64) == 157);
+	CHECK(parallel_get_chunk_count(0, 64) == 0);
+
+	// Per-chunk storage (partial sums, offsets) is sized from these, not from the requested grain.
+	const int64_t count = int64_t(INT32_MAX) * 3 + 1;
+	CHECK(parallel_get_grain(count, 1) == 4);
+	CHECK(parallel_get_chunk_count(count, 1) <= INT32_MAX);
+	CHECK(parallel_get_grain(count, 1000) == 1000);
+}
+
+TEST_CASE("[ParallelAlgorithms] parallel_reduce") {
+	const int64_t sum = parallel_reduce(int64_t(100000), int64_t(0), [](int64_t p_index) { return p_index; }, [](int64_t p_a, int64_t p_b) { return p_a + p_b; }, 100);
+	CHECK(sum == int64_t(100000) * 99999 / 2);
+
+	const int64_t max = parallel_reduce(int64_t(5000), int64_t(-1), [](int64_t p_index) { return (p_index * 7919) % 5000; }, [](int64_t p_a, int64_t p_b) { return MAX(p_a, p_b); }, 64);
+	CHECK(max == 4999);
+
+	CHECK(parallel_reduce(int64_t(0), 42, [](int64_t p_index) { return 1; }, [](int p_a, int p_b) { return p_a + p_b; }) == 42);
+
+	// Chunks are combined in the same order regardless of the amount of threads.
+	RandomPCG rng(7);
+	LocalVector<float> values;
+	for (int i = 0; i < 20000; i++) {
+		values.push_back(rng.randf() * 1000.0f);
+	}
+	float expected = 0.0f;
+	for (uint32_t i = 0; i < values.size(); i += 256) {
+		float chunk = 0.0f;
+		for (uint32_t j = i; j < MIN(values.size(), i + 256); j++) {
+			chunk += values[j];
+		}
+		expected += chunk;
+	}
+	const float result = parallel_reduce(int64_t(values.size()), 0.0f, [&values](int64_t p_index) { return values[p_index]; }, [](float p_a, float p_b) { return p_a + p_b; }, 256);
+	CHECK(result == expected);
+}
+
+TEST_CASE("[ParallelAlgorithms] parallel_prefix_sum") {
+	LocalVector<int> values;
+	for (int i = 0; i < 5000; i++) {
+		values.push_back(i % 13);
+	}
+	LocalVector<int> expected;
+	int sum = 0;
+	for (int value : values) {
+		sum += value;
+		expected.push_back(sum);
+	}
+
+	LocalVector<int> result;
+	result.resize(values.size());
+	parallel_prefix_sum(values.ptr(), result.ptr(), values.size(), 100);
+	CHECK(result.span() == expected.span());
+
+	// In place, with a range that is not a multiple of the grain.
+	parallel_prefix_sum(values.ptr(), values.ptr(), values.size(), 333);
+	CHECK(values.span() == expected.span());
+}
+
+TEST_CASE("[ParallelAlgorithms] parallel_sort") {
+	RandomPCG rng(1234);
+	for (int64_t size : { 0, 1, 2, 100, 1000, 4097, 20000 }) {
+		LocalVector<uint32_t> values;
+		for (int64_t i = 0; i < size; i++) {
+			values.push_back(rng.rand() % 500);
+		}
+		LocalVector<uint32_t> expected = values;
+		SortArray<uint32_t> sorter;
+		sorter.sort(expected.ptr(), expected.size());
+
+		parallel_sort(values.ptr(), values.size(), 128);
+		CHECK_MESSAGE(values.span() == expected.span(), "Sorting ", size, " elements.");
+	}
+}
+
+struct _PairFirstLess {
+	_FORCE_INLINE_ bool operator()(const Pair<int, int> &p_a, const Pair<int, int> &p_b) const {
+		return p_a.first < p_b.first;
+	}
+};
+
+TEST_CASE("[ParallelAlgorithms] parallel_sort merges are stable") {
+	// Each chunk is sorted on its own, merges keep elements from earlier chunks first.
+	LocalVector<Pair<int, int>> values;
+	for (int i = 0; i < 1000; i++) {
+		values.push_back(Pair<int, int>(i % 2, i / 100));
+	}
+	parallel_sort<Pair<int, int>, _PairFirstLess>(values.ptr(), values.size(), 100);
+
+	bool ordered = true;
+	for (uint32_t i = 1; i < values.size(); i++) {
+		ordered = ordered && values[i - 1].first <= values[i].first;
+		if (values[i - 1].first == values[i].first) {
+			ordered = ordered && values[i - 1].second <= values[i].second;
+		}
+	}
+	CHECK(ordered);
+}
+
+TEST_CASE("[ParallelAlgorithms] sort_parallel() on Array and PackedFloat32Array") {
+	RandomPCG rng(99);
+	Array array;
+	PackedFloat32Array floats;
+	for (int i = 0; i < 50000; i++) {
+		array.push_back(int64_t(rng.rand() % 1000));
+		floats.push_back(rng.randf());
+	}
+	Array expected_array = array.duplicate();
+	expected_array.sort();
+	PackedFloat32Array expected_floats = floats;
+	expected_floats.sort();
+
+	array.sort_parallel();
+	CHECK(array == expected_array);
+
+	Variant floats_variant = floats;
+	Variant ret;
+	Callable::CallError ce;
+	floats_variant.callp("sort_parallel", nullptr, 0, ret, ce);
+	CHECK(ce.error == Callable::CallError::CALL_OK);
+	CHECK(PackedFloat32Array(floats_variant) == expected_floats);
+}
+
+} // namespace TestParallelAlgorithms
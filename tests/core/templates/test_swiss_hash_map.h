@@ -0,0 +1,434 @@
+/**************************************************************************/
+/*  test_swiss_hash_map.h                                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/math/random_pcg.h"
+#include "core/templates/a_hash_map.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/swiss_hash_map.h"
+
+#include "tests/test_macros.h"
+
+namespace TestSwissHashMap {
+
+TEST_CASE("[SwissHashMap] List initialization") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 1, "B" }, { 2, "C" }, { 3, "D" }, { 4, "E" } };
+
+	CHECK(map.size() == 5);
+	CHECK(map[0] == "A");
+	CHECK(map[1] == "B");
+	CHECK(map[2] == "C");
+	CHECK(map[3] == "D");
+	CHECK(map[4] == "E");
+}
+
+TEST_CASE("[SwissHashMap] List initialization with existing elements") {
+	SwissHashMap<int, String> map{ { 0, "A" }, { 0, "B" }, { 0, "C" }, { 0, "D" }, { 0, "E" } };
+
+	CHECK(map.size() == 1);
+	CHECK(map[0] == "E");
+}
+
+TEST_CASE("[SwissHashMap] Insert element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+
+	CHECK(e);
+	CHECK(e->key == 42);
+	CHECK(e->value == 84);
+	CHECK(map[42] == 84);
+	CHECK(map.has(42));
+	CHECK(map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Overwrite element") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(42, 1234);
+
+	CHECK(map[42] == 1234);
+}
+
+TEST_CASE("[SwissHashMap] Erase via element") {
+	SwissHashMap<int, int> map;
+	SwissHashMap<int, int>::Iterator e = map.insert(42, 84);
+	map.remove(e);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Erase via key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.erase(42);
+	CHECK(!map.has(42));
+	CHECK(!map.find(42));
+}
+
+TEST_CASE("[SwissHashMap] Size") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 84);
+	map.insert(123, 84);
+	map.insert(0, 84);
+	map.insert(123485, 84);
+
+	CHECK(map.size() == 4);
+}
+
+TEST_CASE("[SwissHashMap] Iteration") {
+	SwissHashMap<int, int> map;
+
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+
+	idx--;
+	for (SwissHashMap<int, int>::Iterator it = map.last(); it; --it) {
+		CHECK(expected[idx] == Pair<int, int>(it->key, it->value));
+		idx--;
+	}
+}
+
+TEST_CASE("[SwissHashMap] Const iteration") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+	map.insert(123485, 1238888);
+	map.insert(123, 111111);
+
+	const SwissHashMap<int, int> const_map = map;
+
+	Vector<Pair<int, int>> expected;
+	expected.push_back(Pair<int, int>(42, 84));
+	expected.push_back(Pair<int, int>(123, 111111));
+	expected.push_back(Pair<int, int>(0, 12934));
+	expected.push_back(Pair<int, int>(123485, 1238888));
+	expected.push_back(Pair<int, int>(123, 111111));
+
+	int idx = 0;
+	for (const KeyValue<int, int> &E : const_map) {
+		CHECK(expected[idx] == Pair<int, int>(E.key, E.value));
+		idx++;
+	}
+
+	idx--;
+	for (SwissHashMap<int, int>::ConstIterator it = const_map.last(); it; --it) {
+		CHECK(expected[idx] == Pair<int, int>(it->key, it->value));
+		idx--;
+	}
+}
+
+TEST_CASE("[SwissHashMap] Replace key") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(0, 12934);
+	CHECK(map.replace_key(0, 1));
+	CHECK(map.has(1));
+	CHECK(map[1] == 12934);
+}
+
+TEST_CASE("[SwissHashMap] Clear") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+
+	map.clear();
+	CHECK(!map.has(42));
+	CHECK(map.size() == 0);
+	CHECK(map.is_empty());
+}
+
+TEST_CASE("[SwissHashMap] Get") {
+	SwissHashMap<int, int> map;
+	map.insert(42, 84);
+	map.insert(123, 12385);
+	map.insert(0, 12934);
+
+	CHECK(map.get(123) == 12385);
+	map.get(123) = 10;
+	CHECK(map.get(123) == 10);
+
+	CHECK(*map.getptr(0) == 12934);
+	*map.getptr(0) = 1;
+	CHECK(*map.getptr(0) == 1);
+
+	CHECK(map.get(42) == 84);
+	CHECK(map.getptr(-10) == nullptr);
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many elements") {
+	const int elem_max = 1234;
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+
+	//insert order should have been kept
+	int idx = 0;
+	for (const KeyValue<int, int> &K : map) {
+		CHECK(idx == K.key);
+		CHECK(idx == K.value);
+		CHECK(map.has(idx));
+		idx++;
+	}
+
+	Vector<int> elems_still_valid;
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			map.erase(i);
+		} else {
+			elems_still_valid.push_back(i);
+		}
+	}
+
+	CHECK(elems_still_valid.size() == map.size());
+
+	for (int i = 0; i < elems_still_valid.size(); i++) {
+		CHECK(map.has(elems_still_valid[i]));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Insert, iterate and remove many strings") {
+	const int elem_max = 432;
+	SwissHashMap<String, String> map;
+
+	// To not print WARNING: Excessive collision count (NN), is the right hash function being used?
+	ERR_PRINT_OFF;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(itos(i), itos(i));
+	}
+	ERR_PRINT_ON;
+
+	//insert order should have been kept
+	int idx = 0;
+	for (auto &K : map) {
+		CHECK(itos(idx) == K.key);
+		CHECK(itos(idx) == K.value);
+		CHECK(map.has(itos(idx)));
+		idx++;
+	}
+
+	Vector<String> elems_still_valid;
+
+	for (int i = 0; i < elem_max; i++) {
+		if ((i % 5) == 0) {
+			map.erase(itos(i));
+		} else {
+			elems_still_valid.push_back(itos(i));
+		}
+	}
+
+	CHECK(elems_still_valid.size() == map.size());
+
+	for (int i = 0; i < elems_still_valid.size(); i++) {
+		CHECK(map.has(elems_still_valid[i]));
+	}
+
+	elems_still_valid.clear();
+}
+
+TEST_CASE("[SwissHashMap] Copy constructor") {
+	SwissHashMap<int, int> map0;
+	const uint32_t count = 5;
+	for (uint32_t i = 0; i < count; i++) {
+		map0.insert(i, i);
+	}
+	SwissHashMap<int, int> map1(map0);
+	CHECK(map0.size() == map1.size());
+	CHECK(map0.get_capacity() == map1.get_capacity());
+	CHECK(*map0.getptr(0) == *map1.getptr(0));
+}
+
+TEST_CASE("[SwissHashMap] Operator =") {
+	SwissHashMap<int, int> map0;
+	SwissHashMap<int, int> map1;
+	const uint32_t count = 5;
+	map1.insert(1234, 1234);
+	for (uint32_t i = 0; i < count; i++) {
+		map0.insert(i, i);
+	}
+	map1 = map0;
+	CHECK(map0.size() == map1.size());
+	CHECK(map0.get_capacity() == map1.get_capacity());
+	CHECK(*map0.getptr(0) == *map1.getptr(0));
+}
+
+TEST_CASE("[SwissHashMap] Array methods") {
+	SwissHashMap<int, int> map;
+	for (int i = 0; i < 100; i++) {
+		map.insert(100 - i, i);
+	}
+	for (int i = 0; i < 100; i++) {
+		CHECK(map.get_by_index(i).value == i);
+	}
+	int index = map.get_index(1);
+	CHECK(map.get_by_index(index).value == 99);
+	CHECK(map.erase_by_index(index));
+	CHECK(!map.erase_by_index(index));
+	CHECK(map.get_index(1) == -1);
+}
+
+TEST_CASE("[SwissHashMap] Span multiple groups") {
+	SwissHashMap<int, int> map;
+	CHECK(map.get_capacity() == SwissHashMap<int, int>::INITIAL_CAPACITY);
+
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i * 2);
+	}
+	CHECK(map.size() == 1000);
+	CHECK(map.get_capacity() > 1000);
+	for (int i = 0; i < 1000; i++) {
+		CHECK(map[i] == i * 2);
+	}
+	CHECK(!map.has(-1));
+	CHECK(!map.has(1000));
+}
+
+TEST_CASE("[SwissHashMap] Reserve") {
+	SwissHashMap<int, int> map;
+	map.reserve(1000);
+	const uint32_t capacity = map.get_capacity();
+	for (int i = 0; i < 1000; i++) {
+		map.insert(i, i);
+	}
+	// All elements should fit without a rehash.
+	CHECK(map.get_capacity() == capacity);
+}
+
+struct SwissHashMapCollidingHasher {
+	static _FORCE_INLINE_ uint32_t hash(const int p_int) { return 7; }
+};
+
+TEST_CASE("[SwissHashMap] Full collisions") {
+	SwissHashMap<int, int, SwissHashMapCollidingHasher> map;
+	const int elem_max = 100;
+
+	// To not print WARNING: Excessive collision count, is the right hash function being used?
+	ERR_PRINT_OFF;
+	for (int i = 0; i < elem_max; i++) {
+		map.insert(i, i);
+	}
+	ERR_PRINT_ON;
+
+	for (int i = 0; i < elem_max; i++) {
+		CHECK(map.has(i));
+	}
+	CHECK(!map.has(elem_max));
+
+	for (int i = 0; i < elem_max; i += 2) {
+		CHECK(map.erase(i));
+	}
+	CHECK(map.size() == elem_max / 2);
+	for (int i = 0; i < elem_max; i++) {
+		CHECK(map.has(i) == (i % 2 == 1));
+	}
+}
+
+TEST_CASE("[SwissHashMap] Insert and erase churn") {
+	// Repeatedly filling and emptying the map leaves tombstones behind, which must be reclaimed.
+	SwissHashMap<int, int> map;
+	for (int round = 0; round < 50; round++) {
+		for (int i = 0; i < 100; i++) {
+			map.insert(round * 100 + i, i);
+		}
+		for (int i = 0; i < 100; i++) {
+			CHECK(map.erase(round * 100 + i));
+		}
+	}
+	CHECK(map.is_empty());
+	CHECK(map.get_capacity() <= 256);
+	CHECK(!map.has(0));
+}
+
+TEST_CASE("[SwissHashMap] Matches other maps") {
+	// Performs the same random operations on all maps, then compares the results.
+	const uint32_t sizes[] = { 16, 1'000, 100'000 };
+	for (uint32_t size : sizes) {
+		SwissHashMap<uint32_t, uint32_t> swiss_map;
+		AHashMap<uint32_t, uint32_t> a_map;
+		HashMap<uint32_t, uint32_t> map;
+		RandomPCG rng(size);
+
+		for (uint32_t i = 0; i < size; i++) {
+			const uint32_t key = rng.rand() % (size * 2);
+			swiss_map.insert(key, i);
+			a_map.insert(key, i);
+			map.insert(key, i);
+		}
+		for (uint32_t i = 0; i < size / 2; i++) {
+			const uint32_t key = rng.rand() % (size * 2);
+			CHECK(swiss_map.erase(key) == map.erase(key));
+			a_map.erase(key);
+		}
+
+		CHECK(swiss_map.size() == map.size());
+		CHECK(swiss_map.size() == a_map.size());
+
+		bool all_match = true;
+		for (uint32_t key = 0; key < size * 2; key++) {
+			const uint32_t *swiss_value = swiss_map.getptr(key);
+			const uint32_t *value = map.getptr(key);
+			if ((swiss_value == nullptr) != (value == nullptr) || (value && *swiss_value != *value)) {
+				all_match = false;
+			}
+		}
+		CHECK(all_match);
+
+		// The insertion order must be the same as AHashMap's, including after erasing.
+		bool same_order = true;
+		for (uint32_t i = 0; i < swiss_map.size(); i++) {
+			if (swiss_map.get_by_index(i).key != a_map.get_by_index(i).key) {
+				same_order = false;
+			}
+		}
+		CHECK(same_order);
+	}
+}
+
+} // namespace TestSwissHashMap
@@ -0,0 +1,133 @@
+/**************************************************************************/
+/*  test_unique_vector.h                                                  */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/templates/unique_vector.h"
+
+#include "tests/test_macros.h"
+
+namespace TestUniqueVector {
+
+TEST_CASE("[UniqueVector] Push back and access") {
+	UniqueVector<int> vector;
+	CHECK(vector.is_empty());
+
+	vector.push_back(0);
+	vector.push_back(1);
+	vector.push_back(2);
+	CHECK(vector.size() == 3);
+
+	vector[1] = 10;
+	CHECK(vector[0] == 0);
+	CHECK(vector[1] == 10);
+	CHECK(vector[2] == 2);
+
+	vector.remove_at(0);
+	CHECK(vector.size() == 2);
+	CHECK(vector[0] == 10);
+
+	int sum = 0;
+	for (int value : vector) {
+		sum += value;
+	}
+	CHECK(sum == 12);
+
+	vector.clear();
+	CHECK(vector.is_empty());
+}
+
+TEST_CASE("[UniqueVector] Resize and fill") {
+	UniqueVector<int> vector;
+	vector.resize_initialized(8);
+	CHECK(vector.size() == 8);
+	CHECK(vector[7] == 0);
+
+	vector.fill(3);
+	CHECK(vector[0] == 3);
+	CHECK(vector[7] == 3);
+
+	vector.resize(2);
+	CHECK(vector.size() == 2);
+	CHECK(vector[1] == 3);
+}
+
+TEST_CASE("[UniqueVector] Move") {
+	UniqueVector<String> vector;
+	vector.push_back("a");
+	vector.push_back("b");
+	const String *data = vector.ptr();
+
+	UniqueVector<String> moved = std::move(vector);
+	CHECK(moved.size() == 2);
+	CHECK(moved.ptr() == data);
+	CHECK(vector.is_empty());
+
+	UniqueVector<String> other;
+	other.push_back("c");
+	SWAP(moved, other);
+	CHECK(moved.size() == 1);
+	CHECK(moved[0] == "c");
+	CHECK(other.ptr() == data);
+}
+
+TEST_CASE("[UniqueVector] Convert to and from Vector without copying") {
+	UniqueVector<uint8_t> vector;
+	vector.resize(16);
+	vector[0] = 42;
+	const uint8_t *data = vector.ptr();
+
+	PackedByteArray packed = vector.release();
+	CHECK(vector.is_empty());
+	CHECK(packed.size() == 16);
+	CHECK(packed[0] == 42);
+	CHECK(packed.ptr() == data);
+
+	UniqueVector<uint8_t> back(std::move(packed));
+	CHECK(packed.is_empty());
+	CHECK(back.size() == 16);
+	CHECK(back.ptr() == data);
+}
+
+TEST_CASE("[UniqueVector] Convert from shared Vector") {
+	Vector<int> shared = { 1, 2, 3 };
+	Vector<int> copy = shared;
+
+	// The buffer is shared with `shared`, so it must be copied.
+	UniqueVector<int> vector(std::move(copy));
+	CHECK(vector.ptr() != shared.ptr());
+	vector[0] = 10;
+
+	CHECK(vector[0] == 10);
+	CHECK(shared[0] == 1);
+	CHECK(shared.size() == 3);
+}
+
+} // namespace TestUniqueVector
@@ -0,0 +1,152 @@
+/**************************************************************************/
+/*  test_work_stealing_queue.h                                            */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/os/thread.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#include "core/templates/work_stealing_queue.h"
+
+#include "tests/test_macros.h"
+
+namespace TestWorkStealingQueue {
+
+TEST_CASE("[WorkStealingQueue] Owner pushes and pops in LIFO order") {
+	WorkStealingQueue<uint64_t, 8> queue;
+	CHECK(queue.is_empty());
+
+	for (uint64_t i = 1; i <= 4; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK(queue.size() == 4);
+
+	uint64_t value = 0;
+	CHECK(queue.pop(value));
+	CHECK(value == 4);
+	CHECK(queue.pop(value));
+	CHECK(value == 3);
+	CHECK(queue.size() == 2);
+}
+
+TEST_CASE("[WorkStealingQueue] Thieves steal in FIFO order") {
+	WorkStealingQueue<uint64_t, 8> queue;
+	for (uint64_t i = 1; i <= 3; i++) {
+		queue.push(i);
+	}
+
+	uint64_t value = 0;
+	CHECK(queue.steal(value));
+	CHECK(value == 1);
+	CHECK(queue.pop(value));
+	CHECK(value == 3);
+	CHECK(queue.steal(value));
+	CHECK(value == 2);
+
+	CHECK(queue.is_empty());
+	CHECK_FALSE(queue.pop(value));
+	CHECK_FALSE(queue.steal(value));
+}
+
+TEST_CASE("[WorkStealingQueue] Push fails when full") {
+	WorkStealingQueue<uint64_t, 4> queue;
+	for (uint64_t i = 0; i < 4; i++) {
+		CHECK(queue.push(i));
+	}
+	CHECK_FALSE(queue.push(4));
+
+	uint64_t value = 0;
+	CHECK(queue.steal(value));
+	CHECK(value == 0);
+	// Stealing makes room again, wrapping around the ring buffer.
+	CHECK(queue.push(4));
+	CHECK(queue.size() == 4);
+}
+
+struct StealTestState {
+	static const uint64_t ELEMENT_COUNT = 100000;
+
+	WorkStealingQueue<uint64_t, 256> queue;
+	LocalVector<SafeNumeric<uint32_t>> taken;
+	SafeFlag owner_done;
+
+	static void thief_function(void *p_user) {
+		StealTestState *state = (StealTestState *)p_user;
+		while (true) {
+			uint64_t value = 0;
+			if (state->queue.steal(value)) {
+				state->taken[value].increment();
+			} else if (state->owner_done.is_set() && state->queue.is_empty()) {
+				break;
+			}
+		}
+	}
+};
+
+TEST_CASE("[WorkStealingQueue] Every element is taken exactly once under contention") {
+	StealTestState state;
+	state.taken.resize(StealTestState::ELEMENT_COUNT);
+
+	const int thief_count = 3;
+	Thread thieves[thief_count];
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].start(&StealTestState::thief_function, &state);
+	}
+
+	uint64_t value = 0;
+	for (uint64_t i = 0; i < StealTestState::ELEMENT_COUNT; i++) {
+		while (!state.queue.push(i)) {
+			// Full; help draining it.
+			if (state.queue.pop(value)) {
+				state.taken[value].increment();
+			}
+		}
+		if (i % 3 == 0 && state.queue.pop(value)) {
+			state.taken[value].increment();
+		}
+	}
+	while (state.queue.pop(value)) {
+		state.taken[value].increment();
+	}
+	state.owner_done.set();
+
+	for (int i = 0; i < thief_count; i++) {
+		thieves[i].wait_to_finish();
+	}
+
+	bool all_taken_once = true;
+	for (uint64_t i = 0; i < StealTestState::ELEMENT_COUNT; i++) {
+		// Reduce number of check messages.
+		all_taken_once &= state.taken[i].get() == 1;
+	}
+	CHECK(all_taken_once);
+}
+
+} // namespace TestWorkStealingQueue
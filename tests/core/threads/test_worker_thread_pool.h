@@ -106,6 +106,45 @@ TEST_CASE("[WorkerThreadPool] Process elements using group tasks") {
 	}
 }
 
+static void static_nested_leaf(void *p_arg) {
+	counter[(uint64_t)p_arg].increment();
+}
+static void static_nested_parent(void *p_arg) {
+	// Tasks posted from a pool thread go to its local queue, where they are either
+	// popped back by this thread while it waits or stolen by other threads.
+	const int children = 16;
+	WorkerThreadPool::TaskID child_tasks[children];
+	for (int i = 0; i < children; i++) {
+		child_tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_leaf, p_arg, true);
+	}
+	for (int i = 0; i < children; i++) {
+		WorkerThreadPool::get_singleton()->wait_for_task_completion(child_tasks[i]);
+	}
+}
+TEST_CASE("[WorkerThreadPool] Process tasks posted from other tasks") {
+	for (int iterations = 0; iterations < 100; iterations++) {
+		const int count = Math::pow(2.0f, Math::random(0.0f, 5.0f));
+
+		counter.clear();
+		counter.resize(count);
+		LocalVector<WorkerThreadPool::TaskID> tasks;
+		tasks.resize(count);
+		for (int i = 0; i < count; i++) {
+			tasks[i] = WorkerThreadPool::get_singleton()->add_native_task(static_nested_parent, (void *)(uintptr_t)i, true);
+		}
+		for (int i = 0; i < count; i++) {
+			WorkerThreadPool::get_singleton()->wait_for_task_completion(tasks[i]);
+		}
+
+		bool all_run = true;
+		for (int i = 0; i < count; i++) {
+			//Reduce number of check messages
+			all_run &= counter[i].get() == 16;
+		}
+		CHECK(all_run);
+	}
+}
+
 static void static_test_daemon(void *p_arg) {
 	while (!exit.is_set()) {
 		counter[0].add(1);
@@ -30,10 +30,12 @@
 
 #pragma once
 
+#include "core/io/file_access.h"
 #include "core/variant/variant.h"
 #include "core/variant/variant_parser.h"
 
 #include "tests/test_macros.h"
+#include "tests/test_utils.h"
 
 namespace TestVariant {
 TEST_CASE("[Variant] Writer and parser integer") {
@@ -105,6 +107,66 @@ TEST_CASE("[Variant] Writer and parser Variant::FLOAT") {
 	CHECK_MESSAGE(float_parsed == 1.0e+100, "Should match the double literal.");
 }
 
+TEST_CASE("[Variant] Parser packed arrays and strings") {
+	// Large enough for the numbers to be converted on several threads.
+	const int count = 100000;
+	String text = "[PackedFloat64Array(";
+	for (int i = 0; i < count; i++) {
+		if (i > 0) {
+			text += ", ";
+		}
+		if (i == 7) {
+			text += "-inf";
+		} else if (i % 2) {
+			text += itos(-i);
+		} else {
+			text += rtos(i * 0.25);
+		}
+	}
+	text += String::utf8("), PackedInt32Array(1, -2, 3), PackedVector2Array(), \"caf\\u00e9 \\U01F600 ünï\", &\"name\"]");
+
+	const String path = TestUtils::get_temp_path("variant_parser.txt");
+	{
+		Ref<FileAccess> f = FileAccess::open(path, FileAccess::WRITE);
+		REQUIRE(f.is_valid());
+		f->store_string(text);
+	}
+
+	VariantParser::StreamString ss;
+	ss.s = text;
+	VariantParser::StreamFile sf;
+	sf.f = FileAccess::open(path, FileAccess::READ);
+	REQUIRE(sf.f.is_valid());
+
+	VariantParser::Stream *streams[2] = { &ss, &sf };
+	for (VariantParser::Stream *stream : streams) {
+		String errs;
+		int line = 0;
+		Variant parsed;
+		REQUIRE(VariantParser::parse(stream, parsed, errs, line) == OK);
+		const Array arr = parsed;
+		REQUIRE(arr.size() == 5);
+
+		const PackedFloat64Array floats = arr[0];
+		REQUIRE(floats.size() == count);
+		bool all_equal = true;
+		for (int i = 0; i < count; i++) {
+			const double expected = i == 7 ? -Math::INF : (i % 2 ? double(-i) : i * 0.25);
+			if (floats[i] != expected) {
+				all_equal = false;
+				break;
+			}
+		}
+		CHECK_MESSAGE(all_equal, "All numbers should parse back.");
+
+		CHECK(arr[1] == Variant(PackedInt32Array({ 1, -2, 3 })));
+		CHECK(PackedVector2Array(arr[2]).is_empty());
+		CHECK(arr[3] == Variant(String::utf8("café 😀 ünï")));
+		CHECK(arr[4].get_type() == Variant::STRING_NAME);
+		CHECK(arr[4] == Variant(StringName("name")));
+	}
+}
+
 TEST_CASE("[Variant] Assignment To Bool from Int,Float,String,Vec2,Vec2i,Vec3,Vec3i,Vec4,Vec4i,Rect2,Rect2i,Trans2d,Trans3d,Color,Call,Plane,Basis,AABB,Quant,Proj,RID,and Object") {
 	Variant int_v = 0;
 	Variant bool_v = true;
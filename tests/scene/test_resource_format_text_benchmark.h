@@ -0,0 +1,121 @@
+/**************************************************************************/
+/*  test_resource_format_text_benchmark.h                                 */
+/**************************************************************************/
+/*                         This file is part of:                          */
+/*                             GODOT ENGINE                               */
+/*                        https://godotengine.org                         */
+/**************************************************************************/
+/* Copyright (c) 2014-present Godot Engine contributors (see AUTHORS.md). */
+/* Copyright (c) 2007-2014 Juan Linietsky, Ariel Manzur.                  */
+/*                                                                        */
+/* Permission is hereby granted, free of charge, to any person obtaining  */
+/* a copy of this software and associated documentation files (the        */
+/* "Software"), to deal in the Software without restriction, including    */
+/* without limitation the rights to use, copy, modify, merge, publish,    */
+/* distribute, sublicense, and/or sell copies of the Software, and to     */
+/* permit persons to whom the Software is furnished to do so, subject to  */
+/* the following conditions:                                              */
+/*                                                                        */
+/* The above copyright notice and this permission notice shall be         */
+/* included in all copies or substantial portions of the Software.        */
+/*                                                                        */
+/* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,        */
+/* EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF     */
+/* MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. */
+/* IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY   */
+/* CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,   */
+/* TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE      */
+/* SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.                 */
+/**************************************************************************/
+
+#pragma once
+
+#include "core/io/dir_access.h"
+#include "core/io/file_access.h"
+#include "core/io/resource_loader.h"
+#include "core/io/resource_saver.h"
+#include "scene/2d/node_2d.h"
+#include "scene/resources/packed_scene.h"
+
+#include "tests/test_macros.h"
+#include "tests/test_utils.h"
+
+namespace TestResourceFormatTextBenchmark {
+
+// The size of the server scenes that were too slow to load as text.
+static const int64_t SCENE_SIZE = 50 << 20;
+// Each node has one sub-resource, with about 40 KiB of text in it.
+static const int NODE_COUNT = 1600;
+static const int POINT_COUNT = 1500;
+
+static Ref<PackedScene> _make_scene() {
+	Node2D *root = memnew(Node2D);
+	root->set_name("Root");
+	for (int i = 0; i < NODE_COUNT; i++) {
+		Node2D *node = memnew(Node2D);
+		node->set_name(vformat("Node%d", i));
+		node->set_position(Vector2(i * 1.25, i * -0.75));
+		node->set_rotation(i * 0.001);
+		node->set_meta("label", vformat("Node \"%d\" of the benchmark scene", i));
+
+		// Sub-resources are mostly packed arrays (meshes, polygons, curves), with some small values around them.
+		Ref<Resource> data = memnew(Resource);
+		PackedVector2Array points;
+		PackedInt32Array indices;
+		points.resize(POINT_COUNT);
+		indices.resize(POINT_COUNT);
+		for (int j = 0; j < POINT_COUNT; j++) {
+			points.write[j] = Vector2(j * 0.37 + i, j * -1.13);
+			indices.write[j] = (i * 7919 + j * 104729) % 65536;
+		}
+		data->set_meta("points", points);
+		data->set_meta("indices", indices);
+		data->set_meta("bounds", Rect2(0, 0, POINT_COUNT * 0.37, POINT_COUNT * 1.13));
+		data->set_meta("tags", Dictionary({ { "index", i }, { "kind", StringName("polygon") } }));
+		node->set_meta("data", data);
+
+		root->add_child(node);
+		node->set_owner(root);
+	}
+
+	Ref<PackedScene> scene = memnew(PackedScene);
+	Error err = scene->pack(root);
+	memdelete(root);
+	REQUIRE(err == OK);
+	return scene;
+}
+
+static uint64_t _load(const String &p_path) {
+	const uint64_t begin = OS::get_singleton()->get_ticks_usec();
+	Ref<PackedScene> loaded = ResourceLoader::load(p_path, "", ResourceFormatLoader::CACHE_MODE_IGNORE);
+	const uint64_t total = OS::get_singleton()->get_ticks_usec() - begin;
+
+	REQUIRE(loaded.is_valid());
+	CHECK(loaded->get_state()->get_node_count() == NODE_COUNT + 1);
+	return total;
+}
+
+// Run with `--test --no-skip`.
+TEST_CASE("[SceneTree][ResourceFormatText][Benchmark] Loading a large text scene" * doctest::skip()) {
+	const String text_path = TestUtils::get_temp_path("benchmark_large.tscn");
+	const String binary_path = TestUtils::get_temp_path("benchmark_large.scn");
+	{
+		Ref<PackedScene> scene = _make_scene();
+		REQUIRE(ResourceSaver::save(scene, text_path) == OK);
+		REQUIRE(ResourceSaver::save(scene, binary_path) == OK);
+	}
+	const int64_t text_size = FileAccess::get_size(text_path);
+	CHECK_MESSAGE(text_size >= SCENE_SIZE, "The scene should be as big as the ones the parser was optimized for.");
+
+	const uint64_t text_usec = _load(text_path);
+	const uint64_t binary_usec = _load(binary_path);
+
+	MESSAGE(vformat("%d MiB text scene: %d ms, %d MiB/s. Same scene as binary (%d MiB): %d ms, text is %.1fx slower.",
+			text_size >> 20, text_usec / 1000, int64_t(text_size * 1000000.0 / MAX(text_usec, (uint64_t)1) / (1 << 20)),
+			FileAccess::get_size(binary_path) >> 20, binary_usec / 1000, (double)text_usec / MAX(binary_usec, (uint64_t)1)));
+
+	DirAccess::remove_file_or_error(text_path);
+	DirAccess::remove_file_or_error(binary_path);
+}
+
+} // namespace TestResourceFormatTextBenchmark
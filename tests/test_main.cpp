@@ -51,11 +51,15 @@
 #include "tests/core/io/test_ip.h"
 #include "tests/core/io/test_json.h"
 #include "tests/core/io/test_json_native.h"
+#include "tests/core/io/test_json_stream.h"
+#include "tests/core/io/test_json_stream_benchmark.h"
 #include "tests/core/io/test_logger.h"
 #include "tests/core/io/test_marshalls.h"
+#include "tests/core/io/test_marshalls_benchmark.h"
 #include "tests/core/io/test_packet_peer.h"
 #include "tests/core/io/test_pck_packer.h"
 #include "tests/core/io/test_resource.h"
+#include "tests/core/io/test_resource_format_binary_benchmark.h"
 #include "tests/core/io/test_resource_uid.h"
 #include "tests/core/io/test_stream_peer.h"
 #include "tests/core/io/test_stream_peer_buffer.h"
@@ -68,6 +72,7 @@
 #include "tests/core/math/test_aabb.h"
 #include "tests/core/math/test_astar.h"
 #include "tests/core/math/test_basis.h"
+#include "tests/core/math/test_bulk_math.h"
 #include "tests/core/math/test_color.h"
 #include "tests/core/math/test_expression.h"
 #include "tests/core/math/test_geometry_2d.h"
@@ -88,13 +93,19 @@
 #include "tests/core/math/test_vector4.h"
 #include "tests/core/math/test_vector4i.h"
 #include "tests/core/object/test_class_db.h"
+#include "tests/core/object/test_message_queue.h"
 #include "tests/core/object/test_method_bind.h"
 #include "tests/core/object/test_object.h"
 #include "tests/core/object/test_undo_redo.h"
+#include "tests/core/object/test_worker_thread_pool_benchmark.h"
+#include "tests/core/os/test_frame_arena.h"
 #include "tests/core/os/test_os.h"
+#include "tests/core/profiling/test_alloc_profiler.h"
+#include "tests/core/profiling/test_trace_recorder.h"
 #include "tests/core/string/test_fuzzy_search.h"
 #include "tests/core/string/test_node_path.h"
 #include "tests/core/string/test_string.h"
+#include "tests/core/string/test_string_name.h"
 #include "tests/core/string/test_translation.h"
 #include "tests/core/string/test_translation_server.h"
 #include "tests/core/templates/test_a_hash_map.h"
@@ -106,11 +117,15 @@
 #include "tests/core/templates/test_local_vector.h"
 #include "tests/core/templates/test_lru.h"
 #include "tests/core/templates/test_paged_array.h"
+#include "tests/core/templates/test_parallel_algorithms.h"
 #include "tests/core/templates/test_rid.h"
 #include "tests/core/templates/test_self_list.h"
 #include "tests/core/templates/test_span.h"
+#include "tests/core/templates/test_swiss_hash_map.h"
+#include "tests/core/templates/test_unique_vector.h"
 #include "tests/core/templates/test_vector.h"
 #include "tests/core/templates/test_vset.h"
+#include "tests/core/templates/test_work_stealing_queue.h"
 #include "tests/core/test_crypto.h"
 #include "tests/core/test_hashing_context.h"
 #include "tests/core/test_time.h"
@@ -142,6 +157,7 @@
 #include "tests/scene/test_parallax_2d.h"
 #include "tests/scene/test_path_2d.h"
 #include "tests/scene/test_path_follow_2d.h"
+#include "tests/scene/test_resource_format_text_benchmark.h"
 #include "tests/scene/test_sprite_2d.h"
 #include "tests/scene/test_sprite_frames.h"
 #include "tests/scene/test_style_box_texture.h"
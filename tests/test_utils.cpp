@@ -31,6 +31,7 @@
 #include "tests/test_utils.h"
 
 #include "core/io/dir_access.h"
+#include "core/io/file_access.h"
 #include "core/os/os.h"
 
 String TestUtils::get_data_path(const String &p_file) {
@@ -47,3 +48,24 @@ String TestUtils::get_temp_path(const String &p_suffix) {
 	DirAccess::make_dir_absolute(temp_base); // Ensure the directory exists.
 	return temp_base.path_join(p_suffix);
 }
+
+uint64_t TestUtils::get_peak_rss_kib() {
+	Ref<FileAccess> status = FileAccess::open("/proc/self/status", FileAccess::READ);
+	if (status.is_null()) {
+		return 0;
+	}
+	while (!status->eof_reached()) {
+		String line = status->get_line();
+		if (line.begins_with("VmHWM:")) {
+			return line.trim_prefix("VmHWM:").strip_edges().to_int();
+		}
+	}
+	return 0;
+}
+
+void TestUtils::reset_peak_rss() {
+	Ref<FileAccess> clear_refs = FileAccess::open("/proc/self/clear_refs", FileAccess::WRITE);
+	if (clear_refs.is_valid()) {
+		clear_refs->store_string("5");
+	}
+}
@@ -30,6 +30,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 class String;
 
 namespace TestUtils {
@@ -37,4 +39,7 @@ namespace TestUtils {
 String get_data_path(const String &p_file);
 String get_executable_dir();
 String get_temp_path(const String &p_suffix);
+// Peak resident set size in KiB since the last reset, or 0 where it can't be measured (Linux only).
+uint64_t get_peak_rss_kib();
+void reset_peak_rss();
 } // namespace TestUtils